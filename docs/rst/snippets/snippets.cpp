@@ -22,7 +22,9 @@
  * @file snippets.cpp
  */
 
+#include <chrono>
 #include <iostream>
+#include <thread>
 
 #include <easynmea/EasyNmea.hpp>
 
@@ -60,6 +62,75 @@ void usage_snippets()
         easynmea.close();
         //!--
     }
+    {
+        //USAGE_REGISTER_DECODER
+        using namespace eduponz::easynmea;
+        EasyNmea easynmea;
+        // Hand the Garmin estimated position error sentences to the application
+        easynmea.register_decoder("PGRME", [](const RawSentence& raw)
+                {
+                    // The sentence is only valid until the handler returns
+                    std::cout << "Position error: " << raw.sentence << std::endl;
+                });
+        // Handlers can only be registered before opening the serial port
+        easynmea.open("/dev/ttyACM0", 9600);
+        //!--
+    }
+    {
+        //USAGE_READ_LATEST
+        using namespace eduponz::easynmea;
+        EasyNmea easynmea;
+        if (easynmea.open("/dev/ttyACM0", 115200) == ReturnCode::RETURN_CODE_OK)
+        {
+            // Poll the current heading at the rate of the control loop, regardless of the rate at
+            // which the device reports it
+            for (int i = 0; i < 100; i++)
+            {
+                THSData ths;
+                if (easynmea.read_latest(ths) == ReturnCode::RETURN_CODE_OK && ths.mode == 'A')
+                {
+                    std::cout << "Heading: " << ths.heading << std::endl;
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+        }
+        easynmea.close();
+        //!--
+    }
+    {
+        //USAGE_RECEIVE_TIME
+        using namespace eduponz::easynmea;
+        EasyNmea easynmea;
+        // Take the wall clock time of the samples as well, which can only be enabled before opening
+        easynmea.stamp_realtime(true);
+        if (easynmea.open("/dev/ttyACM0", 9600) == ReturnCode::RETURN_CODE_OK)
+        {
+            GPGGAData gpgga;
+            if (easynmea.wait_for_data() == ReturnCode::RETURN_CODE_OK &&
+                    easynmea.take_next(gpgga) == ReturnCode::RETURN_CODE_OK)
+            {
+                // The age of the sample, measured on the monotonic clock
+                auto age = std::chrono::steady_clock::now() - gpgga.receive_time.monotonic;
+                std::cout << "GGA received " << std::chrono::duration_cast<std::chrono::microseconds>(age).count()
+                          << " us ago" << std::endl;
+            }
+        }
+        easynmea.close();
+        //!--
+    }
+    {
+        //USAGE_READ_PROFILE
+        using namespace eduponz::easynmea;
+        EasyNmea easynmea;
+        // Wake up once per burst of sentences rather than on every byte
+        if (easynmea.set_read_profile(ReadProfile::lowest_cpu()) != ReturnCode::RETURN_CODE_OK)
+        {
+            std::cout << "Read profiles are not supported, reading with the default one" << std::endl;
+        }
+        easynmea.open("/dev/ttyACM0", 9600);
+        easynmea.close();
+        //!--
+    }
 }
 
 } // namespace docs_snippets
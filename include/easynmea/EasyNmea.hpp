@@ -26,7 +26,9 @@
 #define _EASYNMEA_HPP_
 
 #include <chrono>
+#include <functional>
 #include <memory>
+#include <string>
 
 #include "Bitmask.hpp"
 #include "data.hpp"
@@ -52,6 +54,12 @@ class EasyNmea
 {
 public:
 
+    /**
+     * Handler of the sentences of a registered address. It is called from the thread which reads
+     * from the serial connection, so it must not block, and it must not throw.
+     */
+    using SentenceHandler = std::function<void (const RawSentence& sentence)>;
+
     //! Default constructor. Constructs a \c EasyNmea
     EasyNmea() noexcept;
 
@@ -113,6 +121,282 @@ public:
     ReturnCode take_next(
             GPGGAData& gpgga) noexcept;
 
+    /**
+     * \brief Take the next untaken RMC data sample available.
+     *
+     * \c EasyNmea stores up to the last 10 reported RMC data samples, independently of the GPGGA
+     * ones. \c take_next() is used to retrieve the oldest untaken RMC sample.
+     *
+     * @param[out] rmc A \c RMCData instance which will be populated with the sample.
+     *
+     * @return \c take_next() can return:
+     *     * ReturnCode::RETURN_CODE_OK if the operation succeeded.
+     *     * ReturnCode::RETURN_CODE_NO_DATA if there are not any untaken \c RMCData samples.
+     */
+    ReturnCode take_next(
+            RMCData& rmc) noexcept;
+
+    /**
+     * \brief Take the next untaken GSV satellite table available.
+     *
+     * The GSV sentences of each constellation are reassembled into a satellite table, which is
+     * reported once the last sentence of its group is received. \c EasyNmea stores up to the last
+     * 10 reported tables of any constellation. \c take_next() is used to retrieve the oldest
+     * untaken table.
+     *
+     * @param[out] gsv A \c GSVData instance which will be populated with the table.
+     *
+     * @return \c take_next() can return:
+     *     * ReturnCode::RETURN_CODE_OK if the operation succeeded.
+     *     * ReturnCode::RETURN_CODE_NO_DATA if there are not any untaken \c GSVData tables.
+     */
+    ReturnCode take_next(
+            GSVData& gsv) noexcept;
+
+    /**
+     * \brief Take the next untaken GSA data sample available.
+     *
+     * The GSA sentences of each epoch, one per constellation, are merged into a single sample,
+     * which is reported once the sentence following the last GSA one of the epoch is received.
+     * \c EasyNmea stores up to the last 10 reported GSA samples. \c take_next() is used to retrieve
+     * the oldest untaken sample.
+     *
+     * @param[out] gsa A \c GSAData instance which will be populated with the sample.
+     *
+     * @return \c take_next() can return:
+     *     * ReturnCode::RETURN_CODE_OK if the operation succeeded.
+     *     * ReturnCode::RETURN_CODE_NO_DATA if there are not any untaken \c GSAData samples.
+     */
+    ReturnCode take_next(
+            GSAData& gsa) noexcept;
+
+    /**
+     * \brief Take the next untaken AIS position report available.
+     *
+     * The VDM and VDO sentences of each AIS message are reassembled, and the position reports of
+     * class A and class B stations (message types 1, 2, 3, and 18) are reported once the last
+     * sentence of their message is received. The rest of the AIS messages are discarded.
+     * \c EasyNmea stores up to the last 10 reported AIS position reports. \c take_next() is used to
+     * retrieve the oldest untaken report.
+     *
+     * @param[out] ais A \c AISPositionData instance which will be populated with the report.
+     *
+     * @return \c take_next() can return:
+     *     * ReturnCode::RETURN_CODE_OK if the operation succeeded.
+     *     * ReturnCode::RETURN_CODE_NO_DATA if there are not any untaken \c AISPositionData reports.
+     */
+    ReturnCode take_next(
+            AISPositionData& ais) noexcept;
+
+    /**
+     * \brief Take the next untaken ZDA data sample available.
+     *
+     * ZDA sentences report the UTC date, with which \c EasyNmea dates the \c utc_time of the GPGGA
+     * samples, and of the RMC samples that do not report a date, across midnight included.
+     * \c EasyNmea stores up to the last 10 reported ZDA data samples. \c take_next() is used to
+     * retrieve the oldest untaken ZDA sample.
+     *
+     * @param[out] zda A \c ZDAData instance which will be populated with the sample.
+     *
+     * @return \c take_next() can return:
+     *     * ReturnCode::RETURN_CODE_OK if the operation succeeded.
+     *     * ReturnCode::RETURN_CODE_NO_DATA if there are not any untaken \c ZDAData samples.
+     */
+    ReturnCode take_next(
+            ZDAData& zda) noexcept;
+
+    /**
+     * \brief Take the next untaken HDT data sample available.
+     *
+     * HDT sentences report the true heading, as computed by dual antenna GNSS receivers.
+     * \c EasyNmea stores up to the last 10 reported HDT data samples. \c take_next() is used to
+     * retrieve the oldest untaken HDT sample. Since heading is usually reported at a much higher
+     * rate than position, applications which only need the current value may use \c read_latest()
+     * instead.
+     *
+     * @param[out] hdt A \c HDTData instance which will be populated with the sample.
+     *
+     * @return \c take_next() can return:
+     *     * ReturnCode::RETURN_CODE_OK if the operation succeeded.
+     *     * ReturnCode::RETURN_CODE_NO_DATA if there are not any untaken \c HDTData samples.
+     */
+    ReturnCode take_next(
+            HDTData& hdt) noexcept;
+
+    /**
+     * \brief Take the next untaken THS data sample available.
+     *
+     * THS sentences report the true heading together with the mode in which it was obtained.
+     * \c EasyNmea stores up to the last 10 reported THS data samples. \c take_next() is used to
+     * retrieve the oldest untaken THS sample. Since heading is usually reported at a much higher
+     * rate than position, applications which only need the current value may use \c read_latest()
+     * instead.
+     *
+     * @param[out] ths A \c THSData instance which will be populated with the sample.
+     *
+     * @return \c take_next() can return:
+     *     * ReturnCode::RETURN_CODE_OK if the operation succeeded.
+     *     * ReturnCode::RETURN_CODE_NO_DATA if there are not any untaken \c THSData samples.
+     */
+    ReturnCode take_next(
+            THSData& ths) noexcept;
+
+    /**
+     * \brief Take the next untaken ROT data sample available.
+     *
+     * ROT sentences report the rate of turn of the vessel. \c EasyNmea stores up to the last 10
+     * reported ROT data samples. \c take_next() is used to retrieve the oldest untaken ROT sample.
+     * Since the rate of turn is usually reported at a much higher rate than position, applications
+     * which only need the current value may use \c read_latest() instead.
+     *
+     * @param[out] rot A \c ROTData instance which will be populated with the sample.
+     *
+     * @return \c take_next() can return:
+     *     * ReturnCode::RETURN_CODE_OK if the operation succeeded.
+     *     * ReturnCode::RETURN_CODE_NO_DATA if there are not any untaken \c ROTData samples.
+     */
+    ReturnCode take_next(
+            ROTData& rot) noexcept;
+
+    /**
+     * \brief Take the next untaken GST data sample available.
+     *
+     * GST sentences report the statistics of the position errors of an epoch, so they can be used
+     * to assess the quality of the GPGGA sample with the same time of day. \c EasyNmea stores up to
+     * the last 10 reported GST data samples. \c take_next() is used to retrieve the oldest untaken
+     * GST sample.
+     *
+     * @param[out] gst A \c GSTData instance which will be populated with the sample.
+     *
+     * @return \c take_next() can return:
+     *     * ReturnCode::RETURN_CODE_OK if the operation succeeded.
+     *     * ReturnCode::RETURN_CODE_NO_DATA if there are not any untaken \c GSTData samples.
+     */
+    ReturnCode take_next(
+            GSTData& gst) noexcept;
+
+    /**
+     * \brief Read the latest HDT data sample received.
+     *
+     * The latest sample is kept apart from the ones queued for \c take_next(), and it is read
+     * without locking, so the calling thread never waits for the reception of the sentences nor
+     * delays it. The sample is not taken, so it can be read any number of times, which suits
+     * control loops that poll the current value at their own rate.
+     *
+     * @param[out] hdt A \c HDTData instance which will be populated with the sample.
+     *
+     * @return \c read_latest() can return:
+     *     * ReturnCode::RETURN_CODE_OK if the operation succeeded.
+     *     * ReturnCode::RETURN_CODE_NO_DATA if no \c HDTData sample has been received since the
+     *       connection was opened.
+     */
+    ReturnCode read_latest(
+            HDTData& hdt) noexcept;
+
+    /**
+     * \brief Read the latest THS data sample received.
+     *
+     * The latest sample is kept apart from the ones queued for \c take_next(), and it is read
+     * without locking, so the calling thread never waits for the reception of the sentences nor
+     * delays it. The sample is not taken, so it can be read any number of times, which suits
+     * control loops that poll the current value at their own rate.
+     *
+     * @param[out] ths A \c THSData instance which will be populated with the sample.
+     *
+     * @return \c read_latest() can return:
+     *     * ReturnCode::RETURN_CODE_OK if the operation succeeded.
+     *     * ReturnCode::RETURN_CODE_NO_DATA if no \c THSData sample has been received since the
+     *       connection was opened.
+     */
+    ReturnCode read_latest(
+            THSData& ths) noexcept;
+
+    /**
+     * \brief Read the latest ROT data sample received.
+     *
+     * The latest sample is kept apart from the ones queued for \c take_next(), and it is read
+     * without locking, so the calling thread never waits for the reception of the sentences nor
+     * delays it. The sample is not taken, so it can be read any number of times, which suits
+     * control loops that poll the current value at their own rate.
+     *
+     * @param[out] rot A \c ROTData instance which will be populated with the sample.
+     *
+     * @return \c read_latest() can return:
+     *     * ReturnCode::RETURN_CODE_OK if the operation succeeded.
+     *     * ReturnCode::RETURN_CODE_NO_DATA if no \c ROTData sample has been received since the
+     *       connection was opened.
+     */
+    ReturnCode read_latest(
+            ROTData& rot) noexcept;
+
+    /**
+     * \brief Register a handler for the sentences of an address which the library does not decode.
+     *
+     * The sentences which the library does not support, such as the proprietary '$P' sentences,
+     * are discarded unless a handler has been registered for their address. The sentences of a
+     * registered address are handed to its handler as a \c RawSentence as soon as they are received,
+     * once their framing and checksum have been validated. The sentence is not copied, so it is
+     * only valid during the call to the handler. The supported sentences are always decoded by the
+     * library, so registering their address has no effect.
+     *
+     * \pre The EasyNmea does not have any serial port opened.
+     *
+     * @param[in] address The address of the sentences, without the '$' or the '!' (for instance,
+     *            "PGRME"). It consists of up to 8 upper case letters and digits. An empty address
+     *            registers a handler for every unsupported sentence which has no handler of its own.
+     * @param[in] handler The handler of the sentences.
+     * @return \c register_decoder() can return:
+     *     * ReturnCode::RETURN_CODE_OK if the handler was registered.
+     *     * ReturnCode::RETURN_CODE_BAD_PARAMETER if the address is not valid, it already has a
+     *       handler, or \c handler is empty.
+     *     * ReturnCode::RETURN_CODE_ERROR if 16 handlers have already been registered.
+     *     * ReturnCode::RETURN_CODE_ILLEGAL_OPERATION if the serial connection is open.
+     */
+    ReturnCode register_decoder(
+            const std::string& address,
+            SentenceHandler handler) noexcept;
+
+    /**
+     * \brief Enable taking the realtime time point of the samples, besides the monotonic one.
+     *
+     * Every sample carries the time at which its sentence was received in its \c receive_time,
+     * which is taken when the first byte of the sentence is read from the serial port. The
+     * monotonic time point is always taken, and it measures how long the sample has waited to be
+     * taken. The realtime time point, which relates the sample to the time of other hosts, is only
+     * taken if enabled; otherwise \c ReceiveTime::realtime is left at the epoch of its clock.
+     *
+     * \pre The EasyNmea does not have any serial port opened.
+     *
+     * @param[in] enable Whether to take the realtime time point. It is not taken by default.
+     * @return \c stamp_realtime() can return:
+     *     * ReturnCode::RETURN_CODE_OK if the setting was applied.
+     *     * ReturnCode::RETURN_CODE_ILLEGAL_OPERATION if the serial connection is open.
+     */
+    ReturnCode stamp_realtime(
+            bool enable) noexcept;
+
+    /**
+     * \brief Set when the serial port wakes the reading thread up to take the received bytes.
+     *
+     * This trades the latency of the samples against the CPU time and the wake-ups of the reading
+     * thread. \c ReadProfile::lowest_latency(), the default, hands every sentence over as soon as
+     * it is received, and \c ReadProfile::lowest_cpu() takes each burst of sentences in a couple of
+     * wake-ups, holding them back up to 100 ms. Read profiles are only supported when the library
+     * is built with either of the CMake options \c POSIX_SERIAL_PORT and \c URING_SERIAL_PORT.
+     *
+     * \pre The EasyNmea does not have any serial port opened.
+     *
+     * @param[in] profile The profile applied by the following calls to \c open().
+     * @return \c set_read_profile() can return:
+     *     * ReturnCode::RETURN_CODE_OK if the profile was set.
+     *     * ReturnCode::RETURN_CODE_BAD_PARAMETER if the \c vmin of the profile is 0.
+     *     * ReturnCode::RETURN_CODE_UNSUPPORTED if the library is built with neither
+     *       \c POSIX_SERIAL_PORT nor \c URING_SERIAL_PORT.
+     *     * ReturnCode::RETURN_CODE_ILLEGAL_OPERATION if the serial connection is open.
+     */
+    ReturnCode set_read_profile(
+            const ReadProfile& profile) noexcept;
+
     /**
      * \brief Block the calling thread until there is data available.
      *
@@ -25,18 +25,175 @@
 #ifndef _EASYNMEA_DATA_HPP_
 #define _EASYNMEA_DATA_HPP_
 
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <string>
+#include <string_view>
+#include <type_traits>
 
 #include "types.hpp"
 
 namespace eduponz {
 namespace easynmea {
 
+/**
+ * UTC time point with a resolution of milliseconds. As \c std::chrono::system_clock, it counts the
+ * milliseconds since 1970-01-01 00:00:00 UTC without leap seconds.
+ */
+using UtcTime = std::chrono::time_point<std::chrono::system_clock, std::chrono::milliseconds>;
+
+/**
+ * \struct TagBlock
+ *
+ * @brief Struct for the NMEA 0183 tag block which may precede a sentence
+ *
+ * Tag blocks are prepended to the sentences by loggers and network gateways, enclosed in
+ * backslashes and with their own checksum, as in \c \\s:GPS1,c:1609459200*hh\\$GPGGA,... Only the
+ * source and the time parameters are kept; the rest of them are validated and skipped.
+ */
+struct TagBlock
+{
+    //! Maximum number of characters of the source identifier
+    static constexpr std::size_t MAX_SOURCE_LENGTH = 15;
+
+    /**
+     * Default constructor; it empty-initializes the struct, which stands for a sentence without
+     * tag block
+     */
+    TagBlock() noexcept
+        : source{}
+        , unix_time_ms(-1)
+    {
+    }
+
+    //! Identifier of the source (s: parameter), null terminated. Empty if not present
+    char source[MAX_SOURCE_LENGTH + 1];
+
+    //! UNIX time (c: parameter) in milliseconds. -1 if not present
+    int64_t unix_time_ms;
+
+    /**
+     * Check whether the tag block holds any parameter
+     *
+     * @return true if neither the source nor the time are present; false otherwise
+     */
+    inline bool empty() const noexcept
+    {
+        return source[0] == '\0' && unix_time_ms < 0;
+    }
+
+    /**
+     * Check whether a \c TagBlock is equal to this one
+     *
+     * @param[in] other A constant reference to the \c TagBlock to compare with this one
+     *
+     * @return true if equal; false otherwise
+     */
+    inline bool operator ==(
+            const TagBlock& other) const noexcept
+    {
+        return (std::strncmp(source, other.source, sizeof(source)) == 0 &&
+               unix_time_ms == other.unix_time_ms);
+    }
+
+    /**
+     * Check whether a \c TagBlock is different from this one
+     *
+     * @param[in] other A constant reference to the \c TagBlock to compare with this one
+     *
+     * @return true if different; false otherwise
+     */
+    inline bool operator !=(
+            const TagBlock& other) const noexcept
+    {
+        return !(*this == other);
+    }
+
+};
+
+/**
+ * \struct ReceiveTime
+ *
+ * @brief Struct for the time at which a sentence was received
+ *
+ * The time is taken when the first byte of the sentence, i.e. its '$' or '!', or the '\\' of the
+ * tag block preceding it, is read from the serial port. As the port is read in chunks, it is the
+ * time at which the chunk holding that byte was read. Hence, it does not include the time that the
+ * sentence took to be decoded, nor the time that the sample waited to be taken.
+ */
+struct ReceiveTime
+{
+    /**
+     * Default constructor; it sets both time points to the epoch of their clock, which stands for
+     * a sample which was not received from a serial port
+     */
+    ReceiveTime() noexcept
+        : monotonic()
+        , realtime()
+    {
+    }
+
+    /**
+     * Time point of \c std::chrono::steady_clock, which reads \c CLOCK_MONOTONIC on Linux. It is
+     * not affected by changes of the system time, so it measures the age of the samples, and it
+     * aligns the samples of several receivers read by the same host.
+     */
+    std::chrono::steady_clock::time_point monotonic;
+
+    /**
+     * Time point of \c std::chrono::system_clock, which reads \c CLOCK_REALTIME on Linux. It is
+     * only taken if enabled with \c EasyNmea::stamp_realtime(); otherwise it is the epoch of the
+     * clock.
+     */
+    std::chrono::system_clock::time_point realtime;
+
+    /**
+     * Check whether the sample was received from a serial port
+     *
+     * @return true if \c monotonic is the epoch of its clock; false otherwise
+     */
+    inline bool empty() const noexcept
+    {
+        return monotonic == std::chrono::steady_clock::time_point();
+    }
+
+    /**
+     * Check whether a \c ReceiveTime is equal to this one
+     *
+     * @param[in] other A constant reference to the \c ReceiveTime to compare with this one
+     *
+     * @return true if equal; false otherwise
+     */
+    inline bool operator ==(
+            const ReceiveTime& other) const noexcept
+    {
+        return (monotonic == other.monotonic && realtime == other.realtime);
+    }
+
+    /**
+     * Check whether a \c ReceiveTime is different from this one
+     *
+     * @param[in] other A constant reference to the \c ReceiveTime to compare with this one
+     *
+     * @return true if different; false otherwise
+     */
+    inline bool operator !=(
+            const ReceiveTime& other) const noexcept
+    {
+        return !(*this == other);
+    }
+
+};
 
 /**
  * \struct NMEA0183Data
  *
  * @brief Base struct for all NMEA 0183 Data types
+ *
+ * The NMEA 0183 data types are plain values: they do not have virtual member functions and they are
+ * trivially copyable. Hence, they must not be destroyed through a pointer to \c NMEA0183Data.
  */
 struct NMEA0183Data
 {
@@ -45,19 +202,35 @@ struct NMEA0183Data
      *
      * @param[in] data_kind The \c NMEA0183DataKind of the data instance. Defaults to
      *        \c NMEA0183DataKind::INVALID
+     * @param[in] data_talker The \c NMEA0183Talker of the data instance. Defaults to
+     *        \c NMEA0183Talker::UNKNOWN
      */
     NMEA0183Data(
-            NMEA0183DataKind data_kind = NMEA0183DataKind::INVALID) noexcept
+            NMEA0183DataKind data_kind = NMEA0183DataKind::INVALID,
+            NMEA0183Talker data_talker = NMEA0183Talker::UNKNOWN) noexcept
         : kind(data_kind)
+        , talker(data_talker)
+        , tag_block()
+        , receive_time()
     {
     }
 
-    //! Default virtual constructor
-    virtual ~NMEA0183Data() = default;
-
     //! The NMEA0183DataKind of the data
     NMEA0183DataKind kind;
 
+    //! The talker that originated the sentence
+    NMEA0183Talker talker;
+
+    //! The tag block which preceded the sentence. It is empty if there was none
+    TagBlock tag_block;
+
+    /**
+     * The time at which the sentence was received. For the data assembled from several sentences,
+     * it is the time at which the first of them was received. It is not compared by
+     * \c operator ==(), as it does not belong to the contents of the sentence.
+     */
+    ReceiveTime receive_time;
+
     /**
      * Check whether a \c NMEA0183Data is equal to this one
      *
@@ -68,7 +241,7 @@ struct NMEA0183Data
     inline bool operator ==(
             const NMEA0183Data& other) const noexcept
     {
-        return (kind == other.kind);
+        return (kind == other.kind && talker == other.talker && tag_block == other.tag_block);
     }
 
     /**
@@ -90,18 +263,25 @@ struct NMEA0183Data
  * \struct GPGGAData
  *
  * @brief Struct for data from GPGGA sentences
+ *
+ * GGA sentences from any supported talker (GNGGA, GLGGA, etc.) are also decoded into a \c GPGGAData,
+ * in which case \c talker holds the talker that originated the sentence.
  */
 struct GPGGAData : NMEA0183Data
 {
     /**
      *  Default constructor; it empty-initializes the struct, setting \c kind to
-     * \c NMEA0183DataKind::GPGGA
+     * \c NMEA0183DataKind::GPGGA and \c talker to \c NMEA0183Talker::GP
      */
     GPGGAData() noexcept
-        : NMEA0183Data::NMEA0183Data(NMEA0183DataKind::GPGGA)
+        : NMEA0183Data::NMEA0183Data(NMEA0183DataKind::GPGGA, NMEA0183Talker::GP)
         , timestamp(0)
+        , time_of_day_ms(0)
+        , utc_time(UtcTime::min())
         , latitude(0)
         , longitude(0)
+        , latitude_e7(0)
+        , longitude_e7(0)
         , fix(0)
         , satellites_on_view(0)
         , horizontal_precision(0)
@@ -115,13 +295,37 @@ struct GPGGAData : NMEA0183Data
     //! UTC time hhmmss.milliseconds
     float timestamp;
 
-    //! Latitude in degrees referred to North
+    /**
+     * UTC time of day in milliseconds since midnight. It is calculated with integer arithmetic from
+     * the digits of the sentence, truncated to milliseconds, so it is exact where \c timestamp is
+     * not. It is in [0; 86401000), as it can hold a leap second, or -1 if the time in the sentence
+     * is out of range.
+     */
+    int32_t time_of_day_ms;
 
+    /**
+     * UTC time point of the sample, or \c UtcTime::min() if the date is unknown. GGA sentences do
+     * not carry a date, so the decoder leaves it unknown, and \c EasyNmea sets it from the date of
+     * the latest RMC or ZDA sentence.
+     */
+    UtcTime utc_time;
+
+    //! Latitude in degrees referred to North
     float latitude;
-    //! Longitude in degrees referred to East
 
+    //! Longitude in degrees referred to East
     float longitude;
 
+    /**
+     * Latitude in units of 1e-7 degrees referred to North. It is calculated with integer arithmetic
+     * from the digits of the sentence, so it does not suffer from the rounding of \c latitude, and
+     * it is exact (rounded to the nearest unit) for up to 8 decimal places of minutes.
+     */
+    int32_t latitude_e7;
+
+    //! Longitude in units of 1e-7 degrees referred to East. It is calculated as \c latitude_e7
+    int32_t longitude_e7;
+
     /** GNSS Fix
      *    - 0: no fix
      *    - 1 -> fix
@@ -159,8 +363,12 @@ struct GPGGAData : NMEA0183Data
     {
         return (NMEA0183Data::operator ==(other) &&
                timestamp == other.timestamp &&
+               time_of_day_ms == other.time_of_day_ms &&
+               utc_time == other.utc_time &&
                latitude == other.latitude &&
                longitude == other.longitude &&
+               latitude_e7 == other.latitude_e7 &&
+               longitude_e7 == other.longitude_e7 &&
                fix == other.fix &&
                satellites_on_view == other.satellites_on_view &&
                horizontal_precision == other.horizontal_precision &&
@@ -185,6 +393,1079 @@ struct GPGGAData : NMEA0183Data
 
 };
 
+static_assert(std::is_trivially_copyable<GPGGAData>::value, "GPGGAData must be trivially copyable");
+
+/**
+ * \struct RMCData
+ *
+ * @brief Struct for data from RMC sentences
+ *
+ * RMC sentences from any supported talker (GPRMC, GNRMC, etc.) are decoded into a \c RMCData, in
+ * which case \c talker holds the talker that originated the sentence. The fields that a sentence
+ * leaves empty keep their default values.
+ */
+struct RMCData : NMEA0183Data
+{
+    /**
+     *  Default constructor; it empty-initializes the struct, setting \c kind to
+     * \c NMEA0183DataKind::RMC and \c talker to \c NMEA0183Talker::GP
+     */
+    RMCData() noexcept
+        : NMEA0183Data::NMEA0183Data(NMEA0183DataKind::RMC, NMEA0183Talker::GP)
+        , timestamp(0)
+        , time_of_day_ms(0)
+        , utc_time(UtcTime::min())
+        , status('V')
+        , latitude(0)
+        , longitude(0)
+        , latitude_e7(0)
+        , longitude_e7(0)
+        , speed(-1)
+        , course(-1)
+        , date(0)
+        , magnetic_variation(0)
+        , mode('\0')
+        , navigational_status('\0')
+    {
+    }
+
+    //! UTC time hhmmss.milliseconds
+    float timestamp;
+
+    //! UTC time of day in milliseconds since midnight, as \c GPGGAData::time_of_day_ms
+    int32_t time_of_day_ms;
+
+    /**
+     * UTC time point of the sample, calculated from \c date and \c time_of_day_ms, or
+     * \c UtcTime::min() if the sentence does not report the date. The years 80 to 99 of \c date are
+     * taken as 1980 to 1999, and the rest as 2000 to 2079. If the sentence does not report the
+     * date, \c EasyNmea sets it from the date of the latest RMC or ZDA sentence.
+     */
+    UtcTime utc_time;
+
+    /** Status
+     *    - 'A' -> data valid
+     *    - 'V' -> navigation receiver warning
+     */
+    char status;
+
+    //! Latitude in degrees referred to North
+    float latitude;
+
+    //! Longitude in degrees referred to East
+    float longitude;
+
+    //! Latitude in units of 1e-7 degrees referred to North. It is 0 if the sentence has no position
+    int32_t latitude_e7;
+
+    //! Longitude in units of 1e-7 degrees referred to East. It is 0 if the sentence has no position
+    int32_t longitude_e7;
+
+    //! Speed over ground in knots, or -1 if the sentence does not report it
+    float speed;
+
+    //! Course over ground in degrees referred to true North, or -1 if the sentence does not report it
+    float course;
+
+    //! UTC date as the integer ddmmyy, or 0 if the sentence does not report it
+    uint32_t date;
+
+    //! Magnetic variation in degrees, positive towards East and negative towards West
+    float magnetic_variation;
+
+    /** Mode indicator (NMEA 0183 2.3 and later), or '\0' if the sentence does not report it
+     *    - 'A' -> autonomous
+     *    - 'D' -> differential
+     *    - 'E' -> estimated (dead reckoning)
+     *    - 'F' -> float RTK
+     *    - 'M' -> manual input
+     *    - 'N' -> data not valid
+     *    - 'P' -> precise
+     *    - 'R' -> RTK
+     *    - 'S' -> simulator
+     */
+    char mode;
+
+    /** Navigational status (NMEA 0183 4.1 and later), or '\0' if the sentence does not report it
+     *    - 'S' -> safe
+     *    - 'C' -> caution
+     *    - 'U' -> unsafe
+     *    - 'V' -> not valid
+     */
+    char navigational_status;
+
+    /**
+     * Check whether a \c RMCData is equal to this one
+     *
+     * @param[in] other A constant reference to the \c RMCData to compare with this one
+     *
+     * @return true if equal; false otherwise
+     */
+    inline bool operator ==(
+            const RMCData& other) const noexcept
+    {
+        return (NMEA0183Data::operator ==(other) &&
+               timestamp == other.timestamp &&
+               time_of_day_ms == other.time_of_day_ms &&
+               utc_time == other.utc_time &&
+               status == other.status &&
+               latitude == other.latitude &&
+               longitude == other.longitude &&
+               latitude_e7 == other.latitude_e7 &&
+               longitude_e7 == other.longitude_e7 &&
+               speed == other.speed &&
+               course == other.course &&
+               date == other.date &&
+               magnetic_variation == other.magnetic_variation &&
+               mode == other.mode &&
+               navigational_status == other.navigational_status);
+    }
+
+    /**
+     * Check whether a \c RMCData is different from this one
+     *
+     * @param[in] other A constant reference to the \c RMCData to compare with this one
+     *
+     * @return true if different; false otherwise
+     */
+    inline bool operator !=(
+            const RMCData& other) const noexcept
+    {
+        return !(*this == other);
+    }
+
+};
+
+static_assert(std::is_trivially_copyable<RMCData>::value, "RMCData must be trivially copyable");
+
+/**
+ * \struct ZDAData
+ *
+ * @brief Struct for data from ZDA sentences
+ *
+ * ZDA sentences report the UTC time with the full date, and they are what anchors the time of day
+ * of the rest of the sentences to a date. ZDA sentences from any supported talker (GPZDA, GNZDA,
+ * etc.) are decoded into a \c ZDAData, in which case \c talker holds the talker that originated the
+ * sentence. The fields that a sentence leaves empty keep their default values.
+ */
+struct ZDAData : NMEA0183Data
+{
+    /**
+     *  Default constructor; it empty-initializes the struct, setting \c kind to
+     * \c NMEA0183DataKind::ZDA and \c talker to \c NMEA0183Talker::GP
+     */
+    ZDAData() noexcept
+        : NMEA0183Data::NMEA0183Data(NMEA0183DataKind::ZDA, NMEA0183Talker::GP)
+        , time_of_day_ms(-1)
+        , day(0)
+        , month(0)
+        , year(0)
+        , local_zone_hours(0)
+        , local_zone_minutes(0)
+        , utc_time(UtcTime::min())
+    {
+    }
+
+    /**
+     * UTC time of day in milliseconds since midnight, as \c GPGGAData::time_of_day_ms, or -1 if the
+     * sentence does not report it
+     */
+    int32_t time_of_day_ms;
+
+    //! UTC day of the month in [1; 31], or 0 if the sentence does not report it
+    uint8_t day;
+
+    //! UTC month in [1; 12], or 0 if the sentence does not report it
+    uint8_t month;
+
+    //! UTC year with four digits, or 0 if the sentence does not report it
+    uint16_t year;
+
+    //! Hours of the local time zone offset from UTC, in [-13; 13]
+    int8_t local_zone_hours;
+
+    //! Minutes of the local time zone offset from UTC, in [0; 59], with the sign of \c local_zone_hours
+    uint8_t local_zone_minutes;
+
+    /**
+     * UTC time point of the sample, calculated from the date and \c time_of_day_ms, or
+     * \c UtcTime::min() if the sentence does not report all of them
+     */
+    UtcTime utc_time;
+
+    /**
+     * Check whether a \c ZDAData is equal to this one
+     *
+     * @param[in] other A constant reference to the \c ZDAData to compare with this one
+     *
+     * @return true if equal; false otherwise
+     */
+    inline bool operator ==(
+            const ZDAData& other) const noexcept
+    {
+        return (NMEA0183Data::operator ==(other) &&
+               time_of_day_ms == other.time_of_day_ms &&
+               day == other.day &&
+               month == other.month &&
+               year == other.year &&
+               local_zone_hours == other.local_zone_hours &&
+               local_zone_minutes == other.local_zone_minutes &&
+               utc_time == other.utc_time);
+    }
+
+    /**
+     * Check whether a \c ZDAData is different from this one
+     *
+     * @param[in] other A constant reference to the \c ZDAData to compare with this one
+     *
+     * @return true if different; false otherwise
+     */
+    inline bool operator !=(
+            const ZDAData& other) const noexcept
+    {
+        return !(*this == other);
+    }
+
+};
+
+static_assert(std::is_trivially_copyable<ZDAData>::value, "ZDAData must be trivially copyable");
+
+/**
+ * \struct HDTData
+ *
+ * @brief Struct for data from HDT sentences
+ *
+ * HDT sentences report the true heading, as computed by dual antenna GNSS receivers, usually at a
+ * much higher rate than the position. HDT sentences from any supported talker (GPHDT, GNHDT, etc.)
+ * are decoded into a \c HDTData, in which case \c talker holds the talker that originated the
+ * sentence.
+ */
+struct HDTData : NMEA0183Data
+{
+    /**
+     *  Default constructor; it empty-initializes the struct, setting \c kind to
+     * \c NMEA0183DataKind::HDT and \c talker to \c NMEA0183Talker::GP
+     */
+    HDTData() noexcept
+        : NMEA0183Data::NMEA0183Data(NMEA0183DataKind::HDT, NMEA0183Talker::GP)
+        , heading(-1)
+    {
+    }
+
+    //! Heading in degrees referred to true North, or -1 if the sentence does not report it
+    float heading;
+
+    /**
+     * Check whether a \c HDTData is equal to this one
+     *
+     * @param[in] other A constant reference to the \c HDTData to compare with this one
+     *
+     * @return true if equal; false otherwise
+     */
+    inline bool operator ==(
+            const HDTData& other) const noexcept
+    {
+        return (NMEA0183Data::operator ==(other) &&
+               heading == other.heading);
+    }
+
+    /**
+     * Check whether a \c HDTData is different from this one
+     *
+     * @param[in] other A constant reference to the \c HDTData to compare with this one
+     *
+     * @return true if different; false otherwise
+     */
+    inline bool operator !=(
+            const HDTData& other) const noexcept
+    {
+        return !(*this == other);
+    }
+
+};
+
+static_assert(std::is_trivially_copyable<HDTData>::value, "HDTData must be trivially copyable");
+
+/**
+ * \struct THSData
+ *
+ * @brief Struct for data from THS sentences
+ *
+ * THS sentences report the true heading together with the mode in which it was obtained, and
+ * they supersede HDT sentences as of NMEA 0183 3.0. THS sentences from any supported talker
+ * (GPTHS, GNTHS, etc.) are decoded into a \c THSData, in which case \c talker holds the talker
+ * that originated the sentence.
+ */
+struct THSData : NMEA0183Data
+{
+    /**
+     *  Default constructor; it empty-initializes the struct, setting \c kind to
+     * \c NMEA0183DataKind::THS and \c talker to \c NMEA0183Talker::GP
+     */
+    THSData() noexcept
+        : NMEA0183Data::NMEA0183Data(NMEA0183DataKind::THS, NMEA0183Talker::GP)
+        , heading(-1)
+        , mode('V')
+    {
+    }
+
+    //! Heading in degrees referred to true North, or -1 if the sentence does not report it
+    float heading;
+
+    /** Mode indicator
+     *    - 'A' -> autonomous
+     *    - 'E' -> estimated (dead reckoning)
+     *    - 'M' -> manual input
+     *    - 'S' -> simulator
+     *    - 'V' -> data not valid
+     */
+    char mode;
+
+    /**
+     * Check whether a \c THSData is equal to this one
+     *
+     * @param[in] other A constant reference to the \c THSData to compare with this one
+     *
+     * @return true if equal; false otherwise
+     */
+    inline bool operator ==(
+            const THSData& other) const noexcept
+    {
+        return (NMEA0183Data::operator ==(other) &&
+               heading == other.heading &&
+               mode == other.mode);
+    }
+
+    /**
+     * Check whether a \c THSData is different from this one
+     *
+     * @param[in] other A constant reference to the \c THSData to compare with this one
+     *
+     * @return true if different; false otherwise
+     */
+    inline bool operator !=(
+            const THSData& other) const noexcept
+    {
+        return !(*this == other);
+    }
+
+};
+
+static_assert(std::is_trivially_copyable<THSData>::value, "THSData must be trivially copyable");
+
+/**
+ * \struct ROTData
+ *
+ * @brief Struct for data from ROT sentences
+ *
+ * ROT sentences report the rate of turn of the vessel. ROT sentences from any supported talker
+ * (GPROT, GNROT, etc.) are decoded into a \c ROTData, in which case \c talker holds the talker that
+ * originated the sentence.
+ */
+struct ROTData : NMEA0183Data
+{
+    /**
+     *  Default constructor; it empty-initializes the struct, setting \c kind to
+     * \c NMEA0183DataKind::ROT and \c talker to \c NMEA0183Talker::GP
+     */
+    ROTData() noexcept
+        : NMEA0183Data::NMEA0183Data(NMEA0183DataKind::ROT, NMEA0183Talker::GP)
+        , rate_of_turn(0)
+        , status('V')
+    {
+    }
+
+    /**
+     * Rate of turn in degrees per minute, negative when the bow turns to port, or 0 if the sentence
+     * does not report it
+     */
+    float rate_of_turn;
+
+    /** Status
+     *    - 'A' -> data valid
+     *    - 'V' -> data not valid
+     */
+    char status;
+
+    /**
+     * Check whether a \c ROTData is equal to this one
+     *
+     * @param[in] other A constant reference to the \c ROTData to compare with this one
+     *
+     * @return true if equal; false otherwise
+     */
+    inline bool operator ==(
+            const ROTData& other) const noexcept
+    {
+        return (NMEA0183Data::operator ==(other) &&
+               rate_of_turn == other.rate_of_turn &&
+               status == other.status);
+    }
+
+    /**
+     * Check whether a \c ROTData is different from this one
+     *
+     * @param[in] other A constant reference to the \c ROTData to compare with this one
+     *
+     * @return true if different; false otherwise
+     */
+    inline bool operator !=(
+            const ROTData& other) const noexcept
+    {
+        return !(*this == other);
+    }
+
+};
+
+static_assert(std::is_trivially_copyable<ROTData>::value, "ROTData must be trivially copyable");
+
+/**
+ * \struct GSTData
+ *
+ * @brief Struct for data from GST sentences
+ *
+ * GST sentences report the statistics of the errors of the position solution of an epoch, namely
+ * the standard deviation ellipse of the horizontal position and the standard deviations of the
+ * latitude, longitude, and altitude. Their time of day is that of the GGA sentence of the same
+ * epoch, so they can be used to assess the quality of its fix. GST sentences from any supported
+ * talker (GPGST, GNGST, etc.) are decoded into a \c GSTData, in which case \c talker holds the
+ * talker that originated the sentence. The fields that a sentence leaves empty keep their default
+ * values.
+ */
+struct GSTData : NMEA0183Data
+{
+    /**
+     *  Default constructor; it empty-initializes the struct, setting \c kind to
+     * \c NMEA0183DataKind::GST and \c talker to \c NMEA0183Talker::GP
+     */
+    GSTData() noexcept
+        : NMEA0183Data::NMEA0183Data(NMEA0183DataKind::GST, NMEA0183Talker::GP)
+        , time_of_day_ms(-1)
+        , utc_time(UtcTime::min())
+        , rms(-1)
+        , semi_major_error(-1)
+        , semi_minor_error(-1)
+        , semi_major_orientation(-1)
+        , latitude_error(-1)
+        , longitude_error(-1)
+        , altitude_error(-1)
+    {
+    }
+
+    /**
+     * UTC time of day in milliseconds since midnight, as \c GPGGAData::time_of_day_ms, or -1 if the
+     * sentence does not report it
+     */
+    int32_t time_of_day_ms;
+
+    /**
+     * UTC time point of the sample, calculated from \c time_of_day_ms and the latest date reported
+     * by the device, as \c GPGGAData::utc_time
+     */
+    UtcTime utc_time;
+
+    //! RMS value of the standard deviation of the pseudorange residuals in meters, or -1 if not reported
+    float rms;
+
+    //! Standard deviation of the semi-major axis of the error ellipse in meters, or -1 if not reported
+    float semi_major_error;
+
+    //! Standard deviation of the semi-minor axis of the error ellipse in meters, or -1 if not reported
+    float semi_minor_error;
+
+    /**
+     * Orientation of the semi-major axis of the error ellipse in degrees referred to true North, or
+     * -1 if the sentence does not report it
+     */
+    float semi_major_orientation;
+
+    //! Standard deviation of the latitude error in meters, or -1 if the sentence does not report it
+    float latitude_error;
+
+    //! Standard deviation of the longitude error in meters, or -1 if the sentence does not report it
+    float longitude_error;
+
+    //! Standard deviation of the altitude error in meters, or -1 if the sentence does not report it
+    float altitude_error;
+
+    /**
+     * Check whether a \c GSTData is equal to this one
+     *
+     * @param[in] other A constant reference to the \c GSTData to compare with this one
+     *
+     * @return true if equal; false otherwise
+     */
+    inline bool operator ==(
+            const GSTData& other) const noexcept
+    {
+        return (NMEA0183Data::operator ==(other) &&
+               time_of_day_ms == other.time_of_day_ms &&
+               utc_time == other.utc_time &&
+               rms == other.rms &&
+               semi_major_error == other.semi_major_error &&
+               semi_minor_error == other.semi_minor_error &&
+               semi_major_orientation == other.semi_major_orientation &&
+               latitude_error == other.latitude_error &&
+               longitude_error == other.longitude_error &&
+               altitude_error == other.altitude_error);
+    }
+
+    /**
+     * Check whether a \c GSTData is different from this one
+     *
+     * @param[in] other A constant reference to the \c GSTData to compare with this one
+     *
+     * @return true if different; false otherwise
+     */
+    inline bool operator !=(
+            const GSTData& other) const noexcept
+    {
+        return !(*this == other);
+    }
+
+};
+
+static_assert(std::is_trivially_copyable<GSTData>::value, "GSTData must be trivially copyable");
+
+/**
+ * \struct GSVSatellite
+ *
+ * @brief Struct for the information that GSV sentences provide about a satellite in view
+ *
+ * The elevation, azimuth, and SNR are -1 when the sentence does not report them, e.g. the SNR of
+ * a satellite which is not being tracked.
+ */
+struct GSVSatellite
+{
+    /**
+     *  Default constructor; it empty-initializes the struct
+     */
+    GSVSatellite() noexcept
+        : prn(0)
+        , elevation(-1)
+        , azimuth(-1)
+        , snr(-1)
+    {
+    }
+
+    //! Satellite ID number (PRN) within its constellation
+    uint16_t prn;
+
+    //! Elevation in degrees [0; 90], or -1 if not reported
+    int16_t elevation;
+
+    //! Azimuth in degrees referred to true North [0; 359], or -1 if not reported
+    int16_t azimuth;
+
+    //! Signal to noise ratio in dB-Hz [0; 99], or -1 if not reported
+    int16_t snr;
+
+    /**
+     * Check whether a \c GSVSatellite is equal to this one
+     *
+     * @param[in] other A constant reference to the \c GSVSatellite to compare with this one
+     *
+     * @return true if equal; false otherwise
+     */
+    inline bool operator ==(
+            const GSVSatellite& other) const noexcept
+    {
+        return (prn == other.prn &&
+               elevation == other.elevation &&
+               azimuth == other.azimuth &&
+               snr == other.snr);
+    }
+
+    /**
+     * Check whether a \c GSVSatellite is different from this one
+     *
+     * @param[in] other A constant reference to the \c GSVSatellite to compare with this one
+     *
+     * @return true if different; false otherwise
+     */
+    inline bool operator !=(
+            const GSVSatellite& other) const noexcept
+    {
+        return !(*this == other);
+    }
+
+};
+
+/**
+ * \struct GSVData
+ *
+ * @brief Struct for the satellite table of a constellation, assembled from a group of GSV sentences
+ *
+ * Each constellation reports its satellites in view every epoch in a group of up to nine GSV
+ * sentences with up to four satellites each. A \c GSVData holds the satellites of a whole group,
+ * and it is only reported once the last sentence of the group has been received. \c talker
+ * identifies the constellation. The table has a fixed capacity, so that it is a plain value which
+ * can be copied without allocating memory.
+ */
+struct GSVData : NMEA0183Data
+{
+    //! Maximum number of satellites in a table, i.e. nine sentences of four satellites each
+    static constexpr std::size_t MAX_SATELLITES = 36;
+
+    /**
+     *  Default constructor; it empty-initializes the struct, setting \c kind to
+     * \c NMEA0183DataKind::GSV and \c talker to \c NMEA0183Talker::GP
+     */
+    GSVData() noexcept
+        : NMEA0183Data::NMEA0183Data(NMEA0183DataKind::GSV, NMEA0183Talker::GP)
+        , satellites_in_view(0)
+        , signal_id('\0')
+        , satellite_count(0)
+        , satellites()
+    {
+    }
+
+    //! Number of satellites in view, as reported by the sentences
+    uint8_t satellites_in_view;
+
+    /** Signal ID (NMEA 0183 4.10 and later) as a hexadecimal digit, or '\0' if the sentences do not
+     * report it. Receivers which report several signals of a constellation send a table per signal.
+     */
+    char signal_id;
+
+    //! Number of valid entries in \c satellites
+    uint8_t satellite_count;
+
+    //! Satellites in view, in the order in which they are reported. Only the first \c satellite_count are valid
+    GSVSatellite satellites[MAX_SATELLITES];
+
+    /**
+     * Check whether a \c GSVData is equal to this one. Only the valid entries of the tables are
+     * compared.
+     *
+     * @param[in] other A constant reference to the \c GSVData to compare with this one
+     *
+     * @return true if equal; false otherwise
+     */
+    inline bool operator ==(
+            const GSVData& other) const noexcept
+    {
+        if (!(NMEA0183Data::operator ==(other) &&
+                satellites_in_view == other.satellites_in_view &&
+                signal_id == other.signal_id &&
+                satellite_count == other.satellite_count))
+        {
+            return false;
+        }
+        for (std::size_t i = 0; i < satellite_count && i < MAX_SATELLITES; i++)
+        {
+            if (satellites[i] != other.satellites[i])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Check whether a \c GSVData is different from this one
+     *
+     * @param[in] other A constant reference to the \c GSVData to compare with this one
+     *
+     * @return true if different; false otherwise
+     */
+    inline bool operator !=(
+            const GSVData& other) const noexcept
+    {
+        return !(*this == other);
+    }
+
+};
+
+static_assert(std::is_trivially_copyable<GSVData>::value, "GSVData must be trivially copyable");
+
+/**
+ * \struct GSASystem
+ *
+ * @brief Struct for the satellites of a constellation used in the navigation solution, as reported
+ *        by a GSA sentence
+ */
+struct GSASystem
+{
+    //! Maximum number of satellites reported by a GSA sentence
+    static constexpr std::size_t MAX_SATELLITES = 12;
+
+    /**
+     *  Default constructor; it empty-initializes the struct
+     */
+    GSASystem() noexcept
+        : system_id('\0')
+        , prn_count(0)
+        , prns()
+    {
+    }
+
+    /** GNSS system ID (NMEA 0183 4.10 and later) as a hexadecimal digit, or '\0' if the sentence
+     * does not report it
+     *    - '1' -> GPS
+     *    - '2' -> GLONASS
+     *    - '3' -> Galileo
+     *    - '4' -> BeiDou
+     *    - '5' -> QZSS
+     *    - '6' -> NavIC
+     */
+    char system_id;
+
+    //! Number of valid entries in \c prns
+    uint8_t prn_count;
+
+    //! Satellite ID numbers (PRN) of the satellites used in the solution. Only the first \c prn_count are valid
+    uint16_t prns[MAX_SATELLITES];
+
+    /**
+     * Check whether a \c GSASystem is equal to this one. Only the valid entries of the PRN arrays
+     * are compared.
+     *
+     * @param[in] other A constant reference to the \c GSASystem to compare with this one
+     *
+     * @return true if equal; false otherwise
+     */
+    inline bool operator ==(
+            const GSASystem& other) const noexcept
+    {
+        if (!(system_id == other.system_id && prn_count == other.prn_count))
+        {
+            return false;
+        }
+        for (std::size_t i = 0; i < prn_count && i < MAX_SATELLITES; i++)
+        {
+            if (prns[i] != other.prns[i])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Check whether a \c GSASystem is different from this one
+     *
+     * @param[in] other A constant reference to the \c GSASystem to compare with this one
+     *
+     * @return true if different; false otherwise
+     */
+    inline bool operator !=(
+            const GSASystem& other) const noexcept
+    {
+        return !(*this == other);
+    }
+
+};
+
+/**
+ * \struct GSAData
+ *
+ * @brief Struct for the dilution of precision and the satellites used in a navigation solution
+ *
+ * Receivers which combine several constellations send a GSA sentence per constellation every
+ * epoch, all of them with the same dilutions of precision. A \c GSAData merges the sentences of an
+ * epoch, holding the satellites of each constellation in its own entry of \c systems. The entries
+ * have a fixed capacity, so that it is a plain value which can be copied without allocating memory.
+ */
+struct GSAData : NMEA0183Data
+{
+    //! Maximum number of constellations in a sample
+    static constexpr std::size_t MAX_SYSTEMS = 8;
+
+    /**
+     *  Default constructor; it empty-initializes the struct, setting \c kind to
+     * \c NMEA0183DataKind::GSA and \c talker to \c NMEA0183Talker::GP
+     */
+    GSAData() noexcept
+        : NMEA0183Data::NMEA0183Data(NMEA0183DataKind::GSA, NMEA0183Talker::GP)
+        , selection_mode('A')
+        , fix_type(1)
+        , pdop(-1)
+        , hdop(-1)
+        , vdop(-1)
+        , system_count(0)
+        , systems()
+    {
+    }
+
+    /** Selection mode
+     *    - 'M' -> manual, forced to operate in 2D or 3D
+     *    - 'A' -> automatic, 2D or 3D
+     */
+    char selection_mode;
+
+    /** Fix type
+     *    - 1 -> no fix
+     *    - 2 -> 2D fix
+     *    - 3 -> 3D fix
+     */
+    uint8_t fix_type;
+
+    //! Position dilution of precision, or -1 if not reported
+    float pdop;
+
+    //! Horizontal dilution of precision, or -1 if not reported
+    float hdop;
+
+    //! Vertical dilution of precision, or -1 if not reported
+    float vdop;
+
+    //! Number of valid entries in \c systems
+    uint8_t system_count;
+
+    //! Satellites used in the solution per constellation. Only the first \c system_count are valid
+    GSASystem systems[MAX_SYSTEMS];
+
+    /**
+     * Check whether a \c GSAData is equal to this one. Only the valid entries of \c systems are
+     * compared.
+     *
+     * @param[in] other A constant reference to the \c GSAData to compare with this one
+     *
+     * @return true if equal; false otherwise
+     */
+    inline bool operator ==(
+            const GSAData& other) const noexcept
+    {
+        if (!(NMEA0183Data::operator ==(other) &&
+                selection_mode == other.selection_mode &&
+                fix_type == other.fix_type &&
+                pdop == other.pdop &&
+                hdop == other.hdop &&
+                vdop == other.vdop &&
+                system_count == other.system_count))
+        {
+            return false;
+        }
+        for (std::size_t i = 0; i < system_count && i < MAX_SYSTEMS; i++)
+        {
+            if (systems[i] != other.systems[i])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Check whether a \c GSAData is different from this one
+     *
+     * @param[in] other A constant reference to the \c GSAData to compare with this one
+     *
+     * @return true if different; false otherwise
+     */
+    inline bool operator !=(
+            const GSAData& other) const noexcept
+    {
+        return !(*this == other);
+    }
+
+};
+
+static_assert(std::is_trivially_copyable<GSAData>::value, "GSAData must be trivially copyable");
+
+/**
+ * \struct AISPositionData
+ *
+ * @brief Struct for the position reports of AIS messages
+ *
+ * AIS messages are carried by VDM sentences (received from other stations) and VDO sentences (sent
+ * by the own station), and they may span several sentences. The position reports of class A
+ * stations (message types 1, 2, and 3) and of class B stations (message type 18) are decoded into a
+ * \c AISPositionData, in which case \c talker holds the AIS talker of the sentences. The fields
+ * that the station does not report keep the "not available" values defined by ITU-R M.1371.
+ */
+struct AISPositionData : NMEA0183Data
+{
+    /**
+     *  Default constructor; it empty-initializes the struct, setting \c kind to
+     * \c NMEA0183DataKind::AIS and \c talker to \c NMEA0183Talker::AI
+     */
+    AISPositionData() noexcept
+        : NMEA0183Data::NMEA0183Data(NMEA0183DataKind::AIS, NMEA0183Talker::AI)
+        , message_type(0)
+        , repeat_indicator(0)
+        , mmsi(0)
+        , navigation_status(15)
+        , rate_of_turn(-128)
+        , speed_over_ground(-1)
+        , position_accuracy(false)
+        , latitude(91)
+        , longitude(181)
+        , latitude_e7(910000000)
+        , longitude_e7(1810000000)
+        , course_over_ground(-1)
+        , true_heading(511)
+        , utc_second(60)
+        , raim(false)
+        , channel('\0')
+        , own_ship(false)
+    {
+    }
+
+    //! AIS message type: 1, 2, or 3 for class A stations, and 18 for class B stations
+    uint8_t message_type;
+
+    //! Number of times the message has been repeated [0; 3]
+    uint8_t repeat_indicator;
+
+    //! Maritime Mobile Service Identity of the station
+    uint32_t mmsi;
+
+    //! Navigation status [0; 15] of class A stations. It is 15 (not defined) for class B stations
+    uint8_t navigation_status;
+
+    /** Rate of turn indicator of class A stations, as transmitted [-127; 127]
+     *    - 0 -> not turning
+     *    - [1; 126] -> turning right at (value / 4.733)^2 degrees per minute
+     *    - 127 -> turning right at more than 5 degrees per 30 seconds
+     *    - Negative values -> the same, turning left
+     *    - -128 -> not available, also for class B stations
+     */
+    int16_t rate_of_turn;
+
+    //! Speed over ground in knots, or -1 if not available
+    float speed_over_ground;
+
+    //! Whether the position accuracy is better than 10 meters
+    bool position_accuracy;
+
+    //! Latitude in degrees referred to North, or 91 if not available
+    float latitude;
+
+    //! Longitude in degrees referred to East, or 181 if not available
+    float longitude;
+
+    //! Latitude in units of 1e-7 degrees referred to North, or 910000000 if not available
+    int32_t latitude_e7;
+
+    //! Longitude in units of 1e-7 degrees referred to East, or 1810000000 if not available
+    int32_t longitude_e7;
+
+    //! Course over ground in degrees referred to true North, or -1 if not available
+    float course_over_ground;
+
+    //! True heading in degrees [0; 359], or 511 if not available
+    uint16_t true_heading;
+
+    //! UTC second in which the report was generated [0; 59], or [60; 63] if not available
+    uint8_t utc_second;
+
+    //! Whether the Receiver Autonomous Integrity Monitoring is in use
+    bool raim;
+
+    //! AIS channel in which the message was received ('A', 'B', '1' or '2'), or '\0' if not reported
+    char channel;
+
+    //! Whether the message was sent by the own station, i.e. it was carried by VDO sentences
+    bool own_ship;
+
+    /**
+     * Check whether a \c AISPositionData is equal to this one
+     *
+     * @param[in] other A constant reference to the \c AISPositionData to compare with this one
+     *
+     * @return true if equal; false otherwise
+     */
+    inline bool operator ==(
+            const AISPositionData& other) const noexcept
+    {
+        return (NMEA0183Data::operator ==(other) &&
+               message_type == other.message_type &&
+               repeat_indicator == other.repeat_indicator &&
+               mmsi == other.mmsi &&
+               navigation_status == other.navigation_status &&
+               rate_of_turn == other.rate_of_turn &&
+               speed_over_ground == other.speed_over_ground &&
+               position_accuracy == other.position_accuracy &&
+               latitude == other.latitude &&
+               longitude == other.longitude &&
+               latitude_e7 == other.latitude_e7 &&
+               longitude_e7 == other.longitude_e7 &&
+               course_over_ground == other.course_over_ground &&
+               true_heading == other.true_heading &&
+               utc_second == other.utc_second &&
+               raim == other.raim &&
+               channel == other.channel &&
+               own_ship == other.own_ship);
+    }
+
+    /**
+     * Check whether a \c AISPositionData is different from this one
+     *
+     * @param[in] other A constant reference to the \c AISPositionData to compare with this one
+     *
+     * @return true if different; false otherwise
+     */
+    inline bool operator !=(
+            const AISPositionData& other) const noexcept
+    {
+        return !(*this == other);
+    }
+
+};
+
+static_assert(std::is_trivially_copyable<AISPositionData>::value, "AISPositionData must be trivially copyable");
+
+/**
+ * \struct RawSentence
+ *
+ * @brief Struct for a sentence which is not decoded by the library
+ *
+ * The sentences whose address has been registered with \c EasyNmea::register_decoder() are handed
+ * to their handler as a \c RawSentence once their framing and checksum have been validated. The
+ * sentence is not copied: \c sentence refers to the bytes in which it was received, so it is only
+ * valid during the call to the handler.
+ */
+struct RawSentence : NMEA0183Data
+{
+    /**
+     *  Default constructor; it empty-initializes the struct, setting \c kind to
+     * \c NMEA0183DataKind::RAW and \c talker to \c NMEA0183Talker::UNKNOWN
+     */
+    RawSentence() noexcept
+        : NMEA0183Data::NMEA0183Data(NMEA0183DataKind::RAW, NMEA0183Talker::UNKNOWN)
+        , sentence()
+    {
+    }
+
+    /**
+     * The sentence, from the '$' or '!' to the checksum (both included), without the tag block and
+     * the line terminator
+     */
+    std::string_view sentence;
+
+    /**
+     * Check whether a \c RawSentence is equal to this one
+     *
+     * @param[in] other A constant reference to the \c RawSentence to compare with this one
+     *
+     * @return true if equal; false otherwise
+     */
+    inline bool operator ==(
+            const RawSentence& other) const noexcept
+    {
+        return (NMEA0183Data::operator ==(other) &&
+               sentence == other.sentence);
+    }
+
+    /**
+     * Check whether a \c RawSentence is different from this one
+     *
+     * @param[in] other A constant reference to the \c RawSentence to compare with this one
+     *
+     * @return true if different; false otherwise
+     */
+    inline bool operator !=(
+            const RawSentence& other) const noexcept
+    {
+        return !(*this == other);
+    }
+
+};
+
+static_assert(std::is_trivially_copyable<RawSentence>::value, "RawSentence must be trivially copyable");
+
 } // namespace easynmea
 } // namespace eduponz
 
@@ -42,6 +42,105 @@ enum class NMEA0183DataKind : int32_t
 
     //! Global Positioning System Fix Data
     GPGGA = 1 << 0,
+
+    //! Recommended Minimum Specific GNSS Data
+    RMC = 1 << 1,
+
+    //! GNSS Satellites in View
+    GSV = 1 << 2,
+
+    //! GNSS DOP and Active Satellites
+    GSA = 1 << 3,
+
+    //! AIS Position Report (message types 1, 2, 3, and 18)
+    AIS = 1 << 4,
+
+    //! Sentence which is not decoded by the library, but handed as is to a user registered handler
+    RAW = 1 << 5,
+
+    //! Time and Date
+    ZDA = 1 << 6,
+
+    //! Heading True
+    HDT = 1 << 7,
+
+    //! True Heading and Status
+    THS = 1 << 8,
+
+    //! Rate Of Turn
+    ROT = 1 << 9,
+
+    //! GNSS Pseudorange Error Statistics
+    GST = 1 << 10,
+};
+
+/**
+ * @enum NMEA0183Talker
+ *
+ * @brief Holds the supported NMEA 0183 talker identifiers, i.e. the system that originated a sentence.
+ *
+ * The talker is independent of the sentence kind, so for instance GPGGA, GNGGA and GLGGA sentences are
+ * all decoded as \c NMEA0183DataKind::GPGGA, each of them with its own talker. The AIS talkers are only
+ * accepted in AIS sentences, and the GNSS talkers only in the rest.
+ */
+enum class NMEA0183Talker : uint8_t
+{
+    //! Represents no valid talker
+    UNKNOWN = 0,
+
+    //! GPS
+    GP,
+
+    //! GLONASS
+    GL,
+
+    //! Galileo
+    GA,
+
+    //! BeiDou
+    GB,
+
+    //! BeiDou (legacy identifier)
+    BD,
+
+    //! QZSS
+    GQ,
+
+    //! NavIC
+    GI,
+
+    //! Combination of several GNSS
+    GN,
+
+    //! AIS mobile station
+    AI,
+
+    //! AIS base station
+    AB,
+
+    //! AIS dependent base station
+    AD,
+
+    //! AIS aid to navigation
+    AN,
+
+    //! AIS receiving station
+    AR,
+
+    //! AIS limited base station
+    AS,
+
+    //! AIS transmitting station
+    AT,
+
+    //! AIS repeater station
+    AX,
+
+    //! AIS base station (deprecated identifier)
+    BS,
+
+    //! AIS physical shore station
+    SA,
 };
 
 /**
@@ -161,6 +260,74 @@ private:
     uint32_t value_;
 };
 
+/**
+ * @struct ReadProfile
+ *
+ * This structure holds when the Linux-native serial ports, which are used when the library is built
+ * with the CMake options \c POSIX_SERIAL_PORT and \c URING_SERIAL_PORT, wake the reader up to take
+ * the bytes buffered by the tty, after the \c VMIN and \c VTIME of a non-canonical termios read. It
+ * is selected with \c EasyNmea::set_read_profile().
+ *
+ * Waking up on every byte delivers each line as soon as its last byte arrives, at the cost of one
+ * wake-up per byte, or per handful of bytes, for the whole burst a module sends every epoch.
+ * Waking up on the first byte of a burst and letting the tty buffer the rest of it for a while
+ * takes a couple of wake-ups per burst, at the cost of holding the lines back until then.
+ *
+ * \c VTIME is not applied to the tty as termios' inter-byte timer, since the line discipline wakes
+ * the readers waiting on a tty up on every byte it receives, whatever its \c VMIN and \c VTIME.
+ * It is rather the time the reader sleeps off the tty wait queue once it is readable.
+ */
+struct ReadProfile
+{
+    //! Number of bytes the tty buffers before it is readable (termios VMIN). Between 1 and 255
+    uint8_t vmin;
+
+    /**
+     * Deciseconds the tty is left buffering the rest of a burst once it is readable, before its
+     * bytes are read. 0 reads them right away.
+     */
+    uint8_t vtime;
+
+    /**
+     * \brief Profile which wakes the reader up on every received byte.
+     *
+     * @return A profile with \c vmin 1 and \c vtime 0.
+     */
+    static constexpr ReadProfile lowest_latency() noexcept
+    {
+        return {1, 0};
+    }
+
+    /**
+     * \brief Profile which wakes the reader up once per burst of received bytes.
+     *
+     * The reader is woken up by the first byte of a burst, and it reads the whole burst a
+     * decisecond later, or as much of it as arrived by then, so lines are delivered up to 100 ms
+     * late.
+     *
+     * @return A profile with \c vmin 1 and \c vtime 1.
+     */
+    static constexpr ReadProfile lowest_cpu() noexcept
+    {
+        return {1, 1};
+    }
+
+    //! Equal to operator
+    constexpr bool operator ==(
+            const ReadProfile& other) const noexcept
+    {
+        return vmin == other.vmin && vtime == other.vtime;
+    }
+
+    //! Different from operator
+    constexpr bool operator !=(
+            const ReadProfile& other) const noexcept
+    {
+        return !(*this == other);
+    }
+
+};
+
 } // namespace easynmea
 } // namespace eduponz
 
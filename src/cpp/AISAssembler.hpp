@@ -0,0 +1,263 @@
+// Copyright (c) 2021 Eduardo Ponz Segrelles.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+/**
+ * @file AISAssembler.hpp
+ */
+
+#ifndef _EASYNMEA_AISASSEMBLER_HPP_
+#define _EASYNMEA_AISASSEMBLER_HPP_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include <easynmea/data.hpp>
+#include <easynmea/types.hpp>
+
+namespace eduponz {
+namespace easynmea {
+
+/**
+ * \struct AISFragment
+ *
+ * @brief Struct for the data of a single VDM or VDO sentence, i.e. one fragment of an AIS message
+ *
+ * VDM and VDO sentences are decoded into an \c AISFragment, and \c AISAssembler reassembles the
+ * fragments of each message. The payload is stored already unarmored, as six-bit values. \c kind is
+ * \c NMEA0183DataKind::AIS, as each fragment belongs to an AIS message.
+ */
+struct AISFragment : NMEA0183Data
+{
+    //! Maximum number of six-bit values in the payload of a single sentence
+    static constexpr std::size_t MAX_SEXTETS = 64;
+
+    /**
+     *  Default constructor; it empty-initializes the struct, setting \c kind to
+     * \c NMEA0183DataKind::AIS and \c talker to \c NMEA0183Talker::AI
+     */
+    AISFragment() noexcept
+        : NMEA0183Data::NMEA0183Data(NMEA0183DataKind::AIS, NMEA0183Talker::AI)
+        , fragment_count(0)
+        , fragment_number(0)
+        , sequence_id(-1)
+        , channel('\0')
+        , own_ship(false)
+        , fill_bits(0)
+        , sextet_count(0)
+        , sextets()
+    {
+    }
+
+    //! Number of sentences of the message [1; 9]
+    uint8_t fragment_count;
+
+    //! Number of this sentence within the message [1; 9]
+    uint8_t fragment_number;
+
+    //! Sequential message identifier [0; 9], or -1 if the sentence does not report it
+    int8_t sequence_id;
+
+    //! AIS channel ('A', 'B', '1' or '2'), or '\0' if the sentence does not report it
+    char channel;
+
+    //! Whether the sentence is a VDO sentence, i.e. it carries a message of the own station
+    bool own_ship;
+
+    //! Number of bits appended to the payload to complete its last six-bit value [0; 5]
+    uint8_t fill_bits;
+
+    //! Number of valid entries in \c sextets
+    uint8_t sextet_count;
+
+    //! Unarmored payload. Only the first \c sextet_count are valid
+    uint8_t sextets[MAX_SEXTETS];
+};
+
+static_assert(std::is_trivially_copyable<AISFragment>::value, "AISFragment must be trivially copyable");
+
+/**
+ * \struct AISMessage
+ *
+ * @brief Struct for the payload of a complete AIS message, reassembled from its fragments
+ */
+struct AISMessage
+{
+    //! Maximum number of six-bit values of a message, which is at most 1008 bits long
+    static constexpr std::size_t MAX_SEXTETS = 168;
+
+    //! The AIS talker of the sentences
+    NMEA0183Talker talker = NMEA0183Talker::AI;
+
+    //! The tag block of the first fragment
+    TagBlock tag_block;
+
+    //! The time at which the first fragment was received
+    ReceiveTime receive_time;
+
+    //! AIS channel of the first fragment, or '\0' if it does not report it
+    char channel = '\0';
+
+    //! Whether the message was carried by VDO sentences
+    bool own_ship = false;
+
+    //! Number of bits appended to the payload to complete its last six-bit value [0; 5]
+    uint8_t fill_bits = 0;
+
+    //! Number of valid entries in \c sextets
+    std::size_t sextet_count = 0;
+
+    //! Unarmored payload. Only the first \c sextet_count are valid
+    uint8_t sextets[MAX_SEXTETS] = {};
+
+    /**
+     * \brief Get the length of the message.
+     *
+     * @return The number of bits of the payload, excluding the fill bits.
+     */
+    std::size_t bit_count() const noexcept
+    {
+        return sextet_count * 6 - std::min<std::size_t>(fill_bits, sextet_count * 6);
+    }
+
+};
+
+static_assert(std::is_trivially_copyable<AISMessage>::value, "AISMessage must be trivially copyable");
+
+/**
+ * @class AISAssembler
+ *
+ * This class reassembles the fragments of AIS messages.
+ *
+ * The fragments of a message share a sequential message identifier, so the assembler keeps a
+ * message in progress per identifier, plus one for the messages which do not report it, in a table
+ * of fixed size which is allocated with the assembler. Messages of a single fragment do not need
+ * to be kept, so they never displace a message in progress. A message is only handed out once its
+ * last fragment has been added. A message whose fragments arrive out of order, or which is
+ * interrupted by a new message with the same identifier, is discarded, as it would be incomplete.
+ * The message keeps the tag block of its first fragment, as loggers usually tag the first sentence
+ * of a message only.
+ *
+ * \c AISAssembler is not thread safe; it is meant to be fed from the thread which reads the
+ * sentences.
+ */
+class AISAssembler
+{
+public:
+
+    /**
+     * \brief Add a fragment to the message in progress of its sequential message identifier.
+     *
+     * @param fragment The decoded VDM or VDO sentence.
+     * @return A pointer to the complete message if \c fragment is the last one of its message;
+     *         \c nullptr otherwise. The pointer is valid until the next call to \c add() or
+     *         \c clear().
+     */
+    const AISMessage* add(
+            const AISFragment& fragment) noexcept
+    {
+        if (fragment.fragment_number < 1 || fragment.fragment_number > fragment.fragment_count ||
+                fragment.sequence_id >= static_cast<int8_t>(slots_.size() - 1) ||
+                fragment.sextet_count > AISFragment::MAX_SEXTETS)
+        {
+            return nullptr;
+        }
+        Slot_& slot = fragment.fragment_count == 1 ? single_ :
+                slots_[fragment.sequence_id < 0 ? slots_.size() - 1 : static_cast<std::size_t>(fragment.sequence_id)];
+
+        /* The first fragment starts a new message, discarding any incomplete one */
+        if (fragment.fragment_number == 1)
+        {
+            slot.message.talker = fragment.talker;
+            slot.message.tag_block = fragment.tag_block;
+            slot.message.receive_time = fragment.receive_time;
+            slot.message.channel = fragment.channel;
+            slot.message.own_ship = fragment.own_ship;
+            slot.message.sextet_count = 0;
+            slot.fragment_count = fragment.fragment_count;
+            slot.next_fragment = 1;
+        }
+
+        /* Any other fragment must follow the previous one of the same message */
+        if (fragment.fragment_number != slot.next_fragment || fragment.fragment_count != slot.fragment_count ||
+                fragment.talker != slot.message.talker || fragment.own_ship != slot.message.own_ship ||
+                slot.message.sextet_count + fragment.sextet_count > AISMessage::MAX_SEXTETS)
+        {
+            slot.next_fragment = 0;
+            return nullptr;
+        }
+
+        std::copy(fragment.sextets, fragment.sextets + fragment.sextet_count,
+            slot.message.sextets + slot.message.sextet_count);
+        slot.message.sextet_count += fragment.sextet_count;
+
+        if (fragment.fragment_number == fragment.fragment_count)
+        {
+            // Only the last fragment completes the last six-bit value
+            slot.message.fill_bits = fragment.fill_bits;
+            slot.next_fragment = 0;
+            return &slot.message;
+        }
+        slot.next_fragment++;
+        return nullptr;
+    }
+
+    /**
+     * \brief Discard all the messages in progress.
+     */
+    void clear() noexcept
+    {
+        for (Slot_& slot : slots_)
+        {
+            slot.next_fragment = 0;
+        }
+        single_.next_fragment = 0;
+    }
+
+protected:
+
+    //! Message in progress of a sequential message identifier
+    struct Slot_
+    {
+        //! The payload of the fragments added so far
+        AISMessage message;
+
+        //! Number of fragments of the message
+        uint8_t fragment_count = 0;
+
+        //! Number of the next expected fragment, or 0 if there is no message in progress
+        uint8_t next_fragment = 0;
+    };
+
+    /**
+     * Messages in progress, indexed by sequential message identifier. The last one holds the
+     * message which does not report it
+     */
+    std::array<Slot_, 11> slots_;
+
+    //! Storage of the last message of a single fragment
+    Slot_ single_;
+};
+
+} // namespace eduponz
+} // namespace easynmea
+
+#endif //_EASYNMEA_AISASSEMBLER_HPP_
@@ -0,0 +1,277 @@
+// Copyright (c) 2021 Eduardo Ponz Segrelles.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+/**
+ * @file AISPayload.hpp
+ */
+
+#ifndef _EASYNMEA_AISPAYLOAD_HPP_
+#define _EASYNMEA_AISPAYLOAD_HPP_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include <easynmea/data.hpp>
+#include <easynmea/types.hpp>
+
+#include "AISAssembler.hpp"
+
+namespace eduponz {
+namespace easynmea {
+
+/**
+ * @class AISPayload
+ *
+ * This class provides static APIs to armor and unarmor the six-bit payload of AIS messages, and to
+ * extract the position reports from it.
+ *
+ * Each character of the armored payload carries six bits. Characters are unarmored with a lookup
+ * table, and the six-bit values of a message are packed into bytes before extracting its fields.
+ * Then, each field is extracted from a single 64-bit big-endian window, with two shifts, so fields
+ * spanning several characters do not need to be assembled bit by bit.
+ */
+class AISPayload
+{
+public:
+
+    //! Value of \c sextet() for the characters which do not belong to the armoring alphabet
+    static constexpr uint8_t INVALID_SEXTET = 0xFF;
+
+    /**
+     * \brief Unarmor a character of the payload.
+     *
+     * @param character The armored character, in ['0'; 'W'] or in ['`'; 'w'].
+     * @return The six-bit value of the character, or \c INVALID_SEXTET if it is not armored.
+     */
+    static uint8_t sextet(
+            char character) noexcept
+    {
+        return sextets_[static_cast<unsigned char>(character)];
+    }
+
+    /**
+     * \brief Armor a six-bit value.
+     *
+     * @param sextet The six-bit value. Only its six least significant bits are used.
+     * @return The armored character.
+     */
+    static char character(
+            uint8_t sextet) noexcept
+    {
+        return alphabet_[sextet & 0x3F];
+    }
+
+    /**
+     * \brief Decode the position report of a class A or class B station.
+     *
+     * The position reports are the messages of types 1, 2, 3 (class A), and 18 (class B), which
+     * are 168 bits long.
+     *
+     * @param[in] message The reassembled message.
+     * @param[out] position The \c AISPositionData to populate. It is only modified if the message
+     *             is a position report.
+     * @return \c true if \c position was populated; \c false if the message is not a position
+     *         report, or it is shorter than one.
+     */
+    static bool decode_position(
+            const AISMessage& message,
+            AISPositionData& position) noexcept
+    {
+        if (message.sextet_count == 0 || message.bit_count() < position_bits_)
+        {
+            return false;
+        }
+
+        /* The message type is the first six-bit value, so it is checked before packing */
+        uint8_t type = message.sextets[0];
+        if (type != 1 && type != 2 && type != 3 && type != 18)
+        {
+            return false;
+        }
+        uint8_t bytes[packed_size_];
+        pack_(message.sextets, position_bits_ / 6, bytes);
+
+        AISPositionData data;
+        data.talker = message.talker;
+        data.tag_block = message.tag_block;
+        data.receive_time = message.receive_time;
+        data.channel = message.channel;
+        data.own_ship = message.own_ship;
+        data.message_type = type;
+        data.repeat_indicator = static_cast<uint8_t>(unsigned_(bytes, 6, 2));
+        data.mmsi = unsigned_(bytes, 8, 30);
+
+        // Class B reports do not have navigation status nor rate of turn, so the rest of their
+        // fields are shifted four bits towards the beginning of the message
+        std::size_t offset = 0;
+        if (type == 18)
+        {
+            offset = 4;
+        }
+        else
+        {
+            data.navigation_status = static_cast<uint8_t>(unsigned_(bytes, 38, 4));
+            data.rate_of_turn = static_cast<int16_t>(signed_(bytes, 42, 8));
+        }
+        uint32_t speed = unsigned_(bytes, 50 - offset, 10);
+        data.speed_over_ground = speed == 1023 ? -1 : static_cast<float>(speed) / 10;
+        data.position_accuracy = unsigned_(bytes, 60 - offset, 1) != 0;
+        int32_t longitude = signed_(bytes, 61 - offset, 28);
+        int32_t latitude = signed_(bytes, 89 - offset, 27);
+        data.longitude = static_cast<float>(longitude / 600000.0);
+        data.latitude = static_cast<float>(latitude / 600000.0);
+        data.longitude_e7 = to_degrees_e7_(longitude);
+        data.latitude_e7 = to_degrees_e7_(latitude);
+        uint32_t course = unsigned_(bytes, 116 - offset, 12);
+        data.course_over_ground = course >= 3600 ? -1 : static_cast<float>(course) / 10;
+        data.true_heading = static_cast<uint16_t>(unsigned_(bytes, 128 - offset, 9));
+        data.utc_second = static_cast<uint8_t>(unsigned_(bytes, 137 - offset, 6));
+        // The RAIM flag follows fields of different lengths in each class
+        data.raim = unsigned_(bytes, type == 18 ? 147 : 148, 1) != 0;
+
+        position = data;
+        return true;
+    }
+
+protected:
+
+    //! Length in bits of the position reports
+    static constexpr std::size_t position_bits_ = 168;
+
+    //! Size of the packed position reports, plus room for loading a 64-bit window at any byte
+    static constexpr std::size_t packed_size_ = position_bits_ / 8 + 8;
+
+    //! Characters of the armoring alphabet, indexed by six-bit value
+    static constexpr char alphabet_[] = "0123456789:;<=>?@ABCDEFGHIJKLMNOPQRSTUVW`abcdefghijklmnopqrstuvw";
+
+    //! Build the table which translates each character into its six-bit value, or \c INVALID_SEXTET
+    static constexpr std::array<uint8_t, 256> make_sextets_() noexcept
+    {
+        std::array<uint8_t, 256> table {};
+        for (std::size_t i = 0; i < table.size(); i++)
+        {
+            table[i] = INVALID_SEXTET;
+        }
+        for (uint8_t value = 0; value < 64; value++)
+        {
+            table[static_cast<unsigned char>(alphabet_[value])] = value;
+        }
+        return table;
+    }
+
+    //! Six-bit value of each character, or \c INVALID_SEXTET
+    static const std::array<uint8_t, 256> sextets_;
+
+    /**
+     * \brief Pack six-bit values into bytes, most significant bit first.
+     *
+     * Every four six-bit values fill three bytes. The bytes after the packed ones are zeroed up to
+     * \c packed_size_.
+     *
+     * @param[in] sextets The six-bit values.
+     * @param[in] count The number of six-bit values. It must be a multiple of 4.
+     * @param[out] bytes The packed bytes. It must hold at least \c packed_size_ bytes.
+     */
+    static void pack_(
+            const uint8_t* sextets,
+            std::size_t count,
+            uint8_t* bytes) noexcept
+    {
+        std::size_t size = 0;
+        for (std::size_t i = 0; i < count; i += 4)
+        {
+            uint32_t group = (static_cast<uint32_t>(sextets[i]) << 18) | (static_cast<uint32_t>(sextets[i + 1]) << 12) |
+                    (static_cast<uint32_t>(sextets[i + 2]) << 6) | sextets[i + 3];
+            bytes[size++] = static_cast<uint8_t>(group >> 16);
+            bytes[size++] = static_cast<uint8_t>(group >> 8);
+            bytes[size++] = static_cast<uint8_t>(group);
+        }
+        for (; size < packed_size_; size++)
+        {
+            bytes[size] = 0;
+        }
+    }
+
+    /**
+     * \brief Extract an unsigned field from packed bytes.
+     *
+     * @param bytes The packed bytes. There must be 8 readable bytes from the one holding \c start.
+     * @param start Position of the first bit of the field, counting from the most significant bit
+     *              of the first byte.
+     * @param length Number of bits of the field [1; 32].
+     * @return The value of the field.
+     */
+    static uint32_t unsigned_(
+            const uint8_t* bytes,
+            std::size_t start,
+            std::size_t length) noexcept
+    {
+        const uint8_t* first = bytes + start / 8;
+        uint64_t window = 0;
+        for (std::size_t i = 0; i < 8; i++)
+        {
+            window = (window << 8) | first[i];
+        }
+        return static_cast<uint32_t>((window << (start % 8)) >> (64 - length));
+    }
+
+    /**
+     * \brief Extract a two's complement field from packed bytes.
+     *
+     * @param bytes The packed bytes, as in \c unsigned_().
+     * @param start Position of the first bit of the field, as in \c unsigned_().
+     * @param length Number of bits of the field [1; 32].
+     * @return The value of the field.
+     */
+    static int32_t signed_(
+            const uint8_t* bytes,
+            std::size_t start,
+            std::size_t length) noexcept
+    {
+        uint32_t value = unsigned_(bytes, start, length);
+        // Extend the sign bit of the field to the whole integer
+        uint32_t sign = uint32_t(1) << (length - 1);
+        return static_cast<int32_t>(value ^ sign) - static_cast<int32_t>(sign);
+    }
+
+    /**
+     * \brief Translate an angle in units of 1/10000 minutes into units of 1e-7 degrees.
+     *
+     * @param minutes_e4 The angle in units of 1/10000 minutes.
+     * @return The angle in units of 1e-7 degrees, rounded to the nearest.
+     */
+    static int32_t to_degrees_e7_(
+            int32_t minutes_e4) noexcept
+    {
+        // 1e-7 degrees are 6e-6 minutes, so the angle is scaled by 100 / 6
+        int64_t scaled = static_cast<int64_t>(minutes_e4) * 50;
+        return static_cast<int32_t>((scaled + (scaled < 0 ? -1 : 1)) / 3);
+    }
+
+};
+
+// Defined once the class is complete, so that the table is built at compile time
+inline const std::array<uint8_t, 256> AISPayload::sextets_ = AISPayload::make_sextets_();
+
+} // namespace eduponz
+} // namespace easynmea
+
+#endif //_EASYNMEA_AISPAYLOAD_HPP_
@@ -0,0 +1,232 @@
+// Copyright (c) 2021 Eduardo Ponz Segrelles.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+/**
+ * @file Checksum.cpp
+ */
+
+#include <cstring>
+
+#include "Checksum.hpp"
+#include "Simd.hpp"
+
+using namespace eduponz::easynmea;
+
+namespace {
+
+/**
+ * Fold the 8 bytes of a 64 bit word into a single byte by XORing them.
+ */
+inline uint8_t fold_u64(
+        uint64_t word) noexcept
+{
+    word ^= word >> 32;
+    word ^= word >> 16;
+    word ^= word >> 8;
+    return static_cast<uint8_t>(word);
+}
+
+/**
+ * XOR-reduce the bytes which do not fill a whole vector register.
+ */
+inline uint8_t xor_tail(
+        const char* data,
+        std::size_t size) noexcept
+{
+    uint8_t check = 0;
+    for (std::size_t i = 0; i < size; i++)
+    {
+        check ^= static_cast<uint8_t>(data[i]);
+    }
+    return check;
+}
+
+#if defined(EASYNMEA_SIMD_SSE2)
+uint8_t xor_sse2(
+        const char* data,
+        std::size_t size)
+{
+    __m128i acc = _mm_setzero_si128();
+    std::size_t i = 0;
+    for (; i + 16 <= size; i += 16)
+    {
+        acc = _mm_xor_si128(acc, _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)));
+    }
+    acc = _mm_xor_si128(acc, _mm_srli_si128(acc, 8));
+    uint64_t word = static_cast<uint32_t>(_mm_cvtsi128_si32(acc)) |
+            (static_cast<uint64_t>(static_cast<uint32_t>(_mm_cvtsi128_si32(_mm_srli_si128(acc, 4)))) << 32);
+    return fold_u64(word) ^ xor_tail(data + i, size - i);
+}
+
+#endif // if defined(EASYNMEA_SIMD_SSE2)
+
+#if defined(EASYNMEA_SIMD_AVX2)
+EASYNMEA_TARGET_AVX2 uint8_t xor_avx2(
+        const char* data,
+        std::size_t size)
+{
+    __m256i acc = _mm256_setzero_si256();
+    std::size_t i = 0;
+    for (; i + 32 <= size; i += 32)
+    {
+        acc = _mm256_xor_si256(acc, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i)));
+    }
+    __m128i half = _mm_xor_si128(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+    if (i + 16 <= size)
+    {
+        half = _mm_xor_si128(half, _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)));
+        i += 16;
+    }
+    half = _mm_xor_si128(half, _mm_srli_si128(half, 8));
+    uint64_t word = static_cast<uint32_t>(_mm_cvtsi128_si32(half)) |
+            (static_cast<uint64_t>(static_cast<uint32_t>(_mm_cvtsi128_si32(_mm_srli_si128(half, 4)))) << 32);
+    return fold_u64(word) ^ xor_tail(data + i, size - i);
+}
+
+#endif // if defined(EASYNMEA_SIMD_AVX2)
+
+#if defined(EASYNMEA_SIMD_NEON)
+uint8_t xor_neon(
+        const char* data,
+        std::size_t size)
+{
+    uint8x16_t acc = vdupq_n_u8(0);
+    std::size_t i = 0;
+    for (; i + 16 <= size; i += 16)
+    {
+        acc = veorq_u8(acc, vld1q_u8(reinterpret_cast<const uint8_t*>(data + i)));
+    }
+    uint8x8_t half = veor_u8(vget_low_u8(acc), vget_high_u8(acc));
+    return fold_u64(vget_lane_u64(vreinterpret_u64_u8(half), 0)) ^ xor_tail(data + i, size - i);
+}
+
+#endif // if defined(EASYNMEA_SIMD_NEON)
+
+} // namespace
+
+#if defined(EASYNMEA_SIMD_SSE2)
+const Checksum::XorKernel Checksum::xor_sse2_ = xor_sse2;
+#else
+const Checksum::XorKernel Checksum::xor_sse2_ = nullptr;
+#endif // if defined(EASYNMEA_SIMD_SSE2)
+
+#if defined(EASYNMEA_SIMD_AVX2)
+const Checksum::XorKernel Checksum::xor_avx2_ = xor_avx2;
+#else
+const Checksum::XorKernel Checksum::xor_avx2_ = nullptr;
+#endif // if defined(EASYNMEA_SIMD_AVX2)
+
+#if defined(EASYNMEA_SIMD_NEON)
+const Checksum::XorKernel Checksum::xor_neon_ = xor_neon;
+#else
+const Checksum::XorKernel Checksum::xor_neon_ = nullptr;
+#endif // if defined(EASYNMEA_SIMD_NEON)
+
+uint8_t Checksum::compute(
+        const char* data,
+        std::size_t size) noexcept
+{
+    static const char* name = nullptr;
+    static const XorKernel kernel = select_kernel_(name);
+    return kernel(data, size);
+}
+
+bool Checksum::validate(
+        std::string_view sentence) noexcept
+{
+    /* Separate sentence from checksum: '$<sentence>*hh' */
+    std::size_t checksum_mark = sentence.size() - 3;
+    int checksum = parse_hex(sentence[checksum_mark + 1], sentence[checksum_mark + 2]);
+
+    /**
+     * Calculate checksum from sentence. Characters are sign-extended when XORed, so that the result
+     * is the same as XORing them as char, and it never matches when the XOR has the highest bit set.
+     */
+    int check = static_cast<int8_t>(compute(sentence.data() + 1, checksum_mark - 1));
+
+    /* Validate input checksum */
+    return check == checksum;
+}
+
+std::size_t Checksum::validate_lines(
+        std::string_view buffer,
+        bool* valid,
+        std::size_t max_lines) noexcept
+{
+    std::size_t lines = 0;
+    const char* it = buffer.data();
+    const char* end = it + buffer.size();
+    while (it != end && lines < max_lines)
+    {
+        /* Delimit the line, removing the terminator */
+        const char* line_end = static_cast<const char*>(std::memchr(it, '\n', static_cast<std::size_t>(end - it)));
+        const char* next = line_end ? line_end + 1 : end;
+        line_end = line_end ? line_end : end;
+        if (line_end != it && line_end[-1] == '\r')
+        {
+            --line_end;
+        }
+
+        /* Check the framing: '[$!]<sentence>*hh' with a single '*' */
+        std::size_t size = static_cast<std::size_t>(line_end - it);
+        valid[lines] = size >= 4 &&
+                (it[0] == '$' || it[0] == '!') &&
+                it[size - 3] == '*' &&
+                std::memchr(it + 1, '*', size - 4) == nullptr &&
+                parse_hex(it[size - 2], it[size - 1]) >= 0 &&
+                validate(std::string_view(it, size));
+        lines++;
+        it = next;
+    }
+    return lines;
+}
+
+const char* Checksum::implementation() noexcept
+{
+    const char* name = nullptr;
+    select_kernel_(name);
+    return name;
+}
+
+uint8_t Checksum::xor_scalar_(
+        const char* data,
+        std::size_t size) noexcept
+{
+    uint64_t acc = 0;
+    std::size_t i = 0;
+    for (; i + 8 <= size; i += 8)
+    {
+        uint64_t word;
+        std::memcpy(&word, data + i, sizeof(word));
+        acc ^= word;
+    }
+    return fold_u64(acc) ^ xor_tail(data + i, size - i);
+}
+
+Checksum::XorKernel Checksum::select_kernel_(
+        const char*& name) noexcept
+{
+    return simd::select_kernel<XorKernel>(xor_scalar_, xor_sse2_, xor_avx2_, xor_neon_, name);
+}
+
+bool Checksum::cpu_supports_avx2_() noexcept
+{
+    return simd::cpu_supports_avx2();
+}
@@ -0,0 +1,175 @@
+// Copyright (c) 2021 Eduardo Ponz Segrelles.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+/**
+ * @file Checksum.hpp
+ */
+
+#ifndef _EASYNMEA_CHECKSUM_HPP_
+#define _EASYNMEA_CHECKSUM_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace eduponz {
+namespace easynmea {
+
+/**
+ * @class Checksum
+ *
+ * This class provides static APIs to calculate and validate NMEA 0183 checksums.
+ *
+ * The checksum is calculated by XOR-reducing the sentence bytes with a vectorized kernel. The kernel
+ * is selected once at runtime according to the CPU capabilities:
+ *     * AVX2 or SSE2 on x86 processors.
+ *     * NEON on 64 bit ARM processors.
+ *     * A portable scalar implementation on any other platform.
+ */
+class Checksum
+{
+public:
+
+    /**
+     * \brief Calculate the XOR of all the bytes in a buffer
+     *
+     * @param data Pointer to the first byte.
+     * @param size Number of bytes.
+     * @return The XOR of all the bytes, or 0 if \c size is 0.
+     */
+    static uint8_t compute(
+            const char* data,
+            std::size_t size) noexcept;
+
+    /**
+     * \brief Validate a NMEA 0183 sentence checksum
+     *
+     * The NMEA 0183 checksum is a hexadecimal number calculated as a result of XORing all the
+     * characters in the sentence from the starting '$' or '!' until the checksum mark '*' (none of
+     * them included).
+     *
+     * \pre The sentence is a valid NMEA sentence, meaning that it starts with a '$' or a '!', it
+     * ends with a '*<two hexadecimal digits>', and it does not contain any other '*'.
+     *
+     * @param sentence The sentence which checksum is to be checked.
+     * @return \c true if the sentence contains a correct checksum; \c false otherwise.
+     */
+    static bool validate(
+            std::string_view sentence) noexcept;
+
+    /**
+     * \brief Validate the checksum of every sentence in a buffer holding several lines
+     *
+     * Lines are terminated either in \c '\n' or \c '\r\n'. A last line without terminator is also
+     * validated if it is not empty. Unlike \c validate(), no precondition is placed on the lines: a
+     * line is considered valid if it starts with a '$' or a '!', it ends with a
+     * '*<two hexadecimal digits>' which is the only '*' in the line, and the checksum is correct.
+     *
+     * @param[in] buffer The buffer holding the lines.
+     * @param[out] valid Array in which the result for each line is stored, in order.
+     * @param[in] max_lines Capacity of \c valid. Lines beyond it are not validated.
+     * @return The number of lines validated, i.e. the number of elements written in \c valid.
+     */
+    static std::size_t validate_lines(
+            std::string_view buffer,
+            bool* valid,
+            std::size_t max_lines) noexcept;
+
+    /**
+     * \brief Translate two hexadecimal digits into a number without branching
+     *
+     * @param high The most significant digit.
+     * @param low The least significant digit.
+     * @return The number in [0; 255], or -1 if any of the characters is not a hexadecimal digit.
+     */
+    static int parse_hex(
+            char high,
+            char low) noexcept
+    {
+        int high_value = hex_digit_(high);
+        int low_value = hex_digit_(low);
+        // If any of the digits is -1, then the OR results in a negative number
+        return ((high_value << 4) | low_value) | ((high_value | low_value) >> 31);
+    }
+
+    /**
+     * \brief Get the name of the kernel selected for this CPU
+     *
+     * @return One of "avx2", "sse2", "neon", or "scalar".
+     */
+    static const char* implementation() noexcept;
+
+protected:
+
+    //! Signature of the XOR-reduce kernels
+    using XorKernel = uint8_t (*)(
+        const char* data,
+        std::size_t size);
+
+    /**
+     * \brief Translate a hexadecimal digit into a number without branching
+     *
+     * @param digit The hexadecimal digit.
+     * @return The number in [0; 15], or -1 if \c digit is not a hexadecimal digit.
+     */
+    static int hex_digit_(
+            char digit) noexcept
+    {
+        unsigned int c = static_cast<unsigned char>(digit);
+        // Digits map to their low nibble, letters map to their low nibble plus 9
+        int value = static_cast<int>((c & 0xF) + 9 * ((c >> 6) & 1));
+        int is_digit = (c - '0') < 10;
+        int is_letter = ((c | 0x20) - 'a') < 6;
+        int mask = -(is_digit | is_letter);
+        return (value & mask) | ~mask;
+    }
+
+    //! Portable XOR-reduce kernel, which reduces 8 bytes at a time
+    static uint8_t xor_scalar_(
+            const char* data,
+            std::size_t size) noexcept;
+
+    //! SSE2 XOR-reduce kernel. \c nullptr if not available on this platform
+    static const XorKernel xor_sse2_;
+
+    //! AVX2 XOR-reduce kernel. \c nullptr if not available on this platform
+    static const XorKernel xor_avx2_;
+
+    //! NEON XOR-reduce kernel. \c nullptr if not available on this platform
+    static const XorKernel xor_neon_;
+
+    /**
+     * \brief Select the fastest kernel supported by the CPU
+     *
+     * @param[out] name The name of the selected kernel.
+     * @return The selected kernel.
+     */
+    static XorKernel select_kernel_(
+            const char*& name) noexcept;
+
+    //! Whether the CPU supports AVX2
+    static bool cpu_supports_avx2_() noexcept;
+
+};
+
+} // namespace easynmea
+} // namespace eduponz
+
+#endif //_EASYNMEA_CHECKSUM_HPP_
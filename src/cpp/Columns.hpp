@@ -0,0 +1,154 @@
+// Copyright (c) 2021 Eduardo Ponz Segrelles.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+/**
+ * @file Columns.hpp
+ */
+
+#ifndef _EASYNMEA_COLUMNS_HPP_
+#define _EASYNMEA_COLUMNS_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+#include <easynmea/data.hpp>
+
+namespace eduponz {
+namespace easynmea {
+
+/**
+ * @struct GPGGAColumns
+ *
+ * @brief Caller-provided structure-of-arrays storage for GPGGA data
+ *
+ * Each member points to an array of \c capacity elements which holds one of the \c GPGGAData fields,
+ * so that each field of consecutive samples is contiguous in memory. Any column can be \c nullptr,
+ * in which case that field is not stored.
+ */
+struct GPGGAColumns
+{
+    //! Number of elements of each of the columns
+    std::size_t capacity = 0;
+
+    //! Column for \c GPGGAData::timestamp
+    float* timestamp = nullptr;
+
+    //! Column for \c GPGGAData::time_of_day_ms
+    int32_t* time_of_day_ms = nullptr;
+
+    //! Column for \c GPGGAData::latitude
+    float* latitude = nullptr;
+
+    //! Column for \c GPGGAData::longitude
+    float* longitude = nullptr;
+
+    //! Column for \c GPGGAData::latitude_e7
+    int32_t* latitude_e7 = nullptr;
+
+    //! Column for \c GPGGAData::longitude_e7
+    int32_t* longitude_e7 = nullptr;
+
+    //! Column for \c GPGGAData::fix
+    uint16_t* fix = nullptr;
+
+    //! Column for \c GPGGAData::satellites_on_view
+    uint16_t* satellites_on_view = nullptr;
+
+    //! Column for \c GPGGAData::horizontal_precision
+    float* horizontal_precision = nullptr;
+
+    //! Column for \c GPGGAData::altitude
+    float* altitude = nullptr;
+
+    //! Column for \c GPGGAData::height_of_geoid
+    float* height_of_geoid = nullptr;
+
+    //! Column for \c GPGGAData::dgps_last_update
+    float* dgps_last_update = nullptr;
+
+    //! Column for \c GPGGAData::dgps_reference_station_id
+    uint16_t* dgps_reference_station_id = nullptr;
+
+    /**
+     * \brief Store a sample in a row of the columns
+     *
+     * @param row The row in which the sample is stored. It must be lower than \c capacity.
+     * @param data The sample to store.
+     */
+    void set(
+            std::size_t row,
+            const GPGGAData& data) const noexcept
+    {
+        store_(timestamp, row, data.timestamp);
+        store_(time_of_day_ms, row, data.time_of_day_ms);
+        store_(latitude, row, data.latitude);
+        store_(longitude, row, data.longitude);
+        store_(latitude_e7, row, data.latitude_e7);
+        store_(longitude_e7, row, data.longitude_e7);
+        store_(fix, row, data.fix);
+        store_(satellites_on_view, row, data.satellites_on_view);
+        store_(horizontal_precision, row, data.horizontal_precision);
+        store_(altitude, row, data.altitude);
+        store_(height_of_geoid, row, data.height_of_geoid);
+        store_(dgps_last_update, row, data.dgps_last_update);
+        store_(dgps_reference_station_id, row, data.dgps_reference_station_id);
+    }
+
+private:
+
+    //! Store a value in a row of a column, unless the column is not provided
+    template<class T>
+    static void store_(
+            T* column,
+            std::size_t row,
+            T value) noexcept
+    {
+        if (column)
+        {
+            column[row] = value;
+        }
+    }
+
+};
+
+/**
+ * @struct BatchResult
+ *
+ * @brief Outcome of decoding a buffer holding several lines into columns
+ */
+struct BatchResult
+{
+    //! Number of lines processed, i.e. number of elements written in the status array
+    std::size_t lines = 0;
+
+    //! Number of rows written in the columns
+    std::size_t rows = 0;
+
+    /**
+     * Number of bytes of the buffer that were processed. It is lower than the buffer size when the
+     * status array or the columns were filled up, in which case decoding can be resumed from there.
+     */
+    std::size_t consumed = 0;
+};
+
+} // namespace easynmea
+} // namespace eduponz
+
+#endif //_EASYNMEA_COLUMNS_HPP_
@@ -0,0 +1,131 @@
+// Copyright (c) 2021 Eduardo Ponz Segrelles.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+/**
+ * @file DateAnchor.hpp
+ */
+
+#ifndef _EASYNMEA_DATEANCHOR_HPP_
+#define _EASYNMEA_DATEANCHOR_HPP_
+
+#include <chrono>
+#include <cstdint>
+
+#include <easynmea/data.hpp>
+
+namespace eduponz {
+namespace easynmea {
+
+/**
+ * @class DateAnchor
+ *
+ * This class dates the samples which only report the UTC time of day, such as the GGA ones.
+ *
+ * The samples which report a full date, such as the ZDA ones and most of the RMC ones, anchor the
+ * date. The rest of the samples are dated with the day for which their time of day is the nearest
+ * one to the latest dated sample, so a sample right after midnight is dated with the day following
+ * the one of the anchor, and a late sample from right before midnight with the day of the anchor.
+ * Each dated sample becomes the new anchor, so a stream which only reports the date once keeps on
+ * dating its samples correctly across midnight, as long as it does not pause for more than 12
+ * hours. Before the first anchor, the samples cannot be dated.
+ *
+ * \c DateAnchor is not thread safe; it is meant to be fed from the thread which reads the
+ * sentences.
+ */
+class DateAnchor
+{
+public:
+
+    //! Number of milliseconds in a day
+    static constexpr int64_t MILLISECONDS_PER_DAY = 86400000;
+
+    /**
+     * \brief Date a sample, or anchor the date with it.
+     *
+     * @param[in] time_of_day_ms The time of day of the sample in milliseconds since midnight, or -1
+     *            if the sample does not report a valid time of day.
+     * @param[in, out] utc_time The UTC time point of the sample. If it is \c UtcTime::min(), it is
+     *                 set to the date of the anchor plus \c time_of_day_ms, as long as there is an
+     *                 anchor. Otherwise, it becomes the new anchor.
+     * @return \c true if \c utc_time holds a time point on return; \c false otherwise.
+     */
+    bool stamp(
+            int32_t time_of_day_ms,
+            UtcTime& utc_time) noexcept
+    {
+        if (utc_time != UtcTime::min())
+        {
+            anchor_ = utc_time.time_since_epoch().count();
+            anchored_ = true;
+            return true;
+        }
+        if (!anchored_ || time_of_day_ms < 0)
+        {
+            return false;
+        }
+
+        /* Same day as the anchor, moved to the adjacent day if it is nearer to the anchor */
+        int64_t day = anchor_ / MILLISECONDS_PER_DAY - (anchor_ % MILLISECONDS_PER_DAY < 0 ? 1 : 0);
+        int64_t time = day * MILLISECONDS_PER_DAY + time_of_day_ms;
+        if (time - anchor_ > MILLISECONDS_PER_DAY / 2)
+        {
+            time -= MILLISECONDS_PER_DAY;
+        }
+        else if (anchor_ - time > MILLISECONDS_PER_DAY / 2)
+        {
+            time += MILLISECONDS_PER_DAY;
+        }
+        anchor_ = time;
+        utc_time = UtcTime(std::chrono::milliseconds(time));
+        return true;
+    }
+
+    /**
+     * \brief Check whether there is an anchor.
+     *
+     * @return \c true if a dated sample has been stamped since the last \c clear(); \c false
+     *         otherwise.
+     */
+    bool anchored() const noexcept
+    {
+        return anchored_;
+    }
+
+    /**
+     * \brief Discard the anchor, if any.
+     */
+    void clear() noexcept
+    {
+        anchored_ = false;
+    }
+
+protected:
+
+    //! UTC time of the latest dated sample, in milliseconds since 1970-01-01 00:00:00
+    int64_t anchor_ = 0;
+
+    //! Whether there is an anchor
+    bool anchored_ = false;
+};
+
+} // namespace eduponz
+} // namespace easynmea
+
+#endif //_EASYNMEA_DATEANCHOR_HPP_
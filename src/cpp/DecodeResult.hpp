@@ -0,0 +1,221 @@
+// Copyright (c) 2021 Eduardo Ponz Segrelles.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+/**
+ * @file DecodeResult.hpp
+ */
+
+#ifndef _EASYNMEA_DECODE_RESULT_HPP_
+#define _EASYNMEA_DECODE_RESULT_HPP_
+
+#include <cstdint>
+#include <type_traits>
+#include <variant>
+
+#include <easynmea/data.hpp>
+#include <easynmea/types.hpp>
+
+#include "AISAssembler.hpp"
+#include "GSAMerger.hpp"
+#include "GSVAssembler.hpp"
+
+namespace eduponz {
+namespace easynmea {
+
+/**
+ * @enum DecodeError
+ *
+ * @brief Reasons for which a sentence could not be decoded.
+ */
+enum class DecodeError : uint8_t
+{
+    //! The sentence was decoded successfully
+    NONE = 0,
+
+    //! The sentence does not resemble a NMEA 0183 sentence
+    INVALID_SENTENCE,
+
+    //! The sentence checksum is incorrect
+    INVALID_CHECKSUM,
+
+    //! The sentence identifier is not supported
+    UNSUPPORTED_SENTENCE,
+
+    //! The sentence fields do not follow the format of the sentence kind
+    INVALID_FIELDS,
+
+    //! The tag block preceding the sentence is malformed or its checksum is incorrect
+    INVALID_TAG_BLOCK,
+};
+
+/**
+ * @class DecodeResult
+ *
+ * This class holds the outcome of decoding a NMEA 0183 sentence by value: either one of the supported
+ * data structures, or the reason why the sentence could not be decoded.
+ *
+ * \c DecodeResult does not allocate memory and it is trivially copyable, so it can be stored in
+ * arrays and queues of any kind without any further cost than copying its bytes.
+ */
+class DecodeResult
+{
+public:
+
+    /**
+     * Variant holding any of the supported data structures. GSV and GSA sentences are held as the
+     * part of their group they carry, VDM and VDO sentences as the fragment of their AIS message
+     * they carry, and the sentences handed to a user decoder as the \c RawSentence they are
+     */
+    using Data = std::variant<std::monostate, GPGGAData, RMCData, GSVPart, GSAPart, AISFragment, RawSentence, ZDAData,
+                    HDTData, THSData, ROTData, GSTData>;
+
+    /**
+     * Construct a \c DecodeResult which does not hold any data.
+     *
+     * @param error The reason why the sentence could not be decoded. Defaults to
+     *              \c DecodeError::INVALID_SENTENCE
+     */
+    DecodeResult(
+            DecodeError error = DecodeError::INVALID_SENTENCE) noexcept
+        : data_()
+        , error_(error)
+    {
+    }
+
+    /**
+     * Construct a \c DecodeResult holding a decoded data sample.
+     *
+     * @tparam T The type of the data sample. It must be one of the alternatives of \c Data.
+     * @param data The decoded data sample.
+     */
+    template<class T>
+    DecodeResult(
+            const T& data) noexcept
+        : data_(data)
+        , error_(DecodeError::NONE)
+    {
+    }
+
+    /**
+     * Get the \c NMEA0183DataKind of the held data.
+     *
+     * @return The kind of the held data, or \c NMEA0183DataKind::INVALID if no data is held.
+     */
+    NMEA0183DataKind kind() const noexcept
+    {
+        return std::visit([](const auto& data) -> NMEA0183DataKind
+                       {
+                           if constexpr (std::is_same<std::decay_t<decltype(data)>, std::monostate>::value)
+                           {
+                               return NMEA0183DataKind::INVALID;
+                           }
+                           else
+                           {
+                               return data.kind;
+                           }
+                       }, data_);
+    }
+
+    /**
+     * Get the reason why the sentence could not be decoded.
+     *
+     * @return \c DecodeError::NONE if the sentence was decoded; the reason of the failure otherwise.
+     */
+    DecodeError error() const noexcept
+    {
+        return error_;
+    }
+
+    /**
+     * Get a pointer to the held data if it is of the given type.
+     *
+     * @tparam T The requested data type.
+     * @return A pointer to the held data if it is of type \c T; \c nullptr otherwise. The pointer is
+     *         valid as long as this \c DecodeResult is.
+     */
+    template<class T>
+    const T* get() const noexcept
+    {
+        return std::get_if<T>(&data_);
+    }
+
+    /**
+     * Attach the tag block which preceded the sentence to the held data, if any.
+     *
+     * @param tag_block The tag block of the sentence.
+     */
+    void set_tag_block(
+            const TagBlock& tag_block) noexcept
+    {
+        if (tag_block.empty())
+        {
+            return;
+        }
+        std::visit([&tag_block](auto& data)
+                {
+                    if constexpr (!std::is_same<std::decay_t<decltype(data)>, std::monostate>::value)
+                    {
+                        data.tag_block = tag_block;
+                    }
+                }, data_);
+    }
+
+    /**
+     * Attach the time at which the sentence was received to the held data, if any.
+     *
+     * @param receive_time The time at which the sentence was received.
+     */
+    void set_receive_time(
+            const ReceiveTime& receive_time) noexcept
+    {
+        std::visit([&receive_time](auto& data)
+                {
+                    if constexpr (!std::is_same<std::decay_t<decltype(data)>, std::monostate>::value)
+                    {
+                        data.receive_time = receive_time;
+                    }
+                }, data_);
+    }
+
+    /**
+     * Get the held data.
+     *
+     * @return A constant reference to the variant holding the data.
+     */
+    const Data& data() const noexcept
+    {
+        return data_;
+    }
+
+private:
+
+    //! The decoded data, if any
+    Data data_;
+
+    //! The reason why the sentence could not be decoded
+    DecodeError error_;
+};
+
+static_assert(std::is_trivially_copyable<DecodeResult>::value, "DecodeResult must be trivially copyable");
+
+} // namespace easynmea
+} // namespace eduponz
+
+#endif //_EASYNMEA_DECODE_RESULT_HPP_
@@ -60,6 +60,97 @@ ReturnCode EasyNmea::take_next(
     return impl_->take_next(gpgga);
 }
 
+ReturnCode EasyNmea::take_next(
+        RMCData& rmc) noexcept
+{
+    return impl_->take_next(rmc);
+}
+
+ReturnCode EasyNmea::take_next(
+        GSVData& gsv) noexcept
+{
+    return impl_->take_next(gsv);
+}
+
+ReturnCode EasyNmea::take_next(
+        GSAData& gsa) noexcept
+{
+    return impl_->take_next(gsa);
+}
+
+ReturnCode EasyNmea::take_next(
+        AISPositionData& ais) noexcept
+{
+    return impl_->take_next(ais);
+}
+
+ReturnCode EasyNmea::take_next(
+        ZDAData& zda) noexcept
+{
+    return impl_->take_next(zda);
+}
+
+ReturnCode EasyNmea::take_next(
+        HDTData& hdt) noexcept
+{
+    return impl_->take_next(hdt);
+}
+
+ReturnCode EasyNmea::take_next(
+        THSData& ths) noexcept
+{
+    return impl_->take_next(ths);
+}
+
+ReturnCode EasyNmea::take_next(
+        ROTData& rot) noexcept
+{
+    return impl_->take_next(rot);
+}
+
+ReturnCode EasyNmea::take_next(
+        GSTData& gst) noexcept
+{
+    return impl_->take_next(gst);
+}
+
+ReturnCode EasyNmea::read_latest(
+        HDTData& hdt) noexcept
+{
+    return impl_->read_latest(hdt);
+}
+
+ReturnCode EasyNmea::read_latest(
+        THSData& ths) noexcept
+{
+    return impl_->read_latest(ths);
+}
+
+ReturnCode EasyNmea::read_latest(
+        ROTData& rot) noexcept
+{
+    return impl_->read_latest(rot);
+}
+
+ReturnCode EasyNmea::register_decoder(
+        const std::string& address,
+        SentenceHandler handler) noexcept
+{
+    return impl_->register_decoder(address, std::move(handler));
+}
+
+ReturnCode EasyNmea::stamp_realtime(
+        bool enable) noexcept
+{
+    return impl_->stamp_realtime(enable);
+}
+
+ReturnCode EasyNmea::set_read_profile(
+        const ReadProfile& profile) noexcept
+{
+    return impl_->set_read_profile(profile);
+}
+
 ReturnCode EasyNmea::wait_for_data(
         NMEA0183DataKindMask data_mask,
         std::chrono::milliseconds timeout) noexcept
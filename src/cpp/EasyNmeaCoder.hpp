@@ -25,28 +25,53 @@
 #ifndef _EASYNMEA_DECODER_HPP_
 #define _EASYNMEA_DECODER_HPP_
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
 #include <iostream>
-#include <memory>
-#include <regex>
-#include <sstream>
 #include <string>
+#include <string_view>
 
 #include <easynmea/data.hpp>
 #include <easynmea/types.hpp>
 
+#include "AISPayload.hpp"
+#include "Checksum.hpp"
+#include "Columns.hpp"
+#include "DecodeResult.hpp"
+#include "FieldCodec.hpp"
+#include "PerfectHashTable.hpp"
+#include "SentenceRegistry.hpp"
+#include "SentenceSchema.hpp"
+#include "StructuralIndex.hpp"
+
 namespace eduponz {
 namespace easynmea {
 namespace nmea0183 {
 
-const char* GPGGA_ID = "$GPGGA";
-
 const char* NMEA0183_BASIC_REGEX =
         "\\$[A-Z0-9]+"        // Sentence ID
         "[0-9a-zA-Z,.\\-]*"   // NMEA 0183 data in any form
         "\\*[0-9a-fA-F]{2}";  // Checksum
 
+const char* NMEA0183_ENCAPSULATION_REGEX =
+        "![A-Z0-9]+"                  // Sentence ID
+        "[0-9a-zA-Z,.:;<=>?@`\\-]*"   // Encapsulated data in any form
+        "\\*[0-9a-fA-F]{2}";          // Checksum
+
+const char* TAG_BLOCK_REGEX =
+        "\\\\"                                                                     // Start of the tag block
+        "(s:[\\x20\\x22\\x23\\x25-\\x29\\x2B\\x2D-\\x5B\\x5D-\\x7E]{0,15}"         // Source
+        "|c:[0-9]{1,13}"                                                           // UNIX time
+        "|[abd-rt-z]:[\\x20\\x22\\x23\\x25-\\x29\\x2B\\x2D-\\x5B\\x5D-\\x7E]*)"    // Any other parameter
+        "(,(s:[\\x20\\x22\\x23\\x25-\\x29\\x2B\\x2D-\\x5B\\x5D-\\x7E]{0,15}"       // Rest of the parameters, separated by ','
+        "|c:[0-9]{1,13}"
+        "|[abd-rt-z]:[\\x20\\x22\\x23\\x25-\\x29\\x2B\\x2D-\\x5B\\x5D-\\x7E]*))*"
+        "\\*[0-9a-fA-F]{2}"                                                        // Checksum
+        "\\\\";                                                                    // End of the tag block
+
 const char* GPGGA_REGEX =
-        "\\$GPGGA,"                                                                  // GPGGA sentence ID
+        "\\$(GP|GL|GA|GB|BD|GQ|GI|GN)GGA,"                                          // GGA sentence ID
         "[0-9]{6}(\\.[0-9]+)?,"                                                      // Timestamp in hhmmss.ss
         "((([0-8][0-9])(([0-5][0-9])|(60))\\.[0-9]+)|(90\\.[0]+)),"                  // Latitude as DDMM.mm [0; 90]
         "[NS],"                                                                      // Beraing of latitude
@@ -65,236 +90,1168 @@ const char* GPGGA_REGEX =
         ")?"                                                                         // End of optional fields
         "\\*[0-9a-fA-F]{2}";                                                         // Checksum
 
+const char* RMC_REGEX =
+        "\\$(GP|GL|GA|GB|BD|GQ|GI|GN)RMC,"                                                    // RMC sentence ID
+        "[0-9]{6}(\\.[0-9]+)?,"                                                               // Timestamp in hhmmss.ss
+        "[AV],"                                                                               // Status
+        "(((([0-8][0-9])(([0-5][0-9])|(60))\\.[0-9]+)|(90\\.[0]+)),[NS]|,),"                  // Latitude and bearing or empty
+        "(((((0[0-9]{2})|(1[0-7][0-9]))(([0-5][0-9])|(60))\\.[0-9]+)|(180\\.[0]+)),[EW]|,),"  // Longitude and bearing or empty
+        "([0-9]+\\.[0-9]+)?,"                                                                 // Speed over ground in knots
+        "([0-9]+\\.[0-9]+)?,"                                                                 // Course over ground in degrees
+        "((0[1-9]|[12][0-9]|3[01])(0[1-9]|1[0-2])[0-9]{2})?,"                                 // Date in ddmmyy
+        "([0-9]+\\.[0-9]+,[EW]|,)"                                                            // Magnetic variation and direction
+        "(,[ADEFMNPRS]"                                                                       // Mode indicator (NMEA 2.3)
+        "(,[SCUV])?"                                                                          // Navigational status (NMEA 4.1)
+        ")?"                                                                                  // End of optional fields
+        "\\*[0-9a-fA-F]{2}";                                                                  // Checksum
+
+const char* GSV_REGEX =
+        "\\$(GP|GL|GA|GB|BD|GQ|GI|GN)GSV,"                  // GSV sentence ID
+        "[1-9],"                                            // Number of sentences in the group
+        "[1-9],"                                            // Number of this sentence
+        "[0-9]+"                                            // Satellites in view
+        "(,[0-9]+,([0-9]+)?,([0-9]+)?,([0-9]+)?){0,4}"      // PRN, elevation, azimuth, and SNR of each satellite
+        "(,[0-9A-F])?"                                      // Signal ID (NMEA 4.10)
+        "\\*[0-9a-fA-F]{2}";                                // Checksum
+
+const char* GSA_REGEX =
+        "\\$(GP|GL|GA|GB|BD|GQ|GI|GN)GSA,"                  // GSA sentence ID
+        "[MA],"                                             // Selection mode
+        "[1-3],"                                            // Fix type
+        "([0-9]*,){12}"                                     // PRN of the satellites used in the solution
+        "([0-9]+\\.[0-9]+)?,"                               // PDOP
+        "([0-9]+\\.[0-9]+)?,"                               // HDOP
+        "([0-9]+\\.[0-9]+)?"                                // VDOP
+        "(,[0-9A-F])?"                                      // GNSS system ID (NMEA 4.10)
+        "\\*[0-9a-fA-F]{2}";                                // Checksum
+
+const char* ZDA_REGEX =
+        "\\$(GP|GL|GA|GB|BD|GQ|GI|GN)ZDA,"                  // ZDA sentence ID
+        "([0-9]{6}(\\.[0-9]+)?)?,"                          // Timestamp in hhmmss.ss
+        "(0[1-9]|[12][0-9]|3[01])?,"                        // Day
+        "(0[1-9]|1[0-2])?,"                                 // Month
+        "([0-9]{4})?,"                                      // Year
+        "(-?(0[0-9]|1[0-3]))?,"                             // Local zone hours
+        "([0-5][0-9])?"                                     // Local zone minutes
+        "\\*[0-9a-fA-F]{2}";                                // Checksum
+
+const char* HDT_REGEX =
+        "\\$(GP|GL|GA|GB|BD|GQ|GI|GN)HDT,"                  // HDT sentence ID
+        "([0-9]+\\.[0-9]+)?,"                               // Heading in degrees
+        "T"                                                 // True
+        "\\*[0-9a-fA-F]{2}";                                // Checksum
+
+const char* THS_REGEX =
+        "\\$(GP|GL|GA|GB|BD|GQ|GI|GN)THS,"                  // THS sentence ID
+        "([0-9]+\\.[0-9]+)?,"                               // Heading in degrees
+        "[AEMSV]"                                           // Mode indicator
+        "\\*[0-9a-fA-F]{2}";                                // Checksum
+
+const char* ROT_REGEX =
+        "\\$(GP|GL|GA|GB|BD|GQ|GI|GN)ROT,"                  // ROT sentence ID
+        "(-?[0-9]+\\.[0-9]+)?,"                             // Rate of turn in degrees per minute
+        "[AV]"                                              // Status
+        "\\*[0-9a-fA-F]{2}";                                // Checksum
+
+const char* GST_REGEX =
+        "\\$(GP|GL|GA|GB|BD|GQ|GI|GN)GST,"                  // GST sentence ID
+        "([0-9]{6}(\\.[0-9]+)?)?,"                          // Timestamp in hhmmss.ss
+        "([0-9]+\\.[0-9]+)?,"                               // RMS of the pseudorange residuals
+        "([0-9]+\\.[0-9]+)?,"                               // Standard deviation of the semi-major axis
+        "([0-9]+\\.[0-9]+)?,"                               // Standard deviation of the semi-minor axis
+        "([0-9]+\\.[0-9]+)?,"                               // Orientation of the semi-major axis
+        "([0-9]+\\.[0-9]+)?,"                               // Standard deviation of the latitude error
+        "([0-9]+\\.[0-9]+)?,"                               // Standard deviation of the longitude error
+        "([0-9]+\\.[0-9]+)?"                                // Standard deviation of the altitude error
+        "\\*[0-9a-fA-F]{2}";                                // Checksum
+
+const char* VDM_REGEX =
+        "!(AI|AB|AD|AN|AR|AS|AT|AX|BS|SA)VD[MO],"  // VDM or VDO sentence ID
+        "[1-9],"                                   // Number of fragments
+        "[1-9],"                                   // Fragment number
+        "[0-9]?,"                                  // Sequential message ID
+        "[AB12]?,"                                 // AIS channel
+        "[0-9:;<=>?@A-W`a-w]{1,64},"               // Armored payload
+        "[0-5]"                                    // Number of fill bits
+        "\\*[0-9a-fA-F]{2}";                       // Checksum
+
+//! Schema of the GGA sentences, which accepts the same language as GPGGA_REGEX
+using GGA_SCHEMA = schema::Sentence<GPGGAData, 'G', 'G', 'A',
+                schema::Time<&GPGGAData::timestamp, &GPGGAData::time_of_day_ms>,
+                schema::Latitude<&GPGGAData::latitude, &GPGGAData::latitude_e7>,
+                schema::Longitude<&GPGGAData::longitude, &GPGGAData::longitude_e7>,
+                schema::Digit<&GPGGAData::fix, '0', '2'>,
+                schema::Unsigned<&GPGGAData::satellites_on_view>,
+                schema::Decimal<&GPGGAData::horizontal_precision>,
+                schema::Decimal<&GPGGAData::altitude, true>,
+                schema::Literal<'M'>,
+                schema::Decimal<&GPGGAData::height_of_geoid, true>,
+                schema::Literal<'M'>,
+                schema::Tail<
+                    schema::Optional<schema::Decimal<&GPGGAData::dgps_last_update>>,
+                    schema::Omittable<schema::Unsigned<&GPGGAData::dgps_reference_station_id>>>>;
+
+//! Schema of the RMC sentences, which accepts the same language as RMC_REGEX
+using RMC_SCHEMA = schema::Sentence<RMCData, 'R', 'M', 'C',
+                schema::Time<&RMCData::timestamp, &RMCData::time_of_day_ms>,
+                schema::Char<&RMCData::status, 'A', 'V'>,
+                schema::Optional<schema::Latitude<&RMCData::latitude, &RMCData::latitude_e7>>,
+                schema::Optional<schema::Longitude<&RMCData::longitude, &RMCData::longitude_e7>>,
+                schema::Optional<schema::Decimal<&RMCData::speed>>,
+                schema::Optional<schema::Decimal<&RMCData::course>>,
+                schema::Optional<schema::Date<&RMCData::date>>,
+                schema::List<
+                    schema::Optional<schema::Directed<&RMCData::magnetic_variation, 'E', 'W'>>,
+                    schema::Omittable<schema::Char<&RMCData::mode, 'A', 'D', 'E', 'F', 'M', 'N', 'P', 'R', 'S'>>,
+                    schema::Omittable<schema::Char<&RMCData::navigational_status, 'S', 'C', 'U', 'V'>>>>;
+
+//! Schema of the GSV sentences, which accepts the same language as GSV_REGEX
+using GSV_SCHEMA = schema::Sentence<GSVPart, 'G', 'S', 'V',
+                schema::Digit<&GSVPart::total_parts, '1', '9'>,
+                schema::Digit<&GSVPart::part_number, '1', '9'>,
+                schema::List<
+                    schema::Unsigned<&GSVPart::satellites_in_view>,
+                    schema::Repeated<&GSVPart::satellites, &GSVPart::satellite_count,
+                        schema::Unsigned<&GSVSatellite::prn>,
+                        schema::Optional<schema::Unsigned<&GSVSatellite::elevation>>,
+                        schema::Optional<schema::Unsigned<&GSVSatellite::azimuth>>,
+                        schema::Optional<schema::Unsigned<&GSVSatellite::snr>>>,
+                    schema::Omittable<schema::Char<&GSVPart::signal_id,
+                        '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F'>>>>;
+
+//! Schema of the GSA sentences, which accepts the same language as GSA_REGEX
+using GSA_SCHEMA = schema::Sentence<GSAPart, 'G', 'S', 'A',
+                schema::Char<&GSAPart::selection_mode, 'M', 'A'>,
+                schema::Digit<&GSAPart::fix_type, '1', '3'>,
+                schema::Slots<&GSAPart::prns, &GSAPart::prn_count>,
+                schema::Optional<schema::Decimal<&GSAPart::pdop>>,
+                schema::Optional<schema::Decimal<&GSAPart::hdop>>,
+                schema::List<
+                    schema::Optional<schema::Decimal<&GSAPart::vdop>>,
+                    schema::Omittable<schema::Char<&GSAPart::system_id,
+                        '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F'>>>>;
+
+//! Schema of the ZDA sentences, which accepts the same language as ZDA_REGEX
+using ZDA_SCHEMA = schema::Sentence<ZDAData, 'Z', 'D', 'A',
+                schema::Optional<schema::Time<nullptr, &ZDAData::time_of_day_ms>>,
+                schema::Optional<schema::Fixed<&ZDAData::day, 2, 1, 31>>,
+                schema::Optional<schema::Fixed<&ZDAData::month, 2, 1, 12>>,
+                schema::Optional<schema::Fixed<&ZDAData::year, 4, 0, 9999>>,
+                schema::Optional<schema::Fixed<&ZDAData::local_zone_hours, 2, -13, 13>>,
+                schema::List<
+                    schema::Optional<schema::Fixed<&ZDAData::local_zone_minutes, 2, 0, 59>>>>;
+
+//! Schema of the HDT sentences, which accepts the same language as HDT_REGEX
+using HDT_SCHEMA = schema::Sentence<HDTData, 'H', 'D', 'T',
+                schema::List<
+                    schema::Optional<schema::Decimal<&HDTData::heading>>,
+                    schema::Literal<'T'>>>;
+
+//! Schema of the THS sentences, which accepts the same language as THS_REGEX
+using THS_SCHEMA = schema::Sentence<THSData, 'T', 'H', 'S',
+                schema::List<
+                    schema::Optional<schema::Decimal<&THSData::heading>>,
+                    schema::Char<&THSData::mode, 'A', 'E', 'M', 'S', 'V'>>>;
+
+//! Schema of the ROT sentences, which accepts the same language as ROT_REGEX
+using ROT_SCHEMA = schema::Sentence<ROTData, 'R', 'O', 'T',
+                schema::List<
+                    schema::Optional<schema::Decimal<&ROTData::rate_of_turn, true>>,
+                    schema::Char<&ROTData::status, 'A', 'V'>>>;
+
+//! Schema of the GST sentences, which accepts the same language as GST_REGEX
+using GST_SCHEMA = schema::Sentence<GSTData, 'G', 'S', 'T',
+                schema::Optional<schema::Time<nullptr, &GSTData::time_of_day_ms>>,
+                schema::Optional<schema::Decimal<&GSTData::rms>>,
+                schema::Optional<schema::Decimal<&GSTData::semi_major_error>>,
+                schema::Optional<schema::Decimal<&GSTData::semi_minor_error>>,
+                schema::Optional<schema::Decimal<&GSTData::semi_major_orientation>>,
+                schema::Optional<schema::Decimal<&GSTData::latitude_error>>,
+                schema::Optional<schema::Decimal<&GSTData::longitude_error>>,
+                schema::List<
+                    schema::Optional<schema::Decimal<&GSTData::altitude_error>>>>;
+
 } // namespace nmea0183
 
 /**
  * @class EasyNmeaCoder
  *
- * This class provides static APIs to decode NMEA 0183 sentences.
+ * This class provides static APIs to decode and encode NMEA 0183 sentences.
  */
-class EasyNmeaCoder
+class EasyNmeaCoder : public FieldCodec
 {
 public:
 
     /**
      * \brief Decode a NMEA 0183 sentence
      *
-     * @param sentence The sentence to be decoded
-     * @return A shared pointer to a NMEA0183Data. The \c kind field can be used in combination with
-     *         \c std::static_pointer_cast to cast the pointer to the appropriate type. The function
-     *         transfers the shared pointer ownership to the caller, thus the returned pointer is
-     *         the only reference to the data object.
+     * The sentence is decoded directly from the caller's bytes, so it can point to any buffer (for
+     * instance, the buffer in which the sentence was received). No heap allocation is performed.
+     *
+     * The sentence may be preceded by a tag block, which is validated in the same pass, and whose
+     * source and time are attached to the decoded data.
+     *
+     * @param sentence The sentence to be decoded. It must not contain the line terminator.
+     * @return A \c DecodeResult holding the decoded data by value. Its \c kind() can be used in
+     *         combination with \c get() to access the appropriate data type. If the sentence could
+     *         not be decoded, \c kind() is \c NMEA0183DataKind::INVALID and \c error() holds the
+     *         reason.
+     */
+    static DecodeResult decode(
+            std::string_view sentence) noexcept
+    {
+        return decode_(sentence, nullptr);
+    }
+
+    /**
+     * \brief Decode a NMEA 0183 sentence, handing the unsupported ones to the registered decoders
+     *
+     * The sentence is decoded as in \c decode(std::string_view). However, if its address is not
+     * supported by the library, it is decoded with the decoder registered for it in \c registry,
+     * once its framing and checksum have been validated. In that case, no warning is logged, and
+     * the tag block of the sentence is attached to the data returned by the decoder.
+     *
+     * @param sentence The sentence to be decoded. It must not contain the line terminator.
+     * @param registry The decoders of the sentences not supported by the library.
+     * @return A \c DecodeResult holding the decoded data by value, as in
+     *         \c decode(std::string_view).
+     */
+    static DecodeResult decode(
+            std::string_view sentence,
+            const SentenceRegistry& registry) noexcept
+    {
+        return decode_(sentence, &registry);
+    }
+
+    /**
+     * \brief Decode a NMEA 0183 sentence which has already been indexed with \c StructuralIndex
+     *
+     * The framing, the checksum mark, the sentence identifier, and the tag block are taken from the
+     * index instead of scanning the sentence for them again. The fields of the supported sentences are validated
+     * when decoded, but the characters of unsupported sentences are not checked, so such sentences
+     * are reported as \c DecodeError::UNSUPPORTED_SENTENCE as long as they are framed and their
+     * checksum is correct.
+     *
+     * @param buffer The buffer from which the index was built.
+     * @param index The index of the sentence to be decoded.
+     * @return A \c DecodeResult holding the decoded data by value, as in \c decode(std::string_view).
      */
-    static std::shared_ptr<NMEA0183Data> decode(
-            const std::string& sentence) noexcept
+    static DecodeResult decode(
+            std::string_view buffer,
+            const IndexedSentence& index) noexcept
     {
-        // Check that the sentence resembles a NMEA 0183 sentence
-        if (!std::regex_match(sentence, std::regex(nmea0183::NMEA0183_BASIC_REGEX)))
+        return log_(buffer, index, decode_indexed_(buffer, index, nullptr));
+    }
+
+    /**
+     * \brief Decode a NMEA 0183 sentence which has already been indexed, handing the unsupported
+     * ones to the registered decoders
+     *
+     * The sentence is decoded as in \c decode(std::string_view, const IndexedSentence&), and the
+     * sentences which are not supported by the library are handed to the decoders of \c registry
+     * as in \c decode(std::string_view, const SentenceRegistry&). As the characters of such
+     * sentences are not checked, the decoders must validate them.
+     *
+     * @param buffer The buffer from which the index was built.
+     * @param index The index of the sentence to be decoded.
+     * @param registry The decoders of the sentences not supported by the library.
+     * @return A \c DecodeResult holding the decoded data by value, as in \c decode(std::string_view).
+     */
+    static DecodeResult decode(
+            std::string_view buffer,
+            const IndexedSentence& index,
+            const SentenceRegistry& registry) noexcept
+    {
+        return log_(buffer, index, decode_indexed_(buffer, index, &registry));
+    }
+
+    /**
+     * \brief Hand a sentence over as it is
+     *
+     * Decoder which can be registered in a \c SentenceRegistry so that the sentences of an address
+     * are delivered without decoding their fields. The sentence is not copied, so the returned
+     * \c RawSentence refers to the same bytes as \c sentence.
+     *
+     * @param sentence A sentence whose framing and checksum have already been validated.
+     * @return A \c DecodeResult holding a \c RawSentence. Its talker is set if the sentence
+     *         comes from a supported talker.
+     */
+    static DecodeResult passthrough(
+            std::string_view sentence) noexcept
+    {
+        RawSentence raw;
+        raw.sentence = sentence;
+        if (sentence.size() >= 3)
+        {
+            raw.talker = sentence[0] == '!' ? ais_talker_(sentence[1], sentence[2]) : talker_(sentence[1], sentence[2]);
+        }
+        return DecodeResult(raw);
+    }
+
+    /**
+     * \brief Decode all the GPGGA sentences of a buffer holding several lines into columns
+     *
+     * The buffer is indexed with \c StructuralIndex, and every line is decoded as in
+     * \c decode(std::string_view, const IndexedSentence&), but without logging any warning. Each
+     * line that holds a valid GPGGA sentence is stored in the next row of \c columns, so the rows
+     * are contiguous regardless of the lines that could not be decoded. The lines holding other
+     * kinds of sentences cannot be stored in \c columns, so they are reported as
+     * \c DecodeError::UNSUPPORTED_SENTENCE. No heap allocation is performed.
+     *
+     * Empty lines are skipped. Decoding stops when the buffer has been completely processed, when
+     * \c max_lines lines have been processed, or when a GPGGA sentence is found and \c columns is
+     * full. In the last two cases, decoding can be resumed from \c BatchResult::consumed.
+     *
+     * @param[in] buffer The buffer holding the lines.
+     * @param[in] columns The columns in which the GPGGA samples are stored.
+     * @param[out] status Array in which the outcome of each line is stored, in order. Lines with
+     *             \c DecodeError::NONE correspond to the rows of \c columns, in the same order.
+     * @param[in] max_lines Capacity of \c status.
+     * @return The number of lines processed, the number of rows written, and the number of bytes
+     *         of \c buffer processed.
+     */
+    static BatchResult decode_batch(
+            std::string_view buffer,
+            const GPGGAColumns& columns,
+            DecodeError* status,
+            std::size_t max_lines) noexcept
+    {
+        constexpr std::size_t table_size = 64;
+        IndexedSentence table[table_size];
+        BatchResult batch;
+
+        while (batch.lines < max_lines && batch.consumed < buffer.size())
+        {
+            /* Index the next lines */
+            std::string_view pending = buffer.substr(batch.consumed);
+            std::size_t consumed = 0;
+            std::size_t count = StructuralIndex::build(
+                pending, table, std::min(table_size, max_lines - batch.lines), &consumed);
+
+            /* Decode them into the columns */
+            for (std::size_t i = 0; i < count; i++)
+            {
+                DecodeResult result = decode_indexed_(pending, table[i], nullptr);
+                if (const GPGGAData* gpgga = result.get<GPGGAData>())
+                {
+                    if (batch.rows == columns.capacity)
+                    {
+                        // There is no room for this sample, so resume from it
+                        batch.consumed += table[i].begin - table[i].tag_block_size;
+                        return batch;
+                    }
+                    columns.set(batch.rows++, *gpgga);
+                }
+                status[batch.lines++] = result.kind() == NMEA0183DataKind::INVALID ||
+                        result.kind() == NMEA0183DataKind::GPGGA ? result.error() : DecodeError::UNSUPPORTED_SENTENCE;
+            }
+            batch.consumed += consumed;
+        }
+        return batch;
+    }
+
+    /**
+     * \brief Decode a NMEA 0183 GPGGA sentence
+     *
+     * Convenience overload of \c decode() for callers which are only interested in GPGGA data.
+     *
+     * @param[in] sentence The sentence to be decoded. It must not contain the line terminator.
+     * @param[out] gpgga The \c GPGGAData to populate. It is only modified if the sentence is a valid
+     *             GPGGA sentence.
+     * @return \c true if \c gpgga was populated; \c false if the sentence is not a valid NMEA 0183
+     *         sentence, its checksum is incorrect, or it is not a valid GPGGA sentence.
+     */
+    static bool decode(
+            std::string_view sentence,
+            GPGGAData& gpgga) noexcept
+    {
+        DecodeResult result = decode(sentence);
+        if (const GPGGAData* data = result.get<GPGGAData>())
+        {
+            gpgga = *data;
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * \brief Decode a NMEA 0183 RMC sentence
+     *
+     * Convenience overload of \c decode() for callers which are only interested in RMC data.
+     *
+     * @param[in] sentence The sentence to be decoded. It must not contain the line terminator.
+     * @param[out] rmc The \c RMCData to populate. It is only modified if the sentence is a valid RMC
+     *             sentence.
+     * @return \c true if \c rmc was populated; \c false if the sentence is not a valid NMEA 0183
+     *         sentence, its checksum is incorrect, or it is not a valid RMC sentence.
+     */
+    static bool decode(
+            std::string_view sentence,
+            RMCData& rmc) noexcept
+    {
+        DecodeResult result = decode(sentence);
+        if (const RMCData* data = result.get<RMCData>())
+        {
+            rmc = *data;
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * \brief Encode a \c GPGGAData into a NMEA 0183 GGA sentence
+     *
+     * The sentence is written with the talker of the data and with its checksum, preceded by the tag
+     * block of the data if it is not empty, but without the line terminator. Decoding the sentence
+     * yields the same data, except that the latitude and the longitude in degrees are recomputed
+     * from their exact values in units of 1e-7 degrees. No heap allocation is performed.
+     *
+     * @param[in] gpgga The data to encode.
+     * @param[out] buffer The buffer where the sentence is written.
+     * @param[in] size The size of the buffer.
+     * @return The length of the sentence, or 0 if it does not fit in \c buffer or \c gpgga holds a
+     *         value that a GGA sentence cannot represent.
+     */
+    static std::size_t encode(
+            const GPGGAData& gpgga,
+            char* buffer,
+            std::size_t size) noexcept
+    {
+        return nmea0183::GGA_SCHEMA::encode(gpgga, buffer, size);
+    }
+
+    /**
+     * \brief Encode a \c RMCData into a NMEA 0183 RMC sentence
+     *
+     * The sentence is written as \c encode(const GPGGAData&, char*, std::size_t) does. The fields
+     * holding their default values are written empty, and the mode indicator and the navigational
+     * status are only written if they are set.
+     *
+     * @param[in] rmc The data to encode.
+     * @param[out] buffer The buffer where the sentence is written.
+     * @param[in] size The size of the buffer.
+     * @return The length of the sentence, or 0 if it does not fit in \c buffer or \c rmc holds a
+     *         value that a RMC sentence cannot represent.
+     */
+    static std::size_t encode(
+            const RMCData& rmc,
+            char* buffer,
+            std::size_t size) noexcept
+    {
+        return nmea0183::RMC_SCHEMA::encode(rmc, buffer, size);
+    }
+
+protected:
+
+    /**
+     * \brief Decode a NMEA 0183 sentence, handing the unsupported ones to the registered decoders, if any
+     *
+     * @param sentence The sentence to be decoded. It must not contain the line terminator.
+     * @param registry The decoders of the sentences not supported by the library, or \c nullptr.
+     * @return A \c DecodeResult holding the decoded data by value.
+     */
+    static DecodeResult decode_(
+            std::string_view sentence,
+            const SentenceRegistry* registry) noexcept
+    {
+        // Separate the tag block, if any, from the sentence
+        TagBlock tag_block;
+        if (!sentence.empty() && sentence[0] == '\\')
+        {
+            const char* it = sentence.data();
+            if (!scan_tag_block_(it, sentence.data() + sentence.size(), tag_block))
+            {
+                std::cout << "[WARNING] Sentence '" << sentence << "' has an invalid tag block" << std::endl;
+                return DecodeResult(DecodeError::INVALID_TAG_BLOCK);
+            }
+            sentence.remove_prefix(static_cast<std::size_t>(it - sentence.data()));
+        }
+
+        // Check that the sentence resembles a NMEA 0183 sentence, either parametric or encapsulation
+        if (!is_nmea0183_sentence_(sentence) && !is_encapsulation_sentence_(sentence))
         {
             std::cout << "[WARNING] Sentence '" << sentence << "' is NOT a valid NMEA 0183 sentence" << std::endl;
-            return std::move(std::make_shared<NMEA0183Data>());
+            return DecodeResult(DecodeError::INVALID_SENTENCE);
         }
 
         // Check that the checksum is correct
         if (!validate_checksum_(sentence))
         {
             std::cout << "[WARNING] Sentence: '" << sentence << "' has an incorrect checksum" << std::endl;
-            return std::move(std::make_shared<NMEA0183Data>());
+            return DecodeResult(DecodeError::INVALID_CHECKSUM);
         }
 
-        // Decode according to sentence identifier
-        switch (data_kind_(sentence))
+        // Decode according to sentence address, falling back on the registered decoders
+        std::string_view address = sentence.substr(0, sentence.find(','));
+        std::string_view registered_address = address.substr(0, address.find('*'));
+        SentenceRegistry::Decoder decoder = find_decoder_(address, registered_address, registry);
+        if (decoder == nullptr)
         {
-            case NMEA0183DataKind::GPGGA:
+            std::cout << "[WARNING] Sentence identifier '" << address << "' is NOT supported" << std::endl;
+            return DecodeResult(DecodeError::UNSUPPORTED_SENTENCE);
+        }
+        DecodeResult result = decoder(sentence);
+        if (result.error() == DecodeError::INVALID_FIELDS)
+        {
+            std::cout << "[WARNING] Sentence '" << sentence << "' is NOT a valid " << registered_address.substr(1)
+                      << " sentence" << std::endl;
+        }
+        result.set_tag_block(tag_block);
+        return result;
+    }
+
+    /**
+     * \brief Log the reason why a sentence which has already been indexed could not be decoded
+     *
+     * @param buffer The buffer from which the index was built.
+     * @param index The index of the sentence.
+     * @param result The outcome of decoding the sentence.
+     * @return \c result
+     */
+    static DecodeResult log_(
+            std::string_view buffer,
+            const IndexedSentence& index,
+            const DecodeResult& result) noexcept
+    {
+        switch (result.error())
+        {
+            case DecodeError::INVALID_SENTENCE:
             {
-                return std::move(decode_gpgga_(sentence));
+                std::cout << "[WARNING] Sentence '" << index.sentence(buffer) << "' is NOT a valid NMEA 0183 sentence"
+                          << std::endl;
+                break;
+            }
+            case DecodeError::INVALID_CHECKSUM:
+            {
+                std::cout << "[WARNING] Sentence: '" << index.sentence(buffer) << "' has an incorrect checksum"
+                          << std::endl;
+                break;
+            }
+            case DecodeError::UNSUPPORTED_SENTENCE:
+            {
+                std::cout << "[WARNING] Sentence identifier '" << index.field(buffer, 0) << "' is NOT supported"
+                          << std::endl;
+                break;
+            }
+            case DecodeError::INVALID_FIELDS:
+            {
+                std::cout << "[WARNING] Sentence '" << index.sentence(buffer) << "' is NOT a valid "
+                          << index.field(buffer, 0).substr(1) << " sentence" << std::endl;
+                break;
+            }
+            case DecodeError::INVALID_TAG_BLOCK:
+            {
+                std::cout << "[WARNING] Sentence '" << index.sentence(buffer) << "' has an invalid tag block '"
+                          << index.tag_block(buffer) << "'" << std::endl;
+                break;
             }
             default:
             {
-                return std::move(std::make_shared<NMEA0183Data>());
+                break;
             }
         }
+        return result;
     }
 
-protected:
+    /**
+     * \brief Decode a sentence which has already been indexed, without logging any warning
+     *
+     * @param buffer The buffer from which the index was built.
+     * @param index The index of the sentence to be decoded.
+     * @param registry The decoders of the sentences not supported by the library, or \c nullptr.
+     * @return A \c DecodeResult holding the decoded data by value.
+     */
+    static DecodeResult decode_indexed_(
+            std::string_view buffer,
+            const IndexedSentence& index,
+            const SentenceRegistry* registry) noexcept
+    {
+        std::string_view sentence = index.sentence(buffer);
+
+        // Check that the sentence is framed as a NMEA 0183 sentence
+        if (!index.framed() || Checksum::parse_hex(sentence[sentence.size() - 2], sentence.back()) < 0)
+        {
+            return DecodeResult(DecodeError::INVALID_SENTENCE);
+        }
+
+        // Check that the checksum is correct
+        if (!validate_checksum_(sentence))
+        {
+            return DecodeResult(DecodeError::INVALID_CHECKSUM);
+        }
+
+        // Check the tag block, if any
+        TagBlock tag_block;
+        if (index.tag_block_size > 0)
+        {
+            std::string_view tag = index.tag_block(buffer);
+            const char* it = tag.data();
+            if (!scan_tag_block_(it, tag.data() + tag.size(), tag_block) || it != tag.data() + tag.size())
+            {
+                return DecodeResult(DecodeError::INVALID_TAG_BLOCK);
+            }
+        }
+
+        // Decode according to sentence address, falling back on the registered decoders
+        std::string_view address = index.field(buffer, 0);
+        SentenceRegistry::Decoder decoder = find_decoder_(address, address, registry);
+        if (decoder == nullptr)
+        {
+            return DecodeResult(DecodeError::UNSUPPORTED_SENTENCE);
+        }
+        DecodeResult result = decoder(sentence);
+        result.set_tag_block(tag_block);
+        return result;
+    }
+
+    /**
+     * \brief Check whether a sentence resembles a NMEA 0183 sentence
+     *
+     * The accepted language is exactly the one described by \c nmea0183::NMEA0183_BASIC_REGEX.
+     *
+     * @param sentence The sentence to be checked
+     * @return \c true if the sentence resembles a NMEA 0183 sentence; \c false otherwise.
+     */
+    static bool is_nmea0183_sentence_(
+            std::string_view sentence) noexcept
+    {
+        const char* it = sentence.data();
+        const char* end = it + sentence.size();
+
+        /* Sentence ID */
+        if (!consume_char_(it, end, '$') || it == end || !((*it >= 'A' && *it <= 'Z') || (*it >= '0' && *it <= '9')))
+        {
+            return false;
+        }
+
+        /* NMEA 0183 data in any form */
+        while (it != end && ((*it >= 'A' && *it <= 'Z') || (*it >= 'a' && *it <= 'z') || (*it >= '0' && *it <= '9') ||
+                *it == ',' || *it == '.' || *it == '-'))
+        {
+            ++it;
+        }
+
+        /* Checksum */
+        return consume_char_(it, end, '*') &&
+               consume_hex_digit_(it, end) &&
+               consume_hex_digit_(it, end) &&
+               it == end;
+    }
+
+    /**
+     * \brief Check whether a sentence resembles a NMEA 0183 encapsulation sentence
+     *
+     * Encapsulation sentences start with '!', and carry data armored with characters which the
+     * parametric sentences do not use. The accepted language is exactly the one described by
+     * \c nmea0183::NMEA0183_ENCAPSULATION_REGEX.
+     *
+     * @param sentence The sentence to be checked
+     * @return \c true if the sentence resembles a NMEA 0183 encapsulation sentence; \c false
+     *         otherwise.
+     */
+    static bool is_encapsulation_sentence_(
+            std::string_view sentence) noexcept
+    {
+        const char* it = sentence.data();
+        const char* end = it + sentence.size();
+
+        /* Sentence ID */
+        if (!consume_char_(it, end, '!') || it == end || !((*it >= 'A' && *it <= 'Z') || (*it >= '0' && *it <= '9')))
+        {
+            return false;
+        }
+
+        /* Encapsulated data in any form */
+        while (it != end && ((*it >= 'A' && *it <= 'Z') || (*it >= 'a' && *it <= 'z') || (*it >= '0' && *it <= '9') ||
+                *it == ',' || *it == '.' || *it == '-' || (*it >= ':' && *it <= '@') || *it == '`'))
+        {
+            ++it;
+        }
+
+        /* Checksum */
+        return consume_char_(it, end, '*') &&
+               consume_hex_digit_(it, end) &&
+               consume_hex_digit_(it, end) &&
+               it == end;
+    }
 
     /**
      * \brief Validate a NMEA 0183 sentence checksum
      *
      * The NMEA 0183 checksum is a hexadecimal number calculated as a result of XORing all the
-     * characters in the sentence from the starting '$' until the checksum mark '*' (none of them
-     * included).
+     * characters in the sentence from the starting '$' or '!' until the checksum mark '*' (none of
+     * them included).
      *
      * \pre \c validate_checksum_ assumes that the sentence is a valid NMEA sentence, meaning that
-     * it starts with a '$', and ends with a '*<hexadecimal number>'.
+     * it starts with a '$' or a '!', and ends with a '*<hexadecimal number>'.
      *
      * @param sentence The sentence which checksum is to be checked
      * @return \c true if the sentence contains a correct checksum; \c false otherwise.
      */
     static bool validate_checksum_(
-            const std::string& sentence) noexcept
+            std::string_view sentence) noexcept
     {
-        /* Separate sentence from checksum */
-        std::string sentence_no_check;
-        std::string checksum_str;
-        std::stringstream sentence_ss(sentence);
-        std::getline(sentence_ss, sentence_no_check, '*');
-        std::getline(sentence_ss, checksum_str, '*');
-        sentence_no_check = sentence_no_check.substr(1); // Remove first char from sentence ($)
+        return Checksum::validate(sentence);
+    }
 
-        /* Convert hex string to int */
-        int checksum = 0;
-        std::stringstream checksum_ss;
-        checksum_ss << std::hex << checksum_str;
-        checksum_ss >> checksum;
+    //! Decoder of the sentences of a formatter, regardless of their talker
+    using SentenceDecoder = DecodeResult (*)(
+        std::string_view sentence);
 
-        /* Calculate checksum from sentence */
-        int check = 0;
-        for (char character : sentence_no_check)
+    //! Sentence kind and decoder associated with a sentence formatter
+    struct SentenceFormatter
+    {
+        NMEA0183DataKind kind = NMEA0183DataKind::INVALID;
+        SentenceDecoder decoder = nullptr;
+    };
+
+    /**
+     * \brief Pack the three characters of a sentence formatter into an integer.
+     *
+     * @param formatter Pointer to the first character of the formatter.
+     * @return The characters packed in the lowest three bytes.
+     */
+    static constexpr uint32_t formatter_code_(
+            const char* formatter) noexcept
+    {
+        return static_cast<uint32_t>(static_cast<unsigned char>(formatter[0])) |
+               (static_cast<uint32_t>(static_cast<unsigned char>(formatter[1])) << 8) |
+               (static_cast<uint32_t>(static_cast<unsigned char>(formatter[2])) << 16);
+    }
+
+    /**
+     * \brief Find the sentence kind and decoder of a sentence using its address field.
+     *
+     * The address field is '$' (or '!' for encapsulation sentences) followed by the talker
+     * identifier (two characters) and the sentence formatter (three characters). The talker and the
+     * formatter are looked up independently, so all the supported talkers share the decoder of each
+     * formatter. Encapsulation sentences only accept AIS talkers, and the rest only GNSS talkers.
+     * The formatter is looked up in a perfect hash table built at compile time, so the lookup takes
+     * constant time.
+     *
+     * @param address The address field of the sentence, including the '$' or the '!'.
+     * @return A pointer to the \c SentenceFormatter, or \c nullptr if the talker or the formatter
+     *         are not supported.
+     */
+    static const SentenceFormatter* find_formatter_(
+            std::string_view address) noexcept
+    {
+        using FormatterTable = PerfectHashTable<SentenceFormatter, 9>;
+        static constexpr FormatterTable formatters(std::array<FormatterTable::Item, 9>{{
+            {formatter_code_("GGA"), {NMEA0183DataKind::GPGGA, decode_gpgga_}},
+            {formatter_code_("RMC"), {NMEA0183DataKind::RMC, decode_rmc_}},
+            {formatter_code_("GSV"), {NMEA0183DataKind::GSV, decode_gsv_}},
+            {formatter_code_("GSA"), {NMEA0183DataKind::GSA, decode_gsa_}},
+            {formatter_code_("ZDA"), {NMEA0183DataKind::ZDA, decode_zda_}},
+            {formatter_code_("HDT"), {NMEA0183DataKind::HDT, decode_hdt_}},
+            {formatter_code_("THS"), {NMEA0183DataKind::THS, decode_ths_}},
+            {formatter_code_("ROT"), {NMEA0183DataKind::ROT, decode_rot_}},
+            {formatter_code_("GST"), {NMEA0183DataKind::GST, decode_gst_}}
+        }});
+        using EncapsulationTable = PerfectHashTable<SentenceFormatter, 2>;
+        static constexpr EncapsulationTable encapsulations(std::array<EncapsulationTable::Item, 2>{{
+            {formatter_code_("VDM"), {NMEA0183DataKind::AIS, decode_vdm_}},
+            {formatter_code_("VDO"), {NMEA0183DataKind::AIS, decode_vdm_}}
+        }});
+
+        if (address.size() != 6)
         {
-            check ^= character;
+            return nullptr;
         }
-
-        /* Validate input checksum */
-        return check == checksum;
+        if (address[0] == '$' && talker_(address[1], address[2]) != NMEA0183Talker::UNKNOWN)
+        {
+            return formatters.find(formatter_code_(address.data() + 3));
+        }
+        if (address[0] == '!' && ais_talker_(address[1], address[2]) != NMEA0183Talker::UNKNOWN)
+        {
+            return encapsulations.find(formatter_code_(address.data() + 3));
+        }
+        return nullptr;
     }
 
     /**
-     * \brief Return the NMEA 0183 sentence kind of a sentence using the sentence identifier.
+     * \brief Find the decoder of a sentence using its address field.
+     *
+     * The decoders of the library are looked up first, so the registered decoders are only
+     * consulted for the sentences which the library does not support.
      *
-     * @param sentence The sentence from which the kind is returned.
-     * @return A \c NMEA0183DataKind representing the sentence kind.
+     * @param address The address field of the sentence, including the '$' or the '!'.
+     * @param registered_address The address under which the sentence is looked up in \c registry.
+     *        It is \c address without the checksum of the sentences which do not have any field.
+     * @param registry The decoders of the sentences not supported by the library, or \c nullptr.
+     * @return The decoder of the sentence, or \c nullptr if there is none.
      */
-    static NMEA0183DataKind data_kind_(
-            const std::string& sentence) noexcept
+    static SentenceRegistry::Decoder find_decoder_(
+            std::string_view address,
+            std::string_view registered_address,
+            const SentenceRegistry* registry) noexcept
     {
-        std::string sentence_id;
-        std::stringstream sentence_ss(sentence);
-        std::getline(sentence_ss, sentence_id, ',');
-        if (sentence_id == nmea0183::GPGGA_ID)
+        const SentenceFormatter* formatter = find_formatter_(address);
+        if (formatter != nullptr)
         {
-            return NMEA0183DataKind::GPGGA;
+            return formatter->decoder;
         }
-        std::cout << "[WARNING] Sentence identifier '" << sentence_id << "' is NOT supported" << std::endl;
-        return NMEA0183DataKind::INVALID;
+        if (registry != nullptr)
+        {
+            std::size_t position = registry->find(registered_address);
+            if (position != SentenceRegistry::NOT_FOUND)
+            {
+                return registry->decoder(position);
+            }
+        }
+        return nullptr;
     }
 
     /**
      * \brief Translate a NMEA 0183 GPGGA sentence into a \c GPGGAData object
      *
-     * @param sentence The sentence to be decoded.
-     * @return A \c std::shared_ptr<GPGGAData> containing the GPGGA data. If for any reason the
-     *         sentence is not a valid GPGGA, then the \c kind field of the returned \c GPGGAData
-     *         is set to \c NMEA0183DataKind::INVALID. The function transfers the shared pointer
-     *         ownership to the caller, thus the returned pointer is the only reference to the data
-     *         object.
+     * @param gpgga_sentence The sentence to be decoded.
+     * @return A \c DecodeResult holding the \c GPGGAData. If for any reason the sentence is not a
+     *         valid GPGGA, then the result does not hold any data and its error is
+     *         \c DecodeError::INVALID_FIELDS.
      */
-    static std::shared_ptr<GPGGAData> decode_gpgga_(
-            const std::string& gpgga_sentence) noexcept
+    static DecodeResult decode_gpgga_(
+            std::string_view gpgga_sentence) noexcept
     {
-        std::shared_ptr<GPGGAData> data = std::make_shared<GPGGAData>();
-
-        /* Check that the sentence is a valid GPGGA sentence */
-        if (!std::regex_match(gpgga_sentence, std::regex(nmea0183::GPGGA_REGEX)))
+        /* Validate and translate the sentence in a single pass */
+        GPGGAData gpgga;
+        if (!scan_gpgga_(gpgga_sentence.data(), gpgga_sentence.data() + gpgga_sentence.size(), gpgga))
         {
-            std::cout << "[WARNING] Sentence '" << gpgga_sentence << "' is NOT a valid GPGGA sentence" << std::endl;
-            data->kind = NMEA0183DataKind::INVALID;
-            return std::move(data);
+            return DecodeResult(DecodeError::INVALID_FIELDS);
         }
+        return DecodeResult(gpgga);
+    }
 
-        /* Separate each of the sentence components */
-        std::vector<std::string> gpgga_data_strs = split_(gpgga_sentence);
+    /**
+     * \brief Validate a GPGGA sentence and translate it into a \c GPGGAData in a single pass.
+     *
+     * The scanner, generated from \c nmea0183::GGA_SCHEMA, accepts exactly the language described by
+     * \c nmea0183::GPGGA_REGEX. Each field is translated as soon as it has been validated, so the
+     * sentence is traversed only once.
+     *
+     * @param[in] it Pointer to the first character of the sentence.
+     * @param[in] end Pointer past the last character of the sentence.
+     * @param[out] data The \c GPGGAData to populate. Its contents are unspecified if the sentence
+     *             is not a valid GPGGA sentence.
+     * @return \c true if the sentence is a valid GPGGA sentence; \c false otherwise.
+     */
+    static bool scan_gpgga_(
+            const char* it,
+            const char* end,
+            GPGGAData& data) noexcept
+    {
+        return nmea0183::GGA_SCHEMA::scan(it, end, data);
+    }
+
+    /**
+     * \brief Translate a NMEA 0183 RMC sentence into a \c RMCData object
+     *
+     * The sentence is validated and translated in a single pass by the scanner generated from
+     * \c nmea0183::RMC_SCHEMA, which accepts exactly the language described by
+     * \c nmea0183::RMC_REGEX.
+     *
+     * @param rmc_sentence The sentence to be decoded.
+     * @return A \c DecodeResult holding the \c RMCData. If for any reason the sentence is not a
+     *         valid RMC, then the result does not hold any data and its error is
+     *         \c DecodeError::INVALID_FIELDS.
+     */
+    static DecodeResult decode_rmc_(
+            std::string_view rmc_sentence) noexcept
+    {
+        RMCData rmc;
+        if (!nmea0183::RMC_SCHEMA::scan(rmc_sentence.data(), rmc_sentence.data() + rmc_sentence.size(), rmc))
+        {
+            return DecodeResult(DecodeError::INVALID_FIELDS);
+        }
+        if (rmc.date != 0 && rmc.time_of_day_ms >= 0)
+        {
+            int32_t year = static_cast<int32_t>(rmc.date % 100);
+            rmc.utc_time = to_utc_time_(year < 80 ? 2000 + year : 1900 + year,
+                            static_cast<int32_t>((rmc.date / 100) % 100), static_cast<int32_t>(rmc.date / 10000),
+                            rmc.time_of_day_ms);
+        }
+        return DecodeResult(rmc);
+    }
 
-        /*
-         * Translate NMEA 0183 data to GPGGAData. At this point, the REGEX has already verified that
-         * the fields have a valid format, so it is safe to avoid further checks here.
-         */
-        data->timestamp = std::stof(gpgga_data_strs[1]);
-        data->latitude = to_degrees_(gpgga_data_strs[2]);
-        data->longitude = to_degrees_(gpgga_data_strs[4]);
-        // Always return latitude bearing North
-        if (gpgga_data_strs[3] != "N")
+    /**
+     * \brief Translate a NMEA 0183 ZDA sentence into a \c ZDAData object
+     *
+     * The sentence is validated and translated in a single pass by the scanner generated from
+     * \c nmea0183::ZDA_SCHEMA, which accepts exactly the language described by
+     * \c nmea0183::ZDA_REGEX. The UTC time point is calculated if the sentence reports the time and
+     * the full date.
+     *
+     * @param zda_sentence The sentence to be decoded.
+     * @return A \c DecodeResult holding the \c ZDAData. If for any reason the sentence is not a
+     *         valid ZDA, then the result does not hold any data and its error is
+     *         \c DecodeError::INVALID_FIELDS.
+     */
+    static DecodeResult decode_zda_(
+            std::string_view zda_sentence) noexcept
+    {
+        ZDAData zda;
+        if (!nmea0183::ZDA_SCHEMA::scan(zda_sentence.data(), zda_sentence.data() + zda_sentence.size(), zda))
         {
-            data->latitude = -data->latitude;
+            return DecodeResult(DecodeError::INVALID_FIELDS);
         }
-        // Always return longitude bearing East
-        if (gpgga_data_strs[5] != "E")
+        if (zda.time_of_day_ms >= 0 && zda.day != 0 && zda.month != 0 && zda.year != 0)
         {
-            data->longitude = -data->longitude;
+            zda.utc_time = to_utc_time_(zda.year, zda.month, zda.day, zda.time_of_day_ms);
         }
-        data->fix = std::stoi(gpgga_data_strs[6]);
-        data->satellites_on_view = std::stoi(gpgga_data_strs[7]);
-        data->horizontal_precision = std::stof(gpgga_data_strs[8]);
-        data->altitude = std::stof(gpgga_data_strs[9]);
-        data->height_of_geoid = std::stof(gpgga_data_strs[11]);
-        // Last DGPS update time is optional and can be present but empty
-        if (gpgga_data_strs.size() >= 15 && gpgga_data_strs[13] != "")
+        return DecodeResult(zda);
+    }
+
+    /**
+     * \brief Translate a NMEA 0183 HDT sentence into a \c HDTData object
+     *
+     * The sentence is validated and translated in a single pass by the scanner generated from
+     * \c nmea0183::HDT_SCHEMA, which accepts exactly the language described by
+     * \c nmea0183::HDT_REGEX.
+     *
+     * @param hdt_sentence The sentence to be decoded.
+     * @return A \c DecodeResult holding the \c HDTData. If for any reason the sentence is not a
+     *         valid HDT, then the result does not hold any data and its error is
+     *         \c DecodeError::INVALID_FIELDS.
+     */
+    static DecodeResult decode_hdt_(
+            std::string_view hdt_sentence) noexcept
+    {
+        HDTData hdt;
+        if (!nmea0183::HDT_SCHEMA::scan(hdt_sentence.data(), hdt_sentence.data() + hdt_sentence.size(), hdt))
         {
-            data->dgps_last_update = std::stof(gpgga_data_strs[13]);
+            return DecodeResult(DecodeError::INVALID_FIELDS);
         }
-        // DGPS reference station ID is optional
-        if (gpgga_data_strs.size() == 16)
+        return DecodeResult(hdt);
+    }
+
+    /**
+     * \brief Translate a NMEA 0183 THS sentence into a \c THSData object
+     *
+     * The sentence is validated and translated in a single pass by the scanner generated from
+     * \c nmea0183::THS_SCHEMA, which accepts exactly the language described by
+     * \c nmea0183::THS_REGEX.
+     *
+     * @param ths_sentence The sentence to be decoded.
+     * @return A \c DecodeResult holding the \c THSData. If for any reason the sentence is not a
+     *         valid THS, then the result does not hold any data and its error is
+     *         \c DecodeError::INVALID_FIELDS.
+     */
+    static DecodeResult decode_ths_(
+            std::string_view ths_sentence) noexcept
+    {
+        THSData ths;
+        if (!nmea0183::THS_SCHEMA::scan(ths_sentence.data(), ths_sentence.data() + ths_sentence.size(), ths))
         {
-            data->dgps_reference_station_id = std::stoi(gpgga_data_strs[14]);
+            return DecodeResult(DecodeError::INVALID_FIELDS);
         }
+        return DecodeResult(ths);
+    }
 
-        /* Return the data transfering the ownership */
-        return std::move(data);
+    /**
+     * \brief Translate a NMEA 0183 ROT sentence into a \c ROTData object
+     *
+     * The sentence is validated and translated in a single pass by the scanner generated from
+     * \c nmea0183::ROT_SCHEMA, which accepts exactly the language described by
+     * \c nmea0183::ROT_REGEX.
+     *
+     * @param rot_sentence The sentence to be decoded.
+     * @return A \c DecodeResult holding the \c ROTData. If for any reason the sentence is not a
+     *         valid ROT, then the result does not hold any data and its error is
+     *         \c DecodeError::INVALID_FIELDS.
+     */
+    static DecodeResult decode_rot_(
+            std::string_view rot_sentence) noexcept
+    {
+        ROTData rot;
+        if (!nmea0183::ROT_SCHEMA::scan(rot_sentence.data(), rot_sentence.data() + rot_sentence.size(), rot))
+        {
+            return DecodeResult(DecodeError::INVALID_FIELDS);
+        }
+        return DecodeResult(rot);
     }
 
     /**
-     * \brief Split a string in substrings according to a separator.
+     * \brief Translate a NMEA 0183 GST sentence into a \c GSTData object
+     *
+     * The sentence is validated and translated in a single pass by the scanner generated from
+     * \c nmea0183::GST_SCHEMA, which accepts exactly the language described by
+     * \c nmea0183::GST_REGEX.
      *
-     * @param sentence The string to be split.
-     * @param separator The character used to split the sentence [Defaults: ','].
-     * @return A \c std::vector<std::string> containing the substring (the separator characters are
-     *         not included in the substrings).
+     * @param gst_sentence The sentence to be decoded.
+     * @return A \c DecodeResult holding the \c GSTData. If for any reason the sentence is not a
+     *         valid GST, then the result does not hold any data and its error is
+     *         \c DecodeError::INVALID_FIELDS.
      */
-    static std::vector<std::string> split_(
-            const std::string& sentence,
-            char separator = ',') noexcept
+    static DecodeResult decode_gst_(
+            std::string_view gst_sentence) noexcept
     {
-        std::string result = "";
-        std::stringstream ss(sentence);
-        std::vector<std::string> content;
+        GSTData gst;
+        if (!nmea0183::GST_SCHEMA::scan(gst_sentence.data(), gst_sentence.data() + gst_sentence.size(), gst))
+        {
+            return DecodeResult(DecodeError::INVALID_FIELDS);
+        }
+        return DecodeResult(gst);
+    }
 
-        while (ss.good())
+    /**
+     * \brief Translate a NMEA 0183 GSV sentence into a \c GSVPart object
+     *
+     * The sentence is validated and translated in a single pass by the scanner generated from
+     * \c nmea0183::GSV_SCHEMA, which accepts exactly the language described by
+     * \c nmea0183::GSV_REGEX. The part is reassembled with the rest of its group by a
+     * \c GSVAssembler.
+     *
+     * @param gsv_sentence The sentence to be decoded.
+     * @return A \c DecodeResult holding the \c GSVPart. If for any reason the sentence is not a
+     *         valid GSV, then the result does not hold any data and its error is
+     *         \c DecodeError::INVALID_FIELDS.
+     */
+    static DecodeResult decode_gsv_(
+            std::string_view gsv_sentence) noexcept
+    {
+        GSVPart gsv;
+        if (!nmea0183::GSV_SCHEMA::scan(gsv_sentence.data(), gsv_sentence.data() + gsv_sentence.size(), gsv))
         {
-            std::getline(ss, result, separator);
-            content.push_back(result);
+            return DecodeResult(DecodeError::INVALID_FIELDS);
         }
+        return DecodeResult(gsv);
+    }
 
-        return content;
+    /**
+     * \brief Translate a NMEA 0183 GSA sentence into a \c GSAPart object
+     *
+     * The sentence is validated and translated in a single pass by the scanner generated from
+     * \c nmea0183::GSA_SCHEMA, which accepts exactly the language described by
+     * \c nmea0183::GSA_REGEX. The part is merged with the rest of its epoch by a \c GSAMerger.
+     *
+     * @param gsa_sentence The sentence to be decoded.
+     * @return A \c DecodeResult holding the \c GSAPart. If for any reason the sentence is not a
+     *         valid GSA, then the result does not hold any data and its error is
+     *         \c DecodeError::INVALID_FIELDS.
+     */
+    static DecodeResult decode_gsa_(
+            std::string_view gsa_sentence) noexcept
+    {
+        GSAPart gsa;
+        if (!nmea0183::GSA_SCHEMA::scan(gsa_sentence.data(), gsa_sentence.data() + gsa_sentence.size(), gsa))
+        {
+            return DecodeResult(DecodeError::INVALID_FIELDS);
+        }
+        return DecodeResult(gsa);
     }
 
     /**
-     * \brief Translate a NMEA 0183 angle representation into a decimal floating point representing
-     *        degrees.
+     * \brief Translate a NMEA 0183 VDM or VDO sentence into an \c AISFragment object
      *
-     * \pre The expected format of nmea0183_angle is 'D{1,3}MM.[m]+' where:
-     *    1. D corresponds to degrees
-     *    1. MM.[m]+ is a float representing minutes of degree
+     * The sentence is validated and translated in a single pass by \c scan_vdm_(), which accepts
+     * exactly the language described by \c nmea0183::VDM_REGEX. The fragment is reassembled with the
+     * rest of its AIS message by an \c AISAssembler.
      *
-     * @param nmea0183_angle The angle to be translated.
-     * @return A \c float representing the angle in degrees.
+     * @param vdm_sentence The sentence to be decoded.
+     * @return A \c DecodeResult holding the \c AISFragment. If for any reason the sentence is not a
+     *         valid VDM or VDO, then the result does not hold any data and its error is
+     *         \c DecodeError::INVALID_FIELDS.
      */
-    static float to_degrees_(
-            const std::string& nmea0183_angle) noexcept
+    static DecodeResult decode_vdm_(
+            std::string_view vdm_sentence) noexcept
     {
-        /* Break the string into its 'D{1,3}MM' and '[m]+' components */
-        std::vector<std::string> content = split_(nmea0183_angle, '.');
+        AISFragment vdm;
+        if (!scan_vdm_(vdm_sentence.data(), vdm_sentence.data() + vdm_sentence.size(), vdm))
+        {
+            return DecodeResult(DecodeError::INVALID_FIELDS);
+        }
+        return DecodeResult(vdm);
+    }
 
-        /* Build a string 'MM.[m]+' to represent the minutes of degree */
-        std::string minutes = content[0].substr(content[0].size() - 2) + "." + content[1];
+    /**
+     * \brief Validate a VDM or VDO sentence and translate it into an \c AISFragment in a single pass.
+     *
+     * The payload is unarmored as it is validated, so the sentence is traversed only once.
+     *
+     * @param[in] it Pointer to the first character of the sentence.
+     * @param[in] end Pointer past the last character of the sentence.
+     * @param[out] data The \c AISFragment to populate. Its contents are unspecified if the sentence
+     *             is not a valid VDM or VDO sentence.
+     * @return \c true if the sentence is a valid VDM or VDO sentence; \c false otherwise.
+     */
+    static bool scan_vdm_(
+            const char* it,
+            const char* end,
+            AISFragment& data) noexcept
+    {
+        /* Sentence ID from any AIS talker */
+        if (!consume_char_(it, end, '!') || end - it < 2 ||
+                (data.talker = ais_talker_(it[0], it[1])) == NMEA0183Talker::UNKNOWN)
+        {
+            return false;
+        }
+        it += 2;
+        data.own_ship = false;
+        if (!consume_literal_(it, end, "VD") ||
+                !(consume_char_(it, end, 'M') || (data.own_ship = consume_char_(it, end, 'O'))) ||
+                !consume_char_(it, end, ','))
+        {
+            return false;
+        }
 
-        /* Convert the 'MM.[m]+' string into a floating point number in degrees */
-        float minutes_float = std::stof(minutes) / 60;
+        /* Number of fragments and fragment number, both in [1; 9] */
+        if (end - it < 4 || it[0] < '1' || it[0] > '9' || it[1] != ',' || it[2] < '1' || it[2] > '9' || it[3] != ',')
+        {
+            return false;
+        }
+        data.fragment_count = static_cast<uint8_t>(it[0] - '0');
+        data.fragment_number = static_cast<uint8_t>(it[2] - '0');
+        it += 4;
 
-        /* Remove the 'MM' component from 'D{1,3}MM' */
-        content[0].erase(content[0].end() - 2, content[0].end());
+        /* Sequential message ID and AIS channel, both of which may be empty */
+        data.sequence_id = -1;
+        if (it != end && *it >= '0' && *it <= '9')
+        {
+            data.sequence_id = static_cast<int8_t>(*it++ - '0');
+        }
+        if (!consume_char_(it, end, ','))
+        {
+            return false;
+        }
+        data.channel = '\0';
+        if (it != end && (*it == 'A' || *it == 'B' || *it == '1' || *it == '2'))
+        {
+            data.channel = *it++;
+        }
+        if (!consume_char_(it, end, ','))
+        {
+            return false;
+        }
+
+        /* Armored payload */
+        data.sextet_count = 0;
+        while (it != end && data.sextet_count < AISFragment::MAX_SEXTETS)
+        {
+            uint8_t sextet = AISPayload::sextet(*it);
+            if (sextet == AISPayload::INVALID_SEXTET)
+            {
+                break;
+            }
+            data.sextets[data.sextet_count++] = sextet;
+            ++it;
+        }
+        if (data.sextet_count == 0 || !consume_char_(it, end, ','))
+        {
+            return false;
+        }
+
+        /* Number of fill bits */
+        if (it == end || *it < '0' || *it > '5')
+        {
+            return false;
+        }
+        data.fill_bits = static_cast<uint8_t>(*it++ - '0');
 
-        /* Return the degrees as the summation of 'D{1,3}' plus the 'MM.[m]+' translated into degrees */
-        return std::stof(content[0]) + minutes_float;
+        /* Checksum, which must end the sentence */
+        return consume_char_(it, end, '*') &&
+               consume_hex_digit_(it, end) &&
+               consume_hex_digit_(it, end) &&
+               it == end;
     }
 
 };
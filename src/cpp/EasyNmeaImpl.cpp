@@ -46,6 +46,15 @@ EasyNmeaImpl::EasyNmeaImpl() noexcept
 EasyNmeaImpl::~EasyNmeaImpl() noexcept
 {
     gpgga_data_queue_.clear();
+    rmc_data_queue_.clear();
+    gsv_data_queue_.clear();
+    gsa_data_queue_.clear();
+    ais_data_queue_.clear();
+    zda_data_queue_.clear();
+    hdt_data_queue_.clear();
+    ths_data_queue_.clear();
+    rot_data_queue_.clear();
+    gst_data_queue_.clear();
     /**
      *  If close returns something other than OK, it means that the serial interface was already
      * closed. In that case, if the reading thread is still operative, then we need to wait until
@@ -77,6 +86,13 @@ ReturnCode EasyNmeaImpl::open(
         if (serial_interface_->open(serial_port, baudrate))
         {
             // If the serial interface could be opened, then spawn the reading thread
+            gsv_assembler_.clear();
+            gsa_merger_.clear();
+            ais_assembler_.clear();
+            date_anchor_.clear();
+            latest_hdt_.clear();
+            latest_ths_.clear();
+            latest_rot_.clear();
             routine_running_.store(true);
             read_thread_.reset(new std::thread(&EasyNmeaImpl::read_routine_, this));
             internal_error_.store(false);
@@ -126,7 +142,7 @@ ReturnCode EasyNmeaImpl::take_next(
     std::unique_lock<std::mutex> lck(data_mutex_);
     if (!gpgga_data_queue_.empty())
     {
-        gpgga = *gpgga_data_queue_.front();
+        gpgga = gpgga_data_queue_.front();
         gpgga_data_queue_.pop();
         // If the take operation has emptied the queue, then update corresponding bit in data_received_
         if (gpgga_data_queue_.empty())
@@ -138,6 +154,240 @@ ReturnCode EasyNmeaImpl::take_next(
     return ReturnCode::RETURN_CODE_NO_DATA;
 }
 
+ReturnCode EasyNmeaImpl::take_next(
+        RMCData& rmc) noexcept
+{
+    std::unique_lock<std::mutex> lck(data_mutex_);
+    if (!rmc_data_queue_.empty())
+    {
+        rmc = rmc_data_queue_.front();
+        rmc_data_queue_.pop();
+        // If the take operation has emptied the queue, then update corresponding bit in data_received_
+        if (rmc_data_queue_.empty())
+        {
+            data_received_.clear(NMEA0183DataKind::RMC);
+        }
+        return ReturnCode::RETURN_CODE_OK;
+    }
+    return ReturnCode::RETURN_CODE_NO_DATA;
+}
+
+ReturnCode EasyNmeaImpl::take_next(
+        GSVData& gsv) noexcept
+{
+    std::unique_lock<std::mutex> lck(data_mutex_);
+    if (!gsv_data_queue_.empty())
+    {
+        gsv = gsv_data_queue_.front();
+        gsv_data_queue_.pop();
+        // If the take operation has emptied the queue, then update corresponding bit in data_received_
+        if (gsv_data_queue_.empty())
+        {
+            data_received_.clear(NMEA0183DataKind::GSV);
+        }
+        return ReturnCode::RETURN_CODE_OK;
+    }
+    return ReturnCode::RETURN_CODE_NO_DATA;
+}
+
+ReturnCode EasyNmeaImpl::take_next(
+        GSAData& gsa) noexcept
+{
+    std::unique_lock<std::mutex> lck(data_mutex_);
+    if (!gsa_data_queue_.empty())
+    {
+        gsa = gsa_data_queue_.front();
+        gsa_data_queue_.pop();
+        // If the take operation has emptied the queue, then update corresponding bit in data_received_
+        if (gsa_data_queue_.empty())
+        {
+            data_received_.clear(NMEA0183DataKind::GSA);
+        }
+        return ReturnCode::RETURN_CODE_OK;
+    }
+    return ReturnCode::RETURN_CODE_NO_DATA;
+}
+
+ReturnCode EasyNmeaImpl::take_next(
+        AISPositionData& ais) noexcept
+{
+    std::unique_lock<std::mutex> lck(data_mutex_);
+    if (!ais_data_queue_.empty())
+    {
+        ais = ais_data_queue_.front();
+        ais_data_queue_.pop();
+        // If the take operation has emptied the queue, then update corresponding bit in data_received_
+        if (ais_data_queue_.empty())
+        {
+            data_received_.clear(NMEA0183DataKind::AIS);
+        }
+        return ReturnCode::RETURN_CODE_OK;
+    }
+    return ReturnCode::RETURN_CODE_NO_DATA;
+}
+
+ReturnCode EasyNmeaImpl::take_next(
+        ZDAData& zda) noexcept
+{
+    std::unique_lock<std::mutex> lck(data_mutex_);
+    if (!zda_data_queue_.empty())
+    {
+        zda = zda_data_queue_.front();
+        zda_data_queue_.pop();
+        // If the take operation has emptied the queue, then update corresponding bit in data_received_
+        if (zda_data_queue_.empty())
+        {
+            data_received_.clear(NMEA0183DataKind::ZDA);
+        }
+        return ReturnCode::RETURN_CODE_OK;
+    }
+    return ReturnCode::RETURN_CODE_NO_DATA;
+}
+
+ReturnCode EasyNmeaImpl::take_next(
+        HDTData& hdt) noexcept
+{
+    std::unique_lock<std::mutex> lck(data_mutex_);
+    if (!hdt_data_queue_.empty())
+    {
+        hdt = hdt_data_queue_.front();
+        hdt_data_queue_.pop();
+        // If the take operation has emptied the queue, then update corresponding bit in data_received_
+        if (hdt_data_queue_.empty())
+        {
+            data_received_.clear(NMEA0183DataKind::HDT);
+        }
+        return ReturnCode::RETURN_CODE_OK;
+    }
+    return ReturnCode::RETURN_CODE_NO_DATA;
+}
+
+ReturnCode EasyNmeaImpl::take_next(
+        THSData& ths) noexcept
+{
+    std::unique_lock<std::mutex> lck(data_mutex_);
+    if (!ths_data_queue_.empty())
+    {
+        ths = ths_data_queue_.front();
+        ths_data_queue_.pop();
+        // If the take operation has emptied the queue, then update corresponding bit in data_received_
+        if (ths_data_queue_.empty())
+        {
+            data_received_.clear(NMEA0183DataKind::THS);
+        }
+        return ReturnCode::RETURN_CODE_OK;
+    }
+    return ReturnCode::RETURN_CODE_NO_DATA;
+}
+
+ReturnCode EasyNmeaImpl::take_next(
+        ROTData& rot) noexcept
+{
+    std::unique_lock<std::mutex> lck(data_mutex_);
+    if (!rot_data_queue_.empty())
+    {
+        rot = rot_data_queue_.front();
+        rot_data_queue_.pop();
+        // If the take operation has emptied the queue, then update corresponding bit in data_received_
+        if (rot_data_queue_.empty())
+        {
+            data_received_.clear(NMEA0183DataKind::ROT);
+        }
+        return ReturnCode::RETURN_CODE_OK;
+    }
+    return ReturnCode::RETURN_CODE_NO_DATA;
+}
+
+ReturnCode EasyNmeaImpl::take_next(
+        GSTData& gst) noexcept
+{
+    std::unique_lock<std::mutex> lck(data_mutex_);
+    if (!gst_data_queue_.empty())
+    {
+        gst = gst_data_queue_.front();
+        gst_data_queue_.pop();
+        // If the take operation has emptied the queue, then update corresponding bit in data_received_
+        if (gst_data_queue_.empty())
+        {
+            data_received_.clear(NMEA0183DataKind::GST);
+        }
+        return ReturnCode::RETURN_CODE_OK;
+    }
+    return ReturnCode::RETURN_CODE_NO_DATA;
+}
+
+ReturnCode EasyNmeaImpl::read_latest(
+        HDTData& hdt) noexcept
+{
+    return latest_hdt_.load(hdt) ? ReturnCode::RETURN_CODE_OK : ReturnCode::RETURN_CODE_NO_DATA;
+}
+
+ReturnCode EasyNmeaImpl::read_latest(
+        THSData& ths) noexcept
+{
+    return latest_ths_.load(ths) ? ReturnCode::RETURN_CODE_OK : ReturnCode::RETURN_CODE_NO_DATA;
+}
+
+ReturnCode EasyNmeaImpl::read_latest(
+        ROTData& rot) noexcept
+{
+    return latest_rot_.load(rot) ? ReturnCode::RETURN_CODE_OK : ReturnCode::RETURN_CODE_NO_DATA;
+}
+
+ReturnCode EasyNmeaImpl::register_decoder(
+        const std::string& address,
+        EasyNmea::SentenceHandler handler) noexcept
+{
+    std::unique_lock<std::mutex> lck(mutex_);
+    // The reading thread uses the handlers without locking, so they can only be modified while it is not running
+    if (is_open_nts_())
+    {
+        return ReturnCode::RETURN_CODE_ILLEGAL_OPERATION;
+    }
+    if (registry_.size() == SentenceRegistry::CAPACITY)
+    {
+        return ReturnCode::RETURN_CODE_ERROR;
+    }
+    if (!handler || !registry_.add(address, EasyNmeaCoder::passthrough))
+    {
+        return ReturnCode::RETURN_CODE_BAD_PARAMETER;
+    }
+    sentence_handlers_[registry_.size() - 1] = std::move(handler);
+    return ReturnCode::RETURN_CODE_OK;
+}
+
+ReturnCode EasyNmeaImpl::stamp_realtime(
+        bool enable) noexcept
+{
+    std::unique_lock<std::mutex> lck(mutex_);
+    // The reading thread takes the time points without locking, so they can only be modified while it is not running
+    if (is_open_nts_())
+    {
+        return ReturnCode::RETURN_CODE_ILLEGAL_OPERATION;
+    }
+    serial_interface_->stamp_realtime(enable);
+    return ReturnCode::RETURN_CODE_OK;
+}
+
+ReturnCode EasyNmeaImpl::set_read_profile(
+        const ReadProfile& profile) noexcept
+{
+    std::unique_lock<std::mutex> lck(mutex_);
+    if (is_open_nts_())
+    {
+        return ReturnCode::RETURN_CODE_ILLEGAL_OPERATION;
+    }
+    if (profile.vmin == 0)
+    {
+        return ReturnCode::RETURN_CODE_BAD_PARAMETER;
+    }
+    if (!serial_interface_->set_read_profile(profile))
+    {
+        return ReturnCode::RETURN_CODE_UNSUPPORTED;
+    }
+    return ReturnCode::RETURN_CODE_OK;
+}
+
 ReturnCode EasyNmeaImpl::wait_for_data(
         NMEA0183DataKindMask data_mask,
         std::chrono::milliseconds timeout) noexcept
@@ -158,8 +408,7 @@ ReturnCode EasyNmeaImpl::wait_for_data(
     std::unique_lock<std::mutex> lck(data_mutex_);
     bool did_timeout = !cv_.wait_for(lck, timeout, [&]()
                     {
-                        return !routine_running_.load() ||
-                        (data_mask.is_set(NMEA0183DataKind::GPGGA) && data_received_.is_set(NMEA0183DataKind::GPGGA));
+                        return !routine_running_.load() || !(data_mask & data_received_).is_none();
                     });
 
     // If the wait timed out, return TIMEOUT
@@ -180,21 +429,135 @@ ReturnCode EasyNmeaImpl::wait_for_data(
 }
 
 bool EasyNmeaImpl::process_line_(
-        const std::string& line) noexcept
+        const std::string& line,
+        const ReceiveTime& receive_time) noexcept
 {
-    std::shared_ptr<NMEA0183Data> data = EasyNmeaCoder::decode(line);
-    switch (data->kind)
+    DecodeResult result = EasyNmeaCoder::decode(line, registry_);
+    result.set_receive_time(receive_time);
+
+    // Any line other than a GSA sentence ends the GSA sentences of an epoch
+    GSAData gsa;
+    if (result.kind() != NMEA0183DataKind::GSA && gsa_merger_.flush(gsa))
+    {
+        push_gsa_(gsa);
+    }
+
+    switch (result.kind())
     {
         case NMEA0183DataKind::GPGGA:
         {
+            // GGA sentences do not report the date, so they are dated with the latest one reported
+            GPGGAData gpgga = *result.get<GPGGAData>();
+            date_anchor_.stamp(gpgga.time_of_day_ms, gpgga.utc_time);
             {
                 std::unique_lock<std::mutex> lck(data_mutex_);
-                gpgga_data_queue_.push(std::static_pointer_cast<GPGGAData>(data));
+                gpgga_data_queue_.push(gpgga);
                 data_received_.set(NMEA0183DataKind::GPGGA);
             }
             cv_.notify_all();
             return true;
         }
+        case NMEA0183DataKind::RMC:
+        {
+            // RMC sentences with a date anchor it, and the rest are dated with the latest one reported
+            RMCData rmc = *result.get<RMCData>();
+            date_anchor_.stamp(rmc.time_of_day_ms, rmc.utc_time);
+            {
+                std::unique_lock<std::mutex> lck(data_mutex_);
+                rmc_data_queue_.push(rmc);
+                data_received_.set(NMEA0183DataKind::RMC);
+            }
+            cv_.notify_all();
+            return true;
+        }
+        case NMEA0183DataKind::ZDA:
+        {
+            ZDAData zda = *result.get<ZDAData>();
+            date_anchor_.stamp(zda.time_of_day_ms, zda.utc_time);
+            {
+                std::unique_lock<std::mutex> lck(data_mutex_);
+                zda_data_queue_.push(zda);
+                data_received_.set(NMEA0183DataKind::ZDA);
+            }
+            cv_.notify_all();
+            return true;
+        }
+        case NMEA0183DataKind::HDT:
+        {
+            push_latest_(hdt_data_queue_, latest_hdt_, *result.get<HDTData>());
+            return true;
+        }
+        case NMEA0183DataKind::THS:
+        {
+            push_latest_(ths_data_queue_, latest_ths_, *result.get<THSData>());
+            return true;
+        }
+        case NMEA0183DataKind::ROT:
+        {
+            push_latest_(rot_data_queue_, latest_rot_, *result.get<ROTData>());
+            return true;
+        }
+        case NMEA0183DataKind::GST:
+        {
+            // GST sentences do not report the date, so they are dated as the GGA sentences of their epoch
+            GSTData gst = *result.get<GSTData>();
+            date_anchor_.stamp(gst.time_of_day_ms, gst.utc_time);
+            {
+                std::unique_lock<std::mutex> lck(data_mutex_);
+                gst_data_queue_.push(gst);
+                data_received_.set(NMEA0183DataKind::GST);
+            }
+            cv_.notify_all();
+            return true;
+        }
+        case NMEA0183DataKind::GSV:
+        {
+            // The table is only published once the last part of its group has been added
+            const GSVData* gsv = gsv_assembler_.add(*result.get<GSVPart>());
+            if (gsv != nullptr)
+            {
+                {
+                    std::unique_lock<std::mutex> lck(data_mutex_);
+                    gsv_data_queue_.push(*gsv);
+                    data_received_.set(NMEA0183DataKind::GSV);
+                }
+                cv_.notify_all();
+            }
+            return true;
+        }
+        case NMEA0183DataKind::GSA:
+        {
+            // A GSA sentence which does not belong to the epoch in progress completes it
+            if (gsa_merger_.add(*result.get<GSAPart>(), gsa))
+            {
+                push_gsa_(gsa);
+            }
+            return true;
+        }
+        case NMEA0183DataKind::AIS:
+        {
+            // Only the position reports are published, once the last fragment of their message is added
+            const AISMessage* message = ais_assembler_.add(*result.get<AISFragment>());
+            AISPositionData ais;
+            if (message != nullptr && AISPayload::decode_position(*message, ais))
+            {
+                {
+                    std::unique_lock<std::mutex> lck(data_mutex_);
+                    ais_data_queue_.push(ais);
+                    data_received_.set(NMEA0183DataKind::AIS);
+                }
+                cv_.notify_all();
+            }
+            return true;
+        }
+        case NMEA0183DataKind::RAW:
+        {
+            // The sentence refers to the line, so it is handed over before the next line is read
+            const RawSentence* raw = result.get<RawSentence>();
+            std::size_t position = registry_.find(raw->sentence.substr(0, raw->sentence.find_first_of(",*")));
+            sentence_handlers_[position](*raw);
+            return true;
+        }
         default:
         {
             return false;
@@ -202,18 +565,43 @@ bool EasyNmeaImpl::process_line_(
     }
 }
 
+void EasyNmeaImpl::push_gsa_(
+        const GSAData& gsa) noexcept
+{
+    {
+        std::unique_lock<std::mutex> lck(data_mutex_);
+        gsa_data_queue_.push(gsa);
+        data_received_.set(NMEA0183DataKind::GSA);
+    }
+    cv_.notify_all();
+}
+
+template<class T, int N>
+void EasyNmeaImpl::push_latest_(
+        FixedSizeQueue<T, N>& queue,
+        LatestSample<T>& latest,
+        const T& sample) noexcept
+{
+    // The readers of the latest sample do not wait for the data mutex, so they get it right away
+    latest.store(sample);
+    {
+        std::unique_lock<std::mutex> lck(data_mutex_);
+        queue.push(sample);
+        data_received_.set(sample.kind);
+    }
+    cv_.notify_all();
+}
+
 void EasyNmeaImpl::read_routine_() noexcept
 {
-    // Execute until the flag says otherwise
-    while (routine_running_)
+    // The lines are processed as they are received, until the flag says otherwise or the port fails
+    bool stopped = serial_interface_->read_lines([this](const std::string& line)
+                    {
+                        process_line_(line, serial_interface_->line_time());
+                        return routine_running_.load();
+                    });
+    if (!stopped)
     {
-        std::string line;
-        // Wait for a new line coming from the device
-        if (serial_interface_->read_line(line))
-        {
-            process_line_(line);
-            continue;
-        }
         routine_running_.store(false);
         internal_error_.store(true);
         cv_.notify_all();
@@ -25,6 +25,7 @@
 #ifndef _EASYNMEA_IMPL_HPP_
 #define _EASYNMEA_IMPL_HPP_
 
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
@@ -41,7 +42,13 @@
 #include <easynmea/EasyNmea.hpp>
 #include <easynmea/types.hpp>
 
+#include "AISAssembler.hpp"
+#include "DateAnchor.hpp"
 #include "FixedSizeQueue.hpp"
+#include "GSAMerger.hpp"
+#include "GSVAssembler.hpp"
+#include "LatestSample.hpp"
+#include "SentenceRegistry.hpp"
 #include "SerialInterface.hpp"
 
 using namespace std::chrono_literals;
@@ -120,6 +127,254 @@ public:
     virtual ReturnCode take_next(
             GPGGAData& gpgga) noexcept;
 
+    /**
+     * \brief Take the next untaken RMC data sample available
+     *
+     * \c EasyNmeaImpl stores up to the last 10 reported RMC data samples. \c take_next() is used
+     * to retrieve the oldest untaken RMC sample. If eventually \c take_next takes the last RMC
+     * sample received, then the corresponding bit of \c data_received_ is cleared.
+     *
+     * @param[out] rmc A \c RMCData instance which will be populated with the sample.
+     *
+     * @return \c take_next() can return:
+     *     * ReturnCode::RETURN_CODE_OK if the operation succeeded.
+     *     * ReturnCode::RETURN_CODE_NO_DATA if there are not any untaken \c RMCData samples.
+     */
+    virtual ReturnCode take_next(
+            RMCData& rmc) noexcept;
+
+    /**
+     * \brief Take the next untaken GSV satellite table available
+     *
+     * \c EasyNmeaImpl stores up to the last 10 assembled GSV tables. \c take_next() is used to
+     * retrieve the oldest untaken table. If eventually \c take_next takes the last GSV table
+     * assembled, then the corresponding bit of \c data_received_ is cleared.
+     *
+     * @param[out] gsv A \c GSVData instance which will be populated with the table.
+     *
+     * @return \c take_next() can return:
+     *     * ReturnCode::RETURN_CODE_OK if the operation succeeded.
+     *     * ReturnCode::RETURN_CODE_NO_DATA if there are not any untaken \c GSVData tables.
+     */
+    virtual ReturnCode take_next(
+            GSVData& gsv) noexcept;
+
+    /**
+     * \brief Take the next untaken GSA data sample available
+     *
+     * \c EasyNmeaImpl stores up to the last 10 merged GSA samples. \c take_next() is used to
+     * retrieve the oldest untaken sample. If eventually \c take_next takes the last GSA sample
+     * merged, then the corresponding bit of \c data_received_ is cleared.
+     *
+     * @param[out] gsa A \c GSAData instance which will be populated with the sample.
+     *
+     * @return \c take_next() can return:
+     *     * ReturnCode::RETURN_CODE_OK if the operation succeeded.
+     *     * ReturnCode::RETURN_CODE_NO_DATA if there are not any untaken \c GSAData samples.
+     */
+    virtual ReturnCode take_next(
+            GSAData& gsa) noexcept;
+
+    /**
+     * \brief Take the next untaken AIS position report available
+     *
+     * \c EasyNmeaImpl stores up to the last 10 decoded AIS position reports. \c take_next() is used
+     * to retrieve the oldest untaken report. If eventually \c take_next takes the last AIS report
+     * decoded, then the corresponding bit of \c data_received_ is cleared.
+     *
+     * @param[out] ais A \c AISPositionData instance which will be populated with the report.
+     *
+     * @return \c take_next() can return:
+     *     * ReturnCode::RETURN_CODE_OK if the operation succeeded.
+     *     * ReturnCode::RETURN_CODE_NO_DATA if there are not any untaken \c AISPositionData reports.
+     */
+    virtual ReturnCode take_next(
+            AISPositionData& ais) noexcept;
+
+    /**
+     * \brief Take the next untaken ZDA data sample available
+     *
+     * \c EasyNmeaImpl stores up to the last 10 reported ZDA data samples. \c take_next() is used
+     * to retrieve the oldest untaken ZDA sample. If eventually \c take_next takes the last ZDA
+     * sample received, then the corresponding bit of \c data_received_ is cleared.
+     *
+     * @param[out] zda A \c ZDAData instance which will be populated with the sample.
+     *
+     * @return \c take_next() can return:
+     *     * ReturnCode::RETURN_CODE_OK if the operation succeeded.
+     *     * ReturnCode::RETURN_CODE_NO_DATA if there are not any untaken \c ZDAData samples.
+     */
+    virtual ReturnCode take_next(
+            ZDAData& zda) noexcept;
+
+    /**
+     * \brief Take the next untaken HDT data sample available
+     *
+     * \c EasyNmeaImpl stores up to the last 10 reported HDT data samples. \c take_next() is used
+     * to retrieve the oldest untaken HDT sample. If eventually \c take_next takes the last HDT
+     * sample received, then the corresponding bit of \c data_received_ is cleared.
+     *
+     * @param[out] hdt A \c HDTData instance which will be populated with the sample.
+     *
+     * @return \c take_next() can return:
+     *     * ReturnCode::RETURN_CODE_OK if the operation succeeded.
+     *     * ReturnCode::RETURN_CODE_NO_DATA if there are not any untaken \c HDTData samples.
+     */
+    virtual ReturnCode take_next(
+            HDTData& hdt) noexcept;
+
+    /**
+     * \brief Take the next untaken THS data sample available
+     *
+     * \c EasyNmeaImpl stores up to the last 10 reported THS data samples. \c take_next() is used
+     * to retrieve the oldest untaken THS sample. If eventually \c take_next takes the last THS
+     * sample received, then the corresponding bit of \c data_received_ is cleared.
+     *
+     * @param[out] ths A \c THSData instance which will be populated with the sample.
+     *
+     * @return \c take_next() can return:
+     *     * ReturnCode::RETURN_CODE_OK if the operation succeeded.
+     *     * ReturnCode::RETURN_CODE_NO_DATA if there are not any untaken \c THSData samples.
+     */
+    virtual ReturnCode take_next(
+            THSData& ths) noexcept;
+
+    /**
+     * \brief Take the next untaken ROT data sample available
+     *
+     * \c EasyNmeaImpl stores up to the last 10 reported ROT data samples. \c take_next() is used
+     * to retrieve the oldest untaken ROT sample. If eventually \c take_next takes the last ROT
+     * sample received, then the corresponding bit of \c data_received_ is cleared.
+     *
+     * @param[out] rot A \c ROTData instance which will be populated with the sample.
+     *
+     * @return \c take_next() can return:
+     *     * ReturnCode::RETURN_CODE_OK if the operation succeeded.
+     *     * ReturnCode::RETURN_CODE_NO_DATA if there are not any untaken \c ROTData samples.
+     */
+    virtual ReturnCode take_next(
+            ROTData& rot) noexcept;
+
+    /**
+     * \brief Take the next untaken GST data sample available
+     *
+     * \c EasyNmeaImpl stores up to the last 10 reported GST data samples. \c take_next() is used
+     * to retrieve the oldest untaken GST sample. If eventually \c take_next takes the last GST
+     * sample received, then the corresponding bit of \c data_received_ is cleared.
+     *
+     * @param[out] gst A \c GSTData instance which will be populated with the sample.
+     *
+     * @return \c take_next() can return:
+     *     * ReturnCode::RETURN_CODE_OK if the operation succeeded.
+     *     * ReturnCode::RETURN_CODE_NO_DATA if there are not any untaken \c GSTData samples.
+     */
+    virtual ReturnCode take_next(
+            GSTData& gst) noexcept;
+
+    /**
+     * \brief Read the latest HDT data sample received
+     *
+     * The sample is read from \c latest_hdt_ without taking any lock, so it never waits for the
+     * reading thread nor delays it. The sample is not taken, so it can be read any number of times,
+     * and it does not affect the queue from which \c take_next() takes the samples.
+     *
+     * @param[out] hdt A \c HDTData instance which will be populated with the sample.
+     *
+     * @return \c read_latest() can return:
+     *     * ReturnCode::RETURN_CODE_OK if the operation succeeded.
+     *     * ReturnCode::RETURN_CODE_NO_DATA if no \c HDTData sample has been received since the
+     *       connection was opened.
+     */
+    virtual ReturnCode read_latest(
+            HDTData& hdt) noexcept;
+
+    /**
+     * \brief Read the latest THS data sample received
+     *
+     * The sample is read from \c latest_ths_ without taking any lock, so it never waits for the
+     * reading thread nor delays it. The sample is not taken, so it can be read any number of times,
+     * and it does not affect the queue from which \c take_next() takes the samples.
+     *
+     * @param[out] ths A \c THSData instance which will be populated with the sample.
+     *
+     * @return \c read_latest() can return:
+     *     * ReturnCode::RETURN_CODE_OK if the operation succeeded.
+     *     * ReturnCode::RETURN_CODE_NO_DATA if no \c THSData sample has been received since the
+     *       connection was opened.
+     */
+    virtual ReturnCode read_latest(
+            THSData& ths) noexcept;
+
+    /**
+     * \brief Read the latest ROT data sample received
+     *
+     * The sample is read from \c latest_rot_ without taking any lock, so it never waits for the
+     * reading thread nor delays it. The sample is not taken, so it can be read any number of times,
+     * and it does not affect the queue from which \c take_next() takes the samples.
+     *
+     * @param[out] rot A \c ROTData instance which will be populated with the sample.
+     *
+     * @return \c read_latest() can return:
+     *     * ReturnCode::RETURN_CODE_OK if the operation succeeded.
+     *     * ReturnCode::RETURN_CODE_NO_DATA if no \c ROTData sample has been received since the
+     *       connection was opened.
+     */
+    virtual ReturnCode read_latest(
+            ROTData& rot) noexcept;
+
+    /**
+     * \brief Register a handler for the sentences of an address which the library does not decode.
+     *
+     * The address is registered in \c registry_ with \c EasyNmeaCoder::passthrough() as its decoder,
+     * and the handler is stored in the same position of \c sentence_handlers_. Both are only
+     * modified while the connection is closed, so the reading thread can use them without locking.
+     *
+     * @param[in] address The address of the sentences, without the '$' or the '!'. An empty address
+     *            registers a handler for every unsupported sentence which has no handler of its own.
+     * @param[in] handler The handler of the sentences.
+     * @return \c register_decoder() can return:
+     *     * ReturnCode::RETURN_CODE_OK if the handler was registered.
+     *     * ReturnCode::RETURN_CODE_BAD_PARAMETER if the address is not valid, it already has a
+     *       handler, or \c handler is empty.
+     *     * ReturnCode::RETURN_CODE_ERROR if \c SentenceRegistry::CAPACITY handlers have already
+     *       been registered.
+     *     * ReturnCode::RETURN_CODE_ILLEGAL_OPERATION if the serial connection is open.
+     */
+    virtual ReturnCode register_decoder(
+            const std::string& address,
+            EasyNmea::SentenceHandler handler) noexcept;
+
+    /**
+     * \brief Enable taking the realtime time point of the samples, besides the monotonic one.
+     *
+     * The setting is handed to \c serial_interface_, which takes the time points as it reads the
+     * port. It is only modified while the connection is closed, so the reading thread can use it
+     * without locking.
+     *
+     * @param[in] enable Whether to fill \c ReceiveTime::realtime in the \c receive_time of the
+     *            samples.
+     * @return \c stamp_realtime() can return:
+     *     * ReturnCode::RETURN_CODE_OK if the setting was applied.
+     *     * ReturnCode::RETURN_CODE_ILLEGAL_OPERATION if the serial connection is open.
+     */
+    virtual ReturnCode stamp_realtime(
+            bool enable) noexcept;
+
+    /**
+     * \brief Set when the serial port wakes the reading thread up to take the received bytes.
+     *
+     * The profile is handed to \c serial_interface_, which applies it when the port is opened.
+     *
+     * @param[in] profile The new profile.
+     * @return \c set_read_profile() can return:
+     *     * ReturnCode::RETURN_CODE_OK if the profile was set.
+     *     * ReturnCode::RETURN_CODE_BAD_PARAMETER if the \c vmin of the profile is 0.
+     *     * ReturnCode::RETURN_CODE_UNSUPPORTED if the serial port does not support read profiles.
+     *     * ReturnCode::RETURN_CODE_ILLEGAL_OPERATION if the serial connection is open.
+     */
+    virtual ReturnCode set_read_profile(
+            const ReadProfile& profile) noexcept;
+
     /**
      * \brief Block the calling thread until there is data available.
      *
@@ -169,34 +424,140 @@ protected:
     std::mutex data_mutex_;
 
     /**
-     * Condition variable associated with GPGGA data.
+     * Condition variable associated with the received data.
      *
-     * It is used on \c wait_for_data(), and it's signalled when a new GPGGA sample is received.
+     * It is used on \c wait_for_data(), and it's signalled when a new sample of any kind is received.
      */
     std::condition_variable cv_;
 
     //! Collection of the at most last ten GPGGA samples received from the device
-    FixedSizeQueue<std::shared_ptr<GPGGAData>, 10> gpgga_data_queue_;
+    FixedSizeQueue<GPGGAData, 10> gpgga_data_queue_;
+
+    //! Collection of the at most last ten RMC samples received from the device
+    FixedSizeQueue<RMCData, 10> rmc_data_queue_;
+
+    //! Collection of the at most last ten GSV tables assembled from the device sentences
+    FixedSizeQueue<GSVData, 10> gsv_data_queue_;
+
+    /**
+     * Reassembles the GSV sentences into tables. It is only used from \c read_routine_(), so it
+     * is not protected by any mutex.
+     */
+    GSVAssembler gsv_assembler_;
+
+    //! Collection of the at most last ten GSA samples merged from the device sentences
+    FixedSizeQueue<GSAData, 10> gsa_data_queue_;
+
+    /**
+     * Merges the GSA sentences of each epoch. It is only used from \c read_routine_(), so it is not
+     * protected by any mutex.
+     */
+    GSAMerger gsa_merger_;
+
+    //! Collection of the at most last ten AIS position reports decoded from the device sentences
+    FixedSizeQueue<AISPositionData, 10> ais_data_queue_;
+
+    /**
+     * Reassembles the VDM and VDO sentences into AIS messages. It is only used from
+     * \c read_routine_(), so it is not protected by any mutex.
+     */
+    AISAssembler ais_assembler_;
+
+    //! Collection of the at most last ten ZDA samples received from the device
+    FixedSizeQueue<ZDAData, 10> zda_data_queue_;
+
+    /**
+     * Dates the GGA, RMC, and GST samples with the date of the latest ZDA or RMC sentence. It is only
+     * used from \c read_routine_(), so it is not protected by any mutex.
+     */
+    DateAnchor date_anchor_;
+
+    //! Collection of the at most last ten HDT samples received from the device
+    FixedSizeQueue<HDTData, 10> hdt_data_queue_;
+
+    //! Latest HDT sample received from the device, which is read without locking \c data_mutex_
+    LatestSample<HDTData> latest_hdt_;
+
+    //! Collection of the at most last ten THS samples received from the device
+    FixedSizeQueue<THSData, 10> ths_data_queue_;
+
+    //! Latest THS sample received from the device, which is read without locking \c data_mutex_
+    LatestSample<THSData> latest_ths_;
+
+    //! Collection of the at most last ten ROT samples received from the device
+    FixedSizeQueue<ROTData, 10> rot_data_queue_;
+
+    //! Latest ROT sample received from the device, which is read without locking \c data_mutex_
+    LatestSample<ROTData> latest_rot_;
+
+    //! Collection of the at most last ten GST samples received from the device
+    FixedSizeQueue<GSTData, 10> gst_data_queue_;
+
+    //! Addresses of the unsupported sentences which are handed to \c sentence_handlers_
+    SentenceRegistry registry_;
+
+    //! Handlers of the unsupported sentences, in the same positions as their address in \c registry_
+    std::array<EasyNmea::SentenceHandler, SentenceRegistry::CAPACITY> sentence_handlers_;
 
     /**
      * Process a NMEA 1082 sentence
      *
-     * Currently, the only supported sentences are those of type GPGGA. This function is the entry
-     * point of new lines read in the \c read_routine_(). It parses the line, adds the new gpgga
-     * data to the vector, sets the \c new_position_ flag, and signals the condition variable.
+     * Currently, the supported sentences are those of type GPGGA, RMC, GSV, GSA, ZDA, HDT, THS,
+     * ROT, GST, VDM, and VDO. This function is the entry point of new lines read in the
+     * \c read_routine_(). It parses the line, adds the new data to the queue of its kind, sets the
+     * corresponding bit of \c data_received_, and signals the condition variable. GSV sentences are
+     * added to \c gsv_assembler_ instead, and their table is only queued once the last sentence of
+     * its group is processed. Likewise, GSA sentences are added to \c gsa_merger_, and their sample
+     * is only queued once a line which does not belong to its epoch is processed. VDM and VDO
+     * sentences are added to \c ais_assembler_, and only the position reports of their complete
+     * messages are queued. The unsupported sentences whose address has been registered are handed
+     * to their handler right away, as the line is overwritten by the next one. The GGA, RMC, ZDA,
+     * and GST samples are stamped by \c date_anchor_ before they are queued, so the samples without a
+     * date get the one of the latest sample which reported it. The HDT, THS, and ROT samples, which
+     * are usually reported at a much higher rate than the rest, are also published in their latest
+     * sample slot. Every sample carries the time at which its line was received, and the samples
+     * assembled from several lines carry the time of the first of them.
      *
      * @param line The sentence to parse
+     * @param receive_time The time at which the first byte of the line was read
      *
      * @return true on success, false otherwise.
      */
     bool process_line_(
-            const std::string& line) noexcept;
+            const std::string& line,
+            const ReceiveTime& receive_time) noexcept;
+
+    /**
+     * Queue a merged GSA sample, set the corresponding bit of \c data_received_, and signal the
+     * condition variable.
+     *
+     * @param gsa The merged sample.
+     */
+    void push_gsa_(
+            const GSAData& gsa) noexcept;
+
+    /**
+     * Publish a sample of a high rate data kind, such as the heading ones, in its latest sample
+     * slot, queue it, set the corresponding bit of \c data_received_, and signal the condition
+     * variable. The slot is written first, so its readers get the sample as soon as possible.
+     *
+     * @param queue The queue of the data kind.
+     * @param latest The latest sample slot of the data kind.
+     * @param sample The sample.
+     */
+    template<class T, int N>
+    void push_latest_(
+            FixedSizeQueue<T, N>& queue,
+            LatestSample<T>& latest,
+            const T& sample) noexcept;
 
     /**
      * Routine run by read_thread_.
      *
-     * It reads incoming lines from the NMEA devices, parses them, and signals the \c cv_ when new
-     * data arrives.
+     * It hands the incoming lines from the NMEA devices to \c process_line_() as they are received,
+     * together with their \c SerialInterface::line_time(), through \c SerialInterface::read_lines(),
+     * until \c routine_running_ is cleared or the port is closed. The latter signals the \c cv_, so
+     * that any \c wait_for_data() returns.
      *
      * TODO: This could just be a lambda
      */
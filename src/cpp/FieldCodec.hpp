@@ -0,0 +1,1017 @@
+// Copyright (c) 2021 Eduardo Ponz Segrelles.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+/**
+ * @file FieldCodec.hpp
+ */
+
+#ifndef _EASYNMEA_FIELDCODEC_HPP_
+#define _EASYNMEA_FIELDCODEC_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+#include <easynmea/data.hpp>
+#include <easynmea/types.hpp>
+
+namespace eduponz {
+namespace easynmea {
+
+/**
+ * @class FieldCodec
+ *
+ * This class provides the static building blocks used to validate, translate, and write the fields
+ * of NMEA 0183 sentences. All of them work on caller provided buffers, so they neither allocate
+ * memory nor throw, and none of them depends on the global locale.
+ */
+class FieldCodec
+{
+protected:
+
+    //! Number of milliseconds in a day
+    static constexpr int64_t MILLISECONDS_PER_DAY = 86400000;
+
+    /**
+     * \brief Return the talker corresponding to a talker identifier.
+     *
+     * @param first The first character of the talker identifier.
+     * @param second The second character of the talker identifier.
+     * @return The \c NMEA0183Talker, or \c NMEA0183Talker::UNKNOWN if the talker is not supported.
+     */
+    static constexpr NMEA0183Talker talker_(
+            char first,
+            char second) noexcept
+    {
+        // Both characters packed in a single integer, so that the switch is resolved with a table
+        switch ((static_cast<unsigned int>(static_cast<unsigned char>(first)) << 8) | static_cast<unsigned char>(second))
+        {
+            case ('G' << 8) | 'P':
+                return NMEA0183Talker::GP;
+            case ('G' << 8) | 'L':
+                return NMEA0183Talker::GL;
+            case ('G' << 8) | 'A':
+                return NMEA0183Talker::GA;
+            case ('G' << 8) | 'B':
+                return NMEA0183Talker::GB;
+            case ('B' << 8) | 'D':
+                return NMEA0183Talker::BD;
+            case ('G' << 8) | 'Q':
+                return NMEA0183Talker::GQ;
+            case ('G' << 8) | 'I':
+                return NMEA0183Talker::GI;
+            case ('G' << 8) | 'N':
+                return NMEA0183Talker::GN;
+            default:
+                return NMEA0183Talker::UNKNOWN;
+        }
+    }
+
+    /**
+     * \brief Return the AIS talker corresponding to a talker identifier.
+     *
+     * @param first The first character of the talker identifier.
+     * @param second The second character of the talker identifier.
+     * @return The \c NMEA0183Talker, or \c NMEA0183Talker::UNKNOWN if the talker is not an AIS
+     *         station.
+     */
+    static constexpr NMEA0183Talker ais_talker_(
+            char first,
+            char second) noexcept
+    {
+        switch ((static_cast<unsigned int>(static_cast<unsigned char>(first)) << 8) | static_cast<unsigned char>(second))
+        {
+            case ('A' << 8) | 'I':
+                return NMEA0183Talker::AI;
+            case ('A' << 8) | 'B':
+                return NMEA0183Talker::AB;
+            case ('A' << 8) | 'D':
+                return NMEA0183Talker::AD;
+            case ('A' << 8) | 'N':
+                return NMEA0183Talker::AN;
+            case ('A' << 8) | 'R':
+                return NMEA0183Talker::AR;
+            case ('A' << 8) | 'S':
+                return NMEA0183Talker::AS;
+            case ('A' << 8) | 'T':
+                return NMEA0183Talker::AT;
+            case ('A' << 8) | 'X':
+                return NMEA0183Talker::AX;
+            case ('B' << 8) | 'S':
+                return NMEA0183Talker::BS;
+            case ('S' << 8) | 'A':
+                return NMEA0183Talker::SA;
+            default:
+                return NMEA0183Talker::UNKNOWN;
+        }
+    }
+
+    /**
+     * \brief Return the talker identifier corresponding to a talker.
+     *
+     * @param talker The talker.
+     * @return The two characters of the talker identifier, or \c nullptr if the talker is not a
+     *         GNSS talker.
+     */
+    static constexpr const char* talker_id_(
+            NMEA0183Talker talker) noexcept
+    {
+        switch (talker)
+        {
+            case NMEA0183Talker::GP:
+                return "GP";
+            case NMEA0183Talker::GL:
+                return "GL";
+            case NMEA0183Talker::GA:
+                return "GA";
+            case NMEA0183Talker::GB:
+                return "GB";
+            case NMEA0183Talker::BD:
+                return "BD";
+            case NMEA0183Talker::GQ:
+                return "GQ";
+            case NMEA0183Talker::GI:
+                return "GI";
+            case NMEA0183Talker::GN:
+                return "GN";
+            default:
+                return nullptr;
+        }
+    }
+
+    /**
+     * \brief Validate and translate a NMEA 0183 angle field.
+     *
+     * The accepted formats are 'D{n}MM.m+', where the first digit of the degrees is not greater than
+     * \c max_first_digit (for latitudes, it must be in [0; 8]; for longitudes either 0, or 1 followed
+     * by a digit in [0; 7]) and 'MM' is in [00; 60]; or the upper bound of the range ('90.0+' or
+     * '180.0+').
+     *
+     * @param[in, out] it Pointer to the first character of the field. On success, it points to the
+     *                 character following the field.
+     * @param[in] end Pointer past the last character of the sentence.
+     * @param[in] degree_digits Number of digits used to represent the degrees (2 or 3).
+     * @param[in] max_first_digit Maximum value of the first degree digit.
+     * @param[out] degrees The angle in degrees.
+     * @param[out] degrees_e7 The angle in units of 1e-7 degrees.
+     * @return \c true if the field is a valid angle; \c false otherwise.
+     */
+    static bool scan_angle_(
+            const char*& it,
+            const char* end,
+            std::size_t degree_digits,
+            char max_first_digit,
+            float& degrees,
+            int32_t& degrees_e7) noexcept
+    {
+        const char* field = it;
+        std::size_t digits = consume_digits_(it, end);
+
+        /* Upper bound of the range: '90.0+' or '180.0+' */
+        if (digits == degree_digits)
+        {
+            if (!std::equal(field, it, degree_digits == 2 ? "90" : "180") || !consume_char_(it, end, '.'))
+            {
+                return false;
+            }
+            std::size_t zeros = 0;
+            while (consume_char_(it, end, '0'))
+            {
+                zeros++;
+            }
+            degrees = degree_digits == 2 ? 90 : 180;
+            degrees_e7 = degree_digits == 2 ? 900000000 : 1800000000;
+            return zeros > 0;
+        }
+
+        /* Regular angles: 'D{n}MM.m+' */
+        if (digits != degree_digits + 2 || field[0] > max_first_digit)
+        {
+            return false;
+        }
+        // Three-digit degrees starting with 1 must be in [100; 179]
+        if (degree_digits == 3 && field[0] == '1' && field[1] > '7')
+        {
+            return false;
+        }
+        // Minutes must be in [00; 60]
+        const char* minutes = field + degree_digits;
+        if (minutes[0] > '6' || (minutes[0] == '6' && minutes[1] != '0'))
+        {
+            return false;
+        }
+        if (!consume_char_(it, end, '.') || consume_digits_(it, end) == 0)
+        {
+            return false;
+        }
+        degrees = to_degrees_(field, minutes, it);
+        degrees_e7 = to_degrees_e7_(field, minutes, it);
+        return true;
+    }
+
+    /**
+     * \brief Validate and translate a decimal field in the form '-?[0-9]+.[0-9]+'.
+     *
+     * @param[in, out] it Pointer to the first character of the field. On success, it points to the
+     *                 character following the field.
+     * @param[in] end Pointer past the last character of the sentence.
+     * @param[in] allow_sign Whether a leading '-' is accepted.
+     * @param[out] value The translated value.
+     * @return \c true if the field is a valid decimal; \c false otherwise.
+     */
+    static bool scan_decimal_(
+            const char*& it,
+            const char* end,
+            bool allow_sign,
+            float& value) noexcept
+    {
+        const char* field = it;
+        if (allow_sign)
+        {
+            consume_char_(it, end, '-');
+        }
+        if (consume_digits_(it, end) == 0 || !consume_char_(it, end, '.') || consume_digits_(it, end) == 0)
+        {
+            return false;
+        }
+        value = to_float_(field, it);
+        return true;
+    }
+
+    /**
+     * \brief Validate and translate a UTC time of day field in the form 'hhmmss(.s+)?'.
+     *
+     * Any six digits are accepted as the time, but they are only translated if they are a time of
+     * day, as \c to_time_of_day_ms_() does.
+     *
+     * @param[in, out] it Pointer to the first character of the field. On success, it points to the
+     *                 character following the field.
+     * @param[in] end Pointer past the last character of the sentence.
+     * @param[out] time_of_day_ms The time in milliseconds since midnight, or -1 if it is out of
+     *             range.
+     * @return \c true if the field is a valid time; \c false otherwise.
+     */
+    static bool scan_time_(
+            const char*& it,
+            const char* end,
+            int32_t& time_of_day_ms) noexcept
+    {
+        const char* field = it;
+        if (consume_digits_(it, end) != 6 ||
+                (consume_char_(it, end, '.') && consume_digits_(it, end) == 0))
+        {
+            return false;
+        }
+        time_of_day_ms = to_time_of_day_ms_(field, it);
+        return true;
+    }
+
+    /**
+     * \brief Validate and translate a NMEA 0183 tag block, including its checksum.
+     *
+     * The accepted format is '\\<parameters>*hh\\', where the parameters are separated by ',' and
+     * each of them is a lowercase code and its value separated by ':', and the checksum is the XOR
+     * of all the characters between the opening '\\' and the '*'. The values are made of printable
+     * characters other than '\\', ',', '*', '$', and '!'. The source ('s:') is at most
+     * \c TagBlock::MAX_SOURCE_LENGTH characters long, and the time ('c:') is a UNIX time of up to
+     * 10 digits in seconds, or of 11 to 13 digits in milliseconds. The rest of the parameters are
+     * skipped.
+     *
+     * @param[in, out] it Pointer to the opening '\\'. On success, it points to the character
+     *                 following the closing '\\'.
+     * @param[in] end Pointer past the last character of the line.
+     * @param[out] tag_block The translated tag block. Its contents are unspecified if the tag block
+     *             is not valid.
+     * @return \c true if the tag block is valid and its checksum is correct; \c false otherwise.
+     */
+    static bool scan_tag_block_(
+            const char*& it,
+            const char* end,
+            TagBlock& tag_block) noexcept
+    {
+        const char* cursor = it;
+        if (!consume_char_(cursor, end, '\\'))
+        {
+            return false;
+        }
+        tag_block = TagBlock();
+
+        /* Parameters, XORing every character for the checksum on the way */
+        uint8_t checksum = 0;
+        while (true)
+        {
+            if (end - cursor < 2 || cursor[0] < 'a' || cursor[0] > 'z' || cursor[1] != ':')
+            {
+                return false;
+            }
+            char code = cursor[0];
+            checksum ^= static_cast<uint8_t>(code ^ ':');
+            cursor += 2;
+            const char* value = cursor;
+            while (cursor != end && is_tag_block_character_(*cursor))
+            {
+                checksum ^= static_cast<uint8_t>(*cursor++);
+            }
+            std::size_t length = static_cast<std::size_t>(cursor - value);
+
+            if (code == 's')
+            {
+                if (length > TagBlock::MAX_SOURCE_LENGTH)
+                {
+                    return false;
+                }
+                std::memcpy(tag_block.source, value, length);
+                tag_block.source[length] = '\0';
+            }
+            else if (code == 'c')
+            {
+                const char* digits = value;
+                if (length == 0 || length > 13 || consume_digits_(digits, cursor) != length)
+                {
+                    return false;
+                }
+                int64_t time = 0;
+                for (; value != cursor; ++value)
+                {
+                    time = time * 10 + (*value - '0');
+                }
+                // Times of up to 10 digits are in seconds, and longer ones in milliseconds
+                tag_block.unix_time_ms = length <= 10 ? time * 1000 : time;
+            }
+
+            if (!consume_char_(cursor, end, ','))
+            {
+                break;
+            }
+            checksum ^= static_cast<uint8_t>(',');
+        }
+
+        /* Checksum and closing '\\' */
+        if (end - cursor < 4 || cursor[0] != '*' || cursor[3] != '\\' || hex_value_(cursor[1]) < 0 ||
+                hex_value_(cursor[2]) < 0 || ((hex_value_(cursor[1]) << 4) | hex_value_(cursor[2])) != checksum)
+        {
+            return false;
+        }
+        it = cursor + 4;
+        return true;
+    }
+
+    /**
+     * \brief Check whether a character can be part of the value of a tag block parameter.
+     *
+     * @param c The character to check.
+     * @return \c true if \c c is a printable character other than '\\', ',', '*', '$', and '!';
+     *         \c false otherwise.
+     */
+    static constexpr bool is_tag_block_character_(
+            char c) noexcept
+    {
+        return c >= ' ' && c <= '~' && c != '\\' && c != ',' && c != '*' && c != '$' && c != '!';
+    }
+
+    /**
+     * \brief Consume a character if it is the next one in the sentence.
+     *
+     * @param[in, out] it Pointer to the next character. It is advanced if the character matches.
+     * @param[in] end Pointer past the last character of the sentence.
+     * @param[in] c The expected character.
+     * @return \c true if the character was consumed; \c false otherwise.
+     */
+    static bool consume_char_(
+            const char*& it,
+            const char* end,
+            char c) noexcept
+    {
+        if (it != end && *it == c)
+        {
+            ++it;
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * \brief Consume a string literal if it is next in the sentence.
+     *
+     * @param[in, out] it Pointer to the next character. It is advanced if the whole literal matches.
+     * @param[in] end Pointer past the last character of the sentence.
+     * @param[in] literal The expected null-terminated string.
+     * @return \c true if the literal was consumed; \c false otherwise.
+     */
+    static bool consume_literal_(
+            const char*& it,
+            const char* end,
+            const char* literal) noexcept
+    {
+        const char* cursor = it;
+        for (; *literal != '\0'; ++literal, ++cursor)
+        {
+            if (cursor == end || *cursor != *literal)
+            {
+                return false;
+            }
+        }
+        it = cursor;
+        return true;
+    }
+
+    /**
+     * \brief Consume all the consecutive decimal digits.
+     *
+     * @param[in, out] it Pointer to the next character. It is advanced past the digits.
+     * @param[in] end Pointer past the last character of the sentence.
+     * @return The number of consumed digits.
+     */
+    static std::size_t consume_digits_(
+            const char*& it,
+            const char* end) noexcept
+    {
+        const char* begin = it;
+        while (it != end && *it >= '0' && *it <= '9')
+        {
+            ++it;
+        }
+        return static_cast<std::size_t>(it - begin);
+    }
+
+    /**
+     * \brief Consume a hexadecimal digit.
+     *
+     * @param[in, out] it Pointer to the next character. It is advanced if it is a hexadecimal digit.
+     * @param[in] end Pointer past the last character of the sentence.
+     * @return \c true if a hexadecimal digit was consumed; \c false otherwise.
+     */
+    static bool consume_hex_digit_(
+            const char*& it,
+            const char* end) noexcept
+    {
+        if (it != end && hex_value_(*it) >= 0)
+        {
+            ++it;
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * \brief Return the value of a hexadecimal digit.
+     *
+     * @param digit The hexadecimal digit.
+     * @return The value of the digit in [0; 15], or -1 if \c digit is not a hexadecimal digit.
+     */
+    static int hex_value_(
+            char digit) noexcept
+    {
+        if (digit >= '0' && digit <= '9')
+        {
+            return digit - '0';
+        }
+        if (digit >= 'a' && digit <= 'f')
+        {
+            return digit - 'a' + 10;
+        }
+        if (digit >= 'A' && digit <= 'F')
+        {
+            return digit - 'A' + 10;
+        }
+        return -1;
+    }
+
+    /**
+     * \brief Translate a validated decimal field in the form '-?[0-9]+(.[0-9]+)?' into a double.
+     *
+     * The conversion uses integer arithmetic only, so it does not depend on the global locale,
+     * and it neither allocates memory nor throws. Up to 19 significant digits are taken into
+     * account, and the remaining fractional digits, which are beyond any meaningful precision, are
+     * ignored.
+     *
+     * @param begin Pointer to the first character of the field.
+     * @param end Pointer past the last character of the field.
+     * @return The field value.
+     */
+    static double to_decimal_(
+            const char* begin,
+            const char* end) noexcept
+    {
+        /* Exact powers of ten that can be represented in a double */
+        static constexpr double powers_of_ten[] = {
+            1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+            1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19};
+        constexpr uint64_t max_mantissa = 1000000000000000000ull;
+        constexpr int max_fraction_digits = 19;
+
+        bool negative = begin != end && *begin == '-';
+        if (negative)
+        {
+            ++begin;
+        }
+
+        /* Accumulate the digits into an integer mantissa and a decimal exponent */
+        uint64_t mantissa = 0;
+        int fraction_digits = 0;
+        int ignored_integer_digits = 0;
+        bool fraction = false;
+        for (; begin != end; ++begin)
+        {
+            if (*begin == '.')
+            {
+                fraction = true;
+            }
+            else if (mantissa < max_mantissa && fraction_digits < max_fraction_digits)
+            {
+                mantissa = mantissa * 10 + static_cast<uint64_t>(*begin - '0');
+                fraction_digits += fraction ? 1 : 0;
+            }
+            else if (!fraction)
+            {
+                ignored_integer_digits++;
+            }
+        }
+
+        /* Both the mantissa and the power of ten are exact, so the division is correctly rounded */
+        double value = static_cast<double>(mantissa) / powers_of_ten[fraction_digits];
+        for (; ignored_integer_digits > 0; ignored_integer_digits--)
+        {
+            value *= 10;
+        }
+        return negative ? -value : value;
+    }
+
+    /**
+     * \brief Translate a validated decimal field into a float.
+     *
+     * @param begin Pointer to the first character of the field.
+     * @param end Pointer past the last character of the field.
+     * @return The field value.
+     */
+    static float to_float_(
+            const char* begin,
+            const char* end) noexcept
+    {
+        return static_cast<float>(to_decimal_(begin, end));
+    }
+
+    /**
+     * \brief Translate a validated unsigned integer field into an int.
+     *
+     * @param begin Pointer to the first character of the field.
+     * @param end Pointer past the last character of the field.
+     * @return The field value, saturated to the maximum value of an int.
+     */
+    static int to_int_(
+            const char* begin,
+            const char* end) noexcept
+    {
+        constexpr unsigned int max_value = static_cast<unsigned int>(std::numeric_limits<int>::max());
+        unsigned int value = 0;
+        for (; begin != end; ++begin)
+        {
+            unsigned int digit = static_cast<unsigned int>(*begin - '0');
+            value = value > (max_value - digit) / 10 ? max_value : value * 10 + digit;
+        }
+        return static_cast<int>(value);
+    }
+
+    /**
+     * \brief Translate a validated time field in the form 'hhmmss(.s+)?' into milliseconds since
+     *        midnight.
+     *
+     * The conversion uses integer arithmetic only, so it is exact. The decimal places of the
+     * seconds beyond the third one are truncated, so that the result never rolls over to the next
+     * second.
+     *
+     * @param begin Pointer to the first character of the field.
+     * @param end Pointer past the last character of the field.
+     * @return The time in milliseconds, in [0; 86401000) as the seconds can be 60 on a leap second,
+     *         or -1 if the hours are over 23, the minutes over 59, or the seconds over 60.
+     */
+    static int32_t to_time_of_day_ms_(
+            const char* begin,
+            const char* end) noexcept
+    {
+        int32_t hours = (begin[0] - '0') * 10 + (begin[1] - '0');
+        int32_t minutes = (begin[2] - '0') * 10 + (begin[3] - '0');
+        int32_t seconds = (begin[4] - '0') * 10 + (begin[5] - '0');
+        if (hours > 23 || minutes > 59 || seconds > 60)
+        {
+            return -1;
+        }
+        int32_t time_of_day_ms = ((hours * 60 + minutes) * 60 + seconds) * 1000;
+        const char* fraction = begin + 6;
+        if (fraction != end)
+        {
+            int32_t scale = 100;
+            for (const char* it = fraction + 1; it != end && scale > 0; ++it, scale /= 10)
+            {
+                time_of_day_ms += (*it - '0') * scale;
+            }
+        }
+        return time_of_day_ms;
+    }
+
+    /**
+     * \brief Translate a UTC date and time of day into a \c UtcTime.
+     *
+     * The number of days since 1970-01-01 is calculated with the proleptic Gregorian calendar, using
+     * integer arithmetic only.
+     *
+     * @param year The year, with four digits.
+     * @param month The month, in [1; 12].
+     * @param day The day of the month, in [1; 31].
+     * @param time_of_day_ms The time in milliseconds since midnight.
+     * @return The UTC time point.
+     */
+    static UtcTime to_utc_time_(
+            int32_t year,
+            int32_t month,
+            int32_t day,
+            int32_t time_of_day_ms) noexcept
+    {
+        /* Years starting on March 1st, so that the leap day is the last one of its year */
+        year -= month <= 2 ? 1 : 0;
+        int32_t era = (year >= 0 ? year : year - 399) / 400;
+        int32_t year_of_era = year - era * 400;
+        int32_t day_of_year = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+        int32_t day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+        int64_t days = static_cast<int64_t>(era) * 146097 + day_of_era - 719468;
+        return UtcTime(std::chrono::milliseconds(days * MILLISECONDS_PER_DAY + time_of_day_ms));
+    }
+
+    /**
+     * \brief Translate a NMEA 0183 angle representation into a decimal floating point representing
+     *        degrees.
+     *
+     * \pre The expected format of the angle is 'D{1,3}MM.[m]+' where:
+     *    1. D corresponds to degrees
+     *    1. MM.[m]+ is a float representing minutes of degree
+     *
+     * @param begin Pointer to the first character of the angle.
+     * @param minutes Pointer to the first character of the minutes.
+     * @param end Pointer past the last character of the angle.
+     * @return A \c float representing the angle in degrees.
+     */
+    static float to_degrees_(
+            const char* begin,
+            const char* minutes,
+            const char* end) noexcept
+    {
+        /* Add up the 'D{1,3}' and the 'MM.[m]+' translated into degrees, rounding only once */
+        return static_cast<float>(to_int_(begin, minutes) + to_decimal_(minutes, end) / 60);
+    }
+
+    /**
+     * \brief Translate a NMEA 0183 angle representation into an integer representing units of
+     *        1e-7 degrees.
+     *
+     * The conversion uses integer arithmetic only, so the result is the exact angle rounded to the
+     * nearest unit as long as the minutes have up to 8 decimal places. Further decimal places
+     * represent less than 1e-9 degrees and are ignored.
+     *
+     * \pre The expected format of the angle is 'D{1,3}MM.[m]+', as in \c to_degrees_().
+     *
+     * @param begin Pointer to the first character of the angle.
+     * @param minutes Pointer to the first character of the minutes.
+     * @param end Pointer past the last character of the angle.
+     * @return The angle in units of 1e-7 degrees.
+     */
+    static int32_t to_degrees_e7_(
+            const char* begin,
+            const char* minutes,
+            const char* end) noexcept
+    {
+        constexpr int minute_decimals = 8;
+        constexpr uint64_t minute_scale = 100000000ull;
+        constexpr uint64_t units_per_degree = 10000000ull;
+
+        /* Read 'MM.[m]+' as an integer number of 1e-8 minutes */
+        uint64_t scaled_minutes = 0;
+        int decimals = 0;
+        bool fraction = false;
+        for (const char* it = minutes; it != end && decimals < minute_decimals; ++it)
+        {
+            if (*it == '.')
+            {
+                fraction = true;
+                continue;
+            }
+            scaled_minutes = scaled_minutes * 10 + static_cast<uint64_t>(*it - '0');
+            decimals += fraction ? 1 : 0;
+        }
+        for (; decimals < minute_decimals; decimals++)
+        {
+            scaled_minutes *= 10;
+        }
+
+        /* Add up the degrees and the minutes divided by 60, rounding to the nearest unit */
+        constexpr uint64_t denominator = 60 * minute_scale;
+        uint64_t minutes_e7 = (scaled_minutes * units_per_degree + denominator / 2) / denominator;
+        return static_cast<int32_t>(static_cast<uint64_t>(to_int_(begin, minutes)) * units_per_degree + minutes_e7);
+    }
+
+    /**
+     * \brief Write a character if there is room for it.
+     *
+     * @param[in, out] out Pointer to the next character to write. It is advanced if the character
+     *                 was written.
+     * @param[in] end Pointer past the last character of the output buffer.
+     * @param[in] c The character to write.
+     * @return \c true if the character was written; \c false otherwise.
+     */
+    static bool print_char_(
+            char*& out,
+            char* end,
+            char c) noexcept
+    {
+        if (out == end)
+        {
+            return false;
+        }
+        *out++ = c;
+        return true;
+    }
+
+    /**
+     * \brief Write an unsigned integer in decimal form.
+     *
+     * @param[in, out] out Pointer to the next character to write. It is advanced past the number if
+     *                 it was written.
+     * @param[in] end Pointer past the last character of the output buffer.
+     * @param[in] value The value to write.
+     * @param[in] min_digits Minimum number of digits, padded with leading zeros. At most 20.
+     * @return \c true if the whole number was written; \c false otherwise.
+     */
+    static bool print_unsigned_(
+            char*& out,
+            char* end,
+            uint64_t value,
+            std::size_t min_digits = 1) noexcept
+    {
+        char digits[20];
+        std::size_t count = 0;
+        do
+        {
+            digits[count++] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        } while (value > 0 || count < min_digits);
+
+        if (static_cast<std::size_t>(end - out) < count)
+        {
+            return false;
+        }
+        while (count > 0)
+        {
+            *out++ = digits[--count];
+        }
+        return true;
+    }
+
+    /**
+     * \brief Write a decimal number in the form '-?[0-9]+.[0-9]+'.
+     *
+     * The value is rounded to the nearest multiple of 10^-decimals using integer arithmetic, so the
+     * output does not depend on the global locale. Writing a float with enough decimals and
+     * translating it back with \c to_float_() yields the same float.
+     *
+     * @param[in, out] out Pointer to the next character to write. It is advanced past the number if
+     *                 it was written.
+     * @param[in] end Pointer past the last character of the output buffer.
+     * @param[in] value The value to write. Its magnitude must be lower than 1e9.
+     * @param[in] decimals Number of decimal places, in [1; 9].
+     * @param[in] integer_digits Minimum number of integer digits, padded with leading zeros.
+     * @return \c true if the whole number was written; \c false if it does not fit in the buffer or
+     *         it cannot be represented.
+     */
+    static bool print_decimal_(
+            char*& out,
+            char* end,
+            double value,
+            int decimals,
+            std::size_t integer_digits = 1) noexcept
+    {
+        static constexpr uint64_t powers_of_ten[] = {
+            1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull, 100000000ull,
+            1000000000ull};
+
+        bool negative = value < 0;
+        double magnitude = negative ? -value : value;
+        // The comparison also rejects NaN
+        if (!(magnitude < 1e9) || decimals < 1 || decimals > 9)
+        {
+            return false;
+        }
+        uint64_t scale = powers_of_ten[decimals];
+        uint64_t scaled = static_cast<uint64_t>(magnitude * static_cast<double>(scale) + 0.5);
+        if (negative && scaled != 0 && !print_char_(out, end, '-'))
+        {
+            return false;
+        }
+        return print_unsigned_(out, end, scaled / scale, integer_digits) &&
+               print_char_(out, end, '.') &&
+               print_unsigned_(out, end, scaled % scale, static_cast<std::size_t>(decimals));
+    }
+
+    /**
+     * \brief Write a UTC time of day in the form 'hhmmss(.s+)?'.
+     *
+     * The time is truncated to the number of decimal places, and the leap seconds are written with
+     * 60 seconds.
+     *
+     * @param[in, out] out Pointer to the next character to write. It is advanced past the time if
+     *                 it was written.
+     * @param[in] end Pointer past the last character of the output buffer.
+     * @param[in] time_of_day_ms The time in milliseconds since midnight, in [0; 86401000).
+     * @param[in] decimals Number of decimal places, in [0; 9].
+     * @return \c true if the whole time was written; \c false if it does not fit in the buffer or
+     *         it is out of range.
+     */
+    static bool print_time_(
+            char*& out,
+            char* end,
+            int32_t time_of_day_ms,
+            int decimals) noexcept
+    {
+        if (time_of_day_ms < 0 || time_of_day_ms >= MILLISECONDS_PER_DAY + 1000 || decimals < 0 || decimals > 9)
+        {
+            return false;
+        }
+        int32_t hours = std::min(time_of_day_ms / 3600000, 23);
+        int32_t minutes = std::min((time_of_day_ms - hours * 3600000) / 60000, 59);
+        int32_t milliseconds = time_of_day_ms - hours * 3600000 - minutes * 60000;
+        if (!print_unsigned_(out, end, static_cast<uint64_t>(hours), 2) ||
+                !print_unsigned_(out, end, static_cast<uint64_t>(minutes), 2) ||
+                !print_unsigned_(out, end, static_cast<uint64_t>(milliseconds / 1000), 2))
+        {
+            return false;
+        }
+        if (decimals == 0)
+        {
+            return true;
+        }
+        uint64_t fraction = static_cast<uint64_t>(milliseconds % 1000);
+        for (int i = decimals; i < 3; i++)
+        {
+            fraction /= 10;
+        }
+        for (int i = 3; i < decimals; i++)
+        {
+            fraction *= 10;
+        }
+        return print_char_(out, end, '.') && print_unsigned_(out, end, fraction, static_cast<std::size_t>(decimals));
+    }
+
+    /**
+     * \brief Write the magnitude of an angle in the form 'D{n}MM.mmmmmm'.
+     *
+     * Six decimal places of minutes represent any multiple of 1e-7 degrees exactly, so translating
+     * the output back with \c to_degrees_e7_() yields the same value. The upper bound of the range is
+     * written as '90.0' or '180.0', and the angles above it which \c scan_angle_() accepts (with
+     * minutes in [60; 61)) are written with 60 minutes.
+     *
+     * @param[in, out] out Pointer to the next character to write. It is advanced past the angle if
+     *                 it was written.
+     * @param[in] end Pointer past the last character of the output buffer.
+     * @param[in] degrees_e7 The angle in units of 1e-7 degrees. Its sign is ignored.
+     * @param[in] degree_digits Number of digits used to represent the degrees (2 or 3).
+     * @return \c true if the whole angle was written; \c false if it does not fit in the buffer or
+     *         it is out of range.
+     */
+    static bool print_angle_(
+            char*& out,
+            char* end,
+            int32_t degrees_e7,
+            std::size_t degree_digits) noexcept
+    {
+        constexpr uint32_t units_per_degree = 10000000u;
+        constexpr uint32_t minute_scale = 1000000u;
+
+        uint32_t magnitude = static_cast<uint32_t>(degrees_e7);
+        magnitude = degrees_e7 < 0 ? 0u - magnitude : magnitude;
+        uint32_t max_degrees = degree_digits == 2 ? 90u : 180u;
+        uint32_t degrees = magnitude / units_per_degree;
+        // A multiple of 1e-7 degrees is a multiple of 6e-6 minutes
+        uint32_t minutes_e6 = (magnitude % units_per_degree) * 6;
+
+        /* Upper bound of the range: '90.0' or '180.0' */
+        if (degrees == max_degrees && minutes_e6 == 0)
+        {
+            return print_unsigned_(out, end, degrees) && print_char_(out, end, '.') && print_char_(out, end, '0');
+        }
+
+        /* Regular angles: 'D{n}MM.mmmmmm' */
+        if (degrees >= max_degrees)
+        {
+            degrees--;
+            minutes_e6 += 60 * minute_scale;
+        }
+        if (degrees >= max_degrees || minutes_e6 >= 61 * minute_scale)
+        {
+            return false;
+        }
+        return print_unsigned_(out, end, degrees, degree_digits) &&
+               print_unsigned_(out, end, minutes_e6 / minute_scale, 2) &&
+               print_char_(out, end, '.') &&
+               print_unsigned_(out, end, minutes_e6 % minute_scale, 6);
+    }
+
+    /**
+     * \brief Write a NMEA 0183 tag block with its checksum, as \c scan_tag_block_() accepts it.
+     *
+     * Nothing is written if the tag block is empty. The time is written in seconds if it is a whole
+     * number of them, and in milliseconds otherwise.
+     *
+     * @param[in, out] out Pointer to the next character to write. It is advanced past the tag block
+     *                 if it was written.
+     * @param[in] end Pointer past the last character of the output buffer.
+     * @param[in] tag_block The tag block to write.
+     * @return \c true if the whole tag block was written; \c false if it does not fit in the buffer
+     *         or it cannot be represented.
+     */
+    static bool print_tag_block_(
+            char*& out,
+            char* end,
+            const TagBlock& tag_block) noexcept
+    {
+        if (tag_block.empty())
+        {
+            return true;
+        }
+        char* begin = out;
+        if (!print_char_(out, end, '\\'))
+        {
+            return false;
+        }
+
+        /* Source */
+        std::size_t length = static_cast<std::size_t>(
+            std::find(tag_block.source, tag_block.source + sizeof(tag_block.source), '\0') - tag_block.source);
+        if (length > 0)
+        {
+            if (length > TagBlock::MAX_SOURCE_LENGTH ||
+                    !std::all_of(tag_block.source, tag_block.source + length, is_tag_block_character_) ||
+                    !print_char_(out, end, 's') || !print_char_(out, end, ':') ||
+                    static_cast<std::size_t>(end - out) < length)
+            {
+                return false;
+            }
+            out = std::copy(tag_block.source, tag_block.source + length, out);
+        }
+
+        /* Time, either in seconds (up to 10 digits) or in milliseconds (11 to 13 digits) */
+        if (tag_block.unix_time_ms >= 0)
+        {
+            constexpr uint64_t max_seconds = 10000000000u;
+            uint64_t time = static_cast<uint64_t>(tag_block.unix_time_ms);
+            if (time % 1000 == 0 && time / 1000 < max_seconds)
+            {
+                time /= 1000;
+            }
+            else if (time < max_seconds || time >= max_seconds * 1000)
+            {
+                return false;
+            }
+            if ((length > 0 && !print_char_(out, end, ',')) ||
+                    !print_char_(out, end, 'c') || !print_char_(out, end, ':') ||
+                    !print_unsigned_(out, end, time))
+            {
+                return false;
+            }
+        }
+
+        /* Checksum of everything between the '\\' and the '*', and closing '\\' */
+        static constexpr char hex_digits[] = "0123456789ABCDEF";
+        uint8_t checksum = 0;
+        for (const char* c = begin + 1; c != out; ++c)
+        {
+            checksum ^= static_cast<uint8_t>(*c);
+        }
+        return print_char_(out, end, '*') &&
+               print_char_(out, end, hex_digits[checksum >> 4]) &&
+               print_char_(out, end, hex_digits[checksum & 0xF]) &&
+               print_char_(out, end, '\\');
+    }
+
+};
+
+} // namespace eduponz
+} // namespace easynmea
+
+#endif //_EASYNMEA_FIELDCODEC_HPP_
@@ -0,0 +1,575 @@
+// Copyright (c) 2021 Eduardo Ponz Segrelles.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+/**
+ * @file GPGGAView.hpp
+ */
+
+#ifndef _EASYNMEA_GPGGAVIEW_HPP_
+#define _EASYNMEA_GPGGAVIEW_HPP_
+
+#include <cstdint>
+#include <string_view>
+
+#include <easynmea/data.hpp>
+
+#include "EasyNmeaCoder.hpp"
+#include "StructuralIndex.hpp"
+
+namespace eduponz {
+namespace easynmea {
+
+/**
+ * @class GPGGAView
+ *
+ * Lightweight view of a GGA sentence, from any supported talker, which converts its fields on demand.
+ *
+ * When the view is parsed, the framing, the checksum, the sentence identifier and the number of
+ * fields are validated, and the offsets of the fields are indexed. Each field is then validated and
+ * converted only the first time it is accessed, and the result is cached. The values are the same as
+ * the ones \c EasyNmeaCoder::decode() would return for the sentence.
+ *
+ * Since the fields are validated independently, a field can be accessed even if some other field is
+ * not valid, in which case a full decode would reject the whole sentence. Use \c to_data() to
+ * validate all the fields as a full decode does.
+ *
+ * The view does not copy the sentence, so the sentence must outlive it. Because of the cache, a
+ * \c GPGGAView must not be accessed from several threads concurrently.
+ */
+class GPGGAView
+{
+public:
+
+    /**
+     * \brief Parse a GPGGA sentence
+     *
+     * @param sentence The sentence to be parsed. It must not contain the line terminator.
+     * @return \c true if the sentence is framed as a GPGGA sentence, its checksum is correct, and it
+     *         has the right number of fields; \c false otherwise.
+     */
+    bool parse(
+            std::string_view sentence) noexcept
+    {
+        if (StructuralIndex::build(sentence, &index_, 1) != 1 || index_.begin != 0 || index_.size != sentence.size())
+        {
+            reset_(std::string_view());
+            return false;
+        }
+        return parse(sentence, index_);
+    }
+
+    /**
+     * \brief Parse a GPGGA sentence which has already been indexed with \c StructuralIndex
+     *
+     * @param buffer The buffer from which the index was built.
+     * @param index The index of the sentence to be parsed.
+     * @return \c true if the sentence is framed as a GPGGA sentence, its checksum is correct, and it
+     *         has the right number of fields; \c false otherwise.
+     */
+    bool parse(
+            std::string_view buffer,
+            const IndexedSentence& index) noexcept
+    {
+        index_ = index;
+        reset_(buffer);
+        std::string_view sentence = index_.sentence(buffer_);
+
+        /* Framing, checksum and identifier, from any supported talker */
+        if (!index_.framed() || Checksum::parse_hex(sentence[sentence.size() - 2], sentence.back()) < 0 ||
+                !Checksum::validate(sentence) || !is_gga_address_(field_(0)))
+        {
+            reset_(std::string_view());
+            return false;
+        }
+        data_.talker = Scanner::talker_(sentence[1], sentence[2]);
+
+        /**
+         * Fields: the mandatory ones, the optional DGPS age and station, and the empty field
+         * before the checksum mark. The DGPS station cannot be empty if present.
+         */
+        std::size_t separators = index_.separator_count;
+        bool valid = !index_.truncated &&
+                separators >= MANDATORY_SEPARATORS && separators <= MANDATORY_SEPARATORS + 2 &&
+                field_(separators).empty() &&
+                (separators != MANDATORY_SEPARATORS + 2 || !field_(DGPS_STATION_FIELD).empty()) &&
+                field_(ALTITUDE_UNITS_FIELD) == "M" &&
+                field_(HEIGHT_UNITS_FIELD) == "M";
+        if (!valid)
+        {
+            reset_(std::string_view());
+        }
+        return valid;
+    }
+
+    /**
+     * \brief Check whether the view holds a parsed sentence
+     *
+     * @return \c true if the last call to \c parse() succeeded; \c false otherwise.
+     */
+    bool valid() const noexcept
+    {
+        return !buffer_.empty();
+    }
+
+    /**
+     * \brief Get the UTC time as hhmmss.milliseconds
+     *
+     * @param[out] value The timestamp. It is only modified if the field is valid.
+     * @return \c true if the field is valid; \c false otherwise.
+     */
+    bool timestamp(
+            float& value) const noexcept
+    {
+        return get_(TIMESTAMP, data_.timestamp, value);
+    }
+
+    /**
+     * \brief Get the UTC time of day in milliseconds since midnight
+     *
+     * @param[out] value The time of day, or -1 if it is out of range. It is only modified if the
+     *             field is valid.
+     * @return \c true if the field is valid; \c false otherwise.
+     */
+    bool time_of_day_ms(
+            int32_t& value) const noexcept
+    {
+        return get_(TIMESTAMP, data_.time_of_day_ms, value);
+    }
+
+    /**
+     * \brief Get the latitude in degrees referred to North
+     *
+     * @param[out] value The latitude. It is only modified if the field is valid.
+     * @return \c true if the latitude and its bearing are valid; \c false otherwise.
+     */
+    bool latitude(
+            float& value) const noexcept
+    {
+        return get_(LATITUDE, data_.latitude, value);
+    }
+
+    /**
+     * \brief Get the latitude in units of 1e-7 degrees referred to North
+     *
+     * @param[out] value The latitude. It is only modified if the field is valid.
+     * @return \c true if the latitude and its bearing are valid; \c false otherwise.
+     */
+    bool latitude_e7(
+            int32_t& value) const noexcept
+    {
+        return get_(LATITUDE, data_.latitude_e7, value);
+    }
+
+    /**
+     * \brief Get the longitude in degrees referred to East
+     *
+     * @param[out] value The longitude. It is only modified if the field is valid.
+     * @return \c true if the longitude and its bearing are valid; \c false otherwise.
+     */
+    bool longitude(
+            float& value) const noexcept
+    {
+        return get_(LONGITUDE, data_.longitude, value);
+    }
+
+    /**
+     * \brief Get the longitude in units of 1e-7 degrees referred to East
+     *
+     * @param[out] value The longitude. It is only modified if the field is valid.
+     * @return \c true if the longitude and its bearing are valid; \c false otherwise.
+     */
+    bool longitude_e7(
+            int32_t& value) const noexcept
+    {
+        return get_(LONGITUDE, data_.longitude_e7, value);
+    }
+
+    /**
+     * \brief Get the GNSS fix
+     *
+     * @param[out] value The fix. It is only modified if the field is valid.
+     * @return \c true if the field is valid; \c false otherwise.
+     */
+    bool fix(
+            uint16_t& value) const noexcept
+    {
+        return get_(FIX, data_.fix, value);
+    }
+
+    /**
+     * \brief Get the number of satellites on view
+     *
+     * @param[out] value The number of satellites. It is only modified if the field is valid.
+     * @return \c true if the field is valid; \c false otherwise.
+     */
+    bool satellites_on_view(
+            uint16_t& value) const noexcept
+    {
+        return get_(SATELLITES_ON_VIEW, data_.satellites_on_view, value);
+    }
+
+    /**
+     * \brief Get the horizontal precision in meters
+     *
+     * @param[out] value The horizontal precision. It is only modified if the field is valid.
+     * @return \c true if the field is valid; \c false otherwise.
+     */
+    bool horizontal_precision(
+            float& value) const noexcept
+    {
+        return get_(HORIZONTAL_PRECISION, data_.horizontal_precision, value);
+    }
+
+    /**
+     * \brief Get the altitude over sea level in meters
+     *
+     * @param[out] value The altitude. It is only modified if the field is valid.
+     * @return \c true if the field is valid; \c false otherwise.
+     */
+    bool altitude(
+            float& value) const noexcept
+    {
+        return get_(ALTITUDE, data_.altitude, value);
+    }
+
+    /**
+     * \brief Get the height of geoid above WGS84 ellipsoid in meters
+     *
+     * @param[out] value The height of geoid. It is only modified if the field is valid.
+     * @return \c true if the field is valid; \c false otherwise.
+     */
+    bool height_of_geoid(
+            float& value) const noexcept
+    {
+        return get_(HEIGHT_OF_GEOID, data_.height_of_geoid, value);
+    }
+
+    /**
+     * \brief Get the seconds since the last DGPS update
+     *
+     * @param[out] value The seconds since the last update, or -1 if the field is not present. It is
+     *             only modified if the field is valid.
+     * @return \c true if the field is valid or not present; \c false otherwise.
+     */
+    bool dgps_last_update(
+            float& value) const noexcept
+    {
+        return get_(DGPS_LAST_UPDATE, data_.dgps_last_update, value);
+    }
+
+    /**
+     * \brief Get the DGPS reference station ID
+     *
+     * @param[out] value The station ID, or 0 if the field is not present. It is only modified if
+     *             the field is valid.
+     * @return \c true if the field is valid or not present; \c false otherwise.
+     */
+    bool dgps_reference_station_id(
+            uint16_t& value) const noexcept
+    {
+        return get_(DGPS_REFERENCE_STATION_ID, data_.dgps_reference_station_id, value);
+    }
+
+    /**
+     * \brief Convert all the fields into a \c GPGGAData
+     *
+     * @param[out] data The \c GPGGAData to populate. It is only modified if all the fields are valid.
+     * @return \c true if the view holds a parsed sentence and all its fields are valid, i.e. if
+     *         \c EasyNmeaCoder::decode() would decode the sentence; \c false otherwise.
+     */
+    bool to_data(
+            GPGGAData& data) const noexcept
+    {
+        for (uint16_t field = 0; field < FIELD_COUNT; field++)
+        {
+            if (!convert_(static_cast<Field>(field)))
+            {
+                return false;
+            }
+        }
+        data = data_;
+        return true;
+    }
+
+protected:
+
+    //! Fields which are converted together
+    enum Field : uint16_t
+    {
+        TIMESTAMP,
+        LATITUDE,
+        LONGITUDE,
+        FIX,
+        SATELLITES_ON_VIEW,
+        HORIZONTAL_PRECISION,
+        ALTITUDE,
+        HEIGHT_OF_GEOID,
+        DGPS_LAST_UPDATE,
+        DGPS_REFERENCE_STATION_ID,
+        FIELD_COUNT
+    };
+
+    //! Number of separators of a GPGGA sentence without the optional fields
+    static constexpr std::size_t MANDATORY_SEPARATORS = 13;
+
+    //! Index of the altitude units field
+    static constexpr std::size_t ALTITUDE_UNITS_FIELD = 10;
+
+    //! Index of the height of geoid units field
+    static constexpr std::size_t HEIGHT_UNITS_FIELD = 12;
+
+    //! Index of the DGPS last update field
+    static constexpr std::size_t DGPS_AGE_FIELD = 13;
+
+    //! Index of the DGPS reference station ID field
+    static constexpr std::size_t DGPS_STATION_FIELD = 14;
+
+    /**
+     * Helpers of the single-pass scanner, which are reused to validate and convert each field with
+     * exactly the same rules as a full decode.
+     */
+    class Scanner : public EasyNmeaCoder
+    {
+    public:
+
+        using EasyNmeaCoder::SentenceFormatter;
+        using EasyNmeaCoder::consume_char_;
+        using EasyNmeaCoder::consume_digits_;
+        using EasyNmeaCoder::scan_angle_;
+        using EasyNmeaCoder::find_formatter_;
+        using EasyNmeaCoder::scan_decimal_;
+        using EasyNmeaCoder::scan_time_;
+        using EasyNmeaCoder::talker_;
+        using EasyNmeaCoder::to_decimal_;
+        using EasyNmeaCoder::to_int_;
+    };
+
+    //! Whether an address field corresponds to a GGA sentence from a supported talker
+    static bool is_gga_address_(
+            std::string_view address) noexcept
+    {
+        const Scanner::SentenceFormatter* formatter = Scanner::find_formatter_(address);
+        return formatter != nullptr && formatter->kind == NMEA0183DataKind::GPGGA;
+    }
+
+    //! Forget the cached fields and hold a new buffer
+    void reset_(
+            std::string_view buffer) noexcept
+    {
+        buffer_ = buffer;
+        data_ = GPGGAData();
+        converted_ = 0;
+        invalid_ = 0;
+    }
+
+    //! Get a field of the sentence
+    std::string_view field_(
+            std::size_t index) const noexcept
+    {
+        return index_.field(buffer_, index);
+    }
+
+    //! Convert a field if needed, and copy its cached value
+    template<class T>
+    bool get_(
+            Field field,
+            const T& cached,
+            T& value) const noexcept
+    {
+        if (!convert_(field))
+        {
+            return false;
+        }
+        value = cached;
+        return true;
+    }
+
+    /**
+     * \brief Validate and convert a field, caching the result
+     *
+     * @param field The field to convert.
+     * @return \c true if the field is valid; \c false otherwise.
+     */
+    bool convert_(
+            Field field) const noexcept
+    {
+        const uint16_t mask = static_cast<uint16_t>(1u << field);
+        if (!valid() || (invalid_ & mask))
+        {
+            return false;
+        }
+        if (converted_ & mask)
+        {
+            return true;
+        }
+        if (!scan_field_(field))
+        {
+            invalid_ |= mask;
+            return false;
+        }
+        converted_ |= mask;
+        return true;
+    }
+
+    //! Validate and convert a field into the cached data
+    bool scan_field_(
+            Field field) const noexcept
+    {
+        switch (field)
+        {
+            case TIMESTAMP:
+            {
+                std::string_view text = field_(1);
+                const char* it = text.data();
+                const char* end = it + text.size();
+                if (!Scanner::scan_time_(it, end, data_.time_of_day_ms) || it != end)
+                {
+                    return false;
+                }
+                data_.timestamp = static_cast<float>(Scanner::to_decimal_(text.data(), end));
+                return true;
+            }
+            case LATITUDE:
+            {
+                return scan_coordinate_(2, '8', 'N', 'S', data_.latitude, data_.latitude_e7);
+            }
+            case LONGITUDE:
+            {
+                return scan_coordinate_(4, '1', 'E', 'W', data_.longitude, data_.longitude_e7);
+            }
+            case FIX:
+            {
+                std::string_view text = field_(6);
+                if (text.size() != 1 || text[0] < '0' || text[0] > '2')
+                {
+                    return false;
+                }
+                data_.fix = static_cast<uint16_t>(text[0] - '0');
+                return true;
+            }
+            case SATELLITES_ON_VIEW:
+            {
+                return scan_integer_(field_(7), data_.satellites_on_view);
+            }
+            case HORIZONTAL_PRECISION:
+            {
+                return scan_decimal_(field_(8), false, data_.horizontal_precision);
+            }
+            case ALTITUDE:
+            {
+                return scan_decimal_(field_(9), true, data_.altitude);
+            }
+            case HEIGHT_OF_GEOID:
+            {
+                return scan_decimal_(field_(11), true, data_.height_of_geoid);
+            }
+            case DGPS_LAST_UPDATE:
+            {
+                // Optional, and it can be present but empty
+                std::string_view text = field_(DGPS_AGE_FIELD);
+                return index_.separator_count == MANDATORY_SEPARATORS || text.empty() ||
+                       scan_decimal_(text, false, data_.dgps_last_update);
+            }
+            case DGPS_REFERENCE_STATION_ID:
+            {
+                // Optional, but it cannot be present and empty
+                return index_.separator_count < MANDATORY_SEPARATORS + 2 ||
+                       scan_integer_(field_(DGPS_STATION_FIELD), data_.dgps_reference_station_id);
+            }
+            default:
+            {
+                return false;
+            }
+        }
+    }
+
+    //! Validate and convert a coordinate and its bearing
+    bool scan_coordinate_(
+            std::size_t field,
+            char max_first_digit,
+            char positive,
+            char negative,
+            float& degrees,
+            int32_t& degrees_e7) const noexcept
+    {
+        std::string_view text = field_(field);
+        std::string_view bearing = field_(field + 1);
+        const char* it = text.data();
+        const char* end = it + text.size();
+        std::size_t degree_digits = field == 2 ? 2 : 3;
+        if (!Scanner::scan_angle_(it, end, degree_digits, max_first_digit, degrees, degrees_e7) || it != end ||
+                bearing.size() != 1 || (bearing[0] != positive && bearing[0] != negative))
+        {
+            return false;
+        }
+        if (bearing[0] == negative)
+        {
+            degrees = -degrees;
+            degrees_e7 = -degrees_e7;
+        }
+        return true;
+    }
+
+    //! Validate and convert a decimal field
+    static bool scan_decimal_(
+            std::string_view text,
+            bool allow_sign,
+            float& value) noexcept
+    {
+        const char* it = text.data();
+        const char* end = it + text.size();
+        return Scanner::scan_decimal_(it, end, allow_sign, value) && it == end;
+    }
+
+    //! Validate and convert an unsigned integer field
+    static bool scan_integer_(
+            std::string_view text,
+            uint16_t& value) noexcept
+    {
+        const char* it = text.data();
+        const char* end = it + text.size();
+        if (Scanner::consume_digits_(it, end) == 0 || it != end)
+        {
+            return false;
+        }
+        value = static_cast<uint16_t>(Scanner::to_int_(text.data(), end));
+        return true;
+    }
+
+    //! The buffer holding the sentence. Empty if no sentence has been parsed
+    std::string_view buffer_;
+
+    //! The index of the sentence within \c buffer_
+    IndexedSentence index_;
+
+    //! The cached fields
+    mutable GPGGAData data_;
+
+    //! Bitmask of the fields which have been converted
+    mutable uint16_t converted_ = 0;
+
+    //! Bitmask of the fields which are known to be invalid
+    mutable uint16_t invalid_ = 0;
+};
+
+} // namespace easynmea
+} // namespace eduponz
+
+#endif //_EASYNMEA_GPGGAVIEW_HPP_
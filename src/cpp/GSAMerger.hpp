@@ -0,0 +1,218 @@
+// Copyright (c) 2021 Eduardo Ponz Segrelles.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+/**
+ * @file GSAMerger.hpp
+ */
+
+#ifndef _EASYNMEA_GSAMERGER_HPP_
+#define _EASYNMEA_GSAMERGER_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+#include <easynmea/data.hpp>
+#include <easynmea/types.hpp>
+
+namespace eduponz {
+namespace easynmea {
+
+/**
+ * \struct GSAPart
+ *
+ * @brief Struct for the data of a single GSA sentence, i.e. one constellation of an epoch
+ *
+ * GSA sentences are decoded into a \c GSAPart, and \c GSAMerger merges the parts of each epoch
+ * into a \c GSAData. \c kind is \c NMEA0183DataKind::GSA, as each part belongs to a \c GSAData.
+ */
+struct GSAPart : NMEA0183Data
+{
+    /**
+     *  Default constructor; it empty-initializes the struct, setting \c kind to
+     * \c NMEA0183DataKind::GSA and \c talker to \c NMEA0183Talker::GP
+     */
+    GSAPart() noexcept
+        : NMEA0183Data::NMEA0183Data(NMEA0183DataKind::GSA, NMEA0183Talker::GP)
+        , selection_mode('A')
+        , fix_type(1)
+        , pdop(-1)
+        , hdop(-1)
+        , vdop(-1)
+        , system_id('\0')
+        , prn_count(0)
+        , prns()
+    {
+    }
+
+    //! Selection mode, 'M' for manual or 'A' for automatic
+    char selection_mode;
+
+    //! Fix type, 1 for no fix, 2 for 2D fix, or 3 for 3D fix
+    uint8_t fix_type;
+
+    //! Position dilution of precision, or -1 if not reported
+    float pdop;
+
+    //! Horizontal dilution of precision, or -1 if not reported
+    float hdop;
+
+    //! Vertical dilution of precision, or -1 if not reported
+    float vdop;
+
+    //! GNSS system ID (NMEA 0183 4.10 and later), or '\0' if the sentence does not report it
+    char system_id;
+
+    //! Number of valid entries in \c prns
+    uint8_t prn_count;
+
+    //! Satellite ID numbers of the satellites used in the solution. Only the first \c prn_count are valid
+    uint16_t prns[GSASystem::MAX_SATELLITES];
+};
+
+static_assert(std::is_trivially_copyable<GSAPart>::value, "GSAPart must be trivially copyable");
+
+/**
+ * @class GSAMerger
+ *
+ * This class merges the GSA sentences of an epoch into a single sample.
+ *
+ * The GSA sentences of an epoch are sent one after the other, one per constellation, and all of
+ * them report the same talker, selection mode, fix type, and dilutions of precision. Hence, a part
+ * is merged into the sample in progress as long as it agrees with it on all of those and it does
+ * not repeat one of its GNSS system IDs. Otherwise, the sample in progress is complete, and the
+ * part starts a new one. As the end of an epoch can only be told from the sentence following its
+ * last GSA one, the reader of the sentences must \c flush() the merger whenever it receives any
+ * other sentence. The sample in progress is stored in fixed size storage allocated with the merger,
+ * and it keeps the tag block of its first part.
+ *
+ * \c GSAMerger is not thread safe; it is meant to be fed from the thread which reads the
+ * sentences.
+ */
+class GSAMerger
+{
+public:
+
+    /**
+     * \brief Merge a part into the sample in progress, or start a new sample with it.
+     *
+     * @param[in] part The decoded GSA sentence.
+     * @param[out] merged The \c GSAData to populate with the sample in progress if \c part does not
+     *             belong to it. It is not modified otherwise.
+     * @return \c true if \c part completed the sample in progress, and \c merged was populated;
+     *         \c false otherwise.
+     */
+    bool add(
+            const GSAPart& part,
+            GSAData& merged) noexcept
+    {
+        bool completed = false;
+        if (in_progress_ && !belongs_(part))
+        {
+            completed = flush(merged);
+        }
+
+        if (!in_progress_)
+        {
+            sample_ = GSAData();
+            sample_.talker = part.talker;
+            sample_.tag_block = part.tag_block;
+            sample_.receive_time = part.receive_time;
+            sample_.selection_mode = part.selection_mode;
+            sample_.fix_type = part.fix_type;
+            sample_.pdop = part.pdop;
+            sample_.hdop = part.hdop;
+            sample_.vdop = part.vdop;
+            in_progress_ = true;
+        }
+
+        GSASystem& system = sample_.systems[sample_.system_count++];
+        system.system_id = part.system_id;
+        system.prn_count = 0;
+        for (std::size_t i = 0; i < part.prn_count && i < GSASystem::MAX_SATELLITES; i++)
+        {
+            system.prns[system.prn_count++] = part.prns[i];
+        }
+        return completed;
+    }
+
+    /**
+     * \brief Complete the sample in progress, if any.
+     *
+     * @param[out] merged The \c GSAData to populate with the sample in progress. It is not
+     *             modified if there is none.
+     * @return \c true if there was a sample in progress, and \c merged was populated; \c false
+     *         otherwise.
+     */
+    bool flush(
+            GSAData& merged) noexcept
+    {
+        if (!in_progress_)
+        {
+            return false;
+        }
+        merged = sample_;
+        in_progress_ = false;
+        return true;
+    }
+
+    /**
+     * \brief Discard the sample in progress, if any.
+     */
+    void clear() noexcept
+    {
+        in_progress_ = false;
+    }
+
+protected:
+
+    //! Check whether a part belongs to the sample in progress
+    bool belongs_(
+            const GSAPart& part) const noexcept
+    {
+        if (part.talker != sample_.talker || part.selection_mode != sample_.selection_mode ||
+                part.fix_type != sample_.fix_type || part.pdop != sample_.pdop || part.hdop != sample_.hdop ||
+                part.vdop != sample_.vdop || sample_.system_count >= GSAData::MAX_SYSTEMS)
+        {
+            return false;
+        }
+        if (part.system_id != '\0')
+        {
+            for (std::size_t i = 0; i < sample_.system_count; i++)
+            {
+                if (sample_.systems[i].system_id == part.system_id)
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    //! The sentences merged so far
+    GSAData sample_;
+
+    //! Whether there is a sample in progress
+    bool in_progress_ = false;
+};
+
+} // namespace eduponz
+} // namespace easynmea
+
+#endif //_EASYNMEA_GSAMERGER_HPP_
@@ -0,0 +1,197 @@
+// Copyright (c) 2021 Eduardo Ponz Segrelles.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+/**
+ * @file GSVAssembler.hpp
+ */
+
+#ifndef _EASYNMEA_GSVASSEMBLER_HPP_
+#define _EASYNMEA_GSVASSEMBLER_HPP_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include <easynmea/data.hpp>
+#include <easynmea/types.hpp>
+
+namespace eduponz {
+namespace easynmea {
+
+/**
+ * \struct GSVPart
+ *
+ * @brief Struct for the data of a single GSV sentence, i.e. one part of a group
+ *
+ * GSV sentences are decoded into a \c GSVPart, and \c GSVAssembler reassembles the parts of each
+ * group into a \c GSVData. \c kind is \c NMEA0183DataKind::GSV, as each part belongs to a
+ * \c GSVData.
+ */
+struct GSVPart : NMEA0183Data
+{
+    //! Maximum number of satellites in a single sentence
+    static constexpr std::size_t MAX_SATELLITES = 4;
+
+    /**
+     *  Default constructor; it empty-initializes the struct, setting \c kind to
+     * \c NMEA0183DataKind::GSV and \c talker to \c NMEA0183Talker::GP
+     */
+    GSVPart() noexcept
+        : NMEA0183Data::NMEA0183Data(NMEA0183DataKind::GSV, NMEA0183Talker::GP)
+        , total_parts(0)
+        , part_number(0)
+        , satellites_in_view(0)
+        , signal_id('\0')
+        , satellite_count(0)
+        , satellites()
+    {
+    }
+
+    //! Number of sentences in the group [1; 9]
+    uint8_t total_parts;
+
+    //! Number of this sentence within the group [1; 9]
+    uint8_t part_number;
+
+    //! Number of satellites in view
+    uint8_t satellites_in_view;
+
+    //! Signal ID (NMEA 0183 4.10 and later), or '\0' if the sentence does not report it
+    char signal_id;
+
+    //! Number of valid entries in \c satellites
+    uint8_t satellite_count;
+
+    //! Satellites reported by the sentence. Only the first \c satellite_count are valid
+    GSVSatellite satellites[MAX_SATELLITES];
+};
+
+static_assert(std::is_trivially_copyable<GSVPart>::value, "GSVPart must be trivially copyable");
+static_assert(GSVData::MAX_SATELLITES == 9 * GSVPart::MAX_SATELLITES, "A GSVData must fit a group of nine parts");
+
+/**
+ * @class GSVAssembler
+ *
+ * This class reassembles the parts of GSV groups into satellite tables.
+ *
+ * Each talker sends its group one part after the other, so the assembler keeps a single table in
+ * progress per talker, in storage of fixed size which is allocated with the assembler. A table is
+ * only handed out once the last part of its group has been added. A group whose parts arrive out
+ * of order, or which is interrupted by a new group, is discarded, as its table would be incomplete.
+ * The table keeps the tag block of the first part, as loggers usually tag the first sentence of a
+ * group only.
+ *
+ * \c GSVAssembler is not thread safe; it is meant to be fed from the thread which reads the
+ * sentences.
+ */
+class GSVAssembler
+{
+public:
+
+    /**
+     * \brief Add a part to the table in progress of its talker.
+     *
+     * @param part The decoded GSV sentence.
+     * @return A pointer to the complete table if \c part is the last one of its group; \c nullptr
+     *         otherwise. The pointer is valid until the next call to \c add() or \c clear().
+     */
+    const GSVData* add(
+            const GSVPart& part) noexcept
+    {
+        std::size_t talker = static_cast<std::size_t>(part.talker);
+        if (talker >= slots_.size() || part.total_parts > max_parts_ || part.part_number < 1 ||
+                part.part_number > part.total_parts || part.satellite_count > GSVPart::MAX_SATELLITES)
+        {
+            return nullptr;
+        }
+        Slot_& slot = slots_[talker];
+
+        /* The first part starts a new table, discarding any incomplete one */
+        if (part.part_number == 1)
+        {
+            slot.table = GSVData();
+            slot.table.talker = part.talker;
+            slot.table.tag_block = part.tag_block;
+            slot.table.receive_time = part.receive_time;
+            slot.table.signal_id = part.signal_id;
+            slot.total_parts = part.total_parts;
+            slot.next_part = 1;
+        }
+
+        /* Any other part must follow the previous one of the same group */
+        if (part.part_number != slot.next_part || part.total_parts != slot.total_parts ||
+                part.signal_id != slot.table.signal_id)
+        {
+            slot.next_part = 0;
+            return nullptr;
+        }
+
+        for (std::size_t i = 0; i < part.satellite_count; i++)
+        {
+            slot.table.satellites[slot.table.satellite_count++] = part.satellites[i];
+        }
+        slot.table.satellites_in_view = part.satellites_in_view;
+
+        if (part.part_number == part.total_parts)
+        {
+            slot.next_part = 0;
+            return &slot.table;
+        }
+        slot.next_part++;
+        return nullptr;
+    }
+
+    /**
+     * \brief Discard all the tables in progress.
+     */
+    void clear() noexcept
+    {
+        for (Slot_& slot : slots_)
+        {
+            slot.next_part = 0;
+        }
+    }
+
+protected:
+
+    //! Maximum number of parts of a group
+    static constexpr uint8_t max_parts_ = GSVData::MAX_SATELLITES / GSVPart::MAX_SATELLITES;
+
+    //! Table in progress of a talker
+    struct Slot_
+    {
+        //! The satellites of the parts added so far
+        GSVData table;
+
+        //! Number of parts of the group
+        uint8_t total_parts = 0;
+
+        //! Number of the next expected part, or 0 if there is no table in progress
+        uint8_t next_part = 0;
+    };
+
+    //! Tables in progress, indexed by \c NMEA0183Talker
+    std::array<Slot_, static_cast<std::size_t>(NMEA0183Talker::GN) + 1> slots_;
+};
+
+} // namespace eduponz
+} // namespace easynmea
+
+#endif //_EASYNMEA_GSVASSEMBLER_HPP_
@@ -0,0 +1,369 @@
+// Copyright (c) 2021 Eduardo Ponz Segrelles.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+/**
+ * @file IoUring.hpp
+ */
+
+#ifndef _EASYNMEA_IOURING_HPP_
+#define _EASYNMEA_IOURING_HPP_
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#define EASYNMEA_HAVE_IO_URING 1
+// Defined by <linux/fs.h>, which <linux/io_uring.h> includes, it would clash with StructuralIndex::BLOCK_SIZE
+#undef BLOCK_SIZE
+#endif  // __has_include(<linux/io_uring.h>)
+
+#include <asio/error.hpp>
+#include <asio/error_code.hpp>
+
+namespace eduponz {
+namespace easynmea {
+
+#if defined(EASYNMEA_HAVE_IO_URING)
+
+/**
+ * @class IoUring
+ *
+ * This class is a minimal io_uring instance, set up and driven through the raw system calls, so
+ * that no library is needed on top of the kernel headers.
+ *
+ * Submission queue entries are taken with \c get_sqe(), filled in by the caller, and submitted
+ * all together by the next \c submit_and_wait(), which also waits for completions. Completions are
+ * reaped in batches with \c for_each_cqe().
+ *
+ * It is not thread safe: a single thread at a time may take entries, submit them and reap them.
+ */
+class IoUring
+{
+public:
+
+    /**
+     * Constructor. The ring is not usable until \c setup() succeeds.
+     */
+    IoUring() noexcept
+        : ring_fd_(-1)
+        , sq_ring_(MAP_FAILED)
+        , cq_ring_(MAP_FAILED)
+        , sq_ring_size_(0)
+        , cq_ring_size_(0)
+        , sqes_(static_cast<io_uring_sqe*>(MAP_FAILED))
+        , sqes_size_(0)
+        , sq_tail_(0)
+        , sq_submitted_(0)
+        , sq_head_(nullptr)
+        , sq_tail_ptr_(nullptr)
+        , sq_mask_(0)
+        , sq_entries_(0)
+        , cq_head_(nullptr)
+        , cq_tail_(nullptr)
+        , cq_mask_(0)
+        , cqes_(nullptr)
+    {
+    }
+
+    IoUring(
+            const IoUring&) = delete;
+
+    IoUring& operator =(
+            const IoUring&) = delete;
+
+    /**
+     * Destructor. Destroying the ring cancels the requests in flight, if any.
+     */
+    ~IoUring() noexcept
+    {
+        if (sqes_ != MAP_FAILED)
+        {
+            ::munmap(sqes_, sqes_size_);
+        }
+        if (cq_ring_ != MAP_FAILED && cq_ring_ != sq_ring_)
+        {
+            ::munmap(cq_ring_, cq_ring_size_);
+        }
+        if (sq_ring_ != MAP_FAILED)
+        {
+            ::munmap(sq_ring_, sq_ring_size_);
+        }
+        if (ring_fd_ != -1)
+        {
+            ::close(ring_fd_);
+        }
+    }
+
+    /**
+     * \brief Set the ring up.
+     *
+     * It fails with \c asio::error::operation_not_supported on kernels which cannot read from the
+     * current file position (before Linux 5.6), or which may drop completions.
+     *
+     * @param entries The number of submission queue entries. It is rounded up to a power of two.
+     * @param[out] ec The \c errno of the failing system call, e.g. \c ENOSYS if the kernel does not
+     *             support io_uring, or \c EPERM if it is disabled.
+     * @return true if the ring was set up; false otherwise.
+     */
+    bool setup(
+            unsigned entries,
+            asio::error_code& ec) noexcept
+    {
+        ec.clear();
+        io_uring_params params;
+        std::memset(&params, 0, sizeof(params));
+        ring_fd_ = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+        if (ring_fd_ == -1)
+        {
+            ec = errno_error_();
+            return false;
+        }
+        if (!(params.features & IORING_FEAT_RW_CUR_POS) || !(params.features & IORING_FEAT_NODROP))
+        {
+            ec = asio::error::operation_not_supported;
+            return false;
+        }
+
+        sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+        cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+        if (single_mmap)
+        {
+            sq_ring_size_ = cq_ring_size_ = sq_ring_size_ > cq_ring_size_ ? sq_ring_size_ : cq_ring_size_;
+        }
+        sq_ring_ = ::mmap(nullptr, sq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_,
+                        IORING_OFF_SQ_RING);
+        if (sq_ring_ == MAP_FAILED)
+        {
+            ec = errno_error_();
+            return false;
+        }
+        cq_ring_ = single_mmap ? sq_ring_ :
+                ::mmap(nullptr, cq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_,
+                        IORING_OFF_CQ_RING);
+        if (cq_ring_ == MAP_FAILED)
+        {
+            ec = errno_error_();
+            return false;
+        }
+        sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+        sqes_ = static_cast<io_uring_sqe*>(::mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE,
+                MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQES));
+        if (sqes_ == MAP_FAILED)
+        {
+            ec = errno_error_();
+            return false;
+        }
+
+        char* sq = static_cast<char*>(sq_ring_);
+        sq_head_ = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+        sq_tail_ptr_ = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        sq_mask_ = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        sq_entries_ = params.sq_entries;
+        // Entries are always submitted in order, so the indirection array is the identity
+        unsigned* sq_array = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+        for (unsigned i = 0; i < sq_entries_; i++)
+        {
+            sq_array[i] = i;
+        }
+        sq_tail_ = *sq_tail_ptr_;
+        sq_submitted_ = sq_tail_;
+
+        char* cq = static_cast<char*>(cq_ring_);
+        cq_head_ = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        cq_tail_ = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        cq_mask_ = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        cqes_ = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+        return true;
+    }
+
+    /**
+     * \brief Register the buffers which fixed reads read into, so that they are not mapped on
+     *        every read.
+     *
+     * @param buffers The buffers.
+     * @param count The number of buffers.
+     * @param[out] ec The \c errno of \c io_uring_register().
+     * @return true if the buffers were registered; false otherwise.
+     */
+    bool register_buffers(
+            const iovec* buffers,
+            unsigned count,
+            asio::error_code& ec) noexcept
+    {
+        ec.clear();
+        if (::syscall(__NR_io_uring_register, ring_fd_, IORING_REGISTER_BUFFERS, buffers, count) == -1)
+        {
+            ec = errno_error_();
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * \brief Take the next submission queue entry, zeroed.
+     *
+     * @return The entry, or nullptr if the submission queue is full.
+     */
+    io_uring_sqe* get_sqe() noexcept
+    {
+        unsigned head = __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+        if (sq_tail_ - head >= sq_entries_)
+        {
+            return nullptr;
+        }
+        io_uring_sqe* sqe = &sqes_[sq_tail_ & sq_mask_];
+        std::memset(sqe, 0, sizeof(*sqe));
+        sq_tail_++;
+        return sqe;
+    }
+
+    /**
+     * \brief Submit the entries taken since the previous call, and wait for completions.
+     *
+     * @param wait_nr The number of completions to wait for. 0 just submits.
+     * @param[out] ec The \c errno of \c io_uring_enter().
+     * @return true if the entries were submitted and the completions arrived; false otherwise.
+     */
+    bool submit_and_wait(
+            unsigned wait_nr,
+            asio::error_code& ec) noexcept
+    {
+        ec.clear();
+        __atomic_store_n(sq_tail_ptr_, sq_tail_, __ATOMIC_RELEASE);
+        while (true)
+        {
+            unsigned to_submit = sq_tail_ - sq_submitted_;
+            long submitted = ::syscall(__NR_io_uring_enter, ring_fd_, to_submit, wait_nr,
+                            wait_nr > 0 ? IORING_ENTER_GETEVENTS : 0, nullptr, 0);
+            if (submitted >= 0)
+            {
+                sq_submitted_ += static_cast<unsigned>(submitted);
+                if (sq_submitted_ == sq_tail_)
+                {
+                    return true;
+                }
+                continue;
+            }
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            ec = errno_error_();
+            return false;
+        }
+    }
+
+    /**
+     * \brief Reap all the available completions.
+     *
+     * @param on_cqe Function called with each completion queue entry. The entry is only valid
+     *        during the call.
+     * @return The number of reaped completions.
+     */
+    template<class Function>
+    unsigned for_each_cqe(
+            Function on_cqe) noexcept
+    {
+        unsigned head = *cq_head_;
+        unsigned tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+        unsigned reaped = tail - head;
+        for (; head != tail; head++)
+        {
+            on_cqe(cqes_[head & cq_mask_]);
+        }
+        __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+        return reaped;
+    }
+
+protected:
+
+    //! File descriptor of the ring
+    int ring_fd_;
+
+    //! Mapping of the submission queue ring
+    void* sq_ring_;
+
+    //! Mapping of the completion queue ring. It is sq_ring_ when the kernel maps both at once
+    void* cq_ring_;
+
+    //! Size of sq_ring_
+    std::size_t sq_ring_size_;
+
+    //! Size of cq_ring_
+    std::size_t cq_ring_size_;
+
+    //! Mapping of the submission queue entries
+    io_uring_sqe* sqes_;
+
+    //! Size of sqes_
+    std::size_t sqes_size_;
+
+    //! Tail of the submission queue, including the entries which are not published yet
+    unsigned sq_tail_;
+
+    //! Tail of the submission queue up to which the entries have been submitted
+    unsigned sq_submitted_;
+
+    //! Kernel owned head of the submission queue
+    unsigned* sq_head_;
+
+    //! Published tail of the submission queue
+    unsigned* sq_tail_ptr_;
+
+    //! Mask of the submission queue indices
+    unsigned sq_mask_;
+
+    //! Number of submission queue entries
+    unsigned sq_entries_;
+
+    //! Head of the completion queue
+    unsigned* cq_head_;
+
+    //! Kernel owned tail of the completion queue
+    unsigned* cq_tail_;
+
+    //! Mask of the completion queue indices
+    unsigned cq_mask_;
+
+    //! Completion queue entries
+    io_uring_cqe* cqes_;
+
+    //! Error code of the current errno
+    static asio::error_code errno_error_() noexcept
+    {
+        return asio::error_code(errno, asio::error::get_system_category());
+    }
+
+};
+
+#endif  // defined(EASYNMEA_HAVE_IO_URING)
+
+} // namespace eduponz
+} // namespace easynmea
+
+#endif  /* _EASYNMEA_IOURING_HPP_ */
@@ -0,0 +1,141 @@
+// Copyright (c) 2021 Eduardo Ponz Segrelles.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+/**
+ * @file LatestSample.hpp
+ */
+
+#ifndef _EASYNMEA_LATESTSAMPLE_HPP_
+#define _EASYNMEA_LATESTSAMPLE_HPP_
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace eduponz {
+namespace easynmea {
+
+/**
+ * @class LatestSample
+ *
+ * This template class holds the latest sample of a data kind, which any number of threads can read
+ * while a single thread overwrites it, without any of them ever blocking.
+ *
+ * It is a sequence lock: the writer makes the sequence number odd while it copies the sample, and
+ * even again once the copy is complete, so a reader retries whenever the sequence number was odd
+ * or changed while it copied the sample. The sample is stored in atomic words, so a torn copy is
+ * never undefined behaviour, only discarded. Neither \c store() nor \c load() allocate memory or
+ * perform any system call, so the writer is never delayed by the readers.
+ *
+ * @tparam T The type of the samples. It must be trivially copyable.
+ */
+template<class T>
+class LatestSample
+{
+public:
+
+    static_assert(std::is_trivially_copyable<T>::value, "The samples must be trivially copyable");
+
+    /**
+     * \brief Overwrite the sample.
+     *
+     * \pre It is only called from one thread at a time.
+     *
+     * @param sample The new sample.
+     */
+    void store(
+            const T& sample) noexcept
+    {
+        Words words{};
+        std::memcpy(words.data(), &sample, sizeof(T));
+
+        uint64_t sequence = sequence_.load(std::memory_order_relaxed);
+        sequence_.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (std::size_t i = 0; i < WORDS; i++)
+        {
+            words_[i].store(words[i], std::memory_order_relaxed);
+        }
+        sequence_.store(sequence + 2, std::memory_order_release);
+    }
+
+    /**
+     * \brief Copy the sample.
+     *
+     * @param[out] sample The copy of the sample. It is left untouched if there is no sample.
+     * @return \c true if a sample has been stored since the last \c clear(); \c false otherwise.
+     */
+    bool load(
+            T& sample) const noexcept
+    {
+        Words words;
+        uint64_t before;
+        uint64_t after;
+        do
+        {
+            before = sequence_.load(std::memory_order_acquire);
+            if (before == 0)
+            {
+                return false;
+            }
+            for (std::size_t i = 0; i < WORDS; i++)
+            {
+                words[i] = words_[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            after = sequence_.load(std::memory_order_relaxed);
+        } while ((before & 1) != 0 || before != after);
+
+        std::memcpy(static_cast<void*>(&sample), words.data(), sizeof(T));
+        return true;
+    }
+
+    /**
+     * \brief Discard the sample, if any.
+     *
+     * \pre It is not called concurrently with \c store().
+     */
+    void clear() noexcept
+    {
+        sequence_.store(0, std::memory_order_release);
+    }
+
+protected:
+
+    //! Number of words in which a sample is stored
+    static constexpr std::size_t WORDS = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    //! A sample as plain words
+    using Words = std::array<uint64_t, WORDS>;
+
+    //! Sequence number: odd while the sample is being written, and 0 if there is no sample. It is 64
+    //! bits wide so that it never wraps back to 0, which a 32 bit one would after 2^31 samples
+    std::atomic<uint64_t> sequence_{0};
+
+    //! The sample, stored word by word
+    std::array<std::atomic<uint64_t>, WORDS> words_{};
+};
+
+} // namespace eduponz
+} // namespace easynmea
+
+#endif //_EASYNMEA_LATESTSAMPLE_HPP_
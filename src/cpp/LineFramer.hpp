@@ -0,0 +1,98 @@
+// Copyright (c) 2021 Eduardo Ponz Segrelles.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+/**
+ * @file LineFramer.hpp
+ */
+
+#ifndef _EASYNMEA_LINEFRAMER_HPP_
+#define _EASYNMEA_LINEFRAMER_HPP_
+
+#include <cstring>
+#include <string>
+
+namespace eduponz {
+namespace easynmea {
+
+/**
+ * @class LineFramer
+ *
+ * This class provides static APIs to frame lines, terminated either in \c '\n' or \c '\r\n', out
+ * of the chunks of bytes read from a port or a file. It is shared by \c SerialInterface and
+ * \c UringReader, so that both of them hand over the same lines.
+ *
+ * A line may span several chunks, so the bytes are appended to it until its \c '\n' is found.
+ */
+class LineFramer
+{
+public:
+
+    /**
+     * \brief Append the bytes of a chunk up to the end of the next line to a line.
+     *
+     * The \c '\r' characters and the \c '\n' which ends the line are left out.
+     *
+     * @param[in, out] line The line to which the bytes are appended
+     * @param begin Pointer to the first byte of the chunk which has not been framed yet
+     * @param end Pointer past the last byte of the chunk
+     * @return Pointer past the \c '\n' which ends the line, or nullptr if there is no \c '\n' in
+     *         [begin, end), in which case all of the bytes are appended.
+     */
+    static const char* frame(
+            std::string& line,
+            const char* begin,
+            const char* end) noexcept
+    {
+        const char* line_end = static_cast<const char*>(std::memchr(begin, '\n', end - begin));
+        if (line_end == nullptr)
+        {
+            append(line, begin, end);
+            return nullptr;
+        }
+        append(line, begin, line_end);
+        return line_end + 1;
+    }
+
+    /**
+     * \brief Append the characters in [begin, end) to a line, leaving out the \c '\r' ones.
+     *
+     * @param[in, out] line The line to which the characters are appended
+     * @param begin Pointer to the first character
+     * @param end Pointer past the last character
+     */
+    static void append(
+            std::string& line,
+            const char* begin,
+            const char* end) noexcept
+    {
+        while (begin != end)
+        {
+            const char* carriage_return = static_cast<const char*>(std::memchr(begin, '\r', end - begin));
+            const char* last = carriage_return != nullptr ? carriage_return : end;
+            line.append(begin, last);
+            begin = carriage_return != nullptr ? carriage_return + 1 : end;
+        }
+    }
+
+};
+
+} // namespace easynmea
+} // namespace eduponz
+
+#endif  /* _EASYNMEA_LINEFRAMER_HPP_ */
@@ -0,0 +1,148 @@
+// Copyright (c) 2021 Eduardo Ponz Segrelles.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+/**
+ * @file PerfectHashTable.hpp
+ */
+
+#ifndef _EASYNMEA_PERFECTHASHTABLE_HPP_
+#define _EASYNMEA_PERFECTHASHTABLE_HPP_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace eduponz {
+namespace easynmea {
+
+/**
+ * @class PerfectHashTable
+ *
+ * Immutable lookup table from 32 bit keys to values, built at compile time.
+ *
+ * The keys are hashed with a multiplicative hash, whose multiplier is searched for at compile time so
+ * that no two keys share a slot. Hence, a lookup consists of one multiplication, one shift, and one
+ * comparison, and it never allocates memory.
+ *
+ * @tparam Value The type of the values. It must be a literal type which is default constructible.
+ * @tparam N The number of keys.
+ * @tparam Bits The base 2 logarithm of the number of slots.
+ */
+template<class Value, std::size_t N, unsigned Bits = 5>
+class PerfectHashTable
+{
+public:
+
+    static_assert(N <= (std::size_t(1) << Bits), "There cannot be more keys than slots");
+    static_assert(Bits > 0 && Bits < 32, "The number of slots must be a power of 2 between 2 and 2^31");
+
+    //! A key and its value
+    struct Item
+    {
+        uint32_t key;
+        Value value;
+    };
+
+    /**
+     * Build the table.
+     *
+     * @param items The keys and their values. The keys must be unique.
+     */
+    constexpr PerfectHashTable(
+            const std::array<Item, N>& items)
+        : multiplier_(find_multiplier_(items))
+        , slots_()
+    {
+        for (const Item& item : items)
+        {
+            Slot& slot = slots_[slot_(item.key, multiplier_)];
+            slot.key = item.key;
+            slot.value = item.value;
+            slot.used = true;
+        }
+    }
+
+    /**
+     * Look up a key.
+     *
+     * @param key The key to look up.
+     * @return A pointer to the value of the key, or \c nullptr if the key is not in the table.
+     */
+    constexpr const Value* find(
+            uint32_t key) const noexcept
+    {
+        const Slot& slot = slots_[slot_(key, multiplier_)];
+        return (slot.used && slot.key == key) ? &slot.value : nullptr;
+    }
+
+private:
+
+    //! A slot of the table
+    struct Slot
+    {
+        uint32_t key = 0;
+        Value value = {};
+        bool used = false;
+    };
+
+    //! Number of slots
+    static constexpr std::size_t SIZE = std::size_t(1) << Bits;
+
+    //! Slot of a key for a given multiplier
+    static constexpr std::size_t slot_(
+            uint32_t key,
+            uint32_t multiplier) noexcept
+    {
+        return static_cast<std::size_t>(static_cast<uint32_t>(key * multiplier) >> (32 - Bits));
+    }
+
+    //! Find a multiplier for which no two keys share a slot
+    static constexpr uint32_t find_multiplier_(
+            const std::array<Item, N>& items)
+    {
+        // Start from the golden ratio, and try the following odd numbers
+        for (uint32_t multiplier = 0x9E3779B1u;; multiplier += 2)
+        {
+            bool collision = false;
+            for (std::size_t i = 0; i < N && !collision; i++)
+            {
+                for (std::size_t j = i + 1; j < N && !collision; j++)
+                {
+                    collision = slot_(items[i].key, multiplier) == slot_(items[j].key, multiplier);
+                }
+            }
+            if (!collision)
+            {
+                return multiplier;
+            }
+        }
+    }
+
+    //! The multiplier of the hash
+    uint32_t multiplier_;
+
+    //! The slots of the table
+    std::array<Slot, SIZE> slots_;
+};
+
+} // namespace easynmea
+} // namespace eduponz
+
+#endif //_EASYNMEA_PERFECTHASHTABLE_HPP_
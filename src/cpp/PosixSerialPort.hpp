@@ -0,0 +1,626 @@
+// Copyright (c) 2021 Eduardo Ponz Segrelles.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+/**
+ * @file PosixSerialPort.hpp
+ */
+
+#ifndef _EASYNMEA_POSIXSERIALPORT_HPP_
+#define _EASYNMEA_POSIXSERIALPORT_HPP_
+
+#include <cerrno>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include <asio/buffer.hpp>
+#include <asio/error.hpp>
+#include <asio/error_code.hpp>
+#include <asio/io_service.hpp>
+#include <asio/serial_port_base.hpp>
+
+#include <easynmea/types.hpp>
+
+namespace eduponz {
+namespace easynmea {
+
+/**
+ * @class PosixSerialPort
+ *
+ * This class is a Linux-native \c SerialPort implementation for \c SerialInterface, which reads
+ * from the tty without going through Asio's reactor.
+ *
+ * The tty is opened raw (\c cfmakeraw()) and non-blocking, with the \c VMIN of its \c ReadProfile,
+ * and it is read after waiting for it to be readable on an \c epoll instance. Then, if the profile
+ * has a \c VTIME, the reader sleeps for it before reading, so that the tty buffers the rest of the
+ * burst meanwhile. Every read takes all the bytes the tty has buffered, up to the buffer size.
+ *
+ * \c async_read_some() posts the wait and the read to the \c asio::io_service, so they run on the
+ * thread which runs it, as the completion handler does. \c close() can be called from any other
+ * thread: it wakes the wait up through an \c eventfd registered on the same \c epoll instance, and
+ * the handler is called with \c asio::error::operation_aborted.
+ */
+class PosixSerialPort
+{
+public:
+
+    /**
+     * Constructor.
+     *
+     * @param io_service The I/O service on which the reads are posted.
+     */
+    PosixSerialPort(
+            asio::io_service& io_service) noexcept
+        : io_service_(io_service)
+        , fd_(-1)
+        , epoll_fd_(::epoll_create1(EPOLL_CLOEXEC))
+        , wake_fd_(::eventfd(0, static_cast<int>(EFD_CLOEXEC) | static_cast<int>(EFD_NONBLOCK)))
+        , profile_(ReadProfile::lowest_latency())
+        , backlog_(false)
+    {
+        if (epoll_fd_ == -1 || wake_fd_ == -1)
+        {
+            setup_error_ = errno_error_();
+            return;
+        }
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.fd = wake_fd_;
+        if (::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, wake_fd_, &event) == -1)
+        {
+            setup_error_ = errno_error_();
+        }
+    }
+
+    PosixSerialPort(
+            const PosixSerialPort&) = delete;
+
+    PosixSerialPort& operator =(
+            const PosixSerialPort&) = delete;
+
+    /**
+     * Destructor. It closes the tty if it is open.
+     */
+    ~PosixSerialPort() noexcept
+    {
+        asio::error_code ec;
+        close(ec);
+        if (wake_fd_ != -1)
+        {
+            ::close(wake_fd_);
+        }
+        if (epoll_fd_ != -1)
+        {
+            ::close(epoll_fd_);
+        }
+    }
+
+    /**
+     * \brief Open a tty raw and non-blocking, applying the current \c ReadProfile to it.
+     *
+     * @param device The path to the tty, e.g. "/dev/ttyUSB0".
+     * @param[out] ec \c asio::error::already_open if the port was already open, or the \c errno of
+     *             the failing system call.
+     */
+    void open(
+            const std::string& device,
+            asio::error_code& ec) noexcept
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ec = setup_error_;
+        if (ec)
+        {
+            return;
+        }
+        if (fd_ != -1)
+        {
+            ec = asio::error::already_open;
+            return;
+        }
+
+        int fd = open_tty(device, profile_.vmin, O_NONBLOCK, ec);
+        if (fd == -1)
+        {
+            return;
+        }
+
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.fd = fd;
+        if (::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event) == -1)
+        {
+            ec = errno_error_();
+            ::close(fd);
+            return;
+        }
+        fd_ = fd;
+        backlog_ = false;
+    }
+
+    /**
+     * \brief Check whether the tty is open.
+     *
+     * @return true if it is open; false otherwise.
+     */
+    bool is_open() noexcept
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return fd_ != -1;
+    }
+
+    /**
+     * \brief Set the input and output speed of the tty.
+     *
+     * @param baudrate The speed, which must be one of the termios standard ones.
+     * @param[out] ec \c asio::error::invalid_argument if the speed is not a termios one,
+     *             \c asio::error::bad_descriptor if the port is not open, or the \c errno of the
+     *             failing system call.
+     */
+    void set_option(
+            asio::serial_port_base::baud_rate baudrate,
+            asio::error_code& ec) noexcept
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (fd_ == -1)
+        {
+            ec = asio::error::bad_descriptor;
+            return;
+        }
+        set_baud_rate(fd_, baudrate.value(), ec);
+    }
+
+    /**
+     * \brief Set how many bytes the tty buffers before waking the reader up.
+     *
+     * The profile is kept for the following calls to \c open(), and it is applied right away if
+     * the port is already open.
+     *
+     * @param profile The new profile. Its \c vmin must not be 0.
+     * @param[out] ec \c asio::error::invalid_argument if the \c vmin is 0, or the \c errno of the
+     *             failing system call.
+     */
+    void set_option(
+            const ReadProfile& profile,
+            asio::error_code& ec) noexcept
+    {
+        ec.clear();
+        if (profile.vmin == 0)
+        {
+            ec = asio::error::invalid_argument;
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (fd_ != -1)
+        {
+            termios options;
+            if (!get_attributes_(options, ec))
+            {
+                return;
+            }
+            options.c_cc[VMIN] = profile.vmin;
+            if (!set_attributes_(options, ec))
+            {
+                return;
+            }
+        }
+        profile_ = profile;
+    }
+
+    /**
+     * \brief Get the profile applied to the tty.
+     *
+     * @return The profile.
+     */
+    ReadProfile read_profile() noexcept
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return profile_;
+    }
+
+    /**
+     * \brief Close the tty, aborting the read in progress, if any.
+     *
+     * @param[out] ec The \c errno of \c close(), if it fails. Closing a port which is not open is
+     *             not an error.
+     */
+    void close(
+            asio::error_code& ec) noexcept
+    {
+        ec.clear();
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (fd_ == -1)
+        {
+            return;
+        }
+        ::epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd_, nullptr);
+        if (::close(fd_) == -1)
+        {
+            ec = errno_error_();
+        }
+        fd_ = -1;
+
+        // Wake up the wait in progress, if any, so that it notices that the port is closed
+        uint64_t wake_up = 1;
+        static_cast<void>(::write(wake_fd_, &wake_up, sizeof(wake_up)));
+    }
+
+    /**
+     * \brief Open a tty raw, so that the bytes are read as they are received.
+     *
+     * @param device The path to the tty, e.g. "/dev/ttyUSB0".
+     * @param vmin The number of bytes the tty buffers before it is readable (termios VMIN). The
+     *        termios VTIME is set to 0.
+     * @param flags Flags of \c open() on top of \c O_RDWR, \c O_NOCTTY and \c O_CLOEXEC, e.g.
+     *        \c O_NONBLOCK.
+     * @param[out] ec The \c errno of the failing system call.
+     * @return The file descriptor of the tty, or -1 if it could not be opened.
+     */
+    static int open_tty(
+            const std::string& device,
+            uint8_t vmin,
+            int flags,
+            asio::error_code& ec) noexcept
+    {
+        ec.clear();
+        int fd = ::open(device.c_str(), O_RDWR | O_NOCTTY | O_CLOEXEC | flags);
+        if (fd == -1)
+        {
+            ec = errno_error_();
+            return -1;
+        }
+
+        termios options;
+        if (::tcgetattr(fd, &options) == -1)
+        {
+            ec = errno_error_();
+            ::close(fd);
+            return -1;
+        }
+        ::cfmakeraw(&options);
+        options.c_cflag |= CLOCAL | CREAD;
+        options.c_cc[VMIN] = vmin;
+        options.c_cc[VTIME] = 0;
+        if (::tcsetattr(fd, TCSANOW, &options) == -1)
+        {
+            ec = errno_error_();
+            ::close(fd);
+            return -1;
+        }
+        return fd;
+    }
+
+    /**
+     * \brief Set the input and output speed of an open tty.
+     *
+     * @param fd The file descriptor of the tty.
+     * @param baudrate The speed, which must be one of the termios standard ones.
+     * @param[out] ec \c asio::error::invalid_argument if the speed is not a termios one, or the
+     *             \c errno of the failing system call.
+     * @return true if the speed was set; false otherwise.
+     */
+    static bool set_baud_rate(
+            int fd,
+            unsigned int baudrate,
+            asio::error_code& ec) noexcept
+    {
+        ec.clear();
+        speed_t speed;
+        if (!to_speed_(baudrate, speed))
+        {
+            ec = asio::error::invalid_argument;
+            return false;
+        }
+        termios options;
+        if (::tcgetattr(fd, &options) == -1)
+        {
+            ec = errno_error_();
+            return false;
+        }
+        ::cfsetispeed(&options, speed);
+        ::cfsetospeed(&options, speed);
+        if (::tcsetattr(fd, TCSANOW, &options) == -1)
+        {
+            ec = errno_error_();
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * \brief Read as many bytes as the tty has buffered, once it has buffered as many as the
+     *        \c ReadProfile asks for.
+     *
+     * The wait and the read are posted to the \c asio::io_service, and the handler is called right
+     * after them, on the thread which runs it.
+     *
+     * @param buffers The buffer in which the bytes are stored.
+     * @param handler The completion handler, which is called with the error code and the number of
+     *        read bytes. The error code is \c asio::error::operation_aborted if the port is closed,
+     *        and \c asio::error::eof if the other end of the tty hangs up.
+     */
+    template<class Handler>
+    void async_read_some(
+            const asio::mutable_buffers_1& buffers,
+            Handler handler) noexcept
+    {
+        char* data = static_cast<char*>(buffers.data());
+        std::size_t size = buffers.size();
+        io_service_.post([this, data, size, handler]()
+                {
+                    asio::error_code ec;
+                    std::size_t bytes_transferred = read_some_(data, size, ec);
+                    handler(ec, bytes_transferred);
+                });
+    }
+
+protected:
+
+    //! I/O service on which the reads are posted
+    asio::io_service& io_service_;
+
+    //! Guards fd_ and profile_, which are used both by the reading thread and by close()
+    std::mutex mutex_;
+
+    //! File descriptor of the tty. -1 when the port is closed
+    int fd_;
+
+    //! The epoll instance on which the tty and wake_fd_ are waited for
+    int epoll_fd_;
+
+    //! eventfd written by close() to wake the wait up
+    int wake_fd_;
+
+    //! Error on the creation of epoll_fd_ or wake_fd_, which is returned by open()
+    asio::error_code setup_error_;
+
+    //! Profile applied to the tty
+    ReadProfile profile_;
+
+    //! Whether the last read filled the buffer, so the tty may have more bytes buffered already
+    bool backlog_;
+
+    /**
+     * Wait until the tty is readable as per profile_, and read all the bytes it has buffered, up to
+     * \c size.
+     *
+     * @param[out] data Buffer in which the read bytes are stored
+     * @param size Size of \c data
+     * @param[out] ec The error code of the read
+     * @return The number of read bytes, which is 0 when nothing is read
+     */
+    std::size_t read_some_(
+            char* data,
+            std::size_t size,
+            asio::error_code& ec) noexcept
+    {
+        ec.clear();
+        while (true)
+        {
+            int window;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (fd_ == -1)
+                {
+                    ec = asio::error::operation_aborted;
+                    return 0;
+                }
+                window = backlog_ ? 0 : profile_.vtime * 100;
+            }
+
+            if (!wait_readable_(ec))
+            {
+                return 0;
+            }
+            if (window > 0)
+            {
+                // The rest of the burst is buffered by the tty without waking this thread up
+                pollfd wake{wake_fd_, POLLIN, 0};
+                if (::poll(&wake, 1, window) == 1)
+                {
+                    uint64_t wake_ups;
+                    static_cast<void>(::read(wake_fd_, &wake_ups, sizeof(wake_ups)));
+                }
+            }
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (fd_ == -1)
+            {
+                ec = asio::error::operation_aborted;
+                return 0;
+            }
+            std::size_t bytes_transferred = 0;
+            ssize_t bytes;
+            do
+            {
+                // The tty hands at most 64 bytes per read over when fewer than its VMIN are asked for,
+                // so reads are repeated until it has no more bytes buffered
+                bytes = ::read(fd_, data + bytes_transferred, size - bytes_transferred);
+                bytes_transferred += bytes > 0 ? static_cast<std::size_t>(bytes) : 0;
+            } while (bytes > 0 && bytes_transferred < size && (profile_.vmin > 1 || profile_.vtime > 0));
+
+            if (bytes_transferred > 0)
+            {
+                backlog_ = bytes_transferred == size;
+                return bytes_transferred;
+            }
+            if (bytes == 0 || errno == EIO)
+            {
+                // The other end of the tty hung up
+                ec = asio::error::eof;
+                return 0;
+            }
+            if (errno != EAGAIN && errno != EINTR)
+            {
+                ec = errno_error_();
+                return 0;
+            }
+            backlog_ = false;
+        }
+    }
+
+    /**
+     * Wait until the tty is readable as per its VMIN, or the port is closed.
+     *
+     * @param[out] ec \c asio::error::operation_aborted if the port is closed, or the \c errno of
+     *             \c epoll_wait()
+     * @return true if the tty is readable; false otherwise
+     */
+    bool wait_readable_(
+            asio::error_code& ec) noexcept
+    {
+        while (true)
+        {
+            epoll_event events[2];
+            int ready = ::epoll_wait(epoll_fd_, events, 2, -1);
+            if (ready == -1)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                ec = errno_error_();
+                return false;
+            }
+
+            bool tty_ready = false;
+            for (int i = 0; i < ready; i++)
+            {
+                if (events[i].data.fd == wake_fd_)
+                {
+                    uint64_t wake_ups;
+                    static_cast<void>(::read(wake_fd_, &wake_ups, sizeof(wake_ups)));
+                }
+                else
+                {
+                    tty_ready = true;
+                }
+            }
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (fd_ == -1)
+            {
+                ec = asio::error::operation_aborted;
+                return false;
+            }
+            if (tty_ready)
+            {
+                return true;
+            }
+            // Woken up by a close() which the port has been reopened after
+        }
+    }
+
+    /**
+     * Get the attributes of the open tty.
+     *
+     * @param[out] options The attributes
+     * @param[out] ec \c asio::error::bad_descriptor if the port is not open, or the \c errno of
+     *             \c tcgetattr()
+     * @return true if the attributes were got; false otherwise
+     */
+    bool get_attributes_(
+            termios& options,
+            asio::error_code& ec) noexcept
+    {
+        ec.clear();
+        if (fd_ == -1)
+        {
+            ec = asio::error::bad_descriptor;
+            return false;
+        }
+        if (::tcgetattr(fd_, &options) == -1)
+        {
+            ec = errno_error_();
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * Set the attributes of the open tty.
+     *
+     * @param options The attributes
+     * @param[out] ec The \c errno of \c tcsetattr()
+     * @return true if the attributes were set; false otherwise
+     */
+    bool set_attributes_(
+            const termios& options,
+            asio::error_code& ec) noexcept
+    {
+        ec.clear();
+        if (::tcsetattr(fd_, TCSANOW, &options) == -1)
+        {
+            ec = errno_error_();
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * Convert a baud rate to its termios speed.
+     *
+     * @param baudrate The baud rate
+     * @param[out] speed The termios speed
+     * @return true if \c baudrate is a termios speed; false otherwise
+     */
+    static bool to_speed_(
+            unsigned int baudrate,
+            speed_t& speed) noexcept
+    {
+        static constexpr struct
+        {
+            unsigned int baudrate;
+            speed_t speed;
+        } speeds[] = {
+            {1200, B1200}, {2400, B2400}, {4800, B4800}, {9600, B9600}, {19200, B19200},
+            {38400, B38400}, {57600, B57600}, {115200, B115200}, {230400, B230400},
+            {460800, B460800}, {921600, B921600}};
+
+        for (const auto& entry : speeds)
+        {
+            if (entry.baudrate == baudrate)
+            {
+                speed = entry.speed;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    //! Error code of the current errno
+    static asio::error_code errno_error_() noexcept
+    {
+        return asio::error_code(errno, asio::error::get_system_category());
+    }
+
+};
+
+} // namespace eduponz
+} // namespace easynmea
+
+#endif  /* _EASYNMEA_POSIXSERIALPORT_HPP_ */
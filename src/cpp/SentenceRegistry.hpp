@@ -0,0 +1,210 @@
+// Copyright (c) 2021 Eduardo Ponz Segrelles.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+/**
+ * @file SentenceRegistry.hpp
+ */
+
+#ifndef _EASYNMEA_SENTENCEREGISTRY_HPP_
+#define _EASYNMEA_SENTENCEREGISTRY_HPP_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "DecodeResult.hpp"
+
+namespace eduponz {
+namespace easynmea {
+
+/**
+ * @class SentenceRegistry
+ *
+ * Table of the decoders of the sentences which the library does not support, such as the
+ * proprietary '$P' sentences, indexed by their address.
+ *
+ * \c EasyNmeaCoder only looks a sentence up in the registry once the lookup in its own formatter
+ * tables has failed, so the registry cannot override the decoding of the supported sentences. The
+ * table has a fixed capacity and it never allocates memory. Each address is packed into an integer,
+ * so a lookup is a linear scan of at most \c CAPACITY integer comparisons.
+ *
+ * The registry is not thread safe. It is meant to be populated before decoding starts, and then
+ * only read.
+ */
+class SentenceRegistry
+{
+public:
+
+    //! Decoder of the sentences of an address, which receives the sentence without its tag block
+    using Decoder = DecodeResult (*)(
+        std::string_view sentence);
+
+    //! Maximum number of decoders that can be registered
+    static constexpr std::size_t CAPACITY = 16;
+
+    //! Maximum length of a registered address, without the '$' or the '!'
+    static constexpr std::size_t MAX_ADDRESS_LENGTH = 8;
+
+    //! Position returned by \c find() when there is no decoder for the address
+    static constexpr std::size_t NOT_FOUND = CAPACITY;
+
+    /**
+     * \brief Register the decoder of an address.
+     *
+     * @param address The address to be decoded with \c decoder, without the '$' or the '!', so that
+     *        it matches both parametric and encapsulation sentences (for instance, "PGRME"). It
+     *        consists of up to \c MAX_ADDRESS_LENGTH upper case letters and digits. An empty
+     *        address registers a decoder for every sentence which has no decoder of its own.
+     * @param decoder The decoder of the sentences with that address.
+     * @return \c true if the decoder was registered; \c false if the address is not valid, it
+     *         already has a decoder, \c decoder is \c nullptr, or the registry is full.
+     */
+    bool add(
+            std::string_view address,
+            Decoder decoder) noexcept
+    {
+        if (decoder == nullptr || size_ == CAPACITY || address.size() > MAX_ADDRESS_LENGTH)
+        {
+            return false;
+        }
+        for (char c : address)
+        {
+            if (!((c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9')))
+            {
+                return false;
+            }
+        }
+        uint64_t key = key_(address);
+        for (std::size_t i = 0; i < size_; i++)
+        {
+            if (entries_[i].key == key)
+            {
+                return false;
+            }
+        }
+        entries_[size_++] = {key, decoder};
+        return true;
+    }
+
+    /**
+     * \brief Find the decoder of a sentence using its address field.
+     *
+     * @param address The address field of the sentence, including the '$' or the '!'.
+     * @return The position of the decoder registered for the address or, if there is none, of the
+     *         one registered for every address. \c NOT_FOUND if there is neither.
+     */
+    std::size_t find(
+            std::string_view address) const noexcept
+    {
+        std::size_t found = NOT_FOUND;
+        if (address.empty() || address.size() > MAX_ADDRESS_LENGTH + 1)
+        {
+            // Only the decoder for every address can match
+            address = std::string_view();
+        }
+        else
+        {
+            address.remove_prefix(1);
+        }
+        uint64_t key = key_(address);
+        for (std::size_t i = 0; i < size_; i++)
+        {
+            if (entries_[i].key == key)
+            {
+                return i;
+            }
+            if (entries_[i].key == 0)
+            {
+                found = i;
+            }
+        }
+        return found;
+    }
+
+    /**
+     * Get a registered decoder.
+     *
+     * @param position The position of the decoder, as returned by \c find().
+     * @return The decoder.
+     */
+    Decoder decoder(
+            std::size_t position) const noexcept
+    {
+        return entries_[position].decoder;
+    }
+
+    /**
+     * Get the number of registered decoders.
+     *
+     * @return The number of registered decoders.
+     */
+    std::size_t size() const noexcept
+    {
+        return size_;
+    }
+
+    //! Unregister all the decoders
+    void clear() noexcept
+    {
+        size_ = 0;
+    }
+
+protected:
+
+    //! A packed address and its decoder
+    struct Entry
+    {
+        uint64_t key = 0;
+        Decoder decoder = nullptr;
+    };
+
+    /**
+     * \brief Pack an address into an integer.
+     *
+     * The characters are packed from the lowest byte, so the empty address is packed into 0, and no
+     * other valid address is.
+     *
+     * @param address The address, without the '$' or the '!'. It must not be longer than
+     *        \c MAX_ADDRESS_LENGTH.
+     * @return The packed address.
+     */
+    static uint64_t key_(
+            std::string_view address) noexcept
+    {
+        uint64_t key = 0;
+        for (std::size_t i = 0; i < address.size(); i++)
+        {
+            key |= static_cast<uint64_t>(static_cast<unsigned char>(address[i])) << (8 * i);
+        }
+        return key;
+    }
+
+    //! The registered decoders, in order of registration
+    std::array<Entry, CAPACITY> entries_{};
+
+    //! The number of registered decoders
+    std::size_t size_ = 0;
+};
+
+} // namespace eduponz
+} // namespace easynmea
+
+#endif //_EASYNMEA_SENTENCEREGISTRY_HPP_
@@ -0,0 +1,1192 @@
+// Copyright (c) 2021 Eduardo Ponz Segrelles.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+/**
+ * @file SentenceSchema.hpp
+ */
+
+#ifndef _EASYNMEA_SENTENCESCHEMA_HPP_
+#define _EASYNMEA_SENTENCESCHEMA_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+
+#include <easynmea/data.hpp>
+#include <easynmea/types.hpp>
+
+#include "Checksum.hpp"
+#include "FieldCodec.hpp"
+
+namespace eduponz {
+namespace easynmea {
+
+/**
+ * Declarative description of the NMEA 0183 sentences.
+ *
+ * A sentence schema lists the fields of a sentence after its address field, each of them bound to
+ * the member of the data type where its value is stored. From a schema, \c Sentence generates a
+ * validator, a decoder, and an encoder. All of them are specialized at compile time for the
+ * sentence, traverse it only once, and never allocate memory.
+ *
+ * Every field kind provides the following static members:
+ *   1. \c scan_value(it, end, data) validates the field and stores its value in \c data. On
+ *      success, it advances \c it past the field.
+ *   1. \c print_value(out, end, data) writes the field. On success, it advances \c out past the
+ *      field.
+ *   1. \c scan(it, end, data) and \c print(out, end, data), which do the same for the field
+ *      followed by its ',' separator.
+ *   1. \c present(data) tells whether \c data holds a value for the field, which is what
+ *      \c Optional, \c Omittable, \c Tail, and \c List use to decide whether to write it.
+ *   1. \c fields, the number of ',' separated fields that the kind spans.
+ */
+namespace schema {
+
+/**
+ * @class Separated
+ * \brief Base of the field kinds, which scans and writes a field followed by its ',' separator.
+ *
+ * @tparam Kind The field kind, which provides \c scan_value() and \c print_value().
+ */
+template<class Kind>
+struct Separated : protected FieldCodec
+{
+    //! Number of ',' separated fields that the kind spans
+    static constexpr std::size_t fields = 1;
+
+    template<class Data>
+    static bool scan(
+            const char*& it,
+            const char* end,
+            Data& data) noexcept
+    {
+        return Kind::scan_value(it, end, data) && consume_char_(it, end, ',');
+    }
+
+    template<class Data>
+    static bool print(
+            char*& out,
+            char* end,
+            const Data& data) noexcept
+    {
+        return Kind::print_value(out, end, data) && print_char_(out, end, ',');
+    }
+
+};
+
+/**
+ * @class Member
+ * \brief Mixin of the field kinds bound to a member of the data type.
+ *
+ * A field is present when its member holds a value other than the one of a default constructed
+ * data, which is how the data types represent absent fields.
+ *
+ * @tparam Pointer Pointer to the member.
+ */
+template<auto Pointer>
+struct Member
+{
+    template<class Data>
+    static bool present(
+            const Data& data) noexcept
+    {
+        return !(data.*Pointer == Data().*Pointer);
+    }
+
+protected:
+
+    //! Type of the member in the data type \c Data
+    template<class Data>
+    using type_ = std::remove_reference_t<decltype(std::declval<Data&>().*Pointer)>;
+};
+
+/**
+ * @class ArrayMember
+ * \brief Mixin of the field kinds bound to an array member of the data type.
+ *
+ * @tparam Array Pointer to the array member.
+ */
+template<auto Array>
+struct ArrayMember
+{
+protected:
+
+    //! Type of the elements of the array member in the data type \c Data
+    template<class Data>
+    using element_ = std::remove_extent_t<std::remove_reference_t<decltype(std::declval<Data&>().*Array)>>;
+
+    //! Number of elements of the array member in the data type \c Data
+    template<class Data>
+    static constexpr std::size_t capacity_ =
+            std::extent<std::remove_reference_t<decltype(std::declval<Data&>().*Array)>>::value;
+};
+
+/**
+ * @class Time
+ * \brief UTC time of day in the form 'hhmmss(.s+)?', stored both as a float and as milliseconds since
+ *        midnight.
+ *
+ * Any six digits are accepted, and the milliseconds are -1 if they are not a time of day. The
+ * encoder writes the time from the milliseconds, which are exact, truncated to \c Decimals decimal
+ * places.
+ *
+ * @tparam Seconds Pointer to the float member holding the time as hhmmss.s+, or \c nullptr if the
+ *         data type does not have one.
+ * @tparam Milliseconds Pointer to the int32_t member holding the milliseconds since midnight.
+ * @tparam Decimals Number of decimal places written by the encoder.
+ */
+template<auto Seconds, auto Milliseconds, int Decimals = 3>
+struct Time : Separated<Time<Seconds, Milliseconds, Decimals>>, Member<Milliseconds>
+{
+    template<class Data>
+    static bool scan_value(
+            const char*& it,
+            const char* end,
+            Data& data) noexcept
+    {
+        const char* field = it;
+        if (!FieldCodec::scan_time_(it, end, data.*Milliseconds))
+        {
+            return false;
+        }
+        if constexpr (!std::is_null_pointer<decltype(Seconds)>::value)
+        {
+            data.*Seconds = FieldCodec::to_float_(field, it);
+        }
+        return true;
+    }
+
+    template<class Data>
+    static bool print_value(
+            char*& out,
+            char* end,
+            const Data& data) noexcept
+    {
+        return FieldCodec::print_time_(out, end, data.*Milliseconds, Decimals);
+    }
+
+};
+
+/**
+ * @class Date
+ * \brief UTC date in the form 'ddmmyy', stored as the integer ddmmyy.
+ *
+ * The day must be in [01; 31] and the month in [01; 12].
+ *
+ * @tparam Pointer Pointer to the integer member.
+ */
+template<auto Pointer>
+struct Date : Separated<Date<Pointer>>, Member<Pointer>
+{
+    template<class Data>
+    static bool scan_value(
+            const char*& it,
+            const char* end,
+            Data& data) noexcept
+    {
+        const char* field = it;
+        if (FieldCodec::consume_digits_(it, end) != 6)
+        {
+            return false;
+        }
+        int value = FieldCodec::to_int_(field, it);
+        if (!valid_(value))
+        {
+            return false;
+        }
+        data.*Pointer = static_cast<typename Member<Pointer>::template type_<Data>>(value);
+        return true;
+    }
+
+    template<class Data>
+    static bool print_value(
+            char*& out,
+            char* end,
+            const Data& data) noexcept
+    {
+        return data.*Pointer <= 999999 && valid_(static_cast<int>(data.*Pointer)) &&
+               FieldCodec::print_unsigned_(out, end, static_cast<uint64_t>(data.*Pointer), 6);
+    }
+
+protected:
+
+    //! Check that the day and the month of a ddmmyy date are within range
+    static bool valid_(
+            int date) noexcept
+    {
+        int day = date / 10000;
+        int month = (date / 100) % 100;
+        return day >= 1 && day <= 31 && month >= 1 && month <= 12;
+    }
+
+};
+
+/**
+ * @class Angle
+ * \brief Angle in the form 'D{n}MM.m+' followed by its bearing field, stored both as degrees and as
+ *        units of 1e-7 degrees.
+ *
+ * Both values are negative when the bearing is the negative one. The encoder writes the angle from
+ * the units of 1e-7 degrees, which are exact.
+ *
+ * @tparam Degrees Pointer to the float member holding the angle in degrees.
+ * @tparam DegreesE7 Pointer to the int32_t member holding the angle in units of 1e-7 degrees.
+ * @tparam DegreeDigits Number of digits used to represent the degrees (2 or 3).
+ * @tparam MaxFirstDigit Maximum value of the first degree digit.
+ * @tparam Positive Bearing of the positive angles.
+ * @tparam Negative Bearing of the negative angles.
+ */
+template<auto Degrees, auto DegreesE7, std::size_t DegreeDigits, char MaxFirstDigit, char Positive, char Negative>
+struct Angle : Separated<Angle<Degrees, DegreesE7, DegreeDigits, MaxFirstDigit, Positive, Negative>>,
+    Member<DegreesE7>
+{
+    static constexpr std::size_t fields = 2;
+
+    template<class Data>
+    static bool scan_value(
+            const char*& it,
+            const char* end,
+            Data& data) noexcept
+    {
+        if (!FieldCodec::scan_angle_(it, end, DegreeDigits, MaxFirstDigit, data.*Degrees, data.*DegreesE7) ||
+                !FieldCodec::consume_char_(it, end, ','))
+        {
+            return false;
+        }
+        if (FieldCodec::consume_char_(it, end, Negative))
+        {
+            data.*Degrees = -(data.*Degrees);
+            data.*DegreesE7 = -(data.*DegreesE7);
+            return true;
+        }
+        return FieldCodec::consume_char_(it, end, Positive);
+    }
+
+    template<class Data>
+    static bool print_value(
+            char*& out,
+            char* end,
+            const Data& data) noexcept
+    {
+        return FieldCodec::print_angle_(out, end, data.*DegreesE7, DegreeDigits) &&
+               FieldCodec::print_char_(out, end, ',') &&
+               FieldCodec::print_char_(out, end, data.*DegreesE7 < 0 ? Negative : Positive);
+    }
+
+};
+
+//! Latitude as 'DDMM.m+' in [0; 90] followed by its bearing, 'N' or 'S'
+template<auto Degrees, auto DegreesE7>
+using Latitude = Angle<Degrees, DegreesE7, 2, '8', 'N', 'S'>;
+
+//! Longitude as 'DDDMM.m+' in [0; 180] followed by its bearing, 'E' or 'W'
+template<auto Degrees, auto DegreesE7>
+using Longitude = Angle<Degrees, DegreesE7, 3, '1', 'E', 'W'>;
+
+/**
+ * @class Digit
+ * \brief Single digit in [Min; Max], such as an enumerated indicator, stored as an integer.
+ *
+ * @tparam Pointer Pointer to the integer member.
+ * @tparam Min The minimum digit.
+ * @tparam Max The maximum digit.
+ */
+template<auto Pointer, char Min = '0', char Max = '9'>
+struct Digit : Separated<Digit<Pointer, Min, Max>>, Member<Pointer>
+{
+    static_assert(Min >= '0' && Max <= '9' && Min <= Max, "The digits must be in ['0'; '9']");
+
+    template<class Data>
+    static bool scan_value(
+            const char*& it,
+            const char* end,
+            Data& data) noexcept
+    {
+        if (it == end || *it < Min || *it > Max)
+        {
+            return false;
+        }
+        data.*Pointer = static_cast<typename Member<Pointer>::template type_<Data>>(*it++ - '0');
+        return true;
+    }
+
+    template<class Data>
+    static bool print_value(
+            char*& out,
+            char* end,
+            const Data& data) noexcept
+    {
+        return data.*Pointer >= Min - '0' && data.*Pointer <= Max - '0' &&
+               FieldCodec::print_char_(out, end, static_cast<char>('0' + data.*Pointer));
+    }
+
+};
+
+/**
+ * @class Char
+ * \brief Single character out of a set, such as a status or a mode indicator, stored as a char.
+ *
+ * @tparam Pointer Pointer to the char member.
+ * @tparam Values The accepted characters.
+ */
+template<auto Pointer, char... Values>
+struct Char : Separated<Char<Pointer, Values...>>, Member<Pointer>
+{
+    static_assert(sizeof...(Values) > 0, "At least one character must be accepted");
+
+    template<class Data>
+    static bool scan_value(
+            const char*& it,
+            const char* end,
+            Data& data) noexcept
+    {
+        if (it == end || !accepts_(*it))
+        {
+            return false;
+        }
+        data.*Pointer = *it++;
+        return true;
+    }
+
+    template<class Data>
+    static bool print_value(
+            char*& out,
+            char* end,
+            const Data& data) noexcept
+    {
+        return accepts_(data.*Pointer) && FieldCodec::print_char_(out, end, data.*Pointer);
+    }
+
+protected:
+
+    //! Check whether a character is one of the accepted ones
+    static constexpr bool accepts_(
+            char c) noexcept
+    {
+        return ((c == Values) || ...);
+    }
+
+};
+
+/**
+ * @class Unsigned
+ * \brief Unsigned integer in the form '[0-9]+'.
+ *
+ * @tparam Pointer Pointer to the integer member.
+ */
+template<auto Pointer>
+struct Unsigned : Separated<Unsigned<Pointer>>, Member<Pointer>
+{
+    template<class Data>
+    static bool scan_value(
+            const char*& it,
+            const char* end,
+            Data& data) noexcept
+    {
+        const char* field = it;
+        if (FieldCodec::consume_digits_(it, end) == 0)
+        {
+            return false;
+        }
+        data.*Pointer = static_cast<typename Member<Pointer>::template type_<Data>>(FieldCodec::to_int_(field, it));
+        return true;
+    }
+
+    template<class Data>
+    static bool print_value(
+            char*& out,
+            char* end,
+            const Data& data) noexcept
+    {
+        if constexpr (std::is_signed<typename Member<Pointer>::template type_<Data>>::value)
+        {
+            if (data.*Pointer < 0)
+            {
+                return false;
+            }
+        }
+        return FieldCodec::print_unsigned_(out, end, static_cast<uint64_t>(data.*Pointer));
+    }
+
+};
+
+/**
+ * @class Fixed
+ * \brief Integer in [Min; Max] written with exactly \c Digits digits, such as the fields of a date.
+ *
+ * A leading '-' is accepted if \c Min is negative.
+ *
+ * @tparam Pointer Pointer to the integer member.
+ * @tparam Digits The number of digits.
+ * @tparam Min The minimum value.
+ * @tparam Max The maximum value.
+ */
+template<auto Pointer, std::size_t Digits, int Min, int Max>
+struct Fixed : Separated<Fixed<Pointer, Digits, Min, Max>>, Member<Pointer>
+{
+    static_assert(Digits > 0 && Digits < 10 && Min <= Max, "The values must have between 1 and 9 digits");
+
+    template<class Data>
+    static bool scan_value(
+            const char*& it,
+            const char* end,
+            Data& data) noexcept
+    {
+        bool negative = Min < 0 && FieldCodec::consume_char_(it, end, '-');
+        const char* field = it;
+        if (FieldCodec::consume_digits_(it, end) != Digits)
+        {
+            return false;
+        }
+        int value = negative ? -FieldCodec::to_int_(field, it) : FieldCodec::to_int_(field, it);
+        if (value < Min || value > Max)
+        {
+            return false;
+        }
+        data.*Pointer = static_cast<typename Member<Pointer>::template type_<Data>>(value);
+        return true;
+    }
+
+    template<class Data>
+    static bool print_value(
+            char*& out,
+            char* end,
+            const Data& data) noexcept
+    {
+        int value = static_cast<int>(data.*Pointer);
+        return value >= Min && value <= Max &&
+               (value >= 0 || FieldCodec::print_char_(out, end, '-')) &&
+               FieldCodec::print_unsigned_(out, end, static_cast<uint64_t>(value < 0 ? -value : value), Digits);
+    }
+
+};
+
+/**
+ * @class Decimal
+ * \brief Decimal number in the form '-?[0-9]+.[0-9]+', stored as a float.
+ *
+ * @tparam Pointer Pointer to the float member.
+ * @tparam Signed Whether a leading '-' is accepted.
+ * @tparam Decimals Number of decimal places written by the encoder.
+ */
+template<auto Pointer, bool Signed = false, int Decimals = 3>
+struct Decimal : Separated<Decimal<Pointer, Signed, Decimals>>, Member<Pointer>
+{
+    template<class Data>
+    static bool scan_value(
+            const char*& it,
+            const char* end,
+            Data& data) noexcept
+    {
+        return FieldCodec::scan_decimal_(it, end, Signed, data.*Pointer);
+    }
+
+    template<class Data>
+    static bool print_value(
+            char*& out,
+            char* end,
+            const Data& data) noexcept
+    {
+        return (Signed || !(data.*Pointer < 0)) && FieldCodec::print_decimal_(out, end, data.*Pointer, Decimals);
+    }
+
+};
+
+/**
+ * @class Directed
+ * \brief Decimal number in the form '[0-9]+.[0-9]+' followed by its direction field, stored as a
+ *        float which is negative when the direction is the negative one.
+ *
+ * @tparam Pointer Pointer to the float member.
+ * @tparam Positive Direction of the positive values.
+ * @tparam Negative Direction of the negative values.
+ * @tparam Decimals Number of decimal places written by the encoder.
+ */
+template<auto Pointer, char Positive, char Negative, int Decimals = 1>
+struct Directed : Separated<Directed<Pointer, Positive, Negative, Decimals>>, Member<Pointer>
+{
+    static constexpr std::size_t fields = 2;
+
+    template<class Data>
+    static bool scan_value(
+            const char*& it,
+            const char* end,
+            Data& data) noexcept
+    {
+        if (!FieldCodec::scan_decimal_(it, end, false, data.*Pointer) || !FieldCodec::consume_char_(it, end, ','))
+        {
+            return false;
+        }
+        if (FieldCodec::consume_char_(it, end, Negative))
+        {
+            data.*Pointer = -(data.*Pointer);
+            return true;
+        }
+        return FieldCodec::consume_char_(it, end, Positive);
+    }
+
+    template<class Data>
+    static bool print_value(
+            char*& out,
+            char* end,
+            const Data& data) noexcept
+    {
+        bool negative = data.*Pointer < 0;
+        return FieldCodec::print_decimal_(out, end, negative ? -(data.*Pointer) : data.*Pointer, Decimals) &&
+               FieldCodec::print_char_(out, end, ',') &&
+               FieldCodec::print_char_(out, end, negative ? Negative : Positive);
+    }
+
+};
+
+/**
+ * @class Literal
+ * \brief Field with constant contents, such as a unit of measure.
+ *
+ * @tparam Chars The contents of the field.
+ */
+template<char... Chars>
+struct Literal : Separated<Literal<Chars...>>
+{
+    template<class Data>
+    static bool scan_value(
+            const char*& it,
+            const char* end,
+            Data&) noexcept
+    {
+        return (FieldCodec::consume_char_(it, end, Chars) && ...);
+    }
+
+    template<class Data>
+    static bool print_value(
+            char*& out,
+            char* end,
+            const Data&) noexcept
+    {
+        return (FieldCodec::print_char_(out, end, Chars) && ...);
+    }
+
+    template<class Data>
+    static bool present(
+            const Data&) noexcept
+    {
+        return true;
+    }
+
+};
+
+/**
+ * @class Optional
+ * \brief Field which can be empty. An empty field leaves its member untouched.
+ *
+ * The fields of a kind that spans several fields, such as an angle and its bearing, are either all
+ * empty or all valid.
+ *
+ * @tparam Field The kind of the field when it is not empty.
+ */
+template<class Field>
+struct Optional : Separated<Optional<Field>>
+{
+    static constexpr std::size_t fields = Field::fields;
+
+    template<class Data>
+    static bool scan_value(
+            const char*& it,
+            const char* end,
+            Data& data) noexcept
+    {
+        if (it != end && *it != ',' && *it != '*')
+        {
+            return Field::scan_value(it, end, data);
+        }
+        for (std::size_t i = 1; i < fields; i++)
+        {
+            if (!FieldCodec::consume_char_(it, end, ','))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template<class Data>
+    static bool print_value(
+            char*& out,
+            char* end,
+            const Data& data) noexcept
+    {
+        if (Field::present(data))
+        {
+            return Field::print_value(out, end, data);
+        }
+        for (std::size_t i = 1; i < fields; i++)
+        {
+            if (!FieldCodec::print_char_(out, end, ','))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template<class Data>
+    static bool present(
+            const Data& data) noexcept
+    {
+        return Field::present(data);
+    }
+
+};
+
+/**
+ * @class Omittable
+ * \brief Trailing field which can be missing altogether, separator included.
+ *
+ * As an element of a \c Sentence, the field and its following ',' can be missing when they are the
+ * last ones of the sentence. As an element of a \c List, the field and its preceding ',' can be
+ * missing when they are the last ones of the sentence.
+ *
+ * @tparam Field The kind of the field when it is not missing.
+ */
+template<class Field>
+struct Omittable : protected FieldCodec
+{
+    static constexpr std::size_t fields = Field::fields;
+
+    template<class Data>
+    static bool scan(
+            const char*& it,
+            const char* end,
+            Data& data) noexcept
+    {
+        return it == end || *it == '*' || Field::scan(it, end, data);
+    }
+
+    template<class Data>
+    static bool scan_value(
+            const char*& it,
+            const char* end,
+            Data& data) noexcept
+    {
+        return Field::scan_value(it, end, data);
+    }
+
+    template<class Data>
+    static bool print(
+            char*& out,
+            char* end,
+            const Data& data) noexcept
+    {
+        return !Field::present(data) || Field::print(out, end, data);
+    }
+
+    template<class Data>
+    static bool print_value(
+            char*& out,
+            char* end,
+            const Data& data) noexcept
+    {
+        return Field::print_value(out, end, data);
+    }
+
+    template<class Data>
+    static bool present(
+            const Data& data) noexcept
+    {
+        return Field::present(data);
+    }
+
+};
+
+/**
+ * @class Tail
+ * \brief Group of trailing fields, each followed by its ',' separator, which can be missing
+ *        altogether.
+ *
+ * @tparam Fields The kinds of the fields in the group.
+ */
+template<class ... Fields>
+struct Tail : protected FieldCodec
+{
+    template<class Data>
+    static bool scan(
+            const char*& it,
+            const char* end,
+            Data& data) noexcept
+    {
+        return it == end || *it == '*' || (Fields::scan(it, end, data) && ...);
+    }
+
+    template<class Data>
+    static bool print(
+            char*& out,
+            char* end,
+            const Data& data) noexcept
+    {
+        return !present(data) || (Fields::print(out, end, data) && ...);
+    }
+
+    template<class Data>
+    static bool present(
+            const Data& data) noexcept
+    {
+        return (Fields::present(data) || ...);
+    }
+
+};
+
+/**
+ * @class Repeated
+ * \brief Group of fields which is repeated a variable number of times, each repetition stored in
+ *        an element of an array member.
+ *
+ * Each repetition is preceded by its ',' separator, as the fields of a \c List, and there can be
+ * none of them. The fields of the group are bound to members of the element type of the array.
+ * A repetition is only stored once all its fields have been scanned, so that a following field of
+ * the list is not taken for an incomplete repetition. A \c Repeated can only be an element of a
+ * \c List.
+ *
+ * @tparam Array Pointer to the array member.
+ * @tparam Count Pointer to the integer member holding the number of stored repetitions.
+ * @tparam Fields The kinds of the fields of each repetition.
+ */
+template<auto Array, auto Count, class ... Fields>
+struct Repeated : protected FieldCodec, ArrayMember<Array>
+{
+    template<class Data>
+    static bool scan_next(
+            const char*& it,
+            const char* end,
+            Data& data) noexcept
+    {
+        while (it != end && *it == ',')
+        {
+            const char* group = it;
+            typename ArrayMember<Array>::template element_<Data> element;
+            if (!((consume_char_(group, end, ',') && Fields::scan_value(group, end, element)) && ...))
+            {
+                return true;
+            }
+            if (static_cast<std::size_t>(data.*Count) >= ArrayMember<Array>::template capacity_<Data>)
+            {
+                return false;
+            }
+            (data.*Array)[data.*Count] = element;
+            data.*Count = static_cast<std::remove_reference_t<decltype(data.*Count)>>(data.*Count + 1);
+            it = group;
+        }
+        return true;
+    }
+
+    template<class Data>
+    static bool print_next(
+            char*& out,
+            char* end,
+            const Data& data) noexcept
+    {
+        if (static_cast<std::size_t>(data.*Count) > ArrayMember<Array>::template capacity_<Data>)
+        {
+            return false;
+        }
+        for (std::size_t i = 0; i < static_cast<std::size_t>(data.*Count); i++)
+        {
+            const typename ArrayMember<Array>::template element_<Data>& element = (data.*Array)[i];
+            if (!((print_char_(out, end, ',') && Fields::print_value(out, end, element)) && ...))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template<class Data>
+    static bool present(
+            const Data& data) noexcept
+    {
+        return data.*Count != 0;
+    }
+
+};
+
+/**
+ * @class Slots
+ * \brief Fixed number of fields in the form '[0-9]*', whose non-empty values are stored packed at
+ *        the beginning of an array member.
+ *
+ * There are as many fields as elements in the array, each of them followed by its ',' separator.
+ * The order of the values is kept, but not the fields in which they were, as in the lists of
+ * satellites in use. When encoding, the stored values are written first and the rest of the
+ * fields are left empty.
+ *
+ * @tparam Array Pointer to the array member of unsigned integers.
+ * @tparam Count Pointer to the integer member holding the number of stored values.
+ */
+template<auto Array, auto Count>
+struct Slots : protected FieldCodec, ArrayMember<Array>
+{
+    template<class Data>
+    static bool scan(
+            const char*& it,
+            const char* end,
+            Data& data) noexcept
+    {
+        using Element = typename ArrayMember<Array>::template element_<Data>;
+        data.*Count = 0;
+        for (std::size_t i = 0; i < ArrayMember<Array>::template capacity_<Data>; i++)
+        {
+            const char* field = it;
+            if (consume_digits_(it, end) > 0)
+            {
+                (data.*Array)[data.*Count] = static_cast<Element>(to_int_(field, it));
+                data.*Count = static_cast<std::remove_reference_t<decltype(data.*Count)>>(data.*Count + 1);
+            }
+            if (!consume_char_(it, end, ','))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template<class Data>
+    static bool print(
+            char*& out,
+            char* end,
+            const Data& data) noexcept
+    {
+        std::size_t count = static_cast<std::size_t>(data.*Count);
+        if (count > ArrayMember<Array>::template capacity_<Data>)
+        {
+            return false;
+        }
+        for (std::size_t i = 0; i < ArrayMember<Array>::template capacity_<Data>; i++)
+        {
+            if (i < count && !print_unsigned_(out, end, static_cast<uint64_t>((data.*Array)[i])))
+            {
+                return false;
+            }
+            if (!print_char_(out, end, ','))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template<class Data>
+    static bool present(
+            const Data& data) noexcept
+    {
+        return data.*Count != 0;
+    }
+
+};
+
+/**
+ * @class List
+ * \brief Last fields of a sentence, separated by ',' without a trailing separator, as most
+ *        sentences end.
+ *
+ * The \c Omittable fields of the list can be missing, together with their preceding ',', when they
+ * are the last ones of the sentence. This is how the fields added by later versions of NMEA 0183
+ * are described. The \c Repeated fields of the list can appear any number of times, including
+ * none. A \c List must be the last element of a \c Sentence.
+ *
+ * @tparam First The kind of the first field of the list.
+ * @tparam Rest The kinds of the rest of the fields of the list.
+ */
+template<class First, class ... Rest>
+struct List : protected FieldCodec
+{
+    template<class Data>
+    static bool scan(
+            const char*& it,
+            const char* end,
+            Data& data) noexcept
+    {
+        return First::scan_value(it, end, data) && (scan_next_<Rest>(it, end, data) && ...);
+    }
+
+    template<class Data>
+    static bool print(
+            char*& out,
+            char* end,
+            const Data& data) noexcept
+    {
+        return First::print_value(out, end, data) && Printer_<Rest...>::print(out, end, data);
+    }
+
+    template<class Data>
+    static bool present(
+            const Data& data) noexcept
+    {
+        return First::present(data) || (Rest::present(data) || ...);
+    }
+
+protected:
+
+    //! Whether a field kind is \c Omittable
+    template<class Field>
+    struct is_omittable_ : std::false_type {};
+
+    template<class Field>
+    struct is_omittable_<Omittable<Field>> : std::true_type {};
+
+    //! Whether a field kind is \c Repeated
+    template<class Field>
+    struct is_repeated_ : std::false_type {};
+
+    template<auto Array, auto Count, class ... Fields>
+    struct is_repeated_<Repeated<Array, Count, Fields...>> : std::true_type {};
+
+    //! Scan a field following another one of the list
+    template<class Field, class Data>
+    static bool scan_next_(
+            const char*& it,
+            const char* end,
+            Data& data) noexcept
+    {
+        if constexpr (is_repeated_<Field>::value)
+        {
+            return Field::scan_next(it, end, data);
+        }
+        else
+        {
+            if constexpr (is_omittable_<Field>::value)
+            {
+                if (it == end || *it == '*')
+                {
+                    return true;
+                }
+            }
+            return consume_char_(it, end, ',') && Field::scan_value(it, end, data);
+        }
+    }
+
+    //! Write the fields following another one of the list, omitting the missing trailing ones
+    template<class ... Fields>
+    struct Printer_
+    {
+        template<class Data>
+        static bool print(
+                char*&,
+                char*,
+                const Data&) noexcept
+        {
+            return true;
+        }
+
+    };
+
+    template<class Field, class ... Later>
+    struct Printer_<Field, Later...>
+    {
+        template<class Data>
+        static bool print(
+                char*& out,
+                char* end,
+                const Data& data) noexcept
+        {
+            if constexpr (is_repeated_<Field>::value)
+            {
+                return Field::print_next(out, end, data) && Printer_<Later...>::print(out, end, data);
+            }
+            else
+            {
+                if constexpr (is_omittable_<Field>::value)
+                {
+                    if (!(Field::present(data) || (Later::present(data) || ...)))
+                    {
+                        return true;
+                    }
+                }
+                return print_char_(out, end, ',') &&
+                       Field::print_value(out, end, data) &&
+                       Printer_<Later...>::print(out, end, data);
+            }
+        }
+
+    };
+
+};
+
+/**
+ * @class Sentence
+ * \brief Validator, decoder, and encoder of the sentences described by a schema.
+ *
+ * The sentences start with an address field, which is '$' followed by any supported talker
+ * identifier and the sentence formatter. Then, each field in the schema is followed by a ',', and
+ * the sentence ends with the checksum, '*' followed by two hexadecimal digits.
+ *
+ * @tparam Data The data type of the sentence. It must be default constructible, and have a
+ *         \c NMEA0183Talker \c talker member.
+ * @tparam F0 The first character of the sentence formatter.
+ * @tparam F1 The second character of the sentence formatter.
+ * @tparam F2 The third character of the sentence formatter.
+ * @tparam Fields The kinds of the fields of the sentence, in order.
+ */
+template<class Data, char F0, char F1, char F2, class ... Fields>
+class Sentence : protected FieldCodec
+{
+public:
+
+    //! The sentence formatter, as a null-terminated string
+    static constexpr char formatter[] = {F0, F1, F2, '\0'};
+
+    /**
+     * \brief Validate a sentence and translate it in a single pass.
+     *
+     * The checksum is validated syntactically, but its value is not checked.
+     *
+     * @param[in] it Pointer to the first character of the sentence.
+     * @param[in] end Pointer past the last character of the sentence.
+     * @param[out] data The data to populate. Its contents are unspecified if the sentence is not
+     *             valid.
+     * @return \c true if the sentence is valid; \c false otherwise.
+     */
+    static bool scan(
+            const char* it,
+            const char* end,
+            Data& data) noexcept
+    {
+        /* Sentence ID from any supported talker */
+        if (!consume_char_(it, end, '$') || end - it < 2 ||
+                (data.talker = talker_(it[0], it[1])) == NMEA0183Talker::UNKNOWN)
+        {
+            return false;
+        }
+        it += 2;
+        if (!consume_literal_(it, end, formatter) || !consume_char_(it, end, ','))
+        {
+            return false;
+        }
+
+        /* Fields, each of them validated and translated in order */
+        if (!(Fields::scan(it, end, data) && ...))
+        {
+            return false;
+        }
+
+        /* Checksum, which must end the sentence */
+        return consume_char_(it, end, '*') &&
+               consume_hex_digit_(it, end) &&
+               consume_hex_digit_(it, end) &&
+               it == end;
+    }
+
+    /**
+     * \brief Check whether a sentence is valid.
+     *
+     * @param sentence The sentence, without the line terminator.
+     * @return \c true if the sentence is valid and its checksum is correct; \c false otherwise.
+     */
+    static bool validate(
+            std::string_view sentence) noexcept
+    {
+        Data data;
+        return decode(sentence, data);
+    }
+
+    /**
+     * \brief Decode a sentence.
+     *
+     * @param[in] sentence The sentence, without the line terminator.
+     * @param[out] data The data to populate. Its contents are unspecified if the sentence is not
+     *             valid.
+     * @return \c true if the sentence is valid and its checksum is correct; \c false otherwise.
+     */
+    static bool decode(
+            std::string_view sentence,
+            Data& data) noexcept
+    {
+        return scan(sentence.data(), sentence.data() + sentence.size(), data) && Checksum::validate(sentence);
+    }
+
+    /**
+     * \brief Encode a sentence.
+     *
+     * The sentence is written with its checksum, but without the line terminator nor a null
+     * terminator. If \c Data is a \c NMEA0183Data and its tag block is not empty, the tag block is
+     * written before the sentence.
+     *
+     * @param[in] data The data to encode.
+     * @param[out] buffer The buffer where the sentence is written.
+     * @param[in] size The size of the buffer.
+     * @return The length of the sentence, or 0 if it does not fit in the buffer or \c data holds a
+     *         value which the sentence cannot represent.
+     */
+    static std::size_t encode(
+            const Data& data,
+            char* buffer,
+            std::size_t size) noexcept
+    {
+        char* out = buffer;
+        char* end = buffer + size;
+
+        /* Tag block, if any */
+        if constexpr (std::is_base_of<NMEA0183Data, Data>::value)
+        {
+            if (!print_tag_block_(out, end, data.tag_block))
+            {
+                return 0;
+            }
+        }
+        char* sentence = out;
+
+        /* Sentence ID */
+        const char* talker = talker_id_(data.talker);
+        if (talker == nullptr ||
+                !print_char_(out, end, '$') ||
+                !print_char_(out, end, talker[0]) ||
+                !print_char_(out, end, talker[1]) ||
+                !print_char_(out, end, F0) ||
+                !print_char_(out, end, F1) ||
+                !print_char_(out, end, F2) ||
+                !print_char_(out, end, ','))
+        {
+            return 0;
+        }
+
+        /* Fields */
+        if (!(Fields::print(out, end, data) && ...))
+        {
+            return 0;
+        }
+
+        /* Checksum of everything between the '$' and the '*' */
+        static constexpr char hex_digits[] = "0123456789ABCDEF";
+        uint8_t checksum = Checksum::compute(sentence + 1, static_cast<std::size_t>(out - sentence - 1));
+        if (!print_char_(out, end, '*') ||
+                !print_char_(out, end, hex_digits[checksum >> 4]) ||
+                !print_char_(out, end, hex_digits[checksum & 0xF]))
+        {
+            return 0;
+        }
+        return static_cast<std::size_t>(out - buffer);
+    }
+
+};
+
+} // namespace schema
+} // namespace eduponz
+} // namespace easynmea
+
+#endif //_EASYNMEA_SENTENCESCHEMA_HPP_
@@ -9,43 +9,92 @@
 #ifndef _EASYNMEA_SERIALINTERFACE_H
 #define _EASYNMEA_SERIALINTERFACE_H
 
+#include <array>
+#include <chrono>
 #include <functional>
+#include <iostream>
 #include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
 
 #include <asio/io_service.hpp>
 #include <asio/read.hpp>
 #include <asio/serial_port_base.hpp>
 #include <asio/serial_port.hpp>
 
+#include <easynmea/data.hpp>
+#include <easynmea/types.hpp>
+
+#include "LineFramer.hpp"
+
+#if defined(EASYNMEA_URING_SERIAL_PORT)
+#include "UringSerialPort.hpp"
+#elif defined(EASYNMEA_POSIX_SERIAL_PORT)
+#include "PosixSerialPort.hpp"
+#endif  // defined(EASYNMEA_URING_SERIAL_PORT)
+
 namespace eduponz {
 namespace easynmea {
 
+//! Serial port implementation of \c SerialInterface<>, which is chosen with the CMake options URING_SERIAL_PORT and
+//! POSIX_SERIAL_PORT
+#if defined(EASYNMEA_URING_SERIAL_PORT)
+using DefaultSerialPort = UringSerialPort;
+#elif defined(EASYNMEA_POSIX_SERIAL_PORT)
+using DefaultSerialPort = PosixSerialPort;
+#else
+using DefaultSerialPort = asio::serial_port;
+#endif  // defined(EASYNMEA_URING_SERIAL_PORT)
+
 /**
  * @class SerialInterface
  *
  * This template class provides API to open and close a serial port, as well as for reading a line
  * from it (terminated either in \c '\n' or \c '\r\n')
  *
- * @tparam SerialPort: The serial port implementation. Defaults to asio::serial_port. Any
+ * The lines are framed from an internal buffer, which is filled with as many bytes as the port
+ * has available on each read, so a single read usually yields one or several complete lines. Lines
+ * can be either read one at a time with \c read_line(), or handed to a callback as they are framed
+ * with \c read_lines(), which keeps a single read outstanding on the port until it is closed.
+ *
+ * @tparam SerialPort: The serial port implementation. Defaults to asio::serial_port, to
+ *         \c PosixSerialPort when the library is built with \c POSIX_SERIAL_PORT, or to
+ *         \c UringSerialPort when it is built with \c URING_SERIAL_PORT. Any
  *         \c SerialPort implementation must provide:
  *            * A constructor which takes an \c asio::io_service.
  *            * A `void open(const std::string& device, asio::error_code& ec)`
  *            * A `bool is_open()` function
- *            * A `bool set_option(asio::serial_port_base::baud_rate baudrate, asio::error_code& ec)`
+ *            * A `set_option(asio::serial_port_base::baud_rate baudrate, asio::error_code& ec)`
  *            * A `void close(asio::error_code& ec)`
- *            * A `std::size_t read_some(const asio::mutable_buffers_1& buffers, asio::error_code& ec)`
+ *            * A `void async_read_some(const asio::mutable_buffers_1& buffers, Handler handler)`
+ *         It may also support read profiles (see \c set_read_profile()).
  */
-template <class SerialPort = asio::serial_port>
+template <class SerialPort = DefaultSerialPort>
 class SerialInterface
 {
 public:
 
+    //! Size of the buffer from which lines are framed. It is read in chunks of up to this size
+    static constexpr std::size_t BUFFER_SIZE = 1024;
+
+    /**
+     * Handler of the lines framed by \c read_lines(). It is called from the thread which calls
+     * \c read_lines(), and it returns whether to keep on reading.
+     */
+    using LineHandler = std::function<bool (const std::string& line)>;
+
     /**
      * Constructor.
      */
     SerialInterface() noexcept
         : io_service_()
         , serial_(std::make_unique<SerialPort>(io_service_))
+        , buffer_begin_(0)
+        , buffer_end_(0)
+        , chunk_time_()
+        , line_time_()
+        , realtime_(false)
     {
     }
 
@@ -78,6 +127,9 @@ public:
                 serial_->set_option(asio::serial_port_base::baud_rate(baudrate), ec);
                 if (!ec)
                 {
+                    // Bytes left from a previous connection do not belong to this one
+                    buffer_begin_ = 0;
+                    buffer_end_ = 0;
                     return true;
                 }
             }
@@ -117,7 +169,9 @@ public:
     /**
      * Blocks until a line is received from the serial device.
      *
-     * Eventual \c '\n' or \c '\r\n' characters at the end of the string are removed.
+     * Eventual \c '\n' or \c '\r\n' characters at the end of the string are removed. The line is
+     * framed from the bytes left in the internal buffer by the previous call, and the buffer is
+     * only refilled from the port once it has been drained.
      *
      * \param[out] result A string to store the read line. If the serial connection is not opened,
      *             then @param result will not be modified. If it is open, then it will be cleared
@@ -135,90 +189,298 @@ public:
             return false;
         }
 
-        char c;
         result.clear();
         asio::error_code ec;
         while (true)
         {
-            read_char(c, ec);
-            if (!ec)
+            if (buffer_begin_ == buffer_end_)
             {
-                switch (c)
+                // The buffer is drained, so it is refilled from its start
+                buffer_begin_ = 0;
+                buffer_end_ = read_chunk(buffer_.data(), buffer_.size(), ec);
+                if (ec)
                 {
-                    case '\r':
-                        break;
-                    case '\n':
-                        return true;
-                    default:
-                        result += c;
+                    buffer_end_ = 0;
+                    report_read_error_(ec);
+                    return false;
                 }
+                stamp_chunk_();
             }
-            else
+            if (frame_line_(result))
             {
-                switch (ec.value())
+                return true;
+            }
+        }
+    }
+
+    /**
+     * Blocks handing the lines received from the serial device to a handler, until the port is
+     * closed or the handler asks to stop.
+     *
+     * A single \c async_read_some into the internal buffer is kept outstanding on the port, and
+     * its completion handler frames the received lines and re-arms it, so the I/O service is only
+     * run once for the whole reception. Closing the port cancels the outstanding read, which
+     * promptly returns from \c read_lines(). Eventual \c '\n' or \c '\r\n' characters at the end
+     * of the lines are removed, as in \c read_line().
+     *
+     * \param on_line Handler of the lines. The line is only valid during the call, as it is
+     *        overwritten by the next one. If it returns false, no more lines are handed to it, and
+     *        the bytes already received after its line are kept for the next read.
+     * \return true if the handler asked to stop; false if the port was closed or there was an
+     *         error while reading.
+     */
+    virtual bool read_lines(
+            const LineHandler& on_line) noexcept
+    {
+        if (!is_open())
+        {
+            return false;
+        }
+
+        // The lines left in the buffer by read_line() are handed over before reading again
+        std::string line;
+        while (frame_line_(line))
+        {
+            if (!on_line(line))
+            {
+                return true;
+            }
+            line.clear();
+        }
+
+        bool stopped = false;
+        asio::error_code ec;
+        std::function<void (const asio::error_code&, std::size_t)> on_chunk_read;
+        on_chunk_read = [&](
+            const asio::error_code& error_code,
+            std::size_t bytes_transferred)
                 {
-                    case asio::error::operation_aborted:
+                    if (error_code)
                     {
-                        std::cout << "[INFO] Read operation aborted" << std::endl;
-                        break;
+                        ec = error_code;
+                        return;
                     }
-                    default:
+                    stamp_chunk_();
+                    buffer_begin_ = 0;
+                    buffer_end_ = bytes_transferred;
+                    while (frame_line_(line))
                     {
-                        std::cout << "[ERROR] Something happened while reading: " << ec.message()
-                                  << std::endl;
-                        close();
-                        break;
+                        if (!on_line(line))
+                        {
+                            stopped = true;
+                            return;
+                        }
+                        line.clear();
                     }
-                }
-                return false;
-            }
+                    // The buffer is drained, so the read is re-armed on its start
+                    serial_->async_read_some(asio::buffer(buffer_.data(), buffer_.size()), on_chunk_read);
+                };
+
+        buffer_begin_ = 0;
+        buffer_end_ = 0;
+        io_service_.reset();
+        serial_->async_read_some(asio::buffer(buffer_.data(), buffer_.size()), on_chunk_read);
+        io_service_.run();  // This will block until the port is closed or the handler stops
+        if (stopped)
+        {
+            return true;
+        }
+        if (ec)
+        {
+            report_read_error_(ec);
+        }
+        return false;
+    }
+
+    /**
+     * \brief Enable taking the realtime time point of the lines, besides the monotonic one.
+     *
+     * @param enable Whether to fill \c ReceiveTime::realtime in the time of the lines. It is not
+     *        taken by default.
+     */
+    void stamp_realtime(
+            bool enable) noexcept
+    {
+        realtime_ = enable;
+    }
+
+    /**
+     * \brief Set when the serial port wakes the reader up to take the bytes it has buffered.
+     *
+     * Only the \c SerialPort implementations which provide a `ReadProfile read_profile()` and a
+     * `void set_option(const ReadProfile& profile, asio::error_code& ec)`, such as
+     * \c PosixSerialPort and \c UringSerialPort, support read profiles. The profile is applied by the
+     * following calls to \c open().
+     *
+     * @param profile The new profile. Its \c vmin must not be 0.
+     * @return true if the profile was set; false if \c SerialPort does not support read profiles, or
+     *         the profile could not be set.
+     */
+    virtual bool set_read_profile(
+            const ReadProfile& profile) noexcept
+    {
+        if constexpr (supports_read_profile_<SerialPort>::value)
+        {
+            asio::error_code ec;
+            serial_->set_option(profile, ec);
+            return !ec;
+        }
+        else
+        {
+            static_cast<void>(profile);
+            return false;
         }
     }
 
+    /**
+     * \brief Get the time at which the first byte of the last line was read.
+     *
+     * It is the time at which the chunk holding that byte was read from the port, as the bytes are
+     * read in chunks.
+     *
+     * @return The time of the line returned by \c read_line(), or of the line handed to the
+     *         \c LineHandler by \c read_lines(). It is overwritten when the next line is framed.
+     */
+    const ReceiveTime& line_time() const noexcept
+    {
+        return line_time_;
+    }
+
 protected:
 
+    //! Whether a \c SerialPort implementation supports read profiles
+    template <class Port, class = void>
+    struct supports_read_profile_ : std::false_type
+    {
+    };
+
+    template <class Port>
+    struct supports_read_profile_<Port, std::void_t<decltype(std::declval<Port&>().read_profile())>>
+        : std::true_type
+    {
+    };
+
     //! Asio's I/O service. It is used to construct the \c SerialPort
     asio::io_service io_service_;
 
-    //! Unique pointer to the \c SerialPort implementation (defaults to \c asio::serial_port)
+    //! Unique pointer to the \c SerialPort implementation (defaults to \c DefaultSerialPort)
     std::unique_ptr<SerialPort> serial_;
 
+    //! Bytes read from the port which have not been framed into a line yet
+    std::array<char, BUFFER_SIZE> buffer_;
+
+    //! Position of the first byte in \c buffer_ which has not been framed yet
+    std::size_t buffer_begin_;
+
+    //! Position past the last byte read into \c buffer_
+    std::size_t buffer_end_;
+
+    //! Time at which the bytes in \c buffer_ were read
+    ReceiveTime chunk_time_;
+
+    //! Time at which the first byte of the line being framed was read
+    ReceiveTime line_time_;
+
+    //! Whether to take \c ReceiveTime::realtime as well
+    bool realtime_;
+
     /**
-     * Read a character from the serial port.
+     * Read as many bytes as are available from the serial port, up to \c size.
      *
      * This function blocks until either:
-     *    1. A character is read
+     *    1. At least one byte is read
      *    2. The serial port is closed
      *    3. An internal error occurs on asio::async_read_some
      *
-     * @param[out] c Reference to the read char
+     * @param[out] data Buffer in which the read bytes are stored
+     * @param size Size of \c data
      * @param ec The error code returned by asio::async_read_some
-     * @return The number of read characters, i.e. 1 when something is read, 0 when it's not
+     * @return The number of read bytes, which is 0 when nothing is read
      */
-    virtual std::size_t read_char(
-            char& c,
+    virtual std::size_t read_chunk(
+            char* data,
+            std::size_t size,
             asio::error_code& ec) noexcept
     {
-        std::size_t ret = 1;
-        std::function<void (const asio::error_code&, std::size_t)> on_char_read = [&](
+        std::size_t ret = 0;
+        std::function<void (const asio::error_code&, std::size_t)> on_chunk_read = [&](
             const asio::error_code& error_code,
             std::size_t bytes_transferred)
                 {
-                    if (error_code)
-                    {
-                        ec = error_code;
-                        ret = 0;
-                    }
+                    ec = error_code;
+                    ret = error_code ? 0 : bytes_transferred;
                 };
 
-        c = '\0';
         // Prepare io_service, give it some work, and run it
         io_service_.reset();
-        serial_->async_read_some(asio::buffer(&c, 1), on_char_read);
-        io_service_.run();  // This will block until a new char is ready
+        serial_->async_read_some(asio::buffer(data, size), on_chunk_read);
+        io_service_.run();  // This will block until some bytes are ready
         return ret;
     }
 
+    /**
+     * Move the buffered bytes up to the end of the next line to a line. If the line is empty, it
+     * starts in the buffered chunk, so \c line_time_ is set to the time of the chunk.
+     *
+     * @param[in, out] line The line to which the bytes are appended, leaving out the line
+     *                 terminator
+     * @return true if the end of the line was buffered; false if the buffer was drained before it.
+     */
+    bool frame_line_(
+            std::string& line) noexcept
+    {
+        if (line.empty())
+        {
+            // The line starts in this chunk
+            line_time_ = chunk_time_;
+        }
+        const char* next = LineFramer::frame(line, buffer_.data() + buffer_begin_, buffer_.data() + buffer_end_);
+        if (next == nullptr)
+        {
+            buffer_begin_ = buffer_end_;
+            return false;
+        }
+        buffer_begin_ = static_cast<std::size_t>(next - buffer_.data());
+        return true;
+    }
+
+    /**
+     * Take the time at which a chunk was read into \c buffer_, right after reading it.
+     */
+    void stamp_chunk_() noexcept
+    {
+        chunk_time_.monotonic = std::chrono::steady_clock::now();
+        if (realtime_)
+        {
+            chunk_time_.realtime = std::chrono::system_clock::now();
+        }
+    }
+
+    /**
+     * Report an error while reading from the port, closing it unless the read was aborted by
+     * closing it already.
+     *
+     * @param ec The error code returned by asio::async_read_some
+     */
+    void report_read_error_(
+            const asio::error_code& ec) noexcept
+    {
+        switch (ec.value())
+        {
+            case asio::error::operation_aborted:
+            {
+                std::cout << "[INFO] Read operation aborted" << std::endl;
+                break;
+            }
+            default:
+            {
+                std::cout << "[ERROR] Something happened while reading: " << ec.message() << std::endl;
+                close();
+                break;
+            }
+        }
+    }
+
 };
 
 } // namespace eduponz
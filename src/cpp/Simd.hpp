@@ -0,0 +1,131 @@
+// Copyright (c) 2021 Eduardo Ponz Segrelles.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+/**
+ * @file Simd.hpp
+ *
+ * Architecture detection shared by the vectorized kernels. It must only be included from
+ * translation units, since it pulls in the intrinsics headers.
+ */
+
+#ifndef _EASYNMEA_SIMD_HPP_
+#define _EASYNMEA_SIMD_HPP_
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define EASYNMEA_SIMD_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif // if defined(_MSC_VER)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define EASYNMEA_SIMD_SSE2
+#endif // SSE2 baseline
+#if defined(__GNUC__) || defined(__clang__)
+#define EASYNMEA_SIMD_AVX2
+#define EASYNMEA_TARGET_AVX2 __attribute__((target("avx2")))
+#elif defined(_MSC_VER)
+#define EASYNMEA_SIMD_AVX2
+#define EASYNMEA_TARGET_AVX2
+#endif // AVX2 function attributes
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define EASYNMEA_SIMD_NEON
+#include <arm_neon.h>
+#endif // Architecture
+
+namespace eduponz {
+namespace easynmea {
+namespace simd {
+
+/**
+ * \brief Check whether the CPU and the OS support AVX2
+ *
+ * @return \c true if AVX2 kernels can be run; \c false otherwise.
+ */
+inline bool cpu_supports_avx2() noexcept
+{
+#if defined(EASYNMEA_SIMD_AVX2) && (defined(__GNUC__) || defined(__clang__))
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#elif defined(EASYNMEA_SIMD_AVX2) && defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7)
+    {
+        return false;
+    }
+    __cpuid(info, 1);
+    // The OS must support saving the AVX registers (OSXSAVE and XCR0 bits 1 and 2)
+    bool os_avx = (info[2] & (1 << 27)) && (info[2] & (1 << 28)) && ((_xgetbv(0) & 0x6) == 0x6);
+    __cpuidex(info, 7, 0);
+    return os_avx && (info[1] & (1 << 5));
+#else
+    return false;
+#endif // AVX2 detection
+}
+
+/**
+ * \brief Select the fastest kernel which is compiled in and supported by the CPU
+ *
+ * The kernels are chosen with the same macros which compile them in, so the ones of instruction
+ * sets which are not available on this platform are never returned and can be \c nullptr.
+ *
+ * @param[in] scalar The portable kernel.
+ * @param[in] sse2 The SSE2 kernel.
+ * @param[in] avx2 The AVX2 kernel.
+ * @param[in] neon The NEON kernel.
+ * @param[out] name The name of the selected kernel.
+ * @return The selected kernel.
+ */
+template<typename Kernel>
+inline Kernel select_kernel(
+        Kernel scalar,
+        Kernel sse2,
+        Kernel avx2,
+        Kernel neon,
+        const char*& name) noexcept
+{
+    static_cast<void>(scalar);
+    static_cast<void>(sse2);
+    static_cast<void>(avx2);
+    static_cast<void>(neon);
+#if defined(EASYNMEA_SIMD_AVX2)
+    if (cpu_supports_avx2())
+    {
+        name = "avx2";
+        return avx2;
+    }
+#endif // if defined(EASYNMEA_SIMD_AVX2)
+#if defined(EASYNMEA_SIMD_SSE2)
+    name = "sse2";
+    return sse2;
+#elif defined(EASYNMEA_SIMD_NEON)
+    name = "neon";
+    return neon;
+#else
+    name = "scalar";
+    return scalar;
+#endif // Baseline kernel
+}
+
+} // namespace simd
+} // namespace easynmea
+} // namespace eduponz
+
+#endif //_EASYNMEA_SIMD_HPP_
@@ -0,0 +1,434 @@
+// Copyright (c) 2021 Eduardo Ponz Segrelles.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+/**
+ * @file StructuralIndex.cpp
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include "Simd.hpp"
+#include "StructuralIndex.hpp"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif // if defined(_MSC_VER)
+
+using namespace eduponz::easynmea;
+
+namespace {
+
+/**
+ * Number of blocks classified in each call to the kernel. The bitmaps of a chunk live in the stack.
+ */
+constexpr std::size_t CHUNK_BLOCKS = 64;
+
+/**
+ * Return the position of the least significant set bit of a non-zero word.
+ */
+inline std::size_t trailing_zeros(
+        uint64_t word) noexcept
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long index;
+    _BitScanForward64(&index, word);
+    return static_cast<std::size_t>(index);
+#else
+    return static_cast<std::size_t>(__builtin_ctzll(word));
+#endif // if defined(_MSC_VER) && !defined(__clang__)
+}
+
+/**
+ * Set the highest bit of every byte of a word which is zero, and clear all the other bits.
+ */
+inline uint64_t zero_bytes(
+        uint64_t word) noexcept
+{
+    const uint64_t low_bits = 0x7F7F7F7F7F7F7F7Full;
+    return ~(((word & low_bits) + low_bits) | word | low_bits);
+}
+
+/**
+ * Repeat a character in every byte of a word.
+ */
+constexpr uint64_t broadcast(
+        char c) noexcept
+{
+    return 0x0101010101010101ull * static_cast<unsigned char>(c);
+}
+
+#if defined(EASYNMEA_SIMD_SSE2)
+inline __m128i structural_sse2(
+        __m128i bytes)
+{
+    __m128i found = _mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('$')), _mm_cmpeq_epi8(bytes, _mm_set1_epi8('!')));
+    found = _mm_or_si128(found, _mm_cmpeq_epi8(bytes, _mm_set1_epi8(',')));
+    found = _mm_or_si128(found, _mm_cmpeq_epi8(bytes, _mm_set1_epi8('*')));
+    found = _mm_or_si128(found, _mm_cmpeq_epi8(bytes, _mm_set1_epi8('\r')));
+    return _mm_or_si128(found, _mm_cmpeq_epi8(bytes, _mm_set1_epi8('\n')));
+}
+
+void classify_sse2(
+        const char* data,
+        std::size_t blocks,
+        uint64_t* bitmaps)
+{
+    for (std::size_t block = 0; block < blocks; block++, data += 64)
+    {
+        uint64_t bits = 0;
+        for (std::size_t i = 0; i < 4; i++)
+        {
+            __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16 * i));
+            bits |= static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(structural_sse2(bytes)))) << (16 * i);
+        }
+        bitmaps[block] = bits;
+    }
+}
+
+#endif // if defined(EASYNMEA_SIMD_SSE2)
+
+#if defined(EASYNMEA_SIMD_AVX2)
+EASYNMEA_TARGET_AVX2 inline __m256i structural_avx2(
+        __m256i bytes)
+{
+    __m256i found = _mm256_or_si256(
+        _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('$')), _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('!')));
+    found = _mm256_or_si256(found, _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(',')));
+    found = _mm256_or_si256(found, _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('*')));
+    found = _mm256_or_si256(found, _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\r')));
+    return _mm256_or_si256(found, _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\n')));
+}
+
+EASYNMEA_TARGET_AVX2 void classify_avx2(
+        const char* data,
+        std::size_t blocks,
+        uint64_t* bitmaps)
+{
+    for (std::size_t block = 0; block < blocks; block++, data += 64)
+    {
+        __m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+        __m256i high = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + 32));
+        uint64_t low_bits = static_cast<uint32_t>(_mm256_movemask_epi8(structural_avx2(low)));
+        uint64_t high_bits = static_cast<uint32_t>(_mm256_movemask_epi8(structural_avx2(high)));
+        bitmaps[block] = low_bits | (high_bits << 32);
+    }
+}
+
+#endif // if defined(EASYNMEA_SIMD_AVX2)
+
+#if defined(EASYNMEA_SIMD_NEON)
+inline uint8x16_t structural_neon(
+        uint8x16_t bytes)
+{
+    uint8x16_t found = vorrq_u8(vceqq_u8(bytes, vdupq_n_u8('$')), vceqq_u8(bytes, vdupq_n_u8('!')));
+    found = vorrq_u8(found, vceqq_u8(bytes, vdupq_n_u8(',')));
+    found = vorrq_u8(found, vceqq_u8(bytes, vdupq_n_u8('*')));
+    found = vorrq_u8(found, vceqq_u8(bytes, vdupq_n_u8('\r')));
+    return vorrq_u8(found, vceqq_u8(bytes, vdupq_n_u8('\n')));
+}
+
+void classify_neon(
+        const char* data,
+        std::size_t blocks,
+        uint64_t* bitmaps)
+{
+    // Weight of each byte within its group of 8, so that pairwise additions gather the bits
+    static const uint8_t weights_array[16] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+    const uint8x16_t weights = vld1q_u8(weights_array);
+    for (std::size_t block = 0; block < blocks; block++, data += 64)
+    {
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+        uint8x16_t m0 = vandq_u8(structural_neon(vld1q_u8(bytes)), weights);
+        uint8x16_t m1 = vandq_u8(structural_neon(vld1q_u8(bytes + 16)), weights);
+        uint8x16_t m2 = vandq_u8(structural_neon(vld1q_u8(bytes + 32)), weights);
+        uint8x16_t m3 = vandq_u8(structural_neon(vld1q_u8(bytes + 48)), weights);
+        uint8x16_t sum = vpaddq_u8(vpaddq_u8(m0, m1), vpaddq_u8(m2, m3));
+        sum = vpaddq_u8(sum, sum);
+        bitmaps[block] = vgetq_lane_u64(vreinterpretq_u64_u8(sum), 0);
+    }
+}
+
+#endif // if defined(EASYNMEA_SIMD_NEON)
+
+/**
+ * Start the index of a sentence at a given offset of the buffer.
+ */
+inline void start_sentence(
+        IndexedSentence& sentence,
+        std::size_t begin) noexcept
+{
+    sentence.begin = static_cast<uint32_t>(begin);
+    sentence.size = 0;
+    sentence.checksum_mark = 0;
+    sentence.checksum_marks = 0;
+    sentence.separator_count = 0;
+    sentence.starts_with_mark = false;
+    sentence.tag_block_size = 0;
+    sentence.truncated = false;
+}
+
+/**
+ * Record the tag block which ends right before the start mark of a sentence, if any. Tag blocks are
+ * short, so the opening '\\' is searched backwards from the closing one, within the line.
+ */
+inline void find_tag_block(
+        IndexedSentence& sentence,
+        const char* data,
+        std::size_t line_begin) noexcept
+{
+    std::size_t tag_end = sentence.begin;
+    if (tag_end - line_begin < 2 || data[tag_end - 1] != '\\')
+    {
+        return;
+    }
+    std::size_t limit = tag_end - std::min<std::size_t>(tag_end - line_begin, std::numeric_limits<uint16_t>::max());
+    for (std::size_t position = tag_end - 2; position + 1 > limit; position--)
+    {
+        if (data[position] == '\\')
+        {
+            sentence.tag_block_size = static_cast<uint16_t>(tag_end - position);
+            return;
+        }
+    }
+}
+
+/**
+ * Finish the index of a sentence which ends at a given offset of the buffer, removing the carriage
+ * return if there is one.
+ *
+ * @return Whether the sentence is not empty.
+ */
+inline bool finish_sentence(
+        IndexedSentence& sentence,
+        const char* data,
+        std::size_t end) noexcept
+{
+    if (end > sentence.begin && data[end - 1] == '\r')
+    {
+        end--;
+    }
+    sentence.size = static_cast<uint32_t>(end - sentence.begin);
+    if (sentence.checksum_marks == 0)
+    {
+        sentence.checksum_mark = sentence.size;
+    }
+    return sentence.size > 0;
+}
+
+} // namespace
+
+#if defined(EASYNMEA_SIMD_SSE2)
+const StructuralIndex::BitmapKernel StructuralIndex::classify_sse2_ = classify_sse2;
+#else
+const StructuralIndex::BitmapKernel StructuralIndex::classify_sse2_ = nullptr;
+#endif // if defined(EASYNMEA_SIMD_SSE2)
+
+#if defined(EASYNMEA_SIMD_AVX2)
+const StructuralIndex::BitmapKernel StructuralIndex::classify_avx2_ = classify_avx2;
+#else
+const StructuralIndex::BitmapKernel StructuralIndex::classify_avx2_ = nullptr;
+#endif // if defined(EASYNMEA_SIMD_AVX2)
+
+#if defined(EASYNMEA_SIMD_NEON)
+const StructuralIndex::BitmapKernel StructuralIndex::classify_neon_ = classify_neon;
+#else
+const StructuralIndex::BitmapKernel StructuralIndex::classify_neon_ = nullptr;
+#endif // if defined(EASYNMEA_SIMD_NEON)
+
+std::size_t StructuralIndex::build(
+        std::string_view buffer,
+        IndexedSentence* sentences,
+        std::size_t max_sentences,
+        std::size_t* consumed) noexcept
+{
+    /* Offsets are stored in 32 bits, so larger buffers are indexed partially */
+    buffer = buffer.substr(0, std::numeric_limits<uint32_t>::max());
+    const char* data = buffer.data();
+    std::size_t count = 0;
+
+    if (max_sentences == 0)
+    {
+        if (consumed)
+        {
+            *consumed = 0;
+        }
+        return 0;
+    }
+
+    IndexedSentence* current = sentences;
+    start_sentence(*current, 0);
+    std::size_t line_begin = 0;
+
+    uint64_t bitmaps[CHUNK_BLOCKS];
+    for (std::size_t chunk = 0; chunk < buffer.size(); chunk += CHUNK_BLOCKS * BLOCK_SIZE)
+    {
+        std::size_t chunk_size = std::min(CHUNK_BLOCKS * BLOCK_SIZE, buffer.size() - chunk);
+        classify_(data + chunk, chunk_size, bitmaps);
+
+        /* Visit the structural characters only */
+        for (std::size_t block = 0; block * BLOCK_SIZE < chunk_size; block++)
+        {
+            uint64_t bits = bitmaps[block];
+            while (bits != 0)
+            {
+                std::size_t position = chunk + block * BLOCK_SIZE + trailing_zeros(bits);
+                bits &= bits - 1;
+                std::size_t offset = position - current->begin;
+                switch (data[position])
+                {
+                    case ',':
+                    {
+                        // Separators after the checksum mark are not fields
+                        if (current->checksum_marks > 0)
+                        {
+                            break;
+                        }
+                        if (current->truncated || current->separator_count == IndexedSentence::MAX_SEPARATORS ||
+                                offset > std::numeric_limits<uint16_t>::max())
+                        {
+                            current->truncated = true;
+                            break;
+                        }
+                        current->separators[current->separator_count++] = static_cast<uint16_t>(offset);
+                        break;
+                    }
+                    case '*':
+                    {
+                        if (current->checksum_marks == 0)
+                        {
+                            current->checksum_mark = static_cast<uint32_t>(offset);
+                        }
+                        if (current->checksum_marks < std::numeric_limits<uint8_t>::max())
+                        {
+                            current->checksum_marks++;
+                        }
+                        break;
+                    }
+                    case '$':
+                    case '!':
+                    {
+                        // Resynchronize: whatever came before in the line is not part of the sentence
+                        start_sentence(*current, position);
+                        current->starts_with_mark = true;
+                        find_tag_block(*current, data, line_begin);
+                        break;
+                    }
+                    case '\n':
+                    {
+                        if (finish_sentence(*current, data, position))
+                        {
+                            count++;
+                            if (count == max_sentences)
+                            {
+                                if (consumed)
+                                {
+                                    *consumed = position + 1;
+                                }
+                                return count;
+                            }
+                            current = &sentences[count];
+                        }
+                        start_sentence(*current, position + 1);
+                        line_begin = position + 1;
+                        break;
+                    }
+                    default:
+                    {
+                        // Carriage returns are only relevant before a line feed
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    /* Last line without terminator */
+    if (current->begin < buffer.size() && finish_sentence(*current, data, buffer.size()))
+    {
+        count++;
+    }
+
+    if (consumed)
+    {
+        *consumed = buffer.size();
+    }
+    return count;
+}
+
+const char* StructuralIndex::implementation() noexcept
+{
+    const char* name = nullptr;
+    select_kernel_(name);
+    return name;
+}
+
+void StructuralIndex::classify_scalar_(
+        const char* data,
+        std::size_t blocks,
+        uint64_t* bitmaps) noexcept
+{
+    for (std::size_t block = 0; block < blocks; block++, data += BLOCK_SIZE)
+    {
+        uint64_t bits = 0;
+        for (std::size_t i = 0; i < BLOCK_SIZE; i += 8)
+        {
+            uint64_t word;
+            std::memcpy(&word, data + i, sizeof(word));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+            word = __builtin_bswap64(word);
+#endif // Big endian
+            uint64_t found = zero_bytes(word ^ broadcast('$')) | zero_bytes(word ^ broadcast('!')) |
+                    zero_bytes(word ^ broadcast(',')) | zero_bytes(word ^ broadcast('*')) |
+                    zero_bytes(word ^ broadcast('\r')) | zero_bytes(word ^ broadcast('\n'));
+            // Gather the highest bit of each byte into the lowest byte
+            bits |= (((found >> 7) * 0x0102040810204080ull) >> 56) << i;
+        }
+        bitmaps[block] = bits;
+    }
+}
+
+void StructuralIndex::classify_(
+        const char* data,
+        std::size_t size,
+        uint64_t* bitmaps) noexcept
+{
+    static const char* name = nullptr;
+    static const BitmapKernel kernel = select_kernel_(name);
+
+    std::size_t blocks = size / BLOCK_SIZE;
+    kernel(data, blocks, bitmaps);
+
+    /* The last partial block is classified from a copy padded with zeros */
+    std::size_t remaining = size - blocks * BLOCK_SIZE;
+    if (remaining > 0)
+    {
+        char padded[BLOCK_SIZE] = {};
+        std::memcpy(padded, data + blocks * BLOCK_SIZE, remaining);
+        kernel(padded, 1, bitmaps + blocks);
+    }
+}
+
+StructuralIndex::BitmapKernel StructuralIndex::select_kernel_(
+        const char*& name) noexcept
+{
+    return simd::select_kernel<BitmapKernel>(classify_scalar_, classify_sse2_, classify_avx2_, classify_neon_, name);
+}
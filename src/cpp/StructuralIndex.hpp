@@ -0,0 +1,257 @@
+// Copyright (c) 2021 Eduardo Ponz Segrelles.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+/**
+ * @file StructuralIndex.hpp
+ */
+
+#ifndef _EASYNMEA_STRUCTURALINDEX_HPP_
+#define _EASYNMEA_STRUCTURALINDEX_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace eduponz {
+namespace easynmea {
+
+/**
+ * @struct IndexedSentence
+ *
+ * Location of a sentence and its fields within a buffer, as found by \c StructuralIndex. All the
+ * offsets are relative to the buffer from which the index was built, so the sentence bytes are
+ * never copied.
+ */
+struct IndexedSentence
+{
+    //! Maximum number of field separators recorded for each sentence
+    static constexpr std::size_t MAX_SEPARATORS = 63;
+
+    //! Offset of the first character of the sentence within the buffer
+    uint32_t begin = 0;
+
+    //! Number of characters of the sentence, not including the line terminator
+    uint32_t size = 0;
+
+    //! Offset of the first checksum mark '*' relative to \c begin, or \c size if there is none
+    uint32_t checksum_mark = 0;
+
+    //! Number of checksum marks '*' in the sentence, saturated to 255
+    uint8_t checksum_marks = 0;
+
+    //! Number of field separators ',' before the checksum mark
+    uint8_t separator_count = 0;
+
+    //! Whether the sentence starts with a '$' or a '!'
+    bool starts_with_mark = false;
+
+    /**
+     * Number of characters of the tag block which precedes the sentence, including both '\\', or 0
+     * if there is none. The tag block ends at \c begin
+     */
+    uint16_t tag_block_size = 0;
+
+    /**
+     * Whether some separators could not be recorded, because there were more than \c MAX_SEPARATORS
+     * or they were too far from the beginning of the sentence. In that case, only the first
+     * \c separator_count fields are available.
+     */
+    bool truncated = false;
+
+    //! Offsets of the field separators relative to \c begin
+    uint16_t separators[MAX_SEPARATORS] = {};
+
+    /**
+     * \brief Check whether the sentence is framed as '[$!]<sentence>*hh'
+     *
+     * The characters of the checksum are not checked.
+     *
+     * @return \c true if the sentence starts with a start mark, and its only checksum mark is
+     *         followed by exactly two characters; \c false otherwise.
+     */
+    bool framed() const noexcept
+    {
+        return starts_with_mark && checksum_marks == 1 && size >= 4 && checksum_mark + 3 == size;
+    }
+
+    /**
+     * \brief Get the number of fields before the checksum mark, including the sentence identifier
+     *
+     * @return The number of fields.
+     */
+    std::size_t field_count() const noexcept
+    {
+        return static_cast<std::size_t>(separator_count) + 1;
+    }
+
+    /**
+     * \brief Get the sentence, not including the line terminator
+     *
+     * @param buffer The buffer from which the index was built.
+     * @return A view of the sentence within \c buffer.
+     */
+    std::string_view sentence(
+            std::string_view buffer) const noexcept
+    {
+        return buffer.substr(begin, size);
+    }
+
+    /**
+     * \brief Get the tag block which precedes the sentence
+     *
+     * @param buffer The buffer from which the index was built.
+     * @return A view of the tag block within \c buffer, including both '\\'. It is empty if the
+     *         sentence is not preceded by a tag block.
+     */
+    std::string_view tag_block(
+            std::string_view buffer) const noexcept
+    {
+        return buffer.substr(begin - tag_block_size, tag_block_size);
+    }
+
+    /**
+     * \brief Get a field of the sentence
+     *
+     * Field 0 is the sentence identifier (including the start mark), and the last field ends at the
+     * checksum mark.
+     *
+     * @param buffer The buffer from which the index was built.
+     * @param index The index of the field.
+     * @return A view of the field within \c buffer, not including the separators. It is empty if the
+     *         field does not exist or could not be recorded.
+     */
+    std::string_view field(
+            std::string_view buffer,
+            std::size_t index) const noexcept
+    {
+        if (index >= field_count() || (truncated && index >= separator_count))
+        {
+            return std::string_view();
+        }
+        std::size_t field_begin = index == 0 ? 0 : separators[index - 1] + 1u;
+        std::size_t field_end = index < separator_count ? separators[index] : checksum_mark;
+        return buffer.substr(begin + field_begin, field_end - field_begin);
+    }
+
+};
+
+/**
+ * @class StructuralIndex
+ *
+ * This class provides static APIs to index the sentences contained in a buffer in a single pass.
+ *
+ * The buffer is classified in blocks of 64 bytes with a vectorized kernel, which produces a bitmap
+ * with the positions of the structural characters ('$', '!', ',', '*', '\\r' and '\\n'). Then, only
+ * the set bits are visited to build a table with the location of every sentence and its fields,
+ * which the sentence decoders can consume without tokenizing the sentence again. The kernel is
+ * selected once at runtime according to the CPU capabilities, in the same way as \c Checksum does.
+ */
+class StructuralIndex
+{
+public:
+
+    /**
+     * \brief Index the sentences contained in a buffer
+     *
+     * Lines are terminated either in \c '\n' or \c '\r\n', and a last line without terminator is
+     * also indexed. Empty lines are skipped. If a line contains a start mark ('$' or '!') which is
+     * not its first character, the sentence starts at the last of them, so that the noise received
+     * before a sentence (for instance, the end of a sentence that was partially received) is
+     * discarded. If the start mark is preceded by a tag block, that is, by characters enclosed in
+     * '\\', the tag block is recorded in \c IndexedSentence::tag_block_size instead.
+     *
+     * @param[in] buffer The buffer holding the sentences.
+     * @param[out] sentences Array in which the index of each sentence is stored, in order.
+     * @param[in] max_sentences Capacity of \c sentences.
+     * @param[out] consumed If not \c nullptr, it is set to the number of bytes of \c buffer that were
+     *             indexed, including the terminator of the last indexed line. When \c sentences is
+     *             filled up, indexing can be resumed from that offset.
+     * @return The number of sentences indexed, i.e. the number of elements written in \c sentences.
+     */
+    static std::size_t build(
+            std::string_view buffer,
+            IndexedSentence* sentences,
+            std::size_t max_sentences,
+            std::size_t* consumed = nullptr) noexcept;
+
+    /**
+     * \brief Get the name of the kernel selected for this CPU
+     *
+     * @return One of "avx2", "sse2", "neon", or "scalar".
+     */
+    static const char* implementation() noexcept;
+
+protected:
+
+    //! Number of bytes classified by each bitmap word
+    static constexpr std::size_t BLOCK_SIZE = 64;
+
+    /**
+     * Signature of the classification kernels. Each kernel classifies \c blocks consecutive blocks of
+     * \c BLOCK_SIZE bytes, setting in \c bitmaps[i] the bits of the structural characters of block i.
+     */
+    using BitmapKernel = void (*)(
+        const char* data,
+        std::size_t blocks,
+        uint64_t* bitmaps);
+
+    //! Portable classification kernel, which classifies 8 bytes at a time
+    static void classify_scalar_(
+            const char* data,
+            std::size_t blocks,
+            uint64_t* bitmaps) noexcept;
+
+    //! SSE2 classification kernel. \c nullptr if not available on this platform
+    static const BitmapKernel classify_sse2_;
+
+    //! AVX2 classification kernel. \c nullptr if not available on this platform
+    static const BitmapKernel classify_avx2_;
+
+    //! NEON classification kernel. \c nullptr if not available on this platform
+    static const BitmapKernel classify_neon_;
+
+    /**
+     * \brief Classify a buffer of any size with the kernel selected for this CPU
+     *
+     * @param[in] data Pointer to the first byte.
+     * @param[in] size Number of bytes. It cannot be larger than \c BLOCK_SIZE times the number of
+     *            elements of \c bitmaps.
+     * @param[out] bitmaps The bitmaps of each block. The bits past \c size are cleared.
+     */
+    static void classify_(
+            const char* data,
+            std::size_t size,
+            uint64_t* bitmaps) noexcept;
+
+    /**
+     * \brief Select the fastest kernel supported by the CPU
+     *
+     * @param[out] name The name of the selected kernel.
+     * @return The selected kernel.
+     */
+    static BitmapKernel select_kernel_(
+            const char*& name) noexcept;
+
+};
+
+} // namespace easynmea
+} // namespace eduponz
+
+#endif //_EASYNMEA_STRUCTURALINDEX_HPP_
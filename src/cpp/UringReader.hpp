@@ -0,0 +1,828 @@
+// Copyright (c) 2021 Eduardo Ponz Segrelles.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+/**
+ * @file UringReader.hpp
+ */
+
+#ifndef _EASYNMEA_URINGREADER_HPP_
+#define _EASYNMEA_URINGREADER_HPP_
+
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <asio/error.hpp>
+#include <asio/error_code.hpp>
+
+#include "IoUring.hpp"
+#include "LineFramer.hpp"
+#include "PosixSerialPort.hpp"
+
+namespace eduponz {
+namespace easynmea {
+
+/**
+ * @class UringReader
+ *
+ * This class reads lines from many sources at once on a single thread: serial ports, as well as
+ * regular files and pipes, e.g. to replay logs of NMEA 0183 sentences. It is the counterpart of
+ * \c SerialInterface for gateways with many receivers.
+ *
+ * Each source has a buffer of its own, from which its lines are framed as \c SerialInterface does.
+ * The buffers are registered with an io_uring instance, on which a fixed read is kept in flight
+ * for every source whose buffer is drained. The completions of all the sources are reaped in
+ * batches from the ring, and the reads they re-arm are submitted together with the next wait, so
+ * receiving a chunk of bytes takes a single system call however many sources are read.
+ *
+ * When io_uring is not available, either because the kernel does not support it or because it is
+ * disabled, the reader falls back to waiting for the sources with \c poll() and reading them with
+ * \c read(), with the same behaviour.
+ *
+ * The sources are opened and closed while the lines are not being read, except for \c close(),
+ * which can be called from any other thread to stop \c read_lines().
+ *
+ * It is not a backend of \c EasyNmea, which reads a single port through \c SerialInterface, so the
+ * lines it hands over are neither decoded nor stamped with a \c ReceiveTime. \c UringSerialPort is
+ * the \c SerialPort implementation which reads that port on io_uring.
+ */
+class UringReader
+{
+public:
+
+    //! Size of the buffer of each source. Regular files are read in chunks of this size
+    static constexpr std::size_t BUFFER_SIZE = 4096;
+
+    //! Mechanism with which the sources are read
+    enum class Backend
+    {
+        //! Fixed reads into registered buffers, reaped from an io_uring instance
+        IO_URING,
+        //! \c poll() and \c read()
+        POLL
+    };
+
+    /**
+     * Handler of the lines framed by \c read_lines(). It is called from the thread which calls
+     * \c read_lines(), with the source the line was read from, and it returns whether to keep on
+     * reading.
+     */
+    using LineHandler = std::function<bool (std::size_t source, const std::string& line)>;
+
+    /**
+     * Constructor.
+     *
+     * @param max_sources The maximum number of sources which can be open at once.
+     * @param backend The preferred backend. \c Backend::IO_URING falls back to \c Backend::POLL if
+     *        io_uring is not available.
+     */
+    UringReader(
+            std::size_t max_sources = 32,
+            Backend backend = Backend::IO_URING) noexcept
+        : backend_(Backend::POLL)
+        , sources_(max_sources)
+        , buffers_(max_sources * BUFFER_SIZE)
+        , poll_fds_(max_sources + 1)
+        , poll_sources_(max_sources + 1)
+        , wake_fd_(::eventfd(0, EFD_CLOEXEC))
+        , wake_count_(0)
+        , in_flight_(0)
+        , running_(false)
+        , closing_(false)
+    {
+        if (backend == Backend::IO_URING)
+        {
+            asio::error_code ec;
+            if (setup_ring_(ec))
+            {
+                backend_ = Backend::IO_URING;
+            }
+            else
+            {
+                std::cout << "[INFO] io_uring is not available, reading with poll(). Reason: " << ec.message()
+                          << std::endl;
+            }
+        }
+    }
+
+    UringReader(
+            const UringReader&) = delete;
+
+    UringReader& operator =(
+            const UringReader&) = delete;
+
+    /**
+     * Destructor. It closes all the sources.
+     */
+    ~UringReader() noexcept
+    {
+        close();
+        if (wake_fd_ != -1)
+        {
+            ::close(wake_fd_);
+        }
+    }
+
+    /**
+     * \brief Get the backend with which the sources are read.
+     *
+     * @return \c Backend::IO_URING if io_uring was preferred and it is available;
+     *         \c Backend::POLL otherwise.
+     */
+    Backend backend() const noexcept
+    {
+        return backend_;
+    }
+
+    /**
+     * \brief Open a serial port as a source.
+     *
+     * The tty is opened raw, as \c PosixSerialPort does.
+     *
+     * @param port device name, example "/dev/ttyUSB0"
+     * @param baudrate communication speed, example 9600 or 115200
+     * @param[out] source The source of the port, which its lines are handed over with.
+     * @return true if the port was opened; false if it could not be opened, there are already
+     *         \c max_sources open, or the lines are being read.
+     */
+    bool open(
+            const std::string& port,
+            uint64_t baudrate,
+            std::size_t& source) noexcept
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        asio::error_code ec;
+        int fd = PosixSerialPort::open_tty(port, 1, O_NONBLOCK, ec);
+        if (fd != -1 && !PosixSerialPort::set_baud_rate(fd, static_cast<unsigned int>(baudrate), ec))
+        {
+            ::close(fd);
+            fd = -1;
+        }
+        if (fd == -1)
+        {
+            std::cout << "[ERROR] Cannot open serial port '" << port << "'. Error: " << ec.message() << std::endl;
+            return false;
+        }
+        return add_source_(fd, source);
+    }
+
+    /**
+     * \brief Open a regular file or a pipe as a source.
+     *
+     * A regular file is read up to its end, and a pipe until its writers close it. A pipe without
+     * writers reads as ended.
+     *
+     * @param path The path to the file or the named pipe, or "/dev/stdin".
+     * @param[out] source The source of the file, which its lines are handed over with.
+     * @return true if the file was opened; false if it could not be opened, there are already
+     *         \c max_sources open, or the lines are being read.
+     */
+    bool open_file(
+            const std::string& path,
+            std::size_t& source) noexcept
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        // A named pipe is opened without waiting for a writer
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC | O_NONBLOCK);
+        if (fd == -1)
+        {
+            std::cout << "[ERROR] Cannot open file '" << path << "'. Error: " << std::strerror(errno) << std::endl;
+            return false;
+        }
+        return add_source_(fd, source);
+    }
+
+    /**
+     * \brief Check whether any source is open.
+     *
+     * @return true if at least one source is open; false otherwise.
+     */
+    bool is_open() noexcept
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const Source& source : sources_)
+        {
+            if (source.fd != -1)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * \brief Close all the sources.
+     *
+     * If the lines are being read, \c read_lines() is stopped first, and this call blocks until it
+     * returns. It must not be called from the \c LineHandler, which can return false instead.
+     *
+     * @return true if all the sources were closed; false if any of them could not be closed.
+     */
+    bool close() noexcept
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (running_)
+        {
+            closing_.store(true);
+            uint64_t wake_up = 1;
+            static_cast<void>(::write(wake_fd_, &wake_up, sizeof(wake_up)));
+            cv_.wait(lock, [this]()
+                    {
+                        return !running_;
+                    });
+            closing_.store(false);
+        }
+
+        bool ret = true;
+        for (std::size_t i = 0; i < sources_.size(); i++)
+        {
+            ret &= close_source_(i);
+        }
+        return ret;
+    }
+
+    /**
+     * \brief Blocks handing the lines received from all the sources to a handler, until all of
+     *        them end, they are closed, or the handler asks to stop.
+     *
+     * Eventual \c '\n' or \c '\r\n' characters at the end of the lines are removed, as in
+     * \c SerialInterface::read_lines(). Sources which end (regular files, pipes whose writers
+     * closed them, or ttys which hung up) are closed, handing over their last line even if it does
+     * not end in \c '\n'. Sources which fail are reported and closed as well.
+     *
+     * @param on_line Handler of the lines. The line is only valid during the call, as it is
+     *        overwritten by the next one. If it returns false, no more lines are handed to it, and
+     *        the bytes already received are kept for the next call.
+     * @return true if the handler asked to stop; false if all the sources ended, or they were
+     *         closed.
+     */
+    bool read_lines(
+            const LineHandler& on_line) noexcept
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (running_)
+            {
+                return false;
+            }
+            running_ = true;
+        }
+
+        // A wake-up left by a close() while the lines were not being read does not belong to this call
+        pollfd wake = {wake_fd_, POLLIN, 0};
+        if (::poll(&wake, 1, 0) == 1)
+        {
+            uint64_t wake_ups;
+            static_cast<void>(::read(wake_fd_, &wake_ups, sizeof(wake_ups)));
+        }
+
+        // The lines left in the buffers by the previous call are handed over before reading again
+        bool stopped = false;
+        for (std::size_t i = 0; i < sources_.size() && !stopped; i++)
+        {
+            stopped = sources_[i].fd != -1 && !frame_lines_(i, on_line);
+        }
+        if (!stopped)
+        {
+#if defined(EASYNMEA_HAVE_IO_URING)
+            stopped = backend_ == Backend::IO_URING ? read_ring_(on_line) : read_poll_(on_line);
+#else
+            stopped = read_poll_(on_line);
+#endif  // defined(EASYNMEA_HAVE_IO_URING)
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            running_ = false;
+        }
+        cv_.notify_all();
+        return stopped;
+    }
+
+protected:
+
+    //! State of a source
+    struct Source
+    {
+        //! File descriptor of the source. -1 when it is closed
+        int fd = -1;
+
+        //! Whether a read of the source is in flight on the ring
+        bool in_flight = false;
+
+        //! Position of the first byte in the buffer of the source which has not been framed yet
+        std::size_t begin = 0;
+
+        //! Position past the last byte read into the buffer of the source
+        std::size_t end = 0;
+
+        //! Bytes of the line being framed
+        std::string line;
+    };
+
+    //! Result of handling a read
+    enum class ReadResult
+    {
+        //! The buffer was drained, so the source is read again
+        REARM,
+        //! The handler asked to stop
+        STOP,
+        //! The source ended or failed, and it was closed
+        CLOSED
+    };
+
+    //! user_data of the read of wake_fd_ on the ring
+    static constexpr uint64_t WAKE_USER_DATA = ~uint64_t(0);
+
+    //! user_data of the cancellations on the ring
+    static constexpr uint64_t CANCEL_USER_DATA = ~uint64_t(0) - 1;
+
+    //! Backend with which the sources are read
+    Backend backend_;
+
+    //! Sources, indexed by their source number
+    std::vector<Source> sources_;
+
+    //! Buffers of the sources, one after another
+    std::vector<char> buffers_;
+
+    //! poll() descriptors of wake_fd_ and the sources, for the poll backend
+    std::vector<pollfd> poll_fds_;
+
+    //! Source of each poll() descriptor
+    std::vector<std::size_t> poll_sources_;
+
+    //! eventfd written by close() to wake the reading thread up. It is blocking, as the ring fails
+    //! reads of non-blocking descriptors which are not ready rather than waiting for them
+    int wake_fd_;
+
+    //! Value read from wake_fd_ on the ring
+    uint64_t wake_count_;
+
+    //! Number of requests in flight on the ring
+    std::size_t in_flight_;
+
+    //! Guards the file descriptors of the sources and running_
+    std::mutex mutex_;
+
+    //! Notified when read_lines() returns
+    std::condition_variable cv_;
+
+    //! Whether read_lines() is running
+    bool running_;
+
+    //! Whether close() is waiting for read_lines() to return
+    std::atomic<bool> closing_;
+
+    /**
+     * Set the ring up, with room for a read and a cancellation per source and for wake_fd_, and
+     * register the buffers of the sources with it.
+     *
+     * @param[out] ec The error code of the failing operation
+     * @return true if the ring can be used; false otherwise
+     */
+    bool setup_ring_(
+            asio::error_code& ec) noexcept
+    {
+#if defined(EASYNMEA_HAVE_IO_URING)
+        if (wake_fd_ == -1 || sources_.empty())
+        {
+            ec = asio::error::invalid_argument;
+            return false;
+        }
+        if (!ring_.setup(static_cast<unsigned>(2 * (sources_.size() + 1)), ec))
+        {
+            return false;
+        }
+        std::vector<iovec> buffers(sources_.size());
+        for (std::size_t i = 0; i < sources_.size(); i++)
+        {
+            buffers[i].iov_base = buffer_(i);
+            buffers[i].iov_len = BUFFER_SIZE;
+        }
+        return ring_.register_buffers(buffers.data(), static_cast<unsigned>(buffers.size()), ec);
+#else
+        // Built against kernel headers without io_uring
+        ec = asio::error::operation_not_supported;
+        return false;
+#endif  // defined(EASYNMEA_HAVE_IO_URING)
+    }
+
+#if defined(EASYNMEA_HAVE_IO_URING)
+    //! The ring on which the sources are read, for the io_uring backend
+    IoUring ring_;
+
+    /**
+     * Read the sources on the ring until all of them end, the handler asks to stop, or close() is
+     * called. The requests in flight are cancelled before returning.
+     *
+     * @param on_line Handler of the lines
+     * @return true if the handler asked to stop; false otherwise
+     */
+    bool read_ring_(
+            const LineHandler& on_line) noexcept
+    {
+        arm_wake_();
+        bool reading = false;
+        for (std::size_t i = 0; i < sources_.size(); i++)
+        {
+            if (sources_[i].fd != -1)
+            {
+                arm_read_(i);
+                reading = true;
+            }
+        }
+
+        bool stopped = false;
+        bool aborted = false;
+        asio::error_code ec;
+        while (reading && !stopped && !aborted)
+        {
+            if (!ring_.submit_and_wait(1, ec))
+            {
+                std::cout << "[ERROR] Something happened while reading: " << ec.message() << std::endl;
+                break;
+            }
+            ring_.for_each_cqe([&](const io_uring_cqe& cqe)
+                    {
+                        in_flight_--;
+                        if (cqe.user_data == WAKE_USER_DATA)
+                        {
+                            aborted = closing_.load();
+                            if (!aborted)
+                            {
+                                arm_wake_();
+                            }
+                            return;
+                        }
+                        std::size_t i = static_cast<std::size_t>(cqe.user_data);
+                        sources_[i].in_flight = false;
+                        if (stopped || aborted)
+                        {
+                            keep_read_(i, cqe.res);
+                            return;
+                        }
+                        ReadResult result = on_read_(i, cqe.res, on_line);
+                        if (result == ReadResult::REARM)
+                        {
+                            arm_read_(i);
+                        }
+                        stopped = result == ReadResult::STOP;
+                    });
+
+            reading = false;
+            for (const Source& source : sources_)
+            {
+                reading |= source.in_flight;
+            }
+        }
+
+        cancel_all_();
+        return stopped;
+    }
+
+    //! Queue a read of wake_fd_ on the ring
+    void arm_wake_() noexcept
+    {
+        io_uring_sqe* sqe = next_sqe_();
+        sqe->opcode = IORING_OP_READ;
+        sqe->fd = wake_fd_;
+        sqe->addr = reinterpret_cast<uint64_t>(&wake_count_);
+        sqe->len = sizeof(wake_count_);
+        sqe->off = ~uint64_t(0);
+        sqe->user_data = WAKE_USER_DATA;
+        in_flight_++;
+    }
+
+    /**
+     * Queue a fixed read of a source into its drained buffer on the ring
+     *
+     * @param i The source
+     */
+    void arm_read_(
+            std::size_t i) noexcept
+    {
+        io_uring_sqe* sqe = next_sqe_();
+        sqe->opcode = IORING_OP_READ_FIXED;
+        sqe->fd = sources_[i].fd;
+        sqe->addr = reinterpret_cast<uint64_t>(buffer_(i));
+        sqe->len = static_cast<uint32_t>(BUFFER_SIZE);
+        sqe->off = ~uint64_t(0);  // From the current position, which regular files advance
+        sqe->buf_index = static_cast<uint16_t>(i);
+        sqe->user_data = i;
+        sources_[i].in_flight = true;
+        in_flight_++;
+    }
+
+    /**
+     * Cancel all the requests in flight on the ring, and wait for them to complete. The bytes of
+     * the reads which complete nonetheless are kept for the next call to read_lines().
+     */
+    void cancel_all_() noexcept
+    {
+        std::vector<uint64_t> pending;
+        for (std::size_t i = 0; i < sources_.size(); i++)
+        {
+            if (sources_[i].in_flight)
+            {
+                pending.push_back(i);
+            }
+        }
+        if (in_flight_ > pending.size())
+        {
+            pending.push_back(WAKE_USER_DATA);
+        }
+        for (uint64_t user_data : pending)
+        {
+            io_uring_sqe* sqe = next_sqe_();
+            sqe->opcode = IORING_OP_ASYNC_CANCEL;
+            sqe->addr = user_data;
+            sqe->user_data = CANCEL_USER_DATA;
+            in_flight_++;
+        }
+
+        asio::error_code ec;
+        while (in_flight_ > 0 && ring_.submit_and_wait(1, ec))
+        {
+            ring_.for_each_cqe([this](const io_uring_cqe& cqe)
+                    {
+                        in_flight_--;
+                        if (cqe.user_data != WAKE_USER_DATA && cqe.user_data != CANCEL_USER_DATA)
+                        {
+                            std::size_t i = static_cast<std::size_t>(cqe.user_data);
+                            sources_[i].in_flight = false;
+                            keep_read_(i, cqe.res);
+                        }
+                    });
+        }
+    }
+
+    //! Take the next submission queue entry, submitting the queued ones first if it is full
+    io_uring_sqe* next_sqe_() noexcept
+    {
+        io_uring_sqe* sqe = ring_.get_sqe();
+        while (sqe == nullptr)
+        {
+            asio::error_code ec;
+            ring_.submit_and_wait(0, ec);
+            sqe = ring_.get_sqe();
+        }
+        return sqe;
+    }
+
+#endif  // defined(EASYNMEA_HAVE_IO_URING)
+
+    /**
+     * Read the sources with poll() and read() until all of them end, the handler asks to stop, or
+     * close() is called.
+     *
+     * @param on_line Handler of the lines
+     * @return true if the handler asked to stop; false otherwise
+     */
+    bool read_poll_(
+            const LineHandler& on_line) noexcept
+    {
+        while (true)
+        {
+            poll_fds_[0] = {wake_fd_, POLLIN, 0};
+            nfds_t count = 1;
+            for (std::size_t i = 0; i < sources_.size(); i++)
+            {
+                if (sources_[i].fd != -1)
+                {
+                    poll_fds_[count] = {sources_[i].fd, POLLIN, 0};
+                    poll_sources_[count] = i;
+                    count++;
+                }
+            }
+            if (count == 1)
+            {
+                return false;
+            }
+
+            if (::poll(poll_fds_.data(), count, -1) == -1)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                std::cout << "[ERROR] Something happened while reading: " << std::strerror(errno) << std::endl;
+                return false;
+            }
+            if (poll_fds_[0].revents != 0)
+            {
+                uint64_t wake_ups;
+                static_cast<void>(::read(wake_fd_, &wake_ups, sizeof(wake_ups)));
+                if (closing_.load())
+                {
+                    return false;
+                }
+            }
+            for (nfds_t k = 1; k < count; k++)
+            {
+                if (poll_fds_[k].revents == 0)
+                {
+                    continue;
+                }
+                std::size_t i = poll_sources_[k];
+                ssize_t bytes = ::read(sources_[i].fd, buffer_(i), BUFFER_SIZE);
+                int result = bytes >= 0 ? static_cast<int>(bytes) : -errno;
+                if (result != -EINTR && result != -EAGAIN && on_read_(i, result, on_line) == ReadResult::STOP)
+                {
+                    return true;
+                }
+            }
+        }
+    }
+
+    /**
+     * Handle the result of a read of a source, framing the read lines.
+     *
+     * @param i The source
+     * @param result The number of read bytes, 0 if the source ended, or the negated \c errno
+     * @param on_line Handler of the lines
+     * @return What to do with the source next
+     */
+    ReadResult on_read_(
+            std::size_t i,
+            int result,
+            const LineHandler& on_line) noexcept
+    {
+        Source& source = sources_[i];
+        if (result > 0)
+        {
+            source.begin = 0;
+            source.end = static_cast<std::size_t>(result);
+            return frame_lines_(i, on_line) ? ReadResult::REARM : ReadResult::STOP;
+        }
+        if (result == 0 || result == -EIO)
+        {
+            // The source ended (or the tty hung up), so its last line is complete
+            bool keep_on = source.line.empty() || on_line(i, source.line);
+            std::lock_guard<std::mutex> lock(mutex_);
+            close_source_(i);
+            return keep_on ? ReadResult::CLOSED : ReadResult::STOP;
+        }
+        std::cout << "[ERROR] Something happened while reading source " << i << ": " << std::strerror(-result)
+                  << std::endl;
+        std::lock_guard<std::mutex> lock(mutex_);
+        close_source_(i);
+        return ReadResult::CLOSED;
+    }
+
+    /**
+     * Keep the bytes of a read which completed after the handler asked to stop, so that they are
+     * framed by the next call to read_lines().
+     *
+     * @param i The source
+     * @param result The result of the read
+     */
+    void keep_read_(
+            std::size_t i,
+            int result) noexcept
+    {
+        if (result > 0)
+        {
+            sources_[i].begin = 0;
+            sources_[i].end = static_cast<std::size_t>(result);
+        }
+    }
+
+    /**
+     * Hand the lines buffered for a source to the handler, until the buffer is drained.
+     *
+     * @param i The source
+     * @param on_line Handler of the lines
+     * @return true if the buffer was drained; false if the handler asked to stop before.
+     */
+    bool frame_lines_(
+            std::size_t i,
+            const LineHandler& on_line) noexcept
+    {
+        Source& source = sources_[i];
+        char* buffer = buffer_(i);
+        while (source.begin != source.end)
+        {
+            const char* next = LineFramer::frame(source.line, buffer + source.begin, buffer + source.end);
+            if (next == nullptr)
+            {
+                source.begin = source.end;
+                return true;
+            }
+            source.begin = static_cast<std::size_t>(next - buffer);
+            bool keep_on = on_line(i, source.line);
+            source.line.clear();
+            if (!keep_on)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Start reading from a file descriptor as a new source.
+     *
+     * @param fd The file descriptor, opened non-blocking. It is made blocking, so that the ring
+     *        waits for it to be readable rather than failing the read.
+     * @param[out] source The new source
+     * @return true if the source was added; false if it was closed instead
+     */
+    bool add_source_(
+            int fd,
+            std::size_t& source) noexcept
+    {
+        if (!running_)
+        {
+            for (std::size_t i = 0; i < sources_.size(); i++)
+            {
+                if (sources_[i].fd == -1)
+                {
+                    int flags = ::fcntl(fd, F_GETFL);
+                    if (flags == -1 || ::fcntl(fd, F_SETFL, flags & ~O_NONBLOCK) == -1)
+                    {
+                        break;
+                    }
+                    sources_[i].fd = fd;
+                    sources_[i].begin = 0;
+                    sources_[i].end = 0;
+                    sources_[i].line.clear();
+                    source = i;
+                    return true;
+                }
+            }
+        }
+        ::close(fd);
+        return false;
+    }
+
+    /**
+     * Close a source, if it is open. The caller holds mutex_.
+     *
+     * @param i The source
+     * @return true if the source is closed; false if it could not be closed
+     */
+    bool close_source_(
+            std::size_t i) noexcept
+    {
+        Source& source = sources_[i];
+        if (source.fd == -1)
+        {
+            return true;
+        }
+        int fd = source.fd;
+        source.fd = -1;
+        source.begin = 0;
+        source.end = 0;
+        source.line.clear();
+        if (::close(fd) == -1)
+        {
+            std::cout << "[ERROR] Cannot close source " << i << ". Error: " << std::strerror(errno) << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    //! Buffer of a source
+    char* buffer_(
+            std::size_t i) noexcept
+    {
+        return buffers_.data() + i * BUFFER_SIZE;
+    }
+
+};
+
+} // namespace eduponz
+} // namespace easynmea
+
+#endif  /* _EASYNMEA_URINGREADER_HPP_ */
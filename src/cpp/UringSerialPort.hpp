@@ -0,0 +1,450 @@
+// Copyright (c) 2021 Eduardo Ponz Segrelles.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+/**
+ * @file UringSerialPort.hpp
+ */
+
+#ifndef _EASYNMEA_URINGSERIALPORT_HPP_
+#define _EASYNMEA_URINGSERIALPORT_HPP_
+
+#include <cerrno>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <string>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+#include <asio/buffer.hpp>
+#include <asio/error.hpp>
+#include <asio/error_code.hpp>
+#include <asio/io_service.hpp>
+
+#include "IoUring.hpp"
+#include "PosixSerialPort.hpp"
+
+namespace eduponz {
+namespace easynmea {
+
+/**
+ * @class UringSerialPort
+ *
+ * This class is a \c SerialPort implementation for \c SerialInterface which reads the tty on an
+ * io_uring instance. It is the single port counterpart of \c UringReader, so that \c EasyNmea can
+ * read with io_uring as well.
+ *
+ * The tty is opened as \c PosixSerialPort does, but blocking, and each \c async_read_some() queues
+ * a read of it on the ring, which waits for the tty to be readable as per the \c VMIN of its
+ * \c ReadProfile and reads it in a single system call. If the profile has a \c VTIME, the reader
+ * then sleeps for it on the ring, and takes the rest of the burst which the tty buffered meanwhile.
+ *
+ * \c close() can be called from any other thread: it wakes the ring up through the \c eventfd
+ * which \c PosixSerialPort uses, on which a poll is kept in flight, and the read is cancelled, so
+ * the handler is called with \c asio::error::operation_aborted.
+ *
+ * When io_uring is not available, either because the kernel does not support it or because it is
+ * disabled, the port falls back to reading as \c PosixSerialPort, with the same behaviour.
+ */
+class UringSerialPort : public PosixSerialPort
+{
+public:
+
+    /**
+     * Constructor.
+     *
+     * @param io_service The I/O service on which the reads are posted.
+     */
+    UringSerialPort(
+            asio::io_service& io_service) noexcept
+        : PosixSerialPort(io_service)
+        , uses_io_uring_(false)
+        , opened_(0)
+        , wake_armed_(false)
+    {
+        asio::error_code ec;
+        if (setup_ring_(ec))
+        {
+            uses_io_uring_ = true;
+        }
+        else
+        {
+            std::cout << "[INFO] io_uring is not available, reading the serial port with epoll(). Reason: "
+                      << ec.message() << std::endl;
+        }
+    }
+
+    /**
+     * \brief Check whether the tty is read on io_uring.
+     *
+     * @return true if io_uring is available; false if the port falls back to \c PosixSerialPort.
+     */
+    bool uses_io_uring() const noexcept
+    {
+        return uses_io_uring_;
+    }
+
+    /**
+     * \brief Open a tty raw, applying the current \c ReadProfile to it.
+     *
+     * The tty is left blocking when it is read on io_uring, so that the ring waits for it to be
+     * readable rather than failing the read.
+     *
+     * @param device The path to the tty, e.g. "/dev/ttyUSB0".
+     * @param[out] ec \c asio::error::already_open if the port was already open, or the \c errno of
+     *             the failing system call.
+     */
+    void open(
+            const std::string& device,
+            asio::error_code& ec) noexcept
+    {
+        PosixSerialPort::open(device, ec);
+        if (ec || !uses_io_uring_)
+        {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        int flags = ::fcntl(fd_, F_GETFL);
+        if (flags == -1 || ::fcntl(fd_, F_SETFL, flags & ~O_NONBLOCK) == -1)
+        {
+            ec = errno_error_();
+            ::epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd_, nullptr);
+            ::close(fd_);
+            fd_ = -1;
+            return;
+        }
+        opened_++;
+    }
+
+    /**
+     * \brief Read as many bytes as the tty has buffered, once it has buffered as many as the
+     *        \c ReadProfile asks for.
+     *
+     * The read is posted to the \c asio::io_service, and the handler is called right after it, on
+     * the thread which runs it.
+     *
+     * @param buffers The buffer in which the bytes are stored.
+     * @param handler The completion handler, which is called with the error code and the number of
+     *        read bytes. The error code is \c asio::error::operation_aborted if the port is closed,
+     *        and \c asio::error::eof if the other end of the tty hangs up.
+     */
+    template<class Handler>
+    void async_read_some(
+            const asio::mutable_buffers_1& buffers,
+            Handler handler) noexcept
+    {
+        char* data = static_cast<char*>(buffers.data());
+        std::size_t size = buffers.size();
+        io_service_.post([this, data, size, handler]()
+                {
+                    asio::error_code ec;
+                    std::size_t bytes_transferred = 0;
+#if defined(EASYNMEA_HAVE_IO_URING)
+                    bytes_transferred = uses_io_uring_ ? read_ring_(data, size, ec) : read_some_(data, size, ec);
+#else
+                    bytes_transferred = read_some_(data, size, ec);
+#endif  // defined(EASYNMEA_HAVE_IO_URING)
+                    handler(ec, bytes_transferred);
+                });
+    }
+
+protected:
+
+    //! user_data of the poll of wake_fd_ on the ring
+    static constexpr uint64_t WAKE_USER_DATA = 0;
+
+    //! user_data of the read of the tty on the ring
+    static constexpr uint64_t READ_USER_DATA = 1;
+
+    //! user_data of the VTIME sleeps on the ring
+    static constexpr uint64_t TIMEOUT_USER_DATA = 2;
+
+    //! user_data of the cancellations on the ring
+    static constexpr uint64_t CANCEL_USER_DATA = 3;
+
+    //! Whether the tty is read on ring_
+    bool uses_io_uring_;
+
+    //! Number of times the tty has been opened, so that a read of a closed tty is told apart from
+    //! one of the tty which was opened after it, which may have the same file descriptor
+    uint64_t opened_;
+
+    //! Whether the poll of wake_fd_ is in flight on the ring
+    bool wake_armed_;
+
+    /**
+     * Set the ring up, with room for the poll of wake_fd_, the read of the tty, a sleep, and a
+     * cancellation.
+     *
+     * @param[out] ec The error code of the failing operation
+     * @return true if the ring can be used; false otherwise
+     */
+    bool setup_ring_(
+            asio::error_code& ec) noexcept
+    {
+#if defined(EASYNMEA_HAVE_IO_URING)
+        if (setup_error_)
+        {
+            ec = setup_error_;
+            return false;
+        }
+        return ring_.setup(4, ec);
+#else
+        // Built against kernel headers without io_uring
+        ec = asio::error::operation_not_supported;
+        return false;
+#endif  // defined(EASYNMEA_HAVE_IO_URING)
+    }
+
+#if defined(EASYNMEA_HAVE_IO_URING)
+    //! The ring on which the tty is read
+    IoUring ring_;
+
+    /**
+     * Wait on the ring until the tty is readable as per profile_, and read all the bytes it has
+     * buffered, up to \c size.
+     *
+     * @param[out] data Buffer in which the read bytes are stored
+     * @param size Size of \c data
+     * @param[out] ec The error code of the read
+     * @return The number of read bytes, which is 0 when nothing is read
+     */
+    std::size_t read_ring_(
+            char* data,
+            std::size_t size,
+            asio::error_code& ec) noexcept
+    {
+        ec.clear();
+        while (true)
+        {
+            int fd;
+            uint64_t opened;
+            int window;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (fd_ == -1)
+                {
+                    ec = asio::error::operation_aborted;
+                    return 0;
+                }
+                fd = fd_;
+                opened = opened_;
+                window = backlog_ ? 0 : profile_.vtime * 100;
+            }
+
+            int result;
+            if (!wait_read_(fd, opened, data, size, result, ec))
+            {
+                return 0;
+            }
+            if (result > 0 && window > 0)
+            {
+                // The rest of the burst is buffered by the tty without waking this thread up
+                sleep_(window);
+            }
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (fd_ == -1 || opened_ != opened)
+            {
+                ec = asio::error::operation_aborted;
+                return 0;
+            }
+            if (result > 0)
+            {
+                std::size_t bytes_transferred = static_cast<std::size_t>(result);
+                int buffered = 0;
+                // The tty hands at most 64 bytes per read over when fewer than its VMIN are asked for,
+                // so the bytes it has buffered are read until there are no more
+                while (bytes_transferred < size && (profile_.vmin > 1 || profile_.vtime > 0) &&
+                        ::ioctl(fd_, FIONREAD, &buffered) == 0 && buffered > 0)
+                {
+                    ssize_t bytes = ::read(fd_, data + bytes_transferred, size - bytes_transferred);
+                    if (bytes <= 0)
+                    {
+                        break;
+                    }
+                    bytes_transferred += static_cast<std::size_t>(bytes);
+                }
+                backlog_ = bytes_transferred == size;
+                return bytes_transferred;
+            }
+            if (result == 0 || result == -EIO)
+            {
+                // The other end of the tty hung up
+                ec = asio::error::eof;
+                return 0;
+            }
+            if (result != -EAGAIN && result != -EINTR)
+            {
+                ec = asio::error_code(-result, asio::error::get_system_category());
+                return 0;
+            }
+            backlog_ = false;
+        }
+    }
+
+    /**
+     * Read the tty on the ring, waiting until the read completes or the port is closed. A read of
+     * a port which is closed is cancelled.
+     *
+     * @param fd The file descriptor of the tty
+     * @param opened The value of opened_ when \c fd was taken
+     * @param[out] data Buffer in which the read bytes are stored
+     * @param size Size of \c data
+     * @param[out] result The number of read bytes, 0 if the tty hung up, or the negated \c errno
+     * @param[out] ec \c asio::error::operation_aborted if the port is closed, or the \c errno of
+     *             \c io_uring_enter()
+     * @return true if the read completed; false otherwise
+     */
+    bool wait_read_(
+            int fd,
+            uint64_t opened,
+            char* data,
+            std::size_t size,
+            int& result,
+            asio::error_code& ec) noexcept
+    {
+        arm_wake_();
+        io_uring_sqe* sqe = ring_.get_sqe();
+        sqe->opcode = IORING_OP_READ;
+        sqe->fd = fd;
+        sqe->addr = reinterpret_cast<uint64_t>(data);
+        sqe->len = static_cast<uint32_t>(size);
+        sqe->off = ~uint64_t(0);
+        sqe->user_data = READ_USER_DATA;
+
+        bool read = false;
+        bool cancelled = false;
+        while (!read)
+        {
+            bool woken = false;
+            if (!ring_.submit_and_wait(1, ec))
+            {
+                return false;
+            }
+            ring_.for_each_cqe([&](const io_uring_cqe& cqe)
+                    {
+                        if (cqe.user_data == WAKE_USER_DATA)
+                        {
+                            wake_armed_ = false;
+                            woken = true;
+                        }
+                        else if (cqe.user_data == READ_USER_DATA)
+                        {
+                            read = true;
+                            result = cqe.res;
+                        }
+                    });
+            if (!woken)
+            {
+                continue;
+            }
+
+            uint64_t wake_ups;
+            static_cast<void>(::read(wake_fd_, &wake_ups, sizeof(wake_ups)));
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!read && !cancelled && (fd_ == -1 || opened_ != opened))
+            {
+                // The read of a closed tty is only completed by cancelling it
+                sqe = ring_.get_sqe();
+                sqe->opcode = IORING_OP_ASYNC_CANCEL;
+                sqe->addr = READ_USER_DATA;
+                sqe->user_data = CANCEL_USER_DATA;
+                cancelled = true;
+            }
+            else if (!cancelled)
+            {
+                // Woken up by a close() which the port has been reopened after
+                arm_wake_();
+            }
+        }
+
+        if (cancelled)
+        {
+            ec = asio::error::operation_aborted;
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * Sleep on the ring, until either the time is up or the port is closed.
+     *
+     * @param milliseconds The time to sleep
+     */
+    void sleep_(
+            int milliseconds) noexcept
+    {
+        arm_wake_();
+        __kernel_timespec timeout{milliseconds / 1000, (milliseconds % 1000) * 1000000LL};
+        io_uring_sqe* sqe = ring_.get_sqe();
+        sqe->opcode = IORING_OP_TIMEOUT;
+        sqe->addr = reinterpret_cast<uint64_t>(&timeout);
+        sqe->len = 1;
+        sqe->off = 1;  // The wake-up of wake_fd_ completes it before the time is up
+        sqe->user_data = TIMEOUT_USER_DATA;
+
+        bool done = false;
+        asio::error_code ec;
+        while (!done && ring_.submit_and_wait(1, ec))
+        {
+            ring_.for_each_cqe([&](const io_uring_cqe& cqe)
+                    {
+                        if (cqe.user_data == WAKE_USER_DATA)
+                        {
+                            wake_armed_ = false;
+                            uint64_t wake_ups;
+                            static_cast<void>(::read(wake_fd_, &wake_ups, sizeof(wake_ups)));
+                        }
+                        else if (cqe.user_data == TIMEOUT_USER_DATA)
+                        {
+                            done = true;
+                        }
+                    });
+        }
+    }
+
+    //! Queue a poll of wake_fd_ on the ring, unless it is already in flight
+    void arm_wake_() noexcept
+    {
+        if (wake_armed_)
+        {
+            return;
+        }
+        io_uring_sqe* sqe = ring_.get_sqe();
+        sqe->opcode = IORING_OP_POLL_ADD;
+        sqe->fd = wake_fd_;
+        sqe->poll_events = POLLIN;
+        sqe->user_data = WAKE_USER_DATA;
+        wake_armed_ = true;
+    }
+
+#endif  // defined(EASYNMEA_HAVE_IO_URING)
+
+};
+
+} // namespace eduponz
+} // namespace easynmea
+
+#endif  /* _EASYNMEA_URINGSERIALPORT_HPP_ */
@@ -0,0 +1,312 @@
+// Copyright (c) 2021 Eduardo Ponz Segrelles.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+/**
+ * @file PosixSerialPortBenchmark.cpp
+ *
+ * Measures the latency and the CPU time of receiving NMEA 0183 lines through a pty pair, with
+ * Asio's serial port and with \c PosixSerialPort on each of its \c ReadProfile.
+ *
+ * A writer thread emulates a GNSS module: once per epoch it writes a burst of sentences to the pty
+ * master, paced at the given baud rate, and it timestamps the last byte of each line. The reader
+ * thread receives the lines from the pty slave with \c SerialInterface::read_lines(), and the
+ * latency of each line is the time since its last byte was written. The CPU time and the wake-ups
+ * (voluntary context switches) of the reader thread are taken with \c getrusage().
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <pty.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <asio/serial_port.hpp>
+
+#include <PosixSerialPort.hpp>
+#include <SerialInterface.hpp>
+
+namespace eduponz {
+namespace easynmea {
+namespace benchmark {
+
+using Clock = std::chrono::steady_clock;
+
+//! One epoch of a GNSS module, as in the system tests
+const std::vector<std::string> EPOCH = {
+    "$GNGLL,5703.1740,N,00954.9459,E,072704.000,A,A*4B\r\n",
+    "$GNRMC,072705.000,A,5703.1740,N,00954.9459,E,0.00,90.87,041118,,,A*46\r\n",
+    "$GPVTG,90.87,T,,M,0.00,N,0.00,K,A*0B\r\n",
+    "$GPGGA,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,,*46\r\n",
+    "$GNGSA,A,3,10,18,27,08,11,,,,,,,,2.19,1.97,0.95*10\r\n",
+    "$GNGSA,A,3,68,74,,,,,,,,,,,2.19,1.97,0.95*18\r\n",
+    "$GPGSV,4,1,15,08,73,227,31,10,57,079,18,27,53,156,26,18,49,264,32*75\r\n",
+    "$GPGSV,4,2,15,11,36,278,15,20,32,060,16,01,22,265,,32,20,127,17*74\r\n",
+    "$GPGSV,4,3,15,28,19,326,,14,07,142,,15,06,021,,22,05,216,*7B\r\n",
+    "$GPGSV,4,4,15,21,03,089,,30,02,299,,16,01,187,*47\r\n"};
+
+//! Benchmark parameters
+struct Parameters
+{
+    uint64_t baudrate = 9600;
+    uint32_t epochs_per_second = 1;
+    uint32_t seconds = 10;
+};
+
+//! Results of a run
+struct Results
+{
+    std::vector<double> latencies_us;
+    std::size_t expected_lines = 0;
+    double cpu_ms_per_second = 0;
+    double wake_ups_per_second = 0;
+};
+
+//! Percentile of a sorted vector
+double percentile(
+        const std::vector<double>& sorted,
+        double ratio)
+{
+    if (sorted.empty())
+    {
+        return 0;
+    }
+    return sorted[static_cast<std::size_t>(ratio * (sorted.size() - 1))];
+}
+
+//! Thread CPU time and voluntary context switches
+void thread_usage(
+        double& cpu_ms,
+        long& wake_ups)
+{
+    rusage usage;
+    getrusage(RUSAGE_THREAD, &usage);
+    cpu_ms = (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1e3 +
+            (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e3;
+    wake_ups = usage.ru_nvcsw;
+}
+
+/**
+ * Write the epochs to the pty master, paced at the baud rate, timestamping the end of each line.
+ *
+ * @return The timestamps of the ends of the lines
+ */
+std::vector<Clock::time_point> write_epochs(
+        int master,
+        const Parameters& parameters)
+{
+    std::string epoch;
+    for (const std::string& line : EPOCH)
+    {
+        epoch += line;
+    }
+
+    // 8N1 takes 10 bits per byte
+    const double bytes_per_second = parameters.baudrate / 10.0;
+    const auto epoch_period = std::chrono::microseconds(1000000 / parameters.epochs_per_second);
+    const auto tick = std::chrono::milliseconds(1);
+
+    std::vector<Clock::time_point> line_ends;
+    Clock::time_point start = Clock::now();
+    for (uint32_t i = 0; i < parameters.seconds * parameters.epochs_per_second; i++)
+    {
+        Clock::time_point epoch_start = start + i * epoch_period;
+        std::this_thread::sleep_until(epoch_start);
+        std::size_t written = 0;
+        while (written < epoch.size())
+        {
+            std::this_thread::sleep_until(Clock::now() + tick);
+            double elapsed = std::chrono::duration<double>(Clock::now() - epoch_start).count();
+            std::size_t due = std::min(epoch.size(), static_cast<std::size_t>(elapsed * bytes_per_second) + 1);
+            if (due <= written)
+            {
+                continue;
+            }
+            if (write(master, epoch.data() + written, due - written) != static_cast<ssize_t>(due - written))
+            {
+                std::cout << "Cannot write to the pty master" << std::endl;
+                return line_ends;
+            }
+            Clock::time_point now = Clock::now();
+            for (std::size_t j = written; j < due; j++)
+            {
+                if (epoch[j] == '\n')
+                {
+                    line_ends.push_back(now);
+                }
+            }
+            written = due;
+        }
+    }
+    return line_ends;
+}
+
+/**
+ * Receive the epochs written to a pty pair through a SerialInterface.
+ *
+ * @tparam Interface The SerialInterface
+ * @param args The arguments of the Interface constructor
+ */
+template<class Interface, class ... Args>
+Results run(
+        const Parameters& parameters,
+        Args&&... args)
+{
+    Results results;
+    int master;
+    int slave;
+    char name[128];
+    if (openpty(&master, &slave, name, nullptr, nullptr) == -1)
+    {
+        std::cout << "Cannot open a pty pair" << std::endl;
+        return results;
+    }
+
+    Interface serial_interface(std::forward<Args>(args)...);
+    if (!serial_interface.open(name, parameters.baudrate))
+    {
+        close(master);
+        close(slave);
+        return results;
+    }
+
+    std::vector<Clock::time_point> line_received;
+    line_received.reserve(parameters.seconds * parameters.epochs_per_second * EPOCH.size());
+    double cpu_ms = 0;
+    long wake_ups = 0;
+    std::thread reader([&]()
+            {
+                double cpu_ms_start;
+                long wake_ups_start;
+                thread_usage(cpu_ms_start, wake_ups_start);
+                serial_interface.read_lines([&](const std::string&)
+                {
+                    line_received.push_back(Clock::now());
+                    return true;
+                });
+                thread_usage(cpu_ms, wake_ups);
+                cpu_ms -= cpu_ms_start;
+                wake_ups -= wake_ups_start;
+            });
+
+    std::vector<Clock::time_point> line_ends = write_epochs(master, parameters);
+    // Give the last lines time to arrive, even with the longest VTIME
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+    serial_interface.close();
+    reader.join();
+    close(master);
+    close(slave);
+
+    results.expected_lines = line_ends.size();
+    for (std::size_t i = 0; i < std::min(line_ends.size(), line_received.size()); i++)
+    {
+        results.latencies_us.push_back(std::chrono::duration<double, std::micro>(line_received[i] - line_ends[i]).count());
+    }
+    std::sort(results.latencies_us.begin(), results.latencies_us.end());
+    results.cpu_ms_per_second = cpu_ms / parameters.seconds;
+    results.wake_ups_per_second = static_cast<double>(wake_ups) / parameters.seconds;
+    return results;
+}
+
+//! SerialInterface on a PosixSerialPort with a given ReadProfile
+class ProfiledSerialInterface : public SerialInterface<PosixSerialPort>
+{
+public:
+
+    ProfiledSerialInterface(
+            const ReadProfile& profile)
+    {
+        // The profile is kept by the port until it is opened
+        asio::error_code ec;
+        serial_->set_option(profile, ec);
+    }
+
+};
+
+//! Print a row of the results table
+void print_row(
+        const std::string& backend,
+        const Results& results)
+{
+    std::string lines = std::to_string(results.latencies_us.size()) + "/" + std::to_string(results.expected_lines);
+    std::cout << std::left << std::setw(32) << backend << std::right << std::setw(12) << lines
+              << std::fixed << std::setprecision(1)
+              << std::setw(12) << percentile(results.latencies_us, 0.5)
+              << std::setw(12) << percentile(results.latencies_us, 0.99)
+              << std::setw(12) << percentile(results.latencies_us, 1.0)
+              << std::setw(12) << std::setprecision(2) << results.cpu_ms_per_second
+              << std::setw(12) << std::setprecision(1) << results.wake_ups_per_second << std::endl;
+}
+
+} // namespace benchmark
+} // namespace easynmea
+} // namespace eduponz
+
+int main(
+        int argc,
+        char** argv)
+{
+    using namespace eduponz::easynmea;
+    using namespace eduponz::easynmea::benchmark;
+
+    Parameters parameters;
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        if (!strcmp(argv[i], "-b") || !strcmp(argv[i], "--baudrate"))
+        {
+            parameters.baudrate = std::strtoull(argv[i + 1], nullptr, 10);
+        }
+        else if (!strcmp(argv[i], "-r") || !strcmp(argv[i], "--rate"))
+        {
+            parameters.epochs_per_second = static_cast<uint32_t>(std::strtoul(argv[i + 1], nullptr, 10));
+        }
+        else if (!strcmp(argv[i], "-s") || !strcmp(argv[i], "--seconds"))
+        {
+            parameters.seconds = static_cast<uint32_t>(std::strtoul(argv[i + 1], nullptr, 10));
+        }
+    }
+    if (parameters.epochs_per_second == 0 || parameters.seconds == 0)
+    {
+        std::cout << "Usage: " << argv[0] << " [-b bauds] [-r epochs_per_second] [-s seconds]" << std::endl;
+        return 1;
+    }
+
+    std::cout << "Baud rate: " << parameters.baudrate << ", epochs per second: " << parameters.epochs_per_second
+              << ", seconds: " << parameters.seconds << std::endl;
+    std::cout << std::left << std::setw(32) << "Backend" << std::right << std::setw(12) << "Lines"
+              << std::setw(12) << "p50 [us]" << std::setw(12) << "p99 [us]" << std::setw(12) << "max [us]"
+              << std::setw(12) << "CPU [ms/s]" << std::setw(12) << "Wake-ups/s" << std::endl;
+
+    print_row("asio::serial_port", run<SerialInterface<asio::serial_port>>(parameters));
+    print_row("PosixSerialPort lowest_latency",
+            run<ProfiledSerialInterface>(parameters, ReadProfile::lowest_latency()));
+    print_row("PosixSerialPort lowest_cpu", run<ProfiledSerialInterface>(parameters, ReadProfile::lowest_cpu()));
+    return 0;
+}
@@ -0,0 +1,600 @@
+// Copyright (c) 2021 Eduardo Ponz Segrelles.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+/**
+ * @file UringReaderBenchmark.cpp
+ *
+ * Compares \c UringReader, on io_uring and on its poll() fallback, with a \c SerialInterface per
+ * source, each on a thread of its own, as an application reading many sources with the Asio path
+ * does.
+ *
+ * Two scenarios are run:
+ *    1. Gateway: a writer thread emulates many GNSS modules, writing an epoch of sentences to the
+ *       master of each of the pty pairs at the given rate, and timestamping each line. The
+ *       latency of a line is the time since it was written until it is handed over.
+ *    2. Replay: a log of sentences is read from a regular file, once per source, as fast as
+ *       possible. The \c SerialInterface reads the file through \c FilePort.
+ *
+ * The CPU time and the wake-ups (voluntary context switches) of all the reading threads are taken
+ * with \c getrusage().
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <pty.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <asio/buffer.hpp>
+#include <asio/error.hpp>
+#include <asio/error_code.hpp>
+#include <asio/io_service.hpp>
+#include <asio/serial_port.hpp>
+#include <asio/serial_port_base.hpp>
+
+#include <SerialInterface.hpp>
+#include <UringReader.hpp>
+
+namespace eduponz {
+namespace easynmea {
+namespace benchmark {
+
+using Clock = std::chrono::steady_clock;
+
+//! One epoch of a GNSS module, as in the system tests
+const std::vector<std::string> EPOCH = {
+    "$GNGLL,5703.1740,N,00954.9459,E,072704.000,A,A*4B\r\n",
+    "$GNRMC,072705.000,A,5703.1740,N,00954.9459,E,0.00,90.87,041118,,,A*46\r\n",
+    "$GPVTG,90.87,T,,M,0.00,N,0.00,K,A*0B\r\n",
+    "$GPGGA,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,,*46\r\n",
+    "$GNGSA,A,3,10,18,27,08,11,,,,,,,,2.19,1.97,0.95*10\r\n",
+    "$GNGSA,A,3,68,74,,,,,,,,,,,2.19,1.97,0.95*18\r\n",
+    "$GPGSV,4,1,15,08,73,227,31,10,57,079,18,27,53,156,26,18,49,264,32*75\r\n",
+    "$GPGSV,4,2,15,11,36,278,15,20,32,060,16,01,22,265,,32,20,127,17*74\r\n",
+    "$GPGSV,4,3,15,28,19,326,,14,07,142,,15,06,021,,22,05,216,*7B\r\n",
+    "$GPGSV,4,4,15,21,03,089,,30,02,299,,16,01,187,*47\r\n"};
+
+//! Benchmark parameters
+struct Parameters
+{
+    std::size_t sources = 16;
+    uint32_t epochs_per_second = 10;
+    uint32_t seconds = 5;
+    uint32_t megabytes = 16;
+};
+
+//! Results of a run
+struct Results
+{
+    std::vector<double> latencies_us;
+    std::size_t expected_lines = 0;
+    std::size_t lines = 0;
+    double seconds = 0;
+    double cpu_ms = 0;
+    long wake_ups = 0;
+};
+
+//! Percentile of a sorted vector
+double percentile(
+        const std::vector<double>& sorted,
+        double ratio)
+{
+    if (sorted.empty())
+    {
+        return 0;
+    }
+    return sorted[static_cast<std::size_t>(ratio * (sorted.size() - 1))];
+}
+
+//! Thread CPU time and voluntary context switches
+void thread_usage(
+        double& cpu_ms,
+        long& wake_ups)
+{
+    rusage usage;
+    getrusage(RUSAGE_THREAD, &usage);
+    cpu_ms = (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1e3 +
+            (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e3;
+    wake_ups = usage.ru_nvcsw;
+}
+
+/**
+ * Run a function on a thread, adding the CPU time and the wake-ups of the thread to the results.
+ * The results are only updated by the caller after joining the thread.
+ */
+template<class Function>
+std::thread measured_thread(
+        double& cpu_ms,
+        long& wake_ups,
+        Function function)
+{
+    return std::thread([&cpu_ms, &wake_ups, function]()
+                   {
+                       double cpu_ms_start;
+                       long wake_ups_start;
+                       thread_usage(cpu_ms_start, wake_ups_start);
+                       function();
+                       thread_usage(cpu_ms, wake_ups);
+                       cpu_ms -= cpu_ms_start;
+                       wake_ups -= wake_ups_start;
+                   });
+}
+
+/**
+ * A port which reads a regular file, so that it can be replayed through a \c SerialInterface.
+ * As a file is always readable, the reads are done on the thread which runs the I/O service.
+ */
+class FilePort
+{
+public:
+
+    FilePort(
+            asio::io_service& io_service)
+        : io_service_(io_service)
+        , fd_(-1)
+    {
+    }
+
+    ~FilePort()
+    {
+        asio::error_code ec;
+        close(ec);
+    }
+
+    void open(
+            const std::string& path,
+            asio::error_code& ec)
+    {
+        fd_ = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        ec = fd_ == -1 ? asio::error_code(errno, asio::error::get_system_category()) : asio::error_code();
+    }
+
+    bool is_open() const
+    {
+        return fd_ != -1;
+    }
+
+    void set_option(
+            const asio::serial_port_base::baud_rate&,
+            asio::error_code& ec)
+    {
+        ec = asio::error_code();
+    }
+
+    void close(
+            asio::error_code& ec)
+    {
+        if (fd_ != -1)
+        {
+            ::close(fd_);
+            fd_ = -1;
+        }
+        ec = asio::error_code();
+    }
+
+    template<class Handler>
+    void async_read_some(
+            const asio::mutable_buffers_1& buffer,
+            Handler handler)
+    {
+        void* data = asio::buffer_cast<void*>(buffer);
+        std::size_t size = asio::buffer_size(buffer);
+        io_service_.post([this, data, size, handler]()
+                {
+                    ssize_t bytes = ::read(fd_, data, size);
+                    if (bytes > 0)
+                    {
+                        handler(asio::error_code(), static_cast<std::size_t>(bytes));
+                    }
+                    else if (bytes == 0)
+                    {
+                        // The end of the log stands for the port being closed
+                        handler(asio::error::operation_aborted, 0);
+                    }
+                    else
+                    {
+                        handler(asio::error_code(errno, asio::error::get_system_category()), 0);
+                    }
+                });
+    }
+
+private:
+
+    asio::io_service& io_service_;
+    int fd_;
+};
+
+//! pty pairs, each standing for a GNSS module
+class PtyPairs
+{
+public:
+
+    PtyPairs(
+            std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; i++)
+        {
+            int master;
+            int slave;
+            char name[128];
+            if (openpty(&master, &slave, name, nullptr, nullptr) == -1)
+            {
+                std::cout << "Cannot open a pty pair" << std::endl;
+                break;
+            }
+            masters_.push_back(master);
+            slaves_.push_back(slave);
+            names_.push_back(name);
+        }
+    }
+
+    ~PtyPairs()
+    {
+        for (std::size_t i = 0; i < masters_.size(); i++)
+        {
+            close(masters_[i]);
+            close(slaves_[i]);
+        }
+    }
+
+    const std::vector<std::string>& names() const
+    {
+        return names_;
+    }
+
+    /**
+     * Write the epochs to the masters, timestamping each line.
+     *
+     * @return The timestamps of the lines written to each master
+     */
+    std::vector<std::vector<Clock::time_point>> write_epochs(
+            const Parameters& parameters)
+    {
+        std::vector<std::vector<Clock::time_point>> line_ends(masters_.size());
+        const auto epoch_period = std::chrono::microseconds(1000000 / parameters.epochs_per_second);
+        Clock::time_point start = Clock::now();
+        for (uint32_t epoch = 0; epoch < parameters.seconds * parameters.epochs_per_second; epoch++)
+        {
+            std::this_thread::sleep_until(start + epoch * epoch_period);
+            for (const std::string& line : EPOCH)
+            {
+                for (std::size_t i = 0; i < masters_.size(); i++)
+                {
+                    if (write(masters_[i], line.data(), line.size()) != static_cast<ssize_t>(line.size()))
+                    {
+                        std::cout << "Cannot write to the pty master" << std::endl;
+                        return line_ends;
+                    }
+                    line_ends[i].push_back(Clock::now());
+                }
+            }
+        }
+        return line_ends;
+    }
+
+private:
+
+    std::vector<int> masters_;
+    std::vector<int> slaves_;
+    std::vector<std::string> names_;
+};
+
+//! Compute the latencies of the lines received from each source
+void latencies(
+        const std::vector<std::vector<Clock::time_point>>& line_ends,
+        const std::vector<std::vector<Clock::time_point>>& line_received,
+        Results& results)
+{
+    for (std::size_t i = 0; i < line_ends.size(); i++)
+    {
+        results.expected_lines += line_ends[i].size();
+        results.lines += line_received[i].size();
+        for (std::size_t j = 0; j < std::min(line_ends[i].size(), line_received[i].size()); j++)
+        {
+            results.latencies_us.push_back(
+                std::chrono::duration<double, std::micro>(line_received[i][j] - line_ends[i][j]).count());
+        }
+    }
+    std::sort(results.latencies_us.begin(), results.latencies_us.end());
+}
+
+//! Receive the epochs written to the pty pairs with a UringReader
+Results gateway(
+        const Parameters& parameters,
+        UringReader::Backend backend)
+{
+    Results results;
+    PtyPairs ptys(parameters.sources);
+    UringReader reader(parameters.sources, backend);
+    std::vector<std::size_t> pty_of_source(parameters.sources);
+    for (std::size_t i = 0; i < ptys.names().size(); i++)
+    {
+        std::size_t source;
+        if (!reader.open(ptys.names()[i], 115200, source))
+        {
+            return results;
+        }
+        pty_of_source[source] = i;
+    }
+
+    std::vector<std::vector<Clock::time_point>> line_received(ptys.names().size());
+    std::thread thread = measured_thread(results.cpu_ms, results.wake_ups, [&]()
+                    {
+                        reader.read_lines([&](
+                            std::size_t source,
+                            const std::string&)
+                        {
+                            line_received[pty_of_source[source]].push_back(Clock::now());
+                            return true;
+                        });
+                    });
+
+    std::vector<std::vector<Clock::time_point>> line_ends = ptys.write_epochs(parameters);
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    reader.close();
+    thread.join();
+    latencies(line_ends, line_received, results);
+    return results;
+}
+
+//! Receive the epochs written to the pty pairs with a SerialInterface per pty
+Results gateway(
+        const Parameters& parameters)
+{
+    Results results;
+    PtyPairs ptys(parameters.sources);
+    std::vector<std::unique_ptr<SerialInterface<asio::serial_port>>> interfaces;
+    for (const std::string& name : ptys.names())
+    {
+        interfaces.emplace_back(new SerialInterface<asio::serial_port>());
+        if (!interfaces.back()->open(name, 115200))
+        {
+            return results;
+        }
+    }
+
+    std::vector<std::vector<Clock::time_point>> line_received(interfaces.size());
+    std::vector<double> cpu_ms(interfaces.size());
+    std::vector<long> wake_ups(interfaces.size());
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < interfaces.size(); i++)
+    {
+        threads.push_back(measured_thread(cpu_ms[i], wake_ups[i], [&, i]()
+                {
+                    interfaces[i]->read_lines([&, i](const std::string&)
+                    {
+                        line_received[i].push_back(Clock::now());
+                        return true;
+                    });
+                }));
+    }
+
+    std::vector<std::vector<Clock::time_point>> line_ends = ptys.write_epochs(parameters);
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    for (std::size_t i = 0; i < interfaces.size(); i++)
+    {
+        interfaces[i]->close();
+        threads[i].join();
+        results.cpu_ms += cpu_ms[i];
+        results.wake_ups += wake_ups[i];
+    }
+    latencies(line_ends, line_received, results);
+    return results;
+}
+
+//! Replay the log once per source with a UringReader
+Results replay(
+        const Parameters& parameters,
+        const std::string& path,
+        UringReader::Backend backend)
+{
+    Results results;
+    UringReader reader(parameters.sources, backend);
+    Clock::time_point start = Clock::now();
+    for (std::size_t i = 0; i < parameters.sources; i++)
+    {
+        std::size_t source;
+        if (!reader.open_file(path, source))
+        {
+            return results;
+        }
+    }
+
+    std::thread thread = measured_thread(results.cpu_ms, results.wake_ups, [&]()
+                    {
+                        reader.read_lines([&](
+                            std::size_t,
+                            const std::string&)
+                        {
+                            results.lines++;
+                            return true;
+                        });
+                    });
+    thread.join();
+    results.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    return results;
+}
+
+//! Replay the log once per source with a SerialInterface per source
+Results replay(
+        const Parameters& parameters,
+        const std::string& path)
+{
+    Results results;
+    Clock::time_point start = Clock::now();
+    std::vector<std::unique_ptr<SerialInterface<FilePort>>> interfaces;
+    for (std::size_t i = 0; i < parameters.sources; i++)
+    {
+        interfaces.emplace_back(new SerialInterface<FilePort>());
+        if (!interfaces.back()->open(path, 115200))
+        {
+            return results;
+        }
+    }
+
+    std::vector<std::size_t> lines(interfaces.size());
+    std::vector<double> cpu_ms(interfaces.size());
+    std::vector<long> wake_ups(interfaces.size());
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < interfaces.size(); i++)
+    {
+        threads.push_back(measured_thread(cpu_ms[i], wake_ups[i], [&, i]()
+                {
+                    // The port reads as closed once the file ends
+                    interfaces[i]->read_lines([&, i](const std::string&)
+                    {
+                        lines[i]++;
+                        return true;
+                    });
+                }));
+    }
+    for (std::size_t i = 0; i < interfaces.size(); i++)
+    {
+        threads[i].join();
+        results.lines += lines[i];
+        results.cpu_ms += cpu_ms[i];
+        results.wake_ups += wake_ups[i];
+    }
+    results.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    return results;
+}
+
+//! Print a row of the gateway results table
+void print_gateway_row(
+        const std::string& backend,
+        const Parameters& parameters,
+        const Results& results)
+{
+    std::string lines = std::to_string(results.lines) + "/" + std::to_string(results.expected_lines);
+    std::cout << std::left << std::setw(36) << backend << std::right << std::setw(16) << lines
+              << std::fixed << std::setprecision(1)
+              << std::setw(12) << percentile(results.latencies_us, 0.5)
+              << std::setw(12) << percentile(results.latencies_us, 0.99)
+              << std::setw(12) << std::setprecision(2) << results.cpu_ms / parameters.seconds
+              << std::setw(12) << std::setprecision(1) << results.wake_ups / static_cast<double>(parameters.seconds)
+              << std::endl;
+}
+
+//! Print a row of the replay results table
+void print_replay_row(
+        const std::string& backend,
+        std::size_t bytes,
+        const Results& results)
+{
+    std::cout << std::left << std::setw(36) << backend << std::right << std::setw(16) << results.lines
+              << std::fixed << std::setprecision(1)
+              << std::setw(12) << bytes / 1e6 / results.seconds
+              << std::setw(12) << results.cpu_ms
+              << std::setw(12) << results.wake_ups << std::endl;
+}
+
+} // namespace benchmark
+} // namespace easynmea
+} // namespace eduponz
+
+int main(
+        int argc,
+        char** argv)
+{
+    using namespace eduponz::easynmea;
+    using namespace eduponz::easynmea::benchmark;
+
+    Parameters parameters;
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        if (!strcmp(argv[i], "-n") || !strcmp(argv[i], "--sources"))
+        {
+            parameters.sources = std::strtoul(argv[i + 1], nullptr, 10);
+        }
+        else if (!strcmp(argv[i], "-r") || !strcmp(argv[i], "--rate"))
+        {
+            parameters.epochs_per_second = static_cast<uint32_t>(std::strtoul(argv[i + 1], nullptr, 10));
+        }
+        else if (!strcmp(argv[i], "-s") || !strcmp(argv[i], "--seconds"))
+        {
+            parameters.seconds = static_cast<uint32_t>(std::strtoul(argv[i + 1], nullptr, 10));
+        }
+        else if (!strcmp(argv[i], "-m") || !strcmp(argv[i], "--megabytes"))
+        {
+            parameters.megabytes = static_cast<uint32_t>(std::strtoul(argv[i + 1], nullptr, 10));
+        }
+    }
+    if (parameters.sources == 0 || parameters.epochs_per_second == 0 || parameters.seconds == 0 ||
+            parameters.megabytes == 0)
+    {
+        std::cout << "Usage: " << argv[0] << " [-n sources] [-r epochs_per_second] [-s seconds] [-m megabytes]"
+                  << std::endl;
+        return 1;
+    }
+
+    std::string io_uring = "UringReader io_uring";
+    if (UringReader(1).backend() != UringReader::Backend::IO_URING)
+    {
+        io_uring += " (unavailable)";
+    }
+
+    std::cout << "Gateway. Sources: " << parameters.sources << ", epochs per second: "
+              << parameters.epochs_per_second << ", seconds: " << parameters.seconds << std::endl;
+    std::cout << std::left << std::setw(36) << "Backend" << std::right << std::setw(16) << "Lines"
+              << std::setw(12) << "p50 [us]" << std::setw(12) << "p99 [us]"
+              << std::setw(12) << "CPU [ms/s]" << std::setw(12) << "Wake-ups/s" << std::endl;
+    print_gateway_row("SerialInterface per source", parameters, gateway(parameters));
+    print_gateway_row(io_uring, parameters, gateway(parameters, UringReader::Backend::IO_URING));
+    print_gateway_row("UringReader poll", parameters, gateway(parameters, UringReader::Backend::POLL));
+
+    // The log is written first, so that it is replayed from the page cache
+    const std::string path = "uring_reader_benchmark.log";
+    std::size_t bytes = 0;
+    {
+        std::ofstream log(path, std::ios::binary);
+        while (bytes < parameters.megabytes * 1000000ul)
+        {
+            for (const std::string& line : EPOCH)
+            {
+                log << line;
+                bytes += line.size();
+            }
+        }
+    }
+    bytes *= parameters.sources;
+
+    std::cout << std::endl << "Replay. Sources: " << parameters.sources << ", megabytes per source: "
+              << parameters.megabytes << std::endl;
+    std::cout << std::left << std::setw(36) << "Backend" << std::right << std::setw(16) << "Lines"
+              << std::setw(12) << "MB/s" << std::setw(12) << "CPU [ms]" << std::setw(12) << "Wake-ups" << std::endl;
+    print_replay_row("SerialInterface per source", bytes, replay(parameters, path));
+    print_replay_row(io_uring, bytes, replay(parameters, path, UringReader::Backend::IO_URING));
+    print_replay_row("UringReader poll", bytes, replay(parameters, path, UringReader::Backend::POLL));
+    std::remove(path.c_str());
+    return 0;
+}
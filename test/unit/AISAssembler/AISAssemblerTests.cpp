@@ -0,0 +1,226 @@
+// Copyright (c) 2021 Eduardo Ponz Segrelles.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <easynmea/data.hpp>
+#include <easynmea/types.hpp>
+#include <AISAssembler.hpp>
+#include <AISPayload.hpp>
+#include <EasyNmeaCoder.hpp>
+
+using namespace eduponz::easynmea;
+
+/**
+ * Decode a VDM or VDO sentence into the fragment it carries.
+ */
+AISFragment fragment(
+        const std::string& sentence)
+{
+    DecodeResult result = EasyNmeaCoder::decode(sentence);
+    const AISFragment* vdm = result.get<AISFragment>();
+    EXPECT_NE(vdm, nullptr) << sentence;
+    return vdm != nullptr ? *vdm : AISFragment();
+}
+
+//! A static and voyage related data message (type 5) in two fragments
+const std::vector<std::string> voyage_message = {
+    "!AIVDM,2,1,3,B,55P5TL01VIaAL@7WKO@mBplU@<PDhh000000001S;AJ::4A80?4i@E53,0*3E",
+    "!AIVDM,2,2,3,B,1@0000000000000,2*55"};
+
+//! A position report (type 1) split in two fragments
+const std::vector<std::string> position_message = {
+    "!AIVDM,2,1,7,A,15RTgt0PAso;90,0*0C",
+    "!AIVDM,2,2,7,A,TKcjM8h6g208CQ,0*63"};
+
+TEST(AISAssemblerTests, assembleSingleFragment)
+{
+    AISAssembler assembler;
+    const AISMessage* message = assembler.add(fragment("!AIVDO,1,1,,,B5NJ;PP005l4ot5Isbl03wsUkP06,0*35"));
+    ASSERT_NE(message, nullptr);
+    ASSERT_EQ(message->talker, NMEA0183Talker::AI);
+    ASSERT_EQ(message->channel, '\0');
+    ASSERT_TRUE(message->own_ship);
+    ASSERT_EQ(message->sextet_count, 28u);
+    ASSERT_EQ(message->bit_count(), 168u);
+    ASSERT_EQ(message->sextets[0], 18u);
+
+    /* Other talkers and channels */
+    message = assembler.add(fragment("!BSVDM,1,1,,2,13u?etPv2;0n:dDPwUM1U1Cb069D,0*4E"));
+    ASSERT_NE(message, nullptr);
+    ASSERT_EQ(message->talker, NMEA0183Talker::BS);
+    ASSERT_EQ(message->channel, '2');
+    ASSERT_FALSE(message->own_ship);
+    ASSERT_EQ(message->sextets[0], 1u);
+}
+
+TEST(AISAssemblerTests, assembleMessage)
+{
+    AISAssembler assembler;
+    ASSERT_EQ(assembler.add(fragment(voyage_message[0])), nullptr);
+    const AISMessage* message = assembler.add(fragment(voyage_message[1]));
+    ASSERT_NE(message, nullptr);
+    ASSERT_EQ(message->channel, 'B');
+    ASSERT_EQ(message->sextet_count, 71u);
+    ASSERT_EQ(message->fill_bits, 2u);
+    ASSERT_EQ(message->bit_count(), 424u);
+
+    /* The payload keeps the order of the fragments */
+    const std::string payload = "55P5TL01VIaAL@7WKO@mBplU@<PDhh000000001S;AJ::4A80?4i@E531@0000000000000";
+    for (std::size_t i = 0; i < payload.size(); i++)
+    {
+        ASSERT_EQ(message->sextets[i], AISPayload::sextet(payload[i])) << i;
+    }
+}
+
+TEST(AISAssemblerTests, assembleInterleavedMessages)
+{
+    /* Each sequential message identifier has its own message in progress */
+    AISAssembler assembler;
+    ASSERT_EQ(assembler.add(fragment(voyage_message[0])), nullptr);
+    ASSERT_EQ(assembler.add(fragment(position_message[0])), nullptr);
+    // A single fragment message does not interrupt the rest
+    ASSERT_NE(assembler.add(fragment("!AIVDM,1,1,,A,15RTgt0PAso;90TKcjM8h6g208CQ,0*4A")), nullptr);
+    const AISMessage* message = assembler.add(fragment(voyage_message[1]));
+    ASSERT_NE(message, nullptr);
+    ASSERT_EQ(message->sextet_count, 71u);
+    message = assembler.add(fragment(position_message[1]));
+    ASSERT_NE(message, nullptr);
+    ASSERT_EQ(message->channel, 'A');
+    ASSERT_EQ(message->sextet_count, 28u);
+}
+
+TEST(AISAssemblerTests, assembleWithoutSequenceId)
+{
+    AISAssembler assembler;
+    ASSERT_EQ(assembler.add(fragment("!AIVDM,2,1,,A,15RTgt0PAso;90,0*3B")), nullptr);
+    const AISMessage* message = assembler.add(fragment("!AIVDM,2,2,,A,TKcjM8h6g208CQ,0*54"));
+    ASSERT_NE(message, nullptr);
+    ASSERT_EQ(message->sextet_count, 28u);
+}
+
+TEST(AISAssemblerTests, discardMissingFragment)
+{
+    /* A message whose first fragment is missing is never handed out */
+    AISAssembler assembler;
+    ASSERT_EQ(assembler.add(fragment(voyage_message[1])), nullptr);
+
+    /* Nor is a message whose middle fragment is missing */
+    AISFragment first = fragment(voyage_message[0]);
+    first.fragment_count = 3;
+    ASSERT_EQ(assembler.add(first), nullptr);
+    AISFragment last = fragment(voyage_message[1]);
+    last.fragment_count = 3;
+    last.fragment_number = 3;
+    ASSERT_EQ(assembler.add(last), nullptr);
+}
+
+TEST(AISAssemblerTests, discardRestartedMessage)
+{
+    /* A new message with the same identifier discards the one in progress */
+    AISAssembler assembler;
+    ASSERT_EQ(assembler.add(fragment(voyage_message[0])), nullptr);
+    AISFragment first = fragment(position_message[0]);
+    first.sequence_id = 3;
+    ASSERT_EQ(assembler.add(first), nullptr);
+    AISFragment last = fragment(position_message[1]);
+    last.sequence_id = 3;
+    const AISMessage* message = assembler.add(last);
+    ASSERT_NE(message, nullptr);
+    ASSERT_EQ(message->sextet_count, 28u);
+    ASSERT_EQ(message->sextets[0], 1u);
+}
+
+TEST(AISAssemblerTests, discardInconsistentFragment)
+{
+    AISAssembler assembler;
+
+    /* The number of fragments changes within the message */
+    ASSERT_EQ(assembler.add(fragment(voyage_message[0])), nullptr);
+    AISFragment vdm = fragment(voyage_message[1]);
+    vdm.fragment_count = 3;
+    ASSERT_EQ(assembler.add(vdm), nullptr);
+
+    /* The talker changes within the message */
+    ASSERT_EQ(assembler.add(fragment(voyage_message[0])), nullptr);
+    vdm = fragment(voyage_message[1]);
+    vdm.talker = NMEA0183Talker::AB;
+    ASSERT_EQ(assembler.add(vdm), nullptr);
+
+    /* A VDO fragment completes a VDM message */
+    ASSERT_EQ(assembler.add(fragment(voyage_message[0])), nullptr);
+    vdm = fragment(voyage_message[1]);
+    vdm.own_ship = true;
+    ASSERT_EQ(assembler.add(vdm), nullptr);
+
+    /* The payload exceeds the longest message */
+    vdm = fragment(voyage_message[0]);
+    vdm.fragment_count = 3;
+    vdm.sextet_count = AISFragment::MAX_SEXTETS;
+    for (uint8_t number = 1; number <= vdm.fragment_count; number++)
+    {
+        vdm.fragment_number = number;
+        ASSERT_EQ(assembler.add(vdm), nullptr);
+    }
+}
+
+TEST(AISAssemblerTests, discardInvalidFragment)
+{
+    AISAssembler assembler;
+    AISFragment vdm = fragment(voyage_message[0]);
+
+    /* Fragment number out of the message */
+    vdm.fragment_number = 0;
+    ASSERT_EQ(assembler.add(vdm), nullptr);
+    vdm.fragment_number = 3;
+    ASSERT_EQ(assembler.add(vdm), nullptr);
+
+    /* Sequential message identifier out of range */
+    vdm = fragment(voyage_message[0]);
+    vdm.sequence_id = 10;
+    ASSERT_EQ(assembler.add(vdm), nullptr);
+
+    /* More six-bit values than fit in a fragment */
+    vdm = fragment("!AIVDM,1,1,,A,15RTgt0PAso;90TKcjM8h6g208CQ,0*4A");
+    vdm.sextet_count = AISFragment::MAX_SEXTETS + 1;
+    ASSERT_EQ(assembler.add(vdm), nullptr);
+}
+
+TEST(AISAssemblerTests, clear)
+{
+    /* Clearing the assembler discards the messages in progress */
+    AISAssembler assembler;
+    ASSERT_EQ(assembler.add(fragment(voyage_message[0])), nullptr);
+    ASSERT_EQ(assembler.add(fragment(position_message[0])), nullptr);
+    assembler.clear();
+    ASSERT_EQ(assembler.add(fragment(voyage_message[1])), nullptr);
+    ASSERT_EQ(assembler.add(fragment(position_message[1])), nullptr);
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,171 @@
+// Copyright (c) 2021 Eduardo Ponz Segrelles.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <easynmea/data.hpp>
+#include <easynmea/types.hpp>
+#include <AISAssembler.hpp>
+#include <AISPayload.hpp>
+
+using namespace eduponz::easynmea;
+
+/**
+ * Build a message of a single fragment from its armored payload.
+ */
+AISMessage message(
+        const std::string& payload,
+        uint8_t fill_bits = 0)
+{
+    AISMessage ais;
+    for (char character : payload)
+    {
+        EXPECT_NE(AISPayload::sextet(character), AISPayload::INVALID_SEXTET) << character;
+        ais.sextets[ais.sextet_count++] = AISPayload::sextet(character);
+    }
+    ais.fill_bits = fill_bits;
+    return ais;
+}
+
+TEST(AISPayloadTests, armorAlphabet)
+{
+    /* Every six-bit value is armored into a character which is unarmored into the same value */
+    const std::string alphabet = "0123456789:;<=>?@ABCDEFGHIJKLMNOPQRSTUVW`abcdefghijklmnopqrstuvw";
+    for (uint8_t value = 0; value < 64; value++)
+    {
+        ASSERT_EQ(AISPayload::character(value), alphabet[value]) << int(value);
+        ASSERT_EQ(AISPayload::sextet(alphabet[value]), value) << alphabet[value];
+    }
+
+    /* The rest of the characters are not armored */
+    for (int character = 0; character < 256; character++)
+    {
+        if (alphabet.find(static_cast<char>(character)) == std::string::npos)
+        {
+            ASSERT_EQ(AISPayload::sextet(static_cast<char>(character)), AISPayload::INVALID_SEXTET) << character;
+        }
+    }
+}
+
+TEST(AISPayloadTests, decodeClassAPosition)
+{
+    AISMessage ais = message("15RTgt0PAso;90TKcjM8h6g208CQ");
+    ais.channel = 'A';
+    AISPositionData position;
+    ASSERT_TRUE(AISPayload::decode_position(ais, position));
+    ASSERT_EQ(position.kind, NMEA0183DataKind::AIS);
+    ASSERT_EQ(position.talker, NMEA0183Talker::AI);
+    ASSERT_EQ(position.message_type, 1u);
+    ASSERT_EQ(position.repeat_indicator, 0u);
+    ASSERT_EQ(position.mmsi, 371798000u);
+    ASSERT_EQ(position.navigation_status, 0u);
+    ASSERT_EQ(position.rate_of_turn, -127);
+    ASSERT_FLOAT_EQ(position.speed_over_ground, 12.3f);
+    ASSERT_TRUE(position.position_accuracy);
+    ASSERT_FLOAT_EQ(position.longitude, -123.395383f);
+    ASSERT_FLOAT_EQ(position.latitude, 48.381633f);
+    ASSERT_EQ(position.longitude_e7, -1233953833);
+    ASSERT_EQ(position.latitude_e7, 483816333);
+    ASSERT_FLOAT_EQ(position.course_over_ground, 224.0f);
+    ASSERT_EQ(position.true_heading, 215u);
+    ASSERT_EQ(position.utc_second, 33u);
+    ASSERT_FALSE(position.raim);
+    ASSERT_EQ(position.channel, 'A');
+    ASSERT_FALSE(position.own_ship);
+}
+
+TEST(AISPayloadTests, decodeClassBPosition)
+{
+    AISMessage ais = message("B5NJ;PP005l4ot5Isbl03wsUkP06");
+    ais.own_ship = true;
+    AISPositionData position;
+    ASSERT_TRUE(AISPayload::decode_position(ais, position));
+    ASSERT_EQ(position.message_type, 18u);
+    ASSERT_EQ(position.mmsi, 367430530u);
+
+    /* Class B stations do not report navigation status nor rate of turn */
+    ASSERT_EQ(position.navigation_status, 15u);
+    ASSERT_EQ(position.rate_of_turn, -128);
+    ASSERT_FLOAT_EQ(position.speed_over_ground, 0.0f);
+    ASSERT_FALSE(position.position_accuracy);
+    ASSERT_FLOAT_EQ(position.longitude, -122.26732f);
+    ASSERT_FLOAT_EQ(position.latitude, 37.785035f);
+    ASSERT_EQ(position.longitude_e7, -1222673200);
+    ASSERT_EQ(position.latitude_e7, 377850350);
+    ASSERT_FLOAT_EQ(position.course_over_ground, 0.0f);
+    ASSERT_EQ(position.true_heading, 511u);
+    ASSERT_EQ(position.utc_second, 55u);
+    ASSERT_TRUE(position.own_ship);
+}
+
+TEST(AISPayloadTests, decodeNotAvailable)
+{
+    /* A class A report (type 3) with every field not available, and RAIM in use */
+    AISPositionData position;
+    ASSERT_TRUE(AISPayload::decode_position(message("3C`l7@?P?w<tSF0l4Q@>4?wp2000"), position));
+    ASSERT_EQ(position.message_type, 3u);
+    ASSERT_EQ(position.repeat_indicator, 1u);
+    ASSERT_EQ(position.mmsi, 244123456u);
+
+    /* Values not available are the same as the default ones */
+    AISPositionData expected;
+    expected.message_type = 3;
+    expected.repeat_indicator = 1;
+    expected.mmsi = 244123456;
+    expected.raim = true;
+    ASSERT_EQ(position, expected);
+}
+
+TEST(AISPayloadTests, decodeOtherMessageTypes)
+{
+    /* A static and voyage related data message (type 5) is not a position report */
+    AISPositionData position;
+    position.mmsi = 1;
+    ASSERT_FALSE(AISPayload::decode_position(
+                message("55P5TL01VIaAL@7WKO@mBplU@<PDhh000000001S;AJ::4A80?4i@E531@0000000000000", 2), position));
+    ASSERT_EQ(position.mmsi, 1u);
+
+    /* Nor is an empty message */
+    ASSERT_FALSE(AISPayload::decode_position(AISMessage(), position));
+    ASSERT_EQ(position.mmsi, 1u);
+}
+
+TEST(AISPayloadTests, decodeShortMessage)
+{
+    /* Position reports are 168 bits long */
+    AISPositionData position;
+    ASSERT_FALSE(AISPayload::decode_position(message("15RTgt0PAso;90TKcjM8h6g208C"), position));
+    ASSERT_FALSE(AISPayload::decode_position(message("15RTgt0PAso;90TKcjM8h6g208CQ", 2), position));
+    ASSERT_EQ(position.mmsi, 0u);
+
+    /* Longer messages are decoded from their first 168 bits */
+    ASSERT_TRUE(AISPayload::decode_position(message("15RTgt0PAso;90TKcjM8h6g208CQ00", 4), position));
+    ASSERT_EQ(position.mmsi, 371798000u);
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,218 @@
+// Copyright (c) 2021 Eduardo Ponz Segrelles.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <cctype>
+#include <cstring>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <Checksum.hpp>
+
+using namespace eduponz::easynmea;
+
+class ChecksumTest : public Checksum
+{
+public:
+
+    using Checksum::XorKernel;
+
+    /**
+     * Get all the XOR-reduce kernels available on this platform, including the scalar one.
+     *
+     * @return A vector with the available kernels.
+     */
+    static std::vector<XorKernel> kernels()
+    {
+        std::vector<XorKernel> available = {xor_scalar_};
+        if (xor_sse2_)
+        {
+            available.push_back(xor_sse2_);
+        }
+        if (xor_avx2_ && cpu_supports_avx2_())
+        {
+            available.push_back(xor_avx2_);
+        }
+        if (xor_neon_)
+        {
+            available.push_back(xor_neon_);
+        }
+        return available;
+    }
+
+};
+
+/**
+ * Checksum validation as implemented with string streams before the vectorized kernels were
+ * introduced. It is used as reference to check that the results are bit-identical.
+ */
+bool baseline_validate_checksum(
+        const std::string& sentence)
+{
+    std::string sentence_no_check;
+    std::string checksum_str;
+    std::stringstream sentence_ss(sentence);
+    std::getline(sentence_ss, sentence_no_check, '*');
+    std::getline(sentence_ss, checksum_str, '*');
+    sentence_no_check = sentence_no_check.substr(1);
+
+    int checksum = 0;
+    std::stringstream checksum_ss;
+    checksum_ss << std::hex << checksum_str;
+    checksum_ss >> checksum;
+
+    int check = 0;
+    for (char character : sentence_no_check)
+    {
+        check ^= character;
+    }
+    return check == checksum;
+}
+
+TEST(ChecksumTests, computeAllKernels)
+{
+    std::mt19937 generator(2021);
+    std::vector<char> buffer(300);
+    for (char& c : buffer)
+    {
+        c = static_cast<char>(generator());
+    }
+
+    for (ChecksumTest::XorKernel kernel : ChecksumTest::kernels())
+    {
+        // Unaligned starts and all sizes up to several vector registers
+        for (std::size_t offset = 0; offset < 4; offset++)
+        {
+            for (std::size_t size = 0; size + offset <= buffer.size(); size++)
+            {
+                uint8_t expected = 0;
+                for (std::size_t i = 0; i < size; i++)
+                {
+                    expected ^= static_cast<uint8_t>(buffer[offset + i]);
+                }
+                ASSERT_EQ(kernel(buffer.data() + offset, size), expected) << "size " << size;
+            }
+        }
+    }
+    ASSERT_EQ(Checksum::compute(buffer.data(), 0), 0);
+}
+
+TEST(ChecksumTests, parseHexAllCharacters)
+{
+    for (int high = 0; high < 256; high++)
+    {
+        for (int low = 0; low < 256; low++)
+        {
+            int expected = -1;
+            if (std::isxdigit(high) && std::isxdigit(low))
+            {
+                expected = std::stoi(std::string{static_cast<char>(high), static_cast<char>(low)}, nullptr, 16);
+            }
+            ASSERT_EQ(Checksum::parse_hex(static_cast<char>(high), static_cast<char>(low)), expected);
+        }
+    }
+}
+
+TEST(ChecksumTests, validateMatchesBaseline)
+{
+    std::mt19937 generator(2021);
+    const char* hex_digits = "0123456789abcdefABCDEF";
+    std::size_t valid_sentences = 0;
+
+    for (int i = 0; i < 20000; i++)
+    {
+        /* Random bytes, including non printable characters and characters with the highest bit set */
+        std::string sentence = "$";
+        std::size_t size = 1 + generator() % 120;
+        bool ascii = generator() % 2;
+        for (std::size_t j = 0; j < size; j++)
+        {
+            char c = static_cast<char>(ascii ? 0x20 + generator() % 0x5F : generator());
+            sentence += (c == '*') ? ',' : c;
+        }
+
+        /* Either the right checksum or a random one */
+        uint8_t check = Checksum::compute(sentence.data() + 1, sentence.size() - 1);
+        char checksum[4];
+        if (generator() % 2)
+        {
+            std::snprintf(checksum, sizeof(checksum), (generator() % 2) ? "*%02X" : "*%02x", check);
+        }
+        else
+        {
+            checksum[0] = '*';
+            checksum[1] = hex_digits[generator() % 22];
+            checksum[2] = hex_digits[generator() % 22];
+            checksum[3] = '\0';
+        }
+        sentence += checksum;
+
+        bool expected = baseline_validate_checksum(sentence);
+        valid_sentences += expected ? 1 : 0;
+        ASSERT_EQ(Checksum::validate(sentence), expected) << sentence;
+    }
+    // Make sure that both outcomes have been exercised
+    ASSERT_GT(valid_sentences, 1000u);
+    ASSERT_LT(valid_sentences, 19000u);
+}
+
+TEST(ChecksumTests, validateLines)
+{
+    std::string buffer =
+            "$GPGGA,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,2.2,7854,*4a\r\n"
+            "$GPGGA,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,2.2,7854,*22\r\n"
+            "$GNRMC,072705.000,A,5703.1740,N,00954.9459,E,0.00,90.87,041118,,,A*46\n"
+            "\n"
+            "GNRMC,072705.000,A,5703.1740,N,00954.9459,E,0.00,90.87,041118,,,A*46\n"
+            "$GPTXT,01,01,02,ANTSTATUS=OPEN*2B\n"
+            "$GPTXT,01,01,02,ANTSTATUS=OPEN*2G\n"
+            "$GPTXT,01,01*02,ANTSTATUS=OPEN*2B\n"
+            "*\n"
+            "!AIVDM,1,1,,B,177KQJ5000G?tO`K>RA1wUbN0TKH,0*5C";
+    std::vector<bool> expected = {true, false, true, false, false, true, false, false, false, true};
+
+    bool valid[16];
+    ASSERT_EQ(Checksum::validate_lines(buffer, valid, 16), expected.size());
+    for (std::size_t i = 0; i < expected.size(); i++)
+    {
+        ASSERT_EQ(valid[i], expected[i]) << "line " << i;
+    }
+
+    /* The output capacity is honoured */
+    ASSERT_EQ(Checksum::validate_lines(buffer, valid, 3), 3u);
+    ASSERT_EQ(Checksum::validate_lines("", valid, 16), 0u);
+}
+
+TEST(ChecksumTests, implementationName)
+{
+    std::string name = Checksum::implementation();
+    ASSERT_TRUE(name == "avx2" || name == "sse2" || name == "neon" || name == "scalar") << name;
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
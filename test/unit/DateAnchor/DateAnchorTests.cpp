@@ -0,0 +1,174 @@
+// Copyright (c) 2021 Eduardo Ponz Segrelles.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <chrono>
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+#include <easynmea/data.hpp>
+#include <DateAnchor.hpp>
+
+using namespace eduponz::easynmea;
+
+//! Start of 2002-07-04 in milliseconds since 1970-01-01
+constexpr int64_t DAY = 1025740800000;
+
+//! Milliseconds in an hour
+constexpr int32_t HOUR = 3600000;
+
+/**
+ * Build a time point from milliseconds since 1970-01-01.
+ */
+UtcTime utc(
+        int64_t milliseconds)
+{
+    return UtcTime(std::chrono::milliseconds(milliseconds));
+}
+
+TEST(DateAnchorTests, stampWithoutAnchor)
+{
+    DateAnchor anchor;
+    ASSERT_FALSE(anchor.anchored());
+
+    /* Samples without a date cannot be dated before the first anchor */
+    UtcTime time = UtcTime::min();
+    ASSERT_FALSE(anchor.stamp(12 * HOUR, time));
+    ASSERT_EQ(time, UtcTime::min());
+    ASSERT_FALSE(anchor.anchored());
+
+    /* Samples with a date become the anchor, and they are not modified */
+    time = utc(DAY + 20 * HOUR);
+    ASSERT_TRUE(anchor.stamp(20 * HOUR, time));
+    ASSERT_EQ(time, utc(DAY + 20 * HOUR));
+    ASSERT_TRUE(anchor.anchored());
+}
+
+TEST(DateAnchorTests, stampSameDay)
+{
+    DateAnchor anchor;
+    UtcTime time = utc(DAY + 10 * HOUR);
+    ASSERT_TRUE(anchor.stamp(10 * HOUR, time));
+
+    /* Samples within 12 hours of the anchor in the same day get the date of the anchor */
+    for (int32_t time_of_day_ms : {10 * HOUR, 10 * HOUR + 1, 12 * HOUR, 21 * HOUR, 22 * HOUR - 1})
+    {
+        time = UtcTime::min();
+        ASSERT_TRUE(anchor.stamp(time_of_day_ms, time));
+        ASSERT_EQ(time, utc(DAY + time_of_day_ms)) << time_of_day_ms;
+    }
+}
+
+TEST(DateAnchorTests, stampMidnightRollover)
+{
+    DateAnchor anchor;
+    UtcTime time = utc(DAY + 23 * HOUR + 59 * 60000 + 59000);
+    ASSERT_TRUE(anchor.stamp(23 * HOUR + 59 * 60000 + 59000, time));
+
+    /* A sample right after midnight is dated with the following day */
+    time = UtcTime::min();
+    ASSERT_TRUE(anchor.stamp(0, time));
+    ASSERT_EQ(time, utc(DAY + 24 * HOUR));
+
+    /* The dated sample becomes the anchor, so the date is kept for the rest of the day */
+    for (int32_t time_of_day_ms : {6 * HOUR, 12 * HOUR, 18 * HOUR, 23 * HOUR})
+    {
+        time = UtcTime::min();
+        ASSERT_TRUE(anchor.stamp(time_of_day_ms, time));
+        ASSERT_EQ(time, utc(DAY + 24 * HOUR + time_of_day_ms)) << time_of_day_ms;
+    }
+
+    /* And the next midnight rolls over again */
+    time = UtcTime::min();
+    ASSERT_TRUE(anchor.stamp(HOUR, time));
+    ASSERT_EQ(time, utc(DAY + 48 * HOUR + HOUR));
+}
+
+TEST(DateAnchorTests, stampLateSample)
+{
+    DateAnchor anchor;
+    UtcTime time = utc(DAY + 500);
+    ASSERT_TRUE(anchor.stamp(500, time));
+
+    /* A sample from right before midnight is dated with the day before the anchor */
+    time = UtcTime::min();
+    ASSERT_TRUE(anchor.stamp(24 * HOUR - 500, time));
+    ASSERT_EQ(time, utc(DAY - 500));
+
+    /* A leap second is dated as the first second of the following day */
+    time = UtcTime::min();
+    ASSERT_TRUE(anchor.stamp(24 * HOUR + 250, time));
+    ASSERT_EQ(time, utc(DAY + 250));
+}
+
+TEST(DateAnchorTests, stampInvalidTime)
+{
+    DateAnchor anchor;
+    UtcTime time = utc(DAY);
+    ASSERT_TRUE(anchor.stamp(0, time));
+
+    /* Samples without a valid time of day are not dated */
+    time = UtcTime::min();
+    ASSERT_FALSE(anchor.stamp(-1, time));
+    ASSERT_EQ(time, UtcTime::min());
+    ASSERT_TRUE(anchor.anchored());
+}
+
+TEST(DateAnchorTests, reanchor)
+{
+    DateAnchor anchor;
+    UtcTime time = utc(DAY + 12 * HOUR);
+    ASSERT_TRUE(anchor.stamp(12 * HOUR, time));
+
+    /* A sample with a date replaces the anchor, even if it is far from it */
+    time = utc(DAY + 10 * 24 * HOUR + 12 * HOUR);
+    ASSERT_TRUE(anchor.stamp(12 * HOUR, time));
+    time = UtcTime::min();
+    ASSERT_TRUE(anchor.stamp(13 * HOUR, time));
+    ASSERT_EQ(time, utc(DAY + 10 * 24 * HOUR + 13 * HOUR));
+
+    /* Anchors before 1970 are supported */
+    time = utc(-24 * static_cast<int64_t>(HOUR) + 23 * HOUR);
+    ASSERT_TRUE(anchor.stamp(23 * HOUR, time));
+    time = UtcTime::min();
+    ASSERT_TRUE(anchor.stamp(HOUR, time));
+    ASSERT_EQ(time, utc(HOUR));
+}
+
+TEST(DateAnchorTests, clear)
+{
+    DateAnchor anchor;
+    UtcTime time = utc(DAY);
+    ASSERT_TRUE(anchor.stamp(0, time));
+
+    anchor.clear();
+    ASSERT_FALSE(anchor.anchored());
+    time = UtcTime::min();
+    ASSERT_FALSE(anchor.stamp(HOUR, time));
+    ASSERT_EQ(time, UtcTime::min());
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -52,6 +52,82 @@ public:
         (GPGGAData& gpgga),
         (noexcept, override));
 
+    MOCK_METHOD(ReturnCode,
+        take_next,
+        (RMCData& rmc),
+        (noexcept, override));
+
+    MOCK_METHOD(ReturnCode,
+        take_next,
+        (GSVData& gsv),
+        (noexcept, override));
+
+    MOCK_METHOD(ReturnCode,
+        take_next,
+        (GSAData& gsa),
+        (noexcept, override));
+
+    MOCK_METHOD(ReturnCode,
+        take_next,
+        (AISPositionData& ais),
+        (noexcept, override));
+
+    MOCK_METHOD(ReturnCode,
+        take_next,
+        (ZDAData& zda),
+        (noexcept, override));
+
+    MOCK_METHOD(ReturnCode,
+        take_next,
+        (HDTData& hdt),
+        (noexcept, override));
+
+    MOCK_METHOD(ReturnCode,
+        take_next,
+        (THSData& ths),
+        (noexcept, override));
+
+    MOCK_METHOD(ReturnCode,
+        take_next,
+        (ROTData& rot),
+        (noexcept, override));
+
+    MOCK_METHOD(ReturnCode,
+        take_next,
+        (GSTData& gst),
+        (noexcept, override));
+
+    MOCK_METHOD(ReturnCode,
+        read_latest,
+        (HDTData& hdt),
+        (noexcept, override));
+
+    MOCK_METHOD(ReturnCode,
+        read_latest,
+        (THSData& ths),
+        (noexcept, override));
+
+    MOCK_METHOD(ReturnCode,
+        read_latest,
+        (ROTData& rot),
+        (noexcept, override));
+
+    MOCK_METHOD(ReturnCode,
+        register_decoder,
+        (const std::string& address,
+         EasyNmea::SentenceHandler handler),
+        (noexcept, override));
+
+    MOCK_METHOD(ReturnCode,
+        stamp_realtime,
+        (bool enable),
+        (noexcept, override));
+
+    MOCK_METHOD(ReturnCode,
+        set_read_profile,
+        (const ReadProfile& profile),
+        (noexcept, override));
+
     MOCK_METHOD(ReturnCode,
         wait_for_data,
         (NMEA0183DataKindMask data_mask,
@@ -215,6 +215,557 @@ TEST(EasyNmeaTests, take_nextNoData)
     ASSERT_EQ(gpgga.altitude, 0);
 }
 
+TEST(EasyNmeaTests, take_nextRMCOk)
+{
+    EasyNmeaTest easynmea;
+    std::unique_ptr<EasyNmeaImplMock> impl = std::make_unique<EasyNmeaImplMock>();
+    RMCData rmc;
+    RMCData rmc_ret;
+    rmc_ret.timestamp = 123;
+    rmc_ret.status = 'A';
+    rmc_ret.latitude = 123;
+    rmc_ret.longitude = 123;
+    rmc_ret.speed = 123;
+    rmc_ret.course = 123;
+    rmc_ret.date = 10123;
+    rmc_ret.mode = 'A';
+
+    ASSERT_NE(rmc.speed, rmc_ret.speed);
+
+    EXPECT_CALL(*impl, take_next(rmc))
+            .WillOnce(DoAll(SetArgReferee<0>(rmc_ret), Return(ReturnCode::RETURN_CODE_OK)));
+
+    easynmea.set_impl(std::move(impl));
+
+    ASSERT_EQ(easynmea.take_next(rmc), ReturnCode::RETURN_CODE_OK);
+
+    ASSERT_EQ(rmc, rmc_ret);
+}
+
+TEST(EasyNmeaTests, take_nextRMCNoData)
+{
+    EasyNmeaTest easynmea;
+    std::unique_ptr<EasyNmeaImplMock> impl = std::make_unique<EasyNmeaImplMock>();
+    RMCData rmc;
+
+    EXPECT_CALL(*impl, take_next(rmc))
+            .WillOnce(Return(ReturnCode::RETURN_CODE_NO_DATA));
+
+    easynmea.set_impl(std::move(impl));
+
+    ASSERT_EQ(easynmea.take_next(rmc), ReturnCode::RETURN_CODE_NO_DATA);
+
+    ASSERT_EQ(rmc, RMCData());
+}
+
+TEST(EasyNmeaTests, take_nextGSVOk)
+{
+    EasyNmeaTest easynmea;
+    std::unique_ptr<EasyNmeaImplMock> impl = std::make_unique<EasyNmeaImplMock>();
+    GSVData gsv;
+    GSVData gsv_ret;
+    gsv_ret.talker = NMEA0183Talker::GL;
+    gsv_ret.satellites_in_view = 9;
+    gsv_ret.satellite_count = 1;
+    gsv_ret.satellites[0].prn = 65;
+    gsv_ret.satellites[0].elevation = 15;
+    gsv_ret.satellites[0].azimuth = 270;
+    gsv_ret.satellites[0].snr = 42;
+
+    ASSERT_NE(gsv, gsv_ret);
+
+    EXPECT_CALL(*impl, take_next(gsv))
+            .WillOnce(DoAll(SetArgReferee<0>(gsv_ret), Return(ReturnCode::RETURN_CODE_OK)));
+
+    easynmea.set_impl(std::move(impl));
+
+    ASSERT_EQ(easynmea.take_next(gsv), ReturnCode::RETURN_CODE_OK);
+
+    ASSERT_EQ(gsv, gsv_ret);
+}
+
+TEST(EasyNmeaTests, take_nextGSVNoData)
+{
+    EasyNmeaTest easynmea;
+    std::unique_ptr<EasyNmeaImplMock> impl = std::make_unique<EasyNmeaImplMock>();
+    GSVData gsv;
+
+    EXPECT_CALL(*impl, take_next(gsv))
+            .WillOnce(Return(ReturnCode::RETURN_CODE_NO_DATA));
+
+    easynmea.set_impl(std::move(impl));
+
+    ASSERT_EQ(easynmea.take_next(gsv), ReturnCode::RETURN_CODE_NO_DATA);
+
+    ASSERT_EQ(gsv, GSVData());
+}
+
+TEST(EasyNmeaTests, take_nextGSAOk)
+{
+    EasyNmeaTest easynmea;
+    std::unique_ptr<EasyNmeaImplMock> impl = std::make_unique<EasyNmeaImplMock>();
+    GSAData gsa;
+    GSAData gsa_ret;
+    gsa_ret.talker = NMEA0183Talker::GN;
+    gsa_ret.fix_type = 3;
+    gsa_ret.pdop = 2.19f;
+    gsa_ret.hdop = 1.97f;
+    gsa_ret.vdop = 0.95f;
+    gsa_ret.system_count = 1;
+    gsa_ret.systems[0].prn_count = 1;
+    gsa_ret.systems[0].prns[0] = 10;
+
+    ASSERT_NE(gsa, gsa_ret);
+
+    EXPECT_CALL(*impl, take_next(gsa))
+            .WillOnce(DoAll(SetArgReferee<0>(gsa_ret), Return(ReturnCode::RETURN_CODE_OK)));
+
+    easynmea.set_impl(std::move(impl));
+
+    ASSERT_EQ(easynmea.take_next(gsa), ReturnCode::RETURN_CODE_OK);
+
+    ASSERT_EQ(gsa, gsa_ret);
+}
+
+TEST(EasyNmeaTests, take_nextGSANoData)
+{
+    EasyNmeaTest easynmea;
+    std::unique_ptr<EasyNmeaImplMock> impl = std::make_unique<EasyNmeaImplMock>();
+    GSAData gsa;
+
+    EXPECT_CALL(*impl, take_next(gsa))
+            .WillOnce(Return(ReturnCode::RETURN_CODE_NO_DATA));
+
+    easynmea.set_impl(std::move(impl));
+
+    ASSERT_EQ(easynmea.take_next(gsa), ReturnCode::RETURN_CODE_NO_DATA);
+
+    ASSERT_EQ(gsa, GSAData());
+}
+
+TEST(EasyNmeaTests, take_nextAISOk)
+{
+    EasyNmeaTest easynmea;
+    std::unique_ptr<EasyNmeaImplMock> impl = std::make_unique<EasyNmeaImplMock>();
+    AISPositionData ais;
+    AISPositionData ais_ret;
+    ais_ret.message_type = 1;
+    ais_ret.mmsi = 371798000;
+    ais_ret.speed_over_ground = 12.3f;
+    ais_ret.latitude = 48.381633f;
+    ais_ret.longitude = -123.395383f;
+    ais_ret.channel = 'A';
+
+    ASSERT_NE(ais, ais_ret);
+
+    EXPECT_CALL(*impl, take_next(ais))
+            .WillOnce(DoAll(SetArgReferee<0>(ais_ret), Return(ReturnCode::RETURN_CODE_OK)));
+
+    easynmea.set_impl(std::move(impl));
+
+    ASSERT_EQ(easynmea.take_next(ais), ReturnCode::RETURN_CODE_OK);
+
+    ASSERT_EQ(ais, ais_ret);
+}
+
+TEST(EasyNmeaTests, take_nextAISNoData)
+{
+    EasyNmeaTest easynmea;
+    std::unique_ptr<EasyNmeaImplMock> impl = std::make_unique<EasyNmeaImplMock>();
+    AISPositionData ais;
+
+    EXPECT_CALL(*impl, take_next(ais))
+            .WillOnce(Return(ReturnCode::RETURN_CODE_NO_DATA));
+
+    easynmea.set_impl(std::move(impl));
+
+    ASSERT_EQ(easynmea.take_next(ais), ReturnCode::RETURN_CODE_NO_DATA);
+
+    ASSERT_EQ(ais, AISPositionData());
+}
+
+TEST(EasyNmeaTests, take_nextZDAOk)
+{
+    EasyNmeaTest easynmea;
+    std::unique_ptr<EasyNmeaImplMock> impl = std::make_unique<EasyNmeaImplMock>();
+    ZDAData zda;
+    ZDAData zda_ret;
+    zda_ret.time_of_day_ms = 72930000;
+    zda_ret.day = 4;
+    zda_ret.month = 7;
+    zda_ret.year = 2002;
+    zda_ret.utc_time = UtcTime(std::chrono::milliseconds(1025813730000));
+
+    ASSERT_NE(zda, zda_ret);
+
+    EXPECT_CALL(*impl, take_next(zda))
+            .WillOnce(DoAll(SetArgReferee<0>(zda_ret), Return(ReturnCode::RETURN_CODE_OK)));
+
+    easynmea.set_impl(std::move(impl));
+
+    ASSERT_EQ(easynmea.take_next(zda), ReturnCode::RETURN_CODE_OK);
+
+    ASSERT_EQ(zda, zda_ret);
+}
+
+TEST(EasyNmeaTests, take_nextZDANoData)
+{
+    EasyNmeaTest easynmea;
+    std::unique_ptr<EasyNmeaImplMock> impl = std::make_unique<EasyNmeaImplMock>();
+    ZDAData zda;
+
+    EXPECT_CALL(*impl, take_next(zda))
+            .WillOnce(Return(ReturnCode::RETURN_CODE_NO_DATA));
+
+    easynmea.set_impl(std::move(impl));
+
+    ASSERT_EQ(easynmea.take_next(zda), ReturnCode::RETURN_CODE_NO_DATA);
+
+    ASSERT_EQ(zda, ZDAData());
+}
+
+TEST(EasyNmeaTests, take_nextHDTOk)
+{
+    EasyNmeaTest easynmea;
+    std::unique_ptr<EasyNmeaImplMock> impl = std::make_unique<EasyNmeaImplMock>();
+    HDTData hdt;
+    HDTData hdt_ret;
+    hdt_ret.heading = 274.07f;
+
+    ASSERT_NE(hdt, hdt_ret);
+
+    EXPECT_CALL(*impl, take_next(hdt))
+            .WillOnce(DoAll(SetArgReferee<0>(hdt_ret), Return(ReturnCode::RETURN_CODE_OK)));
+
+    easynmea.set_impl(std::move(impl));
+
+    ASSERT_EQ(easynmea.take_next(hdt), ReturnCode::RETURN_CODE_OK);
+
+    ASSERT_EQ(hdt, hdt_ret);
+}
+
+TEST(EasyNmeaTests, take_nextHDTNoData)
+{
+    EasyNmeaTest easynmea;
+    std::unique_ptr<EasyNmeaImplMock> impl = std::make_unique<EasyNmeaImplMock>();
+    HDTData hdt;
+
+    EXPECT_CALL(*impl, take_next(hdt))
+            .WillOnce(Return(ReturnCode::RETURN_CODE_NO_DATA));
+
+    easynmea.set_impl(std::move(impl));
+
+    ASSERT_EQ(easynmea.take_next(hdt), ReturnCode::RETURN_CODE_NO_DATA);
+
+    ASSERT_EQ(hdt, HDTData());
+}
+
+TEST(EasyNmeaTests, take_nextTHSOk)
+{
+    EasyNmeaTest easynmea;
+    std::unique_ptr<EasyNmeaImplMock> impl = std::make_unique<EasyNmeaImplMock>();
+    THSData ths;
+    THSData ths_ret;
+    ths_ret.heading = 274.07f;
+    ths_ret.mode = 'A';
+
+    ASSERT_NE(ths, ths_ret);
+
+    EXPECT_CALL(*impl, take_next(ths))
+            .WillOnce(DoAll(SetArgReferee<0>(ths_ret), Return(ReturnCode::RETURN_CODE_OK)));
+
+    easynmea.set_impl(std::move(impl));
+
+    ASSERT_EQ(easynmea.take_next(ths), ReturnCode::RETURN_CODE_OK);
+
+    ASSERT_EQ(ths, ths_ret);
+}
+
+TEST(EasyNmeaTests, take_nextTHSNoData)
+{
+    EasyNmeaTest easynmea;
+    std::unique_ptr<EasyNmeaImplMock> impl = std::make_unique<EasyNmeaImplMock>();
+    THSData ths;
+
+    EXPECT_CALL(*impl, take_next(ths))
+            .WillOnce(Return(ReturnCode::RETURN_CODE_NO_DATA));
+
+    easynmea.set_impl(std::move(impl));
+
+    ASSERT_EQ(easynmea.take_next(ths), ReturnCode::RETURN_CODE_NO_DATA);
+
+    ASSERT_EQ(ths, THSData());
+}
+
+TEST(EasyNmeaTests, take_nextROTOk)
+{
+    EasyNmeaTest easynmea;
+    std::unique_ptr<EasyNmeaImplMock> impl = std::make_unique<EasyNmeaImplMock>();
+    ROTData rot;
+    ROTData rot_ret;
+    rot_ret.rate_of_turn = -12.5f;
+    rot_ret.status = 'A';
+
+    ASSERT_NE(rot, rot_ret);
+
+    EXPECT_CALL(*impl, take_next(rot))
+            .WillOnce(DoAll(SetArgReferee<0>(rot_ret), Return(ReturnCode::RETURN_CODE_OK)));
+
+    easynmea.set_impl(std::move(impl));
+
+    ASSERT_EQ(easynmea.take_next(rot), ReturnCode::RETURN_CODE_OK);
+
+    ASSERT_EQ(rot, rot_ret);
+}
+
+TEST(EasyNmeaTests, take_nextROTNoData)
+{
+    EasyNmeaTest easynmea;
+    std::unique_ptr<EasyNmeaImplMock> impl = std::make_unique<EasyNmeaImplMock>();
+    ROTData rot;
+
+    EXPECT_CALL(*impl, take_next(rot))
+            .WillOnce(Return(ReturnCode::RETURN_CODE_NO_DATA));
+
+    easynmea.set_impl(std::move(impl));
+
+    ASSERT_EQ(easynmea.take_next(rot), ReturnCode::RETURN_CODE_NO_DATA);
+
+    ASSERT_EQ(rot, ROTData());
+}
+
+TEST(EasyNmeaTests, take_nextGSTOk)
+{
+    EasyNmeaTest easynmea;
+    std::unique_ptr<EasyNmeaImplMock> impl = std::make_unique<EasyNmeaImplMock>();
+    GSTData gst;
+    GSTData gst_ret;
+    gst_ret.time_of_day_ms = 62894000;
+    gst_ret.rms = 0.006f;
+    gst_ret.latitude_error = 0.023f;
+    gst_ret.longitude_error = 0.020f;
+    gst_ret.altitude_error = 0.031f;
+
+    ASSERT_NE(gst, gst_ret);
+
+    EXPECT_CALL(*impl, take_next(gst))
+            .WillOnce(DoAll(SetArgReferee<0>(gst_ret), Return(ReturnCode::RETURN_CODE_OK)));
+
+    easynmea.set_impl(std::move(impl));
+
+    ASSERT_EQ(easynmea.take_next(gst), ReturnCode::RETURN_CODE_OK);
+
+    ASSERT_EQ(gst, gst_ret);
+}
+
+TEST(EasyNmeaTests, take_nextGSTNoData)
+{
+    EasyNmeaTest easynmea;
+    std::unique_ptr<EasyNmeaImplMock> impl = std::make_unique<EasyNmeaImplMock>();
+    GSTData gst;
+
+    EXPECT_CALL(*impl, take_next(gst))
+            .WillOnce(Return(ReturnCode::RETURN_CODE_NO_DATA));
+
+    easynmea.set_impl(std::move(impl));
+
+    ASSERT_EQ(easynmea.take_next(gst), ReturnCode::RETURN_CODE_NO_DATA);
+
+    ASSERT_EQ(gst, GSTData());
+}
+
+TEST(EasyNmeaTests, read_latestHDTOk)
+{
+    EasyNmeaTest easynmea;
+    std::unique_ptr<EasyNmeaImplMock> impl = std::make_unique<EasyNmeaImplMock>();
+    HDTData hdt;
+    HDTData hdt_ret;
+    hdt_ret.heading = 274.07f;
+
+    ASSERT_NE(hdt, hdt_ret);
+
+    EXPECT_CALL(*impl, read_latest(hdt))
+            .WillOnce(DoAll(SetArgReferee<0>(hdt_ret), Return(ReturnCode::RETURN_CODE_OK)));
+
+    easynmea.set_impl(std::move(impl));
+
+    ASSERT_EQ(easynmea.read_latest(hdt), ReturnCode::RETURN_CODE_OK);
+
+    ASSERT_EQ(hdt, hdt_ret);
+}
+
+TEST(EasyNmeaTests, read_latestHDTNoData)
+{
+    EasyNmeaTest easynmea;
+    std::unique_ptr<EasyNmeaImplMock> impl = std::make_unique<EasyNmeaImplMock>();
+    HDTData hdt;
+
+    EXPECT_CALL(*impl, read_latest(hdt))
+            .WillOnce(Return(ReturnCode::RETURN_CODE_NO_DATA));
+
+    easynmea.set_impl(std::move(impl));
+
+    ASSERT_EQ(easynmea.read_latest(hdt), ReturnCode::RETURN_CODE_NO_DATA);
+
+    ASSERT_EQ(hdt, HDTData());
+}
+
+TEST(EasyNmeaTests, read_latestTHSOk)
+{
+    EasyNmeaTest easynmea;
+    std::unique_ptr<EasyNmeaImplMock> impl = std::make_unique<EasyNmeaImplMock>();
+    THSData ths;
+    THSData ths_ret;
+    ths_ret.heading = 274.07f;
+    ths_ret.mode = 'A';
+
+    ASSERT_NE(ths, ths_ret);
+
+    EXPECT_CALL(*impl, read_latest(ths))
+            .WillOnce(DoAll(SetArgReferee<0>(ths_ret), Return(ReturnCode::RETURN_CODE_OK)));
+
+    easynmea.set_impl(std::move(impl));
+
+    ASSERT_EQ(easynmea.read_latest(ths), ReturnCode::RETURN_CODE_OK);
+
+    ASSERT_EQ(ths, ths_ret);
+}
+
+TEST(EasyNmeaTests, read_latestTHSNoData)
+{
+    EasyNmeaTest easynmea;
+    std::unique_ptr<EasyNmeaImplMock> impl = std::make_unique<EasyNmeaImplMock>();
+    THSData ths;
+
+    EXPECT_CALL(*impl, read_latest(ths))
+            .WillOnce(Return(ReturnCode::RETURN_CODE_NO_DATA));
+
+    easynmea.set_impl(std::move(impl));
+
+    ASSERT_EQ(easynmea.read_latest(ths), ReturnCode::RETURN_CODE_NO_DATA);
+
+    ASSERT_EQ(ths, THSData());
+}
+
+TEST(EasyNmeaTests, read_latestROTOk)
+{
+    EasyNmeaTest easynmea;
+    std::unique_ptr<EasyNmeaImplMock> impl = std::make_unique<EasyNmeaImplMock>();
+    ROTData rot;
+    ROTData rot_ret;
+    rot_ret.rate_of_turn = -12.5f;
+    rot_ret.status = 'A';
+
+    ASSERT_NE(rot, rot_ret);
+
+    EXPECT_CALL(*impl, read_latest(rot))
+            .WillOnce(DoAll(SetArgReferee<0>(rot_ret), Return(ReturnCode::RETURN_CODE_OK)));
+
+    easynmea.set_impl(std::move(impl));
+
+    ASSERT_EQ(easynmea.read_latest(rot), ReturnCode::RETURN_CODE_OK);
+
+    ASSERT_EQ(rot, rot_ret);
+}
+
+TEST(EasyNmeaTests, read_latestROTNoData)
+{
+    EasyNmeaTest easynmea;
+    std::unique_ptr<EasyNmeaImplMock> impl = std::make_unique<EasyNmeaImplMock>();
+    ROTData rot;
+
+    EXPECT_CALL(*impl, read_latest(rot))
+            .WillOnce(Return(ReturnCode::RETURN_CODE_NO_DATA));
+
+    easynmea.set_impl(std::move(impl));
+
+    ASSERT_EQ(easynmea.read_latest(rot), ReturnCode::RETURN_CODE_NO_DATA);
+
+    ASSERT_EQ(rot, ROTData());
+}
+
+TEST(EasyNmeaTests, register_decoderOk)
+{
+    EasyNmeaTest easynmea;
+    std::unique_ptr<EasyNmeaImplMock> impl = std::make_unique<EasyNmeaImplMock>();
+
+    EXPECT_CALL(*impl, register_decoder(std::string("PGRME"), _))
+            .WillOnce(Return(ReturnCode::RETURN_CODE_OK));
+
+    easynmea.set_impl(std::move(impl));
+
+    ASSERT_EQ(easynmea.register_decoder("PGRME", [](const RawSentence&)
+            {
+            }), ReturnCode::RETURN_CODE_OK);
+}
+
+TEST(EasyNmeaTests, register_decoderIllegal)
+{
+    EasyNmeaTest easynmea;
+    std::unique_ptr<EasyNmeaImplMock> impl = std::make_unique<EasyNmeaImplMock>();
+
+    EXPECT_CALL(*impl, register_decoder(std::string("PGRME"), _))
+            .WillOnce(Return(ReturnCode::RETURN_CODE_ILLEGAL_OPERATION));
+
+    easynmea.set_impl(std::move(impl));
+
+    ASSERT_EQ(easynmea.register_decoder("PGRME", [](const RawSentence&)
+            {
+            }), ReturnCode::RETURN_CODE_ILLEGAL_OPERATION);
+}
+
+TEST(EasyNmeaTests, stamp_realtimeOk)
+{
+    EasyNmeaTest easynmea;
+    std::unique_ptr<EasyNmeaImplMock> impl = std::make_unique<EasyNmeaImplMock>();
+
+    EXPECT_CALL(*impl, stamp_realtime(true))
+            .WillOnce(Return(ReturnCode::RETURN_CODE_OK));
+
+    easynmea.set_impl(std::move(impl));
+
+    ASSERT_EQ(easynmea.stamp_realtime(true), ReturnCode::RETURN_CODE_OK);
+}
+
+TEST(EasyNmeaTests, stamp_realtimeIllegal)
+{
+    EasyNmeaTest easynmea;
+    std::unique_ptr<EasyNmeaImplMock> impl = std::make_unique<EasyNmeaImplMock>();
+
+    EXPECT_CALL(*impl, stamp_realtime(true))
+            .WillOnce(Return(ReturnCode::RETURN_CODE_ILLEGAL_OPERATION));
+
+    easynmea.set_impl(std::move(impl));
+
+    ASSERT_EQ(easynmea.stamp_realtime(true), ReturnCode::RETURN_CODE_ILLEGAL_OPERATION);
+}
+
+TEST(EasyNmeaTests, set_read_profileOk)
+{
+    EasyNmeaTest easynmea;
+    std::unique_ptr<EasyNmeaImplMock> impl = std::make_unique<EasyNmeaImplMock>();
+
+    EXPECT_CALL(*impl, set_read_profile(ReadProfile::lowest_cpu()))
+            .WillOnce(Return(ReturnCode::RETURN_CODE_OK));
+
+    easynmea.set_impl(std::move(impl));
+
+    ASSERT_EQ(easynmea.set_read_profile(ReadProfile::lowest_cpu()), ReturnCode::RETURN_CODE_OK);
+}
+
+TEST(EasyNmeaTests, set_read_profileUnsupported)
+{
+    EasyNmeaTest easynmea;
+    std::unique_ptr<EasyNmeaImplMock> impl = std::make_unique<EasyNmeaImplMock>();
+
+    EXPECT_CALL(*impl, set_read_profile(ReadProfile::lowest_cpu()))
+            .WillOnce(Return(ReturnCode::RETURN_CODE_UNSUPPORTED));
+
+    easynmea.set_impl(std::move(impl));
+
+    ASSERT_EQ(easynmea.set_read_profile(ReadProfile::lowest_cpu()), ReturnCode::RETURN_CODE_UNSUPPORTED);
+}
+
 TEST(EasyNmeaTests, wait_for_dataOk)
 {
     EasyNmeaTest easynmea;
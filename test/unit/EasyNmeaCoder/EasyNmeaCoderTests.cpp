@@ -18,9 +18,23 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 // THE SOFTWARE.
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <clocale>
 #include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
 #include <memory>
+#include <new>
+#include <random>
+#include <regex>
+#include <string_view>
 #include <thread>
+#include <type_traits>
+#include <utility>
 
 #include <gtest/gtest.h>
 
@@ -29,15 +43,127 @@
 
 using namespace eduponz::easynmea;
 
+class EasyNmeaCoderTest : public EasyNmeaCoder
+{
+public:
+
+    using EasyNmeaCoder::to_decimal_;
+    using EasyNmeaCoder::to_degrees_;
+    using EasyNmeaCoder::to_int_;
+};
+
+//! Number of heap allocations performed by the test process
+static std::atomic<std::size_t> heap_allocations(0);
+
+void* operator new(
+        std::size_t size)
+{
+    heap_allocations++;
+    if (void* ptr = std::malloc(size == 0 ? 1 : size))
+    {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(
+        void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(
+        void* ptr,
+        std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+/**
+ * Turns a mutated body followed by its checksum into what is being mutated: the text which is
+ * matched against the regular expression, and the sentence which is handed to the decoder.
+ */
+using MutationFrame = std::function<std::pair<std::string, std::string> (const std::string& checked)>;
+
+//! MutationFrame of the mutated sentences themselves
+std::pair<std::string, std::string> frame_sentence(
+        const std::string& checked)
+{
+    return {checked, checked};
+}
+
+/**
+ * Mutate valid sentences one character at a time and check that the decoder accepts a sentence
+ * as \c kind if and only if it matches \c regex. The checksum is recalculated for every mutation
+ * so that only the grammar of the sentence is exercised.
+ *
+ * @param bodies The valid sentences, without their checksum
+ * @param alphabet The characters which are substituted or inserted
+ * @param regex The regular expression of the sentences
+ * @param kind The kind the decoder yields for the sentences which match \c regex
+ * @param start The number of leading characters of the bodies which are neither mutated nor
+ *        covered by the checksum, i.e. their '$' or '!'
+ * @param frame What is being mutated, e.g. the tag block of a sentence rather than the sentence
+ */
+void expect_decoder_matches_regex(
+        const std::vector<std::string>& bodies,
+        const std::string& alphabet,
+        const char* regex,
+        NMEA0183DataKind kind,
+        std::size_t start = 1,
+        const MutationFrame& frame = frame_sentence)
+{
+    std::regex sentence_regex(regex);
+    std::mt19937 generator(2021);
+
+    for (const std::string& body : bodies)
+    {
+        for (int i = 0; i < 1000; i++)
+        {
+            std::string mutated = body;
+            std::size_t position = start + generator() % (mutated.size() - start);
+            char character = alphabet[generator() % alphabet.size()];
+            switch (generator() % 3)
+            {
+                case 0:
+                    mutated[position] = character;
+                    break;
+                case 1:
+                    mutated.insert(mutated.begin() + position, character);
+                    break;
+                default:
+                    mutated.erase(position, 1);
+            }
+
+            int checksum = 0;
+            for (std::size_t j = start; j < mutated.size(); j++)
+            {
+                checksum ^= mutated[j];
+            }
+            char checksum_str[4];
+            std::snprintf(checksum_str, sizeof(checksum_str), "*%02X", checksum);
+            std::pair<std::string, std::string> framed = frame(mutated + checksum_str);
+
+            bool expected = std::regex_match(framed.first, sentence_regex);
+            DecodeResult result = EasyNmeaCoder::decode(framed.second);
+            ASSERT_EQ(result.kind() == kind, expected) << framed.first;
+        }
+    }
+}
+
 TEST(EasyNmeaCoderTests, decodeGPGGAValidNE)
 {
     std::string sentence = "$GPGGA,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,2.2,7854,*4a";
-    std::shared_ptr<GPGGAData> data = std::static_pointer_cast<GPGGAData>(EasyNmeaCoder::decode(sentence));
+    DecodeResult result = EasyNmeaCoder::decode(sentence);
 
-    ASSERT_EQ(data->kind, NMEA0183DataKind::GPGGA);
+    ASSERT_EQ(result.kind(), NMEA0183DataKind::GPGGA);
+    const GPGGAData* data = result.get<GPGGAData>();
+    ASSERT_NE(data, nullptr);
     ASSERT_FLOAT_EQ(data->timestamp, 72705);
     ASSERT_FLOAT_EQ(data->latitude, 57.0529);
     ASSERT_FLOAT_EQ(data->longitude, 9.9157648);
+    ASSERT_EQ(data->latitude_e7, 570529000);
+    ASSERT_EQ(data->longitude_e7, 99157650);
     ASSERT_EQ(data->fix, 1);
     ASSERT_EQ(data->satellites_on_view, 7);
     ASSERT_FLOAT_EQ(data->horizontal_precision, 1.97);
@@ -50,9 +176,11 @@ TEST(EasyNmeaCoderTests, decodeGPGGAValidNE)
 TEST(EasyNmeaCoderTests, decodeGPGGAValidNW)
 {
     std::string sentence = "$GPGGA,072706.000,5703.1740,N,00954.9459,W,1,8,1.28,-21.2,M,42.5,M,2.2,7854,*50";
-    std::shared_ptr<GPGGAData> data = std::static_pointer_cast<GPGGAData>(EasyNmeaCoder::decode(sentence));
+    DecodeResult result = EasyNmeaCoder::decode(sentence);
 
-    ASSERT_EQ(data->kind, NMEA0183DataKind::GPGGA);
+    ASSERT_EQ(result.kind(), NMEA0183DataKind::GPGGA);
+    const GPGGAData* data = result.get<GPGGAData>();
+    ASSERT_NE(data, nullptr);
     ASSERT_FLOAT_EQ(data->timestamp, 72706);
     ASSERT_FLOAT_EQ(data->latitude, 57.0529);
     ASSERT_FLOAT_EQ(data->longitude, -9.9157648);
@@ -68,9 +196,11 @@ TEST(EasyNmeaCoderTests, decodeGPGGAValidNW)
 TEST(EasyNmeaCoderTests, decodeGPGGAValidSE)
 {
     std::string sentence = "$GPGGA,072707.000,5703.1740,S,00954.9459,E,1,8,1.27,-21.2,M,42.5,M,2.2,7854,*51";
-    std::shared_ptr<GPGGAData> data = std::static_pointer_cast<GPGGAData>(EasyNmeaCoder::decode(sentence));
+    DecodeResult result = EasyNmeaCoder::decode(sentence);
 
-    ASSERT_EQ(data->kind, NMEA0183DataKind::GPGGA);
+    ASSERT_EQ(result.kind(), NMEA0183DataKind::GPGGA);
+    const GPGGAData* data = result.get<GPGGAData>();
+    ASSERT_NE(data, nullptr);
     ASSERT_FLOAT_EQ(data->timestamp, 72707);
     ASSERT_FLOAT_EQ(data->latitude, -57.0529);
     ASSERT_FLOAT_EQ(data->longitude, 9.9157648);
@@ -86,9 +216,11 @@ TEST(EasyNmeaCoderTests, decodeGPGGAValidSE)
 TEST(EasyNmeaCoderTests, decodeGPGGAValidSW)
 {
     std::string sentence = "$GPGGA,072708.000,5703.1736,S,00954.9457,W,1,8,1.28,-21.6,M,42.5,M,2.2,7854,*48";
-    std::shared_ptr<GPGGAData> data = std::static_pointer_cast<GPGGAData>(EasyNmeaCoder::decode(sentence));
+    DecodeResult result = EasyNmeaCoder::decode(sentence);
 
-    ASSERT_EQ(data->kind, NMEA0183DataKind::GPGGA);
+    ASSERT_EQ(result.kind(), NMEA0183DataKind::GPGGA);
+    const GPGGAData* data = result.get<GPGGAData>();
+    ASSERT_NE(data, nullptr);
     ASSERT_FLOAT_EQ(data->timestamp, 72708);
     ASSERT_FLOAT_EQ(data->latitude, -57.0529);
     ASSERT_FLOAT_EQ(data->longitude, -9.9157648);
@@ -104,9 +236,11 @@ TEST(EasyNmeaCoderTests, decodeGPGGAValidSW)
 TEST(EasyNmeaCoderTests, decodeGPGGAValidNoAgeOfDiffGPS)
 {
     std::string sentence = "$GPGGA,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,,7854,*64";
-    std::shared_ptr<GPGGAData> data = std::static_pointer_cast<GPGGAData>(EasyNmeaCoder::decode(sentence));
+    DecodeResult result = EasyNmeaCoder::decode(sentence);
 
-    ASSERT_EQ(data->kind, NMEA0183DataKind::GPGGA);
+    ASSERT_EQ(result.kind(), NMEA0183DataKind::GPGGA);
+    const GPGGAData* data = result.get<GPGGAData>();
+    ASSERT_NE(data, nullptr);
     ASSERT_FLOAT_EQ(data->timestamp, 72705);
     ASSERT_FLOAT_EQ(data->latitude, 57.0529);
     ASSERT_FLOAT_EQ(data->longitude, 9.9157648);
@@ -122,9 +256,11 @@ TEST(EasyNmeaCoderTests, decodeGPGGAValidNoAgeOfDiffGPS)
 TEST(EasyNmeaCoderTests, decodeGPGGAValidEmptyAgeOfDiffGPSNoDiffRefStation)
 {
     std::string sentence = "$GPGGA,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,,*46";
-    std::shared_ptr<GPGGAData> data = std::static_pointer_cast<GPGGAData>(EasyNmeaCoder::decode(sentence));
+    DecodeResult result = EasyNmeaCoder::decode(sentence);
 
-    ASSERT_EQ(data->kind, NMEA0183DataKind::GPGGA);
+    ASSERT_EQ(result.kind(), NMEA0183DataKind::GPGGA);
+    const GPGGAData* data = result.get<GPGGAData>();
+    ASSERT_NE(data, nullptr);
     ASSERT_FLOAT_EQ(data->timestamp, 72705);
     ASSERT_FLOAT_EQ(data->latitude, 57.0529);
     ASSERT_FLOAT_EQ(data->longitude, 9.9157648);
@@ -140,9 +276,11 @@ TEST(EasyNmeaCoderTests, decodeGPGGAValidEmptyAgeOfDiffGPSNoDiffRefStation)
 TEST(EasyNmeaCoderTests, decodeGPGGAValidNoDiffRefStation)
 {
     std::string sentence = "$GPGGA,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,2.2,*68";
-    std::shared_ptr<GPGGAData> data = std::static_pointer_cast<GPGGAData>(EasyNmeaCoder::decode(sentence));
+    DecodeResult result = EasyNmeaCoder::decode(sentence);
 
-    ASSERT_EQ(data->kind, NMEA0183DataKind::GPGGA);
+    ASSERT_EQ(result.kind(), NMEA0183DataKind::GPGGA);
+    const GPGGAData* data = result.get<GPGGAData>();
+    ASSERT_NE(data, nullptr);
     ASSERT_FLOAT_EQ(data->timestamp, 72705);
     ASSERT_FLOAT_EQ(data->latitude, 57.0529);
     ASSERT_FLOAT_EQ(data->longitude, 9.9157648);
@@ -158,9 +296,11 @@ TEST(EasyNmeaCoderTests, decodeGPGGAValidNoDiffRefStation)
 TEST(EasyNmeaCoderTests, decodeGPGGAValidNoOptionals)
 {
     std::string sentence = "$GPGGA,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,*6a";
-    std::shared_ptr<GPGGAData> data = std::static_pointer_cast<GPGGAData>(EasyNmeaCoder::decode(sentence));
+    DecodeResult result = EasyNmeaCoder::decode(sentence);
 
-    ASSERT_EQ(data->kind, NMEA0183DataKind::GPGGA);
+    ASSERT_EQ(result.kind(), NMEA0183DataKind::GPGGA);
+    const GPGGAData* data = result.get<GPGGAData>();
+    ASSERT_NE(data, nullptr);
     ASSERT_FLOAT_EQ(data->timestamp, 72705);
     ASSERT_FLOAT_EQ(data->latitude, 57.0529);
     ASSERT_FLOAT_EQ(data->longitude, 9.9157648);
@@ -173,145 +313,248 @@ TEST(EasyNmeaCoderTests, decodeGPGGAValidNoOptionals)
     ASSERT_EQ(data->dgps_reference_station_id, 0);
 }
 
+TEST(EasyNmeaCoderTests, decodeGPGGAValidRangeLimits)
+{
+    std::string sentence = "$GPGGA,072705.000,90.0,N,180.00,W,1,7,1.97,-21.2,M,42.5,M,,*6E";
+    DecodeResult result = EasyNmeaCoder::decode(sentence);
+
+    ASSERT_EQ(result.kind(), NMEA0183DataKind::GPGGA);
+    const GPGGAData* data = result.get<GPGGAData>();
+    ASSERT_NE(data, nullptr);
+    ASSERT_FLOAT_EQ(data->latitude, 90);
+    ASSERT_FLOAT_EQ(data->longitude, -180);
+    ASSERT_EQ(data->latitude_e7, 900000000);
+    ASSERT_EQ(data->longitude_e7, -1800000000);
+
+    sentence = "$GPGGA,072705,8960.5,S,17960.25,E,2,12,0.9,21.2,M,-42.5,M,*5E";
+    result = EasyNmeaCoder::decode(sentence);
+
+    ASSERT_EQ(result.kind(), NMEA0183DataKind::GPGGA);
+    data = result.get<GPGGAData>();
+    ASSERT_NE(data, nullptr);
+    ASSERT_FLOAT_EQ(data->timestamp, 72705);
+    ASSERT_FLOAT_EQ(data->latitude, -90.008333);
+    ASSERT_FLOAT_EQ(data->longitude, 180.00417);
+    ASSERT_EQ(data->latitude_e7, -900083333);
+    ASSERT_EQ(data->longitude_e7, 1800041667);
+    ASSERT_EQ(data->fix, 2);
+    ASSERT_EQ(data->satellites_on_view, 12);
+    ASSERT_FLOAT_EQ(data->horizontal_precision, 0.9);
+    ASSERT_FLOAT_EQ(data->altitude, 21.2);
+    ASSERT_FLOAT_EQ(data->height_of_geoid, -42.5);
+    ASSERT_FLOAT_EQ(data->dgps_last_update, -1);
+    ASSERT_EQ(data->dgps_reference_station_id, 0);
+}
+
+TEST(EasyNmeaCoderTests, decodeGPGGAFixedPointCoordinates)
+{
+    struct Case
+    {
+        const char* latitude;
+        const char* longitude;
+        int32_t latitude_e7;
+        int32_t longitude_e7;
+    };
+
+    const std::vector<Case> cases = {
+        {"4807.038247,N", "01131.000000,E", 481173041, 115166667},
+        {"0000.0000001,S", "00000.0000030,W", 0, -1},
+        {"8959.9999999,N", "17959.9999999,E", 900000000, 1800000000},
+        {"3352.12345678,S", "15112.87654321,E", -338687243, 1512146091},
+        {"3352.123456789999,S", "12345.678912349999,W", -338687243, -1237613152}
+    };
+
+    for (const Case& test_case : cases)
+    {
+        /* Build the sentence with its checksum */
+        std::string sentence = std::string("$GPGGA,072705.000,") + test_case.latitude + "," + test_case.longitude +
+                ",1,7,1.97,-21.2,M,42.5,M,,";
+        char checksum[4];
+        std::snprintf(checksum, sizeof(checksum), "*%02X", Checksum::compute(sentence.data() + 1, sentence.size() - 1));
+        sentence += checksum;
+
+        DecodeResult result = EasyNmeaCoder::decode(sentence);
+        const GPGGAData* data = result.get<GPGGAData>();
+        ASSERT_NE(data, nullptr) << sentence;
+        ASSERT_EQ(data->latitude_e7, test_case.latitude_e7) << sentence;
+        ASSERT_EQ(data->longitude_e7, test_case.longitude_e7) << sentence;
+        // The floating point representation is consistent with the fixed point one
+        ASSERT_NEAR(data->latitude, test_case.latitude_e7 * 1e-7, 1e-5) << sentence;
+        ASSERT_NEAR(data->longitude, test_case.longitude_e7 * 1e-7, 1e-5) << sentence;
+    }
+}
+
+TEST(EasyNmeaCoderTests, decodeGPGGAMatchesRegex)
+{
+    /* The decoder accepts a mutated GPGGA sentence if and only if it matches nmea0183::GPGGA_REGEX */
+    const std::vector<std::string> bodies = {
+        "$GPGGA,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,2.2,7854,",
+        "$GPGGA,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,,",
+        "$GPGGA,072705,90.00,S,180.0,W,2,12,0.9,21.2,M,-42.5,M,"
+    };
+    const std::string alphabet = "0123456789.,-NSEWMAG*";
+    expect_decoder_matches_regex(bodies, alphabet, nmea0183::GPGGA_REGEX, NMEA0183DataKind::GPGGA);
+}
+
 TEST(EasyNmeaCoderTests, decodeInvalidSentenceID)
 {
     std::string sentence = "$ABCDE,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,2.2,7854,*5d";
-    std::shared_ptr<NMEA0183Data> data = EasyNmeaCoder::decode(sentence);
-    ASSERT_EQ(data->kind, NMEA0183DataKind::INVALID);
+    DecodeResult result = EasyNmeaCoder::decode(sentence);
+    ASSERT_EQ(result.kind(), NMEA0183DataKind::INVALID);
+    ASSERT_EQ(result.error(), DecodeError::UNSUPPORTED_SENTENCE);
 }
 
 TEST(EasyNmeaCoderTests, decodeGPGGAInvalidTime)
 {
     std::string sentence = "$GPGGA,123,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,2.2,7854,*63";
-    std::shared_ptr<GPGGAData> data = std::static_pointer_cast<GPGGAData>(EasyNmeaCoder::decode(sentence));
-    ASSERT_EQ(data->kind, NMEA0183DataKind::INVALID);
+    DecodeResult result = EasyNmeaCoder::decode(sentence);
+    ASSERT_EQ(result.kind(), NMEA0183DataKind::INVALID);
+    ASSERT_EQ(result.error(), DecodeError::INVALID_FIELDS);
 }
 
 TEST(EasyNmeaCoderTests, decodeGPGGAInvalidLatitudeLength)
 {
     std::string sentence = "$GPGGA,072705.000,123.123,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,2.2,7854,*49";
-    std::shared_ptr<GPGGAData> data = std::static_pointer_cast<GPGGAData>(EasyNmeaCoder::decode(sentence));
-    ASSERT_EQ(data->kind, NMEA0183DataKind::INVALID);
+    DecodeResult result = EasyNmeaCoder::decode(sentence);
+    ASSERT_EQ(result.kind(), NMEA0183DataKind::INVALID);
+    ASSERT_EQ(result.error(), DecodeError::INVALID_FIELDS);
 }
 
 TEST(EasyNmeaCoderTests, decodeGPGGAInvalidLatitudeDegrees)
 {
     std::string sentence = "$GPGGA,072705.000,9903.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,2.2,7854,*48";
-    std::shared_ptr<GPGGAData> data = std::static_pointer_cast<GPGGAData>(EasyNmeaCoder::decode(sentence));
-    ASSERT_EQ(data->kind, NMEA0183DataKind::INVALID);
+    DecodeResult result = EasyNmeaCoder::decode(sentence);
+    ASSERT_EQ(result.kind(), NMEA0183DataKind::INVALID);
+    ASSERT_EQ(result.error(), DecodeError::INVALID_FIELDS);
 
 }
 
 TEST(EasyNmeaCoderTests, decodeGPGGAInvalidLatitudeMinutes)
 {
     std::string sentence = "$GPGGA,072705.000,5761.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,2.2,7854,*4e";
-    std::shared_ptr<GPGGAData> data = std::static_pointer_cast<GPGGAData>(EasyNmeaCoder::decode(sentence));
-    ASSERT_EQ(data->kind, NMEA0183DataKind::INVALID);
+    DecodeResult result = EasyNmeaCoder::decode(sentence);
+    ASSERT_EQ(result.kind(), NMEA0183DataKind::INVALID);
+    ASSERT_EQ(result.error(), DecodeError::INVALID_FIELDS);
 }
 
 TEST(EasyNmeaCoderTests, decodeGPGGAInvalidLongitudeLength)
 {
     std::string sentence = "$GPGGA,072705.000,5703.1740,N,123.123,E,1,7,1.97,-21.2,M,42.5,M,2.2,7854,*73";
-    std::shared_ptr<GPGGAData> data = std::static_pointer_cast<GPGGAData>(EasyNmeaCoder::decode(sentence));
-    ASSERT_EQ(data->kind, NMEA0183DataKind::INVALID);
+    DecodeResult result = EasyNmeaCoder::decode(sentence);
+    ASSERT_EQ(result.kind(), NMEA0183DataKind::INVALID);
+    ASSERT_EQ(result.error(), DecodeError::INVALID_FIELDS);
 }
 
 TEST(EasyNmeaCoderTests, decodeGPGGAInvalidLongitudeDegrees)
 {
     std::string sentence = "$GPGGA,072705.000,5703.1740,N,18154.9459,E,1,7,1.97,-21.2,M,42.5,M,2.2,7854,*4b";
-    std::shared_ptr<GPGGAData> data = std::static_pointer_cast<GPGGAData>(EasyNmeaCoder::decode(sentence));
-    ASSERT_EQ(data->kind, NMEA0183DataKind::INVALID);
+    DecodeResult result = EasyNmeaCoder::decode(sentence);
+    ASSERT_EQ(result.kind(), NMEA0183DataKind::INVALID);
+    ASSERT_EQ(result.error(), DecodeError::INVALID_FIELDS);
 }
 
 TEST(EasyNmeaCoderTests, decodeGPGGAInvalidLongitudeMinutes)
 {
     std::string sentence = "$GPGGA,072705.000,5703.1740,N,00961.9459,E,1,7,1.97,-21.2,M,42.5,M,2.2,7854,*4c";
-    std::shared_ptr<GPGGAData> data = std::static_pointer_cast<GPGGAData>(EasyNmeaCoder::decode(sentence));
-    ASSERT_EQ(data->kind, NMEA0183DataKind::INVALID);
+    DecodeResult result = EasyNmeaCoder::decode(sentence);
+    ASSERT_EQ(result.kind(), NMEA0183DataKind::INVALID);
+    ASSERT_EQ(result.error(), DecodeError::INVALID_FIELDS);
 }
 
 TEST(EasyNmeaCoderTests, decodeGPGGAInvalidAltitudeUnits)
 {
     std::string sentence = "$GPGGA,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,A,42.5,M,2.2,7854,*46";
-    std::shared_ptr<GPGGAData> data = std::static_pointer_cast<GPGGAData>(EasyNmeaCoder::decode(sentence));
-    ASSERT_EQ(data->kind, NMEA0183DataKind::INVALID);
+    DecodeResult result = EasyNmeaCoder::decode(sentence);
+    ASSERT_EQ(result.kind(), NMEA0183DataKind::INVALID);
+    ASSERT_EQ(result.error(), DecodeError::INVALID_FIELDS);
 }
 
 TEST(EasyNmeaCoderTests, decodeGPGGAInvalidHeightUnits)
 {
     std::string sentence = "$GPGGA,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,A,2.2,7854,*46";
-    std::shared_ptr<GPGGAData> data = std::static_pointer_cast<GPGGAData>(EasyNmeaCoder::decode(sentence));
-    ASSERT_EQ(data->kind, NMEA0183DataKind::INVALID);
+    DecodeResult result = EasyNmeaCoder::decode(sentence);
+    ASSERT_EQ(result.kind(), NMEA0183DataKind::INVALID);
+    ASSERT_EQ(result.error(), DecodeError::INVALID_FIELDS);
 }
 
 TEST(EasyNmeaCoderTests, decodeGPGGAInvalidChecksum)
 {
     std::string sentence = "$GPGGA,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,2.2,7854,*22";
-    std::shared_ptr<NMEA0183Data> data = EasyNmeaCoder::decode(sentence);
-    ASSERT_EQ(data->kind, NMEA0183DataKind::INVALID);
+    DecodeResult result = EasyNmeaCoder::decode(sentence);
+    ASSERT_EQ(result.kind(), NMEA0183DataKind::INVALID);
+    ASSERT_EQ(result.error(), DecodeError::INVALID_CHECKSUM);
 }
 
 TEST(EasyNmeaCoderTests, decodeGPGGANoTime)
 {
     std::string sentence = "$GPGGA,,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,2.2,7854,*53";
-    std::shared_ptr<GPGGAData> data = std::static_pointer_cast<GPGGAData>(EasyNmeaCoder::decode(sentence));
-    ASSERT_EQ(data->kind, NMEA0183DataKind::INVALID);
+    DecodeResult result = EasyNmeaCoder::decode(sentence);
+    ASSERT_EQ(result.kind(), NMEA0183DataKind::INVALID);
+    ASSERT_EQ(result.error(), DecodeError::INVALID_FIELDS);
 }
 
 TEST(EasyNmeaCoderTests, decodeGPGGANoLatitude)
 {
     std::string sentence = "$GPGGA,072705.000,,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,2.2,7854,*67";
-    std::shared_ptr<GPGGAData> data = std::static_pointer_cast<GPGGAData>(EasyNmeaCoder::decode(sentence));
-    ASSERT_EQ(data->kind, NMEA0183DataKind::INVALID);
+    DecodeResult result = EasyNmeaCoder::decode(sentence);
+    ASSERT_EQ(result.kind(), NMEA0183DataKind::INVALID);
+    ASSERT_EQ(result.error(), DecodeError::INVALID_FIELDS);
 }
 
 TEST(EasyNmeaCoderTests, decodeGPGGANoLongitude)
 {
     std::string sentence = "$GPGGA,072705.000,5703.1740,N,,E,1,7,1.97,-21.2,M,42.5,M,2.2,7854,*5d";
-    std::shared_ptr<GPGGAData> data = std::static_pointer_cast<GPGGAData>(EasyNmeaCoder::decode(sentence));
-    ASSERT_EQ(data->kind, NMEA0183DataKind::INVALID);
+    DecodeResult result = EasyNmeaCoder::decode(sentence);
+    ASSERT_EQ(result.kind(), NMEA0183DataKind::INVALID);
+    ASSERT_EQ(result.error(), DecodeError::INVALID_FIELDS);
 }
 
 TEST(EasyNmeaCoderTests, decodeGPGGANoFix)
 {
     std::string sentence = "$GPGGA,072705.000,5703.1740,N,00954.9459,E,,7,1.97,-21.2,M,42.5,M,2.2,7854,*7b";
-    std::shared_ptr<GPGGAData> data = std::static_pointer_cast<GPGGAData>(EasyNmeaCoder::decode(sentence));
-    ASSERT_EQ(data->kind, NMEA0183DataKind::INVALID);
+    DecodeResult result = EasyNmeaCoder::decode(sentence);
+    ASSERT_EQ(result.kind(), NMEA0183DataKind::INVALID);
+    ASSERT_EQ(result.error(), DecodeError::INVALID_FIELDS);
 }
 
 TEST(EasyNmeaCoderTests, decodeGPGGANoNumberOfSatellites)
 {
     std::string sentence = "$GPGGA,072705.000,5703.1740,N,00954.9459,E,1,,1.97,-21.2,M,42.5,M,2.2,7854,*7d";
-    std::shared_ptr<GPGGAData> data = std::static_pointer_cast<GPGGAData>(EasyNmeaCoder::decode(sentence));
-    ASSERT_EQ(data->kind, NMEA0183DataKind::INVALID);
+    DecodeResult result = EasyNmeaCoder::decode(sentence);
+    ASSERT_EQ(result.kind(), NMEA0183DataKind::INVALID);
+    ASSERT_EQ(result.error(), DecodeError::INVALID_FIELDS);
 }
 
 TEST(EasyNmeaCoderTests, decodeGPGGANoHDOP)
 {
     std::string sentence = "$GPGGA,072705.000,5703.1740,N,00954.9459,E,1,7,,-21.2,M,42.5,M,2.2,7854,*5b";
-    std::shared_ptr<GPGGAData> data = std::static_pointer_cast<GPGGAData>(EasyNmeaCoder::decode(sentence));
-    ASSERT_EQ(data->kind, NMEA0183DataKind::INVALID);
+    DecodeResult result = EasyNmeaCoder::decode(sentence);
+    ASSERT_EQ(result.kind(), NMEA0183DataKind::INVALID);
+    ASSERT_EQ(result.error(), DecodeError::INVALID_FIELDS);
 }
 
 TEST(EasyNmeaCoderTests, decodeGPGGANoAltitude)
 {
     std::string sentence = "$GPGGA,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,,M,42.5,M,2.2,7854,*78";
-    std::shared_ptr<GPGGAData> data = std::static_pointer_cast<GPGGAData>(EasyNmeaCoder::decode(sentence));
-    ASSERT_EQ(data->kind, NMEA0183DataKind::INVALID);
+    DecodeResult result = EasyNmeaCoder::decode(sentence);
+    ASSERT_EQ(result.kind(), NMEA0183DataKind::INVALID);
+    ASSERT_EQ(result.error(), DecodeError::INVALID_FIELDS);
 }
 
 TEST(EasyNmeaCoderTests, decodeGPGGANoHeight)
 {
     std::string sentence = "$GPGGA,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,,M,2.2,7854,*57";
-    std::shared_ptr<GPGGAData> data = std::static_pointer_cast<GPGGAData>(EasyNmeaCoder::decode(sentence));
-    ASSERT_EQ(data->kind, NMEA0183DataKind::INVALID);
+    DecodeResult result = EasyNmeaCoder::decode(sentence);
+    ASSERT_EQ(result.kind(), NMEA0183DataKind::INVALID);
+    ASSERT_EQ(result.error(), DecodeError::INVALID_FIELDS);
 }
 
 TEST(EasyNmeaCoderTests, decodeGPGGANoChecksum)
 {
     std::string sentence = "$GPGGA,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,2.2,7854";
-    std::shared_ptr<GPGGAData> data = std::static_pointer_cast<GPGGAData>(EasyNmeaCoder::decode(sentence));
-    ASSERT_EQ(data->kind, NMEA0183DataKind::INVALID);
+    DecodeResult result = EasyNmeaCoder::decode(sentence);
+    ASSERT_EQ(result.kind(), NMEA0183DataKind::INVALID);
+    ASSERT_EQ(result.error(), DecodeError::INVALID_SENTENCE);
 }
 
 TEST(EasyNmeaCoderTests, decodeUnsupportedSentence)
@@ -320,49 +563,1332 @@ TEST(EasyNmeaCoderTests, decodeUnsupportedSentence)
         "$GPBOD,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,2.2,7854,*42",
         "$GPBWC,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,2.2,7854,*5d",
         "$GPGLL,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,2.2,7854,*4c",
-        "$GPGSA,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,2.2,7854,*5e",
-        "$GPGSV,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,2.2,7854,*49",
-        "$GPHDT,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,2.2,7854,*53",
         "$GPR00,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,2.2,7854,*59",
         "$GPRMA,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,2.2,7854,*55",
         "$GPRMB,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,2.2,7854,*56",
-        "$GPRMC,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,2.2,7854,*57",
         "$GPRTE,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,2.2,7854,*48",
         "$GPTRF,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,2.2,7854,*4b",
         "$GPSTN,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,2.2,7854,*42",
         "$GPVBW,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,2.2,7854,*48",
         "$GPVTG,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,2.2,7854,*4e",
         "$GPWPL,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,2.2,7854,*40",
-        "$GPXTE,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,2.2,7854,*42",
-        "$GPZDA,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,2.2,7854,*54"
+        "$GPXTE,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,2.2,7854,*42"
     };
 
     for (std::string sentence : sentences)
     {
-        std::shared_ptr<NMEA0183Data> data = EasyNmeaCoder::decode(sentence);
-        ASSERT_EQ(data->kind, NMEA0183DataKind::INVALID);
+        DecodeResult result = EasyNmeaCoder::decode(sentence);
+        ASSERT_EQ(result.kind(), NMEA0183DataKind::INVALID);
+        ASSERT_EQ(result.error(), DecodeError::UNSUPPORTED_SENTENCE);
     }
 }
 
 TEST(EasyNmeaCoderTests, decodeEmptySentence)
 {
     std::string sentence = "";
-    std::shared_ptr<NMEA0183Data> data = EasyNmeaCoder::decode(sentence);
-    ASSERT_EQ(data->kind, NMEA0183DataKind::INVALID);
+    DecodeResult result = EasyNmeaCoder::decode(sentence);
+    ASSERT_EQ(result.kind(), NMEA0183DataKind::INVALID);
+    ASSERT_EQ(result.error(), DecodeError::INVALID_SENTENCE);
 }
 
 TEST(EasyNmeaCoderTests, decodeOnlyChecksumSentence)
 {
     std::string sentence = "*0";
-    std::shared_ptr<NMEA0183Data> data = EasyNmeaCoder::decode(sentence);
-    ASSERT_EQ(data->kind, NMEA0183DataKind::INVALID);
+    DecodeResult result = EasyNmeaCoder::decode(sentence);
+    ASSERT_EQ(result.kind(), NMEA0183DataKind::INVALID);
+    ASSERT_EQ(result.error(), DecodeError::INVALID_SENTENCE);
 }
 
 TEST(EasyNmeaCoderTests, decodeOnlyAstheriscSentence)
 {
     std::string sentence = "*";
-    std::shared_ptr<NMEA0183Data> data = EasyNmeaCoder::decode(sentence);
-    ASSERT_EQ(data->kind, NMEA0183DataKind::INVALID);
+    DecodeResult result = EasyNmeaCoder::decode(sentence);
+    ASSERT_EQ(result.kind(), NMEA0183DataKind::INVALID);
+    ASSERT_EQ(result.error(), DecodeError::INVALID_SENTENCE);
+}
+
+TEST(EasyNmeaCoderTests, decodeStringViewNoAllocation)
+{
+    /* Sentences are decoded directly from a receive-like buffer holding several lines */
+    const char buffer[] =
+            "$GPGGA,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,2.2,7854,*4a\r\n"
+            "$GPGGA,072705.000,5703.174012345678901234567890,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,,*46\r\n"
+            "$GPGGA,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,2.2,7854,*22\r\n"
+            "$GPGGA,072705.000,9903.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,2.2,7854,*48\r\n"
+            "$GPRMC,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,2.2,7854,*57\r\n"
+            "*\r\n";
+    std::string_view sentence = std::string_view(buffer).substr(0, std::string_view(buffer).find("\r\n"));
+
+    GPGGAData gpgga;
+    std::size_t allocations_before = heap_allocations.load();
+    ASSERT_TRUE(EasyNmeaCoder::decode(sentence, gpgga));
+    ASSERT_EQ(heap_allocations.load(), allocations_before);
+
+    ASSERT_EQ(gpgga.kind, NMEA0183DataKind::GPGGA);
+    ASSERT_FLOAT_EQ(gpgga.timestamp, 72705);
+    ASSERT_FLOAT_EQ(gpgga.latitude, 57.0529);
+    ASSERT_FLOAT_EQ(gpgga.longitude, 9.9157648);
+    ASSERT_EQ(gpgga.satellites_on_view, 7);
+    ASSERT_EQ(gpgga.dgps_reference_station_id, 7854);
+
+    /* Long fields and rejected sentences must not allocate either */
+    std::string_view remaining(buffer);
+    std::size_t decoded = 0;
+    allocations_before = heap_allocations.load();
+    while (!remaining.empty())
+    {
+        std::size_t line_end = remaining.find("\r\n");
+        decoded += EasyNmeaCoder::decode(remaining.substr(0, line_end), gpgga) ? 1 : 0;
+        remaining.remove_prefix(line_end + 2);
+    }
+    ASSERT_EQ(heap_allocations.load(), allocations_before);
+    ASSERT_EQ(decoded, 2u);
+    ASSERT_FLOAT_EQ(gpgga.latitude, 57.0529);
+}
+
+TEST(EasyNmeaCoderTests, decodeResultValueSemantics)
+{
+    static_assert(std::is_trivially_copyable<DecodeResult>::value, "DecodeResult must be trivially copyable");
+
+    const std::vector<std::string> sentences = {
+        "$GPGGA,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,2.2,7854,*4a",
+        "$GPGGA,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,2.2,7854,*22",
+        "$GPGGA,072706.000,5703.1740,N,00954.9459,W,1,8,1.28,-21.2,M,42.5,M,2.2,7854,*50"
+    };
+
+    /* Results can be stored in plain arrays and copied around as raw bytes */
+    std::array<DecodeResult, 3> results;
+    for (std::size_t i = 0; i < sentences.size(); i++)
+    {
+        DecodeResult result = EasyNmeaCoder::decode(sentences[i]);
+        std::memcpy(static_cast<void*>(&results[i]), &result, sizeof(DecodeResult));
+    }
+
+    ASSERT_EQ(results[0].kind(), NMEA0183DataKind::GPGGA);
+    ASSERT_EQ(results[0].error(), DecodeError::NONE);
+    ASSERT_NE(results[0].get<GPGGAData>(), nullptr);
+    ASSERT_FLOAT_EQ(results[0].get<GPGGAData>()->timestamp, 72705);
+
+    ASSERT_EQ(results[1].kind(), NMEA0183DataKind::INVALID);
+    ASSERT_EQ(results[1].error(), DecodeError::INVALID_CHECKSUM);
+    ASSERT_EQ(results[1].get<GPGGAData>(), nullptr);
+
+    ASSERT_EQ(results[2].kind(), NMEA0183DataKind::GPGGA);
+    ASSERT_FLOAT_EQ(results[2].get<GPGGAData>()->longitude, -9.9157648);
+}
+
+TEST(EasyNmeaCoderTests, decodeIndexedSentences)
+{
+    const std::vector<std::string> sentences = {
+        "$GPGGA,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,2.2,7854,*4a",
+        "$GPGGA,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,2.2,7854,*22",
+        "$GPGGA,072706.000,5703.1740,N,00954.9459,W,1,8,1.28,-21.2,M,42.5,M,2.2,7854,*50",
+        "$GPGGA,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,,*6e",
+        "$GPGGA,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,*42",
+        "$GPGGA,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,F,42.5,M,2.2,7854,*41",
+        "$GPGGA,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,2.2,7854,",
+        "*0"
+    };
+
+    /* Index a buffer with all the sentences, and decode them from the index */
+    std::string buffer;
+    for (const std::string& sentence : sentences)
+    {
+        buffer += sentence + "\r\n";
+    }
+    std::vector<IndexedSentence> index(sentences.size());
+    ASSERT_EQ(StructuralIndex::build(buffer, index.data(), index.size()), sentences.size());
+
+    for (std::size_t i = 0; i < sentences.size(); i++)
+    {
+        /* Each failure is logged once, as when decoding the sentence alone */
+        testing::internal::CaptureStdout();
+        DecodeResult expected = EasyNmeaCoder::decode(sentences[i]);
+        std::string expected_log = testing::internal::GetCapturedStdout();
+        testing::internal::CaptureStdout();
+        DecodeResult result = EasyNmeaCoder::decode(buffer, index[i]);
+        std::string log = testing::internal::GetCapturedStdout();
+        ASSERT_EQ(log, expected_log) << sentences[i];
+        ASSERT_EQ(std::count(log.begin(), log.end(), '\n'), expected.error() == DecodeError::NONE ? 0 : 1);
+        ASSERT_EQ(result.kind(), expected.kind()) << sentences[i];
+        ASSERT_EQ(result.error(), expected.error()) << sentences[i];
+        if (expected.kind() == NMEA0183DataKind::GPGGA)
+        {
+            ASSERT_EQ(*result.get<GPGGAData>(), *expected.get<GPGGAData>());
+        }
+    }
+}
+
+TEST(EasyNmeaCoderTests, convertDecimalMatchesStrtod)
+{
+    std::mt19937 generator(2021);
+    for (int i = 0; i < 100000; i++)
+    {
+        /* Random decimals in the NMEA 0183 formats, with up to 25 digits */
+        std::string field = (generator() % 2) ? "-" : "";
+        std::size_t integer_digits = 1 + generator() % 12;
+        std::size_t fraction_digits = generator() % 13;
+        for (std::size_t j = 0; j < integer_digits; j++)
+        {
+            field += static_cast<char>('0' + generator() % 10);
+        }
+        if (fraction_digits > 0)
+        {
+            field += '.';
+            for (std::size_t j = 0; j < fraction_digits; j++)
+            {
+                field += static_cast<char>('0' + generator() % 10);
+            }
+        }
+
+        double expected = std::strtod(field.c_str(), nullptr);
+        double value = EasyNmeaCoderTest::to_decimal_(field.data(), field.data() + field.size());
+        ASSERT_DOUBLE_EQ(value, expected) << field;
+        ASSERT_FLOAT_EQ(static_cast<float>(value), std::strtof(field.c_str(), nullptr)) << field;
+    }
+
+    /* Digits beyond the precision of the mantissa */
+    std::string field = "123456789012345678901234.5";
+    ASSERT_DOUBLE_EQ(EasyNmeaCoderTest::to_decimal_(field.data(), field.data() + field.size()), 1.2345678901234568e23);
+    field = "0.0000000001234567890123456789";
+    ASSERT_DOUBLE_EQ(EasyNmeaCoderTest::to_decimal_(field.data(), field.data() + field.size()), 1.23456789e-10);
+
+    /* Integers saturate instead of overflowing */
+    field = "99999999999999999999";
+    ASSERT_EQ(EasyNmeaCoderTest::to_int_(field.data(), field.data() + field.size()), 2147483647);
+    field = "007854";
+    ASSERT_EQ(EasyNmeaCoderTest::to_int_(field.data(), field.data() + field.size()), 7854);
+}
+
+TEST(EasyNmeaCoderTests, convertDegrees)
+{
+    std::string angle = "5703.1740";
+    ASSERT_FLOAT_EQ(EasyNmeaCoderTest::to_degrees_(angle.data(), angle.data() + 2, angle.data() + angle.size()),
+            57.05290);
+    angle = "00954.9459";
+    ASSERT_FLOAT_EQ(EasyNmeaCoderTest::to_degrees_(angle.data(), angle.data() + 3, angle.data() + angle.size()),
+            9.915765);
+    angle = "17960.0000";
+    ASSERT_FLOAT_EQ(EasyNmeaCoderTest::to_degrees_(angle.data(), angle.data() + 3, angle.data() + angle.size()),
+            180.0);
+}
+
+TEST(EasyNmeaCoderTests, decodeLocaleIndependent)
+{
+    /* Locales which use a comma as decimal separator */
+    const char* locales[] = {"de_DE.UTF-8", "de_DE.utf8", "de_DE", "es_ES.UTF-8", "fr_FR.UTF-8", "German"};
+    std::string previous = std::setlocale(LC_ALL, nullptr);
+    const char* selected = nullptr;
+    for (const char* locale : locales)
+    {
+        if ((selected = std::setlocale(LC_ALL, locale)) != nullptr)
+        {
+            break;
+        }
+    }
+    if (selected == nullptr)
+    {
+        GTEST_SKIP() << "No locale with comma as decimal separator is available";
+    }
+
+    std::string sentence = "$GPGGA,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,2.2,7854,*4a";
+    DecodeResult result = EasyNmeaCoder::decode(sentence);
+    std::setlocale(LC_ALL, previous.c_str());
+
+    const GPGGAData* data = result.get<GPGGAData>();
+    ASSERT_NE(data, nullptr);
+    ASSERT_FLOAT_EQ(data->timestamp, 72705);
+    ASSERT_FLOAT_EQ(data->latitude, 57.0529);
+    ASSERT_FLOAT_EQ(data->longitude, 9.9157648);
+    ASSERT_FLOAT_EQ(data->horizontal_precision, 1.97);
+    ASSERT_FLOAT_EQ(data->altitude, -21.2);
+    ASSERT_FLOAT_EQ(data->dgps_last_update, 2.2);
+}
+
+TEST(EasyNmeaCoderTests, decodeBatchColumns)
+{
+    const std::vector<std::string> sentences = {
+        "$GPGGA,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,2.2,7854,*4a",
+        "$GPGGA,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,2.2,7854,*22",
+        "$GPGGA,072706.000,5703.1740,N,00954.9459,W,1,8,1.28,-21.2,M,42.5,M,2.2,7854,*50",
+        "$GPGGA,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,F,42.5,M,2.2,7854,*41",
+        "GPGGA,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,2.2,7854,*4a",
+        "$GPGGA,072705,8960.5,S,17960.25,E,2,12,0.9,21.2,M,-42.5,M,*5E"
+    };
+    std::string buffer;
+    for (const std::string& sentence : sentences)
+    {
+        buffer += sentence + "\r\n\r\n";
+    }
+
+    /* Columns for all the fields but the floating point coordinates */
+    constexpr std::size_t capacity = 8;
+    float timestamp[capacity];
+    int32_t latitude_e7[capacity];
+    int32_t longitude_e7[capacity];
+    uint16_t fix[capacity];
+    uint16_t satellites_on_view[capacity];
+    float horizontal_precision[capacity];
+    float altitude[capacity];
+    float height_of_geoid[capacity];
+    float dgps_last_update[capacity];
+    uint16_t dgps_reference_station_id[capacity];
+    GPGGAColumns columns;
+    columns.capacity = capacity;
+    columns.timestamp = timestamp;
+    columns.latitude_e7 = latitude_e7;
+    columns.longitude_e7 = longitude_e7;
+    columns.fix = fix;
+    columns.satellites_on_view = satellites_on_view;
+    columns.horizontal_precision = horizontal_precision;
+    columns.altitude = altitude;
+    columns.height_of_geoid = height_of_geoid;
+    columns.dgps_last_update = dgps_last_update;
+    columns.dgps_reference_station_id = dgps_reference_station_id;
+
+    DecodeError status[16];
+    testing::internal::CaptureStdout();
+    std::size_t allocations = heap_allocations;
+    BatchResult batch = EasyNmeaCoder::decode_batch(buffer, columns, status, 16);
+    allocations = heap_allocations - allocations;
+    ASSERT_EQ(testing::internal::GetCapturedStdout(), "");
+    ASSERT_EQ(allocations, 0u);
+    ASSERT_EQ(batch.lines, sentences.size());
+    ASSERT_EQ(batch.rows, 3u);
+    ASSERT_EQ(batch.consumed, buffer.size());
+
+    /* Each line has the same outcome as decoding it alone, and valid samples fill the rows in order */
+    std::size_t row = 0;
+    for (std::size_t i = 0; i < sentences.size(); i++)
+    {
+        DecodeResult expected = EasyNmeaCoder::decode(sentences[i]);
+        ASSERT_EQ(status[i], expected.error()) << sentences[i];
+        if (const GPGGAData* data = expected.get<GPGGAData>())
+        {
+            ASSERT_EQ(timestamp[row], data->timestamp);
+            ASSERT_EQ(latitude_e7[row], data->latitude_e7);
+            ASSERT_EQ(longitude_e7[row], data->longitude_e7);
+            ASSERT_EQ(fix[row], data->fix);
+            ASSERT_EQ(satellites_on_view[row], data->satellites_on_view);
+            ASSERT_EQ(horizontal_precision[row], data->horizontal_precision);
+            ASSERT_EQ(altitude[row], data->altitude);
+            ASSERT_EQ(height_of_geoid[row], data->height_of_geoid);
+            ASSERT_EQ(dgps_last_update[row], data->dgps_last_update);
+            ASSERT_EQ(dgps_reference_station_id[row], data->dgps_reference_station_id);
+            row++;
+        }
+    }
+    ASSERT_EQ(row, batch.rows);
+}
+
+TEST(EasyNmeaCoderTests, decodeBatchResume)
+{
+    std::string buffer;
+    for (int i = 0; i < 100; i++)
+    {
+        buffer += "$GPGGA,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,2.2,7854,*4a\r\n";
+        buffer += "$GPGGA,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,2.2,7854,*22\r\n";
+    }
+
+    /* Decode with small columns and status arrays, resuming from the consumed bytes */
+    float latitude[7];
+    GPGGAColumns columns;
+    columns.capacity = 7;
+    columns.latitude = latitude;
+    DecodeError status[11];
+
+    std::size_t offset = 0;
+    std::size_t lines = 0;
+    std::size_t rows = 0;
+    while (offset < buffer.size())
+    {
+        BatchResult batch = EasyNmeaCoder::decode_batch(std::string_view(buffer).substr(offset), columns, status, 11);
+        ASSERT_TRUE(batch.lines > 0 || batch.rows > 0);
+        ASSERT_LE(batch.lines, 11u);
+        ASSERT_LE(batch.rows, 7u);
+        for (std::size_t i = 0; i < batch.lines; i++)
+        {
+            ASSERT_EQ(status[i], ((lines + i) % 2) ? DecodeError::INVALID_CHECKSUM : DecodeError::NONE);
+        }
+        for (std::size_t i = 0; i < batch.rows; i++)
+        {
+            ASSERT_FLOAT_EQ(latitude[i], 57.0529);
+        }
+        lines += batch.lines;
+        rows += batch.rows;
+        offset += batch.consumed;
+    }
+    ASSERT_EQ(lines, 200u);
+    ASSERT_EQ(rows, 100u);
+    ASSERT_EQ(offset, buffer.size());
+}
+
+TEST(EasyNmeaCoderTests, decodeGGATalkers)
+{
+    const std::vector<std::pair<std::string, NMEA0183Talker>> talkers = {
+        {"GP", NMEA0183Talker::GP}, {"GL", NMEA0183Talker::GL}, {"GA", NMEA0183Talker::GA},
+        {"GB", NMEA0183Talker::GB}, {"BD", NMEA0183Talker::BD}, {"GQ", NMEA0183Talker::GQ},
+        {"GI", NMEA0183Talker::GI}, {"GN", NMEA0183Talker::GN}};
+
+    /* Every talker shares the GGA decoder */
+    for (const auto& talker : talkers)
+    {
+        std::string sentence = "$" + talker.first + "GGA,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,,";
+        char checksum[4];
+        std::snprintf(checksum, sizeof(checksum), "*%02X", Checksum::compute(sentence.data() + 1, sentence.size() - 1));
+        sentence += checksum;
+
+        DecodeResult result = EasyNmeaCoder::decode(sentence);
+        ASSERT_EQ(result.kind(), NMEA0183DataKind::GPGGA) << sentence;
+        ASSERT_EQ(result.get<GPGGAData>()->talker, talker.second);
+        ASSERT_FLOAT_EQ(result.get<GPGGAData>()->latitude, 57.0529);
+
+        IndexedSentence index;
+        ASSERT_EQ(StructuralIndex::build(sentence, &index, 1), 1u);
+        ASSERT_EQ(EasyNmeaCoder::decode(sentence, index).get<GPGGAData>()->talker, talker.second);
+    }
+
+    /* Unknown talkers and formatters are not supported */
+    const std::vector<std::string> addresses = {"$XXGGA", "$GPGGB", "$GpGGA", "$GPGG", "$GPGGAA", "$GGA"};
+    for (const std::string& address : addresses)
+    {
+        std::string sentence = address + ",072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,,";
+        char checksum[4];
+        std::snprintf(checksum, sizeof(checksum), "*%02X", Checksum::compute(sentence.data() + 1, sentence.size() - 1));
+        sentence += checksum;
+
+        DecodeResult result = EasyNmeaCoder::decode(sentence);
+        ASSERT_EQ(result.kind(), NMEA0183DataKind::INVALID) << sentence;
+    }
+}
+
+TEST(EasyNmeaCoderTests, encodeGPGGA)
+{
+    GPGGAData gpgga;
+    gpgga.talker = NMEA0183Talker::GN;
+    gpgga.time_of_day_ms = (7 * 3600 + 27 * 60 + 5) * 1000;
+    gpgga.latitude_e7 = 570529000;
+    gpgga.longitude_e7 = -99157431;
+    gpgga.fix = 1;
+    gpgga.satellites_on_view = 7;
+    gpgga.horizontal_precision = 1.97f;
+    gpgga.altitude = -21.2f;
+    gpgga.height_of_geoid = 42.5f;
+
+    /* The sentence is encoded without allocating memory */
+    char buffer[128];
+    std::size_t allocations_before = heap_allocations.load();
+    std::size_t size = EasyNmeaCoder::encode(gpgga, buffer, sizeof(buffer));
+    ASSERT_EQ(heap_allocations.load(), allocations_before);
+
+    std::string sentence(buffer, size);
+    std::string expected = "$GNGGA,072705.000,5703.174000,N,00954.944586,W,1,7,1.970,-21.200,M,42.500,M,";
+    char checksum[4];
+    std::snprintf(checksum, sizeof(checksum), "*%02X", Checksum::compute(expected.data() + 1, expected.size() - 1));
+    ASSERT_EQ(sentence, expected + checksum);
+
+    /* The sentence decodes into the same data */
+    DecodeResult result = EasyNmeaCoder::decode(sentence);
+    ASSERT_EQ(result.kind(), NMEA0183DataKind::GPGGA);
+    const GPGGAData* decoded = result.get<GPGGAData>();
+    ASSERT_EQ(decoded->talker, NMEA0183Talker::GN);
+    ASSERT_EQ(decoded->time_of_day_ms, gpgga.time_of_day_ms);
+    ASSERT_FLOAT_EQ(decoded->timestamp, 72705);
+    ASSERT_EQ(decoded->latitude_e7, gpgga.latitude_e7);
+    ASSERT_EQ(decoded->longitude_e7, gpgga.longitude_e7);
+    ASSERT_FLOAT_EQ(decoded->horizontal_precision, gpgga.horizontal_precision);
+    ASSERT_EQ(decoded->dgps_last_update, -1);
+    ASSERT_EQ(decoded->dgps_reference_station_id, 0u);
+
+    /* Sentences are not truncated */
+    ASSERT_EQ(EasyNmeaCoder::encode(gpgga, buffer, size - 1), 0u);
+}
+
+TEST(EasyNmeaCoderTests, decodeRMC)
+{
+    std::string sentence = "$GNRMC,072705.000,A,5703.1740,N,00954.9459,E,0.00,90.87,041118,,,A*46";
+    DecodeResult result = EasyNmeaCoder::decode(sentence);
+    ASSERT_EQ(result.kind(), NMEA0183DataKind::RMC);
+    ASSERT_EQ(result.error(), DecodeError::NONE);
+
+    const RMCData* rmc = result.get<RMCData>();
+    ASSERT_NE(rmc, nullptr);
+    ASSERT_EQ(rmc->talker, NMEA0183Talker::GN);
+    ASSERT_FLOAT_EQ(rmc->timestamp, 72705.0f);
+    ASSERT_EQ(rmc->status, 'A');
+    ASSERT_FLOAT_EQ(rmc->latitude, 57.0529f);
+    ASSERT_FLOAT_EQ(rmc->longitude, 9.915765f);
+    ASSERT_EQ(rmc->latitude_e7, 570529000);
+    ASSERT_EQ(rmc->longitude_e7, 99157650);
+    ASSERT_FLOAT_EQ(rmc->speed, 0.0f);
+    ASSERT_FLOAT_EQ(rmc->course, 90.87f);
+    ASSERT_EQ(rmc->date, 41118u);
+    ASSERT_FLOAT_EQ(rmc->magnetic_variation, 0.0f);
+    ASSERT_EQ(rmc->mode, 'A');
+    ASSERT_EQ(rmc->navigational_status, '\0');
+
+    /* The convenience overload only populates RMC data */
+    RMCData data;
+    ASSERT_TRUE(EasyNmeaCoder::decode(sentence, data));
+    ASSERT_EQ(data, *rmc);
+    GPGGAData gpgga;
+    ASSERT_FALSE(EasyNmeaCoder::decode(sentence, gpgga));
+
+    /* The indexed path decodes RMC sentences as well */
+    IndexedSentence index;
+    ASSERT_EQ(StructuralIndex::build(sentence, &index, 1), 1u);
+    ASSERT_EQ(EasyNmeaCoder::decode(sentence, index).kind(), NMEA0183DataKind::RMC);
+}
+
+TEST(EasyNmeaCoderTests, decodeRMCVersions)
+{
+    auto with_checksum = [](std::string body)
+            {
+                char checksum[4];
+                std::snprintf(checksum, sizeof(checksum), "*%02X", Checksum::compute(body.data() + 1, body.size() - 1));
+                return body + checksum;
+            };
+
+    /* NMEA 0183 2.2: no mode indicator, and a receiver without fix leaves the position empty */
+    RMCData rmc;
+    ASSERT_TRUE(EasyNmeaCoder::decode(with_checksum("$GPRMC,001225,V,,,,,,,280606,,"), rmc));
+    ASSERT_EQ(rmc.status, 'V');
+    ASSERT_EQ(rmc.latitude_e7, 0);
+    ASSERT_EQ(rmc.longitude_e7, 0);
+    ASSERT_FLOAT_EQ(rmc.speed, -1.0f);
+    ASSERT_FLOAT_EQ(rmc.course, -1.0f);
+    ASSERT_EQ(rmc.date, 280606u);
+    ASSERT_EQ(rmc.mode, '\0');
+
+    /* NMEA 0183 2.2 with magnetic variation */
+    ASSERT_TRUE(EasyNmeaCoder::decode(
+                with_checksum("$GPRMC,123519,A,4807.038,S,01131.000,W,022.4,084.4,230394,003.1,W"), rmc));
+    ASSERT_EQ(rmc.latitude_e7, -481173000);
+    ASSERT_EQ(rmc.longitude_e7, -115166667);
+    ASSERT_FLOAT_EQ(rmc.speed, 22.4f);
+    ASSERT_FLOAT_EQ(rmc.course, 84.4f);
+    ASSERT_FLOAT_EQ(rmc.magnetic_variation, -3.1f);
+    ASSERT_EQ(rmc.mode, '\0');
+
+    /* NMEA 0183 4.1: mode indicator and navigational status */
+    ASSERT_TRUE(EasyNmeaCoder::decode(
+                with_checksum("$GNRMC,123519.00,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,E,D,S"), rmc));
+    ASSERT_FLOAT_EQ(rmc.magnetic_variation, 3.1f);
+    ASSERT_EQ(rmc.mode, 'D');
+    ASSERT_EQ(rmc.navigational_status, 'S');
+
+    /* Invalid sentences */
+    const std::vector<std::string> invalid = {
+        with_checksum("$GNRMC,123519,X,4807.038,N,01131.000,E,022.4,084.4,230394,,,A"),   // Status
+        with_checksum("$GNRMC,123519,A,4807.038,,01131.000,E,022.4,084.4,230394,,,A"),    // Latitude bearing
+        with_checksum("$GNRMC,123519,A,,N,01131.000,E,022.4,084.4,230394,,,A"),           // Half empty latitude
+        with_checksum("$GNRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,320394,,,A"),   // Day
+        with_checksum("$GNRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,231394,,,A"),   // Month
+        with_checksum("$GNRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,230394,,,X"),   // Mode
+        with_checksum("$GNRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,230394,,,A,"),  // Trailing separator
+        with_checksum("$GNRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,230394,,,A,S,") // Extra field
+    };
+    for (const std::string& sentence : invalid)
+    {
+        DecodeResult result = EasyNmeaCoder::decode(sentence);
+        ASSERT_EQ(result.kind(), NMEA0183DataKind::INVALID) << sentence;
+        ASSERT_EQ(result.error(), DecodeError::INVALID_FIELDS) << sentence;
+    }
+}
+
+TEST(EasyNmeaCoderTests, decodeRMCMatchesRegex)
+{
+    /* The decoder accepts a mutated RMC sentence if and only if it matches nmea0183::RMC_REGEX */
+    const std::vector<std::string> bodies = {
+        "$GNRMC,072705.000,A,5703.1740,N,00954.9459,E,0.00,90.87,041118,,,A",
+        "$GPRMC,001225,V,,,,,,,280606,,",
+        "$GNRMC,123519.00,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W,D,S",
+        "$GPRMC,235959,A,90.00,S,180.0,W,1.5,,311299,,"
+    };
+    const std::string alphabet = "0123456789.,-NSEWAVDRMC*";
+    expect_decoder_matches_regex(bodies, alphabet, nmea0183::RMC_REGEX, NMEA0183DataKind::RMC);
+}
+
+TEST(EasyNmeaCoderTests, encodeRMC)
+{
+    const std::vector<std::string> sentences = {
+        "$GNRMC,072705.000,A,5703.1740,N,00954.9459,E,0.00,90.87,041118,,,A*46",
+        "$GPRMC,001225,V,,,,,,,280606,,*3F",
+    };
+    for (const std::string& sentence : sentences)
+    {
+        RMCData rmc;
+        ASSERT_TRUE(EasyNmeaCoder::decode(sentence, rmc)) << sentence;
+
+        char buffer[128];
+        std::size_t size = EasyNmeaCoder::encode(rmc, buffer, sizeof(buffer));
+        ASSERT_GT(size, 0u) << sentence;
+
+        RMCData decoded;
+        ASSERT_TRUE(EasyNmeaCoder::decode(std::string_view(buffer, size), decoded)) << std::string(buffer, size);
+        ASSERT_EQ(decoded, rmc) << std::string(buffer, size);
+    }
+
+    /* The navigational status cannot be written without a mode indicator */
+    RMCData rmc;
+    rmc.navigational_status = 'S';
+    char buffer[128];
+    ASSERT_EQ(EasyNmeaCoder::encode(rmc, buffer, sizeof(buffer)), 0u);
+    rmc.mode = 'A';
+    ASSERT_GT(EasyNmeaCoder::encode(rmc, buffer, sizeof(buffer)), 0u);
+}
+
+TEST(EasyNmeaCoderTests, decodeBatchOtherKinds)
+{
+    /* Only GPGGA samples fit in the columns, so the rest are reported as unsupported */
+    std::string buffer =
+            "$GNRMC,072705.000,A,5703.1740,N,00954.9459,E,0.00,90.87,041118,,,A*46\r\n"
+            "$GPGGA,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,,*46\r\n";
+    float timestamps[2];
+    GPGGAColumns columns;
+    columns.capacity = 2;
+    columns.timestamp = timestamps;
+    DecodeError status[2];
+
+    BatchResult batch = EasyNmeaCoder::decode_batch(buffer, columns, status, 2);
+    ASSERT_EQ(batch.lines, 2u);
+    ASSERT_EQ(batch.rows, 1u);
+    ASSERT_EQ(status[0], DecodeError::UNSUPPORTED_SENTENCE);
+    ASSERT_EQ(status[1], DecodeError::NONE);
+}
+
+TEST(EasyNmeaCoderTests, decodeGSV)
+{
+    /* Each GSV sentence is decoded into the part of its group that it carries */
+    DecodeResult result = EasyNmeaCoder::decode(
+        "$GPGSV,4,2,15,11,36,278,15,20,32,060,16,01,22,265,,32,20,127,17*74");
+    ASSERT_EQ(result.error(), DecodeError::NONE);
+    ASSERT_EQ(result.kind(), NMEA0183DataKind::GSV);
+    const GSVPart* gsv = result.get<GSVPart>();
+    ASSERT_NE(gsv, nullptr);
+    ASSERT_EQ(gsv->talker, NMEA0183Talker::GP);
+    ASSERT_EQ(gsv->total_parts, 4u);
+    ASSERT_EQ(gsv->part_number, 2u);
+    ASSERT_EQ(gsv->satellites_in_view, 15u);
+    ASSERT_EQ(gsv->signal_id, '\0');
+    ASSERT_EQ(gsv->satellite_count, 4u);
+    ASSERT_EQ(gsv->satellites[0].prn, 11u);
+    ASSERT_EQ(gsv->satellites[0].elevation, 36);
+    ASSERT_EQ(gsv->satellites[0].azimuth, 278);
+    ASSERT_EQ(gsv->satellites[0].snr, 15);
+    ASSERT_EQ(gsv->satellites[2].prn, 1u);
+    ASSERT_EQ(gsv->satellites[2].snr, -1);
+
+    /* Last part of a group, with less than four satellites */
+    result = EasyNmeaCoder::decode("$GLGSV,3,3,09,76,06,014,*5E");
+    gsv = result.get<GSVPart>();
+    ASSERT_NE(gsv, nullptr);
+    ASSERT_EQ(gsv->talker, NMEA0183Talker::GL);
+    ASSERT_EQ(gsv->satellite_count, 1u);
+    ASSERT_EQ(gsv->satellites[0].prn, 76u);
+    ASSERT_EQ(gsv->satellites[0].snr, -1);
+
+    /* Satellites without position, and signal ID of NMEA 0183 4.10 */
+    result = EasyNmeaCoder::decode("$GPGSV,2,2,07,20,10,180,30,25,,,,29,77,300,45,1*64");
+    gsv = result.get<GSVPart>();
+    ASSERT_NE(gsv, nullptr);
+    ASSERT_EQ(gsv->signal_id, '1');
+    ASSERT_EQ(gsv->satellite_count, 3u);
+    ASSERT_EQ(gsv->satellites[1].prn, 25u);
+    ASSERT_EQ(gsv->satellites[1].elevation, -1);
+    ASSERT_EQ(gsv->satellites[1].azimuth, -1);
+
+    /* No satellites in view */
+    result = EasyNmeaCoder::decode("$GPGSV,1,1,00*79");
+    gsv = result.get<GSVPart>();
+    ASSERT_NE(gsv, nullptr);
+    ASSERT_EQ(gsv->satellites_in_view, 0u);
+    ASSERT_EQ(gsv->satellite_count, 0u);
+}
+
+TEST(EasyNmeaCoderTests, decodeGSVMatchesRegex)
+{
+    /* The decoder accepts a mutated GSV sentence if and only if it matches nmea0183::GSV_REGEX */
+    const std::vector<std::string> bodies = {
+        "$GPGSV,4,1,15,08,73,227,31,10,57,079,18,27,53,156,26,18,49,264,32",
+        "$GLGSV,3,3,09,76,06,014,",
+        "$GPGSV,2,2,07,20,10,180,30,25,,,,29,77,300,45,1",
+        "$GAGSV,1,1,01,05,45,090,35,7",
+        "$GPGSV,1,1,00"
+    };
+    const std::string alphabet = "0123456789ABF,.-GSV*";
+    expect_decoder_matches_regex(bodies, alphabet, nmea0183::GSV_REGEX, NMEA0183DataKind::GSV);
+}
+
+TEST(EasyNmeaCoderTests, decodeGSA)
+{
+    /* Each GSA sentence is decoded into the part of its epoch that it carries */
+    DecodeResult result = EasyNmeaCoder::decode("$GNGSA,A,3,10,18,27,08,11,,,,,,,,2.19,1.97,0.95*10");
+    ASSERT_EQ(result.error(), DecodeError::NONE);
+    ASSERT_EQ(result.kind(), NMEA0183DataKind::GSA);
+    const GSAPart* gsa = result.get<GSAPart>();
+    ASSERT_NE(gsa, nullptr);
+    ASSERT_EQ(gsa->talker, NMEA0183Talker::GN);
+    ASSERT_EQ(gsa->selection_mode, 'A');
+    ASSERT_EQ(gsa->fix_type, 3u);
+    ASSERT_EQ(gsa->prn_count, 5u);
+    const uint16_t prns[] = {10, 18, 27, 8, 11};
+    for (std::size_t i = 0; i < gsa->prn_count; i++)
+    {
+        ASSERT_EQ(gsa->prns[i], prns[i]) << i;
+    }
+    ASSERT_FLOAT_EQ(gsa->pdop, 2.19f);
+    ASSERT_FLOAT_EQ(gsa->hdop, 1.97f);
+    ASSERT_FLOAT_EQ(gsa->vdop, 0.95f);
+    ASSERT_EQ(gsa->system_id, '\0');
+
+    /* Every PRN field in use, and system ID of NMEA 0183 4.10 */
+    result = EasyNmeaCoder::decode("$GNGSA,A,3,01,02,03,04,05,06,07,08,09,10,11,12,1.0,0.8,0.6,3*3F");
+    gsa = result.get<GSAPart>();
+    ASSERT_NE(gsa, nullptr);
+    ASSERT_EQ(gsa->prn_count, 12u);
+    ASSERT_EQ(gsa->prns[11], 12u);
+    ASSERT_EQ(gsa->system_id, '3');
+
+    /* No satellites nor dilutions of precision */
+    result = EasyNmeaCoder::decode("$GPGSA,M,2,,,,,,,,,,,,,,,*11");
+    gsa = result.get<GSAPart>();
+    ASSERT_NE(gsa, nullptr);
+    ASSERT_EQ(gsa->selection_mode, 'M');
+    ASSERT_EQ(gsa->fix_type, 2u);
+    ASSERT_EQ(gsa->prn_count, 0u);
+    ASSERT_FLOAT_EQ(gsa->pdop, -1.0f);
+    ASSERT_FLOAT_EQ(gsa->hdop, -1.0f);
+    ASSERT_FLOAT_EQ(gsa->vdop, -1.0f);
+}
+
+TEST(EasyNmeaCoderTests, decodeGSAMatchesRegex)
+{
+    /* The decoder accepts a mutated GSA sentence if and only if it matches nmea0183::GSA_REGEX */
+    const std::vector<std::string> bodies = {
+        "$GNGSA,A,3,10,18,27,08,11,,,,,,,,2.19,1.97,0.95",
+        "$GNGSA,A,3,01,02,03,04,05,06,07,08,09,10,11,12,1.0,0.8,0.6,3",
+        "$GPGSA,M,2,,,,,,,,,,,,,,,",
+        "$GPGSA,A,1,,,,,,,,,,,,,99.99,99.99,99.99"
+    };
+    const std::string alphabet = "0123456789ABF,.-MGS*";
+    expect_decoder_matches_regex(bodies, alphabet, nmea0183::GSA_REGEX, NMEA0183DataKind::GSA);
+}
+
+TEST(EasyNmeaCoderTests, decodeVDM)
+{
+    /* Each VDM sentence is decoded into the fragment of its AIS message that it carries */
+    DecodeResult result = EasyNmeaCoder::decode(
+        "!AIVDM,2,1,3,B,55P5TL01VIaAL@7WKO@mBplU@<PDhh000000001S;AJ::4A80?4i@E53,0*3E");
+    ASSERT_EQ(result.error(), DecodeError::NONE);
+    ASSERT_EQ(result.kind(), NMEA0183DataKind::AIS);
+    const AISFragment* vdm = result.get<AISFragment>();
+    ASSERT_NE(vdm, nullptr);
+    ASSERT_EQ(vdm->talker, NMEA0183Talker::AI);
+    ASSERT_EQ(vdm->fragment_count, 2u);
+    ASSERT_EQ(vdm->fragment_number, 1u);
+    ASSERT_EQ(vdm->sequence_id, 3);
+    ASSERT_EQ(vdm->channel, 'B');
+    ASSERT_FALSE(vdm->own_ship);
+    ASSERT_EQ(vdm->fill_bits, 0u);
+    ASSERT_EQ(vdm->sextet_count, 56u);
+    // The payload is unarmored: '5' -> 5, '@' -> 16, 'h' -> 48
+    ASSERT_EQ(vdm->sextets[0], 5u);
+    ASSERT_EQ(vdm->sextets[13], 16u);
+    ASSERT_EQ(vdm->sextets[28], 48u);
+
+    /* Single fragment messages without sequential message ID */
+    result = EasyNmeaCoder::decode("!AIVDM,1,1,,A,15RTgt0PAso;90TKcjM8h6g208CQ,0*4A");
+    vdm = result.get<AISFragment>();
+    ASSERT_NE(vdm, nullptr);
+    ASSERT_EQ(vdm->sequence_id, -1);
+    ASSERT_EQ(vdm->channel, 'A');
+    ASSERT_EQ(vdm->sextet_count, 28u);
+
+    /* Messages of the own station, without channel, and from other AIS talkers */
+    result = EasyNmeaCoder::decode("!AIVDO,1,1,,,B5NJ;PP005l4ot5Isbl03wsUkP06,0*35");
+    vdm = result.get<AISFragment>();
+    ASSERT_NE(vdm, nullptr);
+    ASSERT_TRUE(vdm->own_ship);
+    ASSERT_EQ(vdm->channel, '\0');
+    result = EasyNmeaCoder::decode("!BSVDM,1,1,,2,13u?etPv2;0n:dDPwUM1U1Cb069D,0*4E");
+    vdm = result.get<AISFragment>();
+    ASSERT_NE(vdm, nullptr);
+    ASSERT_EQ(vdm->talker, NMEA0183Talker::BS);
+    ASSERT_EQ(vdm->channel, '2');
+
+    /* The last fragment reports the fill bits */
+    result = EasyNmeaCoder::decode("!AIVDM,2,2,3,B,1@0000000000000,2*55");
+    vdm = result.get<AISFragment>();
+    ASSERT_NE(vdm, nullptr);
+    ASSERT_EQ(vdm->fill_bits, 2u);
+
+    /* GNSS talkers are not accepted in AIS sentences, nor AIS talkers in the rest */
+    ASSERT_EQ(EasyNmeaCoder::decode("!GPVDM,1,1,,A,15RTgt0PAso;90TKcjM8h6g208CQ,0*55").error(),
+            DecodeError::UNSUPPORTED_SENTENCE);
+    ASSERT_EQ(EasyNmeaCoder::decode("$AIGGA,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,2.2,7854,*55")
+            .error(), DecodeError::UNSUPPORTED_SENTENCE);
+
+    /* Sentences indexed with StructuralIndex are decoded in the same way */
+    std::string buffer =
+            "!AIVDM,2,1,3,B,55P5TL01VIaAL@7WKO@mBplU@<PDhh000000001S;AJ::4A80?4i@E53,0*3E\r\n"
+            "!AIVDM,2,2,3,B,1@0000000000000,2*55\r\n";
+    IndexedSentence index[2];
+    ASSERT_EQ(StructuralIndex::build(buffer, index, 2), 2u);
+    result = EasyNmeaCoder::decode(buffer, index[1]);
+    vdm = result.get<AISFragment>();
+    ASSERT_NE(vdm, nullptr);
+    ASSERT_EQ(vdm->fragment_number, 2u);
+    ASSERT_EQ(vdm->sextet_count, 15u);
+}
+
+TEST(EasyNmeaCoderTests, decodeVDMMatchesRegex)
+{
+    /* The decoder accepts a mutated VDM or VDO sentence if and only if it matches nmea0183::VDM_REGEX */
+    const std::vector<std::string> bodies = {
+        "!AIVDM,2,1,3,B,55P5TL01VIaAL@7WKO@mBplU@<PDhh000000001S;AJ::4A80?4i@E53,0",
+        "!AIVDM,2,2,3,B,1@0000000000000,2",
+        "!AIVDM,1,1,,A,15RTgt0PAso;90TKcjM8h6g208CQ,0",
+        "!AIVDO,1,1,,,B5NJ;PP005l4ot5Isbl03wsUkP06,0",
+        "!BSVDM,1,1,,2,13u?etPv2;0n:dDPwUM1U1Cb069D,0"
+    };
+    const std::string alphabet = "0123456789ABIMOVDWXw`_@,.-*!";
+    /* The '!' is skipped by the mutations and the checksum, as the '$' of the other sentences */
+    expect_decoder_matches_regex(bodies, alphabet, nmea0183::VDM_REGEX, NMEA0183DataKind::AIS, 1);
+
+    /* The payload of a single sentence is at most 64 characters long */
+    std::regex vdm_regex(nmea0183::VDM_REGEX);
+    std::string payload(64, 'w');
+    std::string body = "!AIVDM,1,1,,A," + payload + ",0";
+    char checksum_str[4];
+    std::snprintf(checksum_str, sizeof(checksum_str), "*%02X", Checksum::compute(body.data() + 1, body.size() - 1));
+    ASSERT_TRUE(std::regex_match(body + checksum_str, vdm_regex));
+    ASSERT_EQ(EasyNmeaCoder::decode(body + checksum_str).kind(), NMEA0183DataKind::AIS);
+    body = "!AIVDM,1,1,,A," + payload + "w,0";
+    std::snprintf(checksum_str, sizeof(checksum_str), "*%02X", Checksum::compute(body.data() + 1, body.size() - 1));
+    ASSERT_FALSE(std::regex_match(body + checksum_str, vdm_regex));
+    ASSERT_EQ(EasyNmeaCoder::decode(body + checksum_str).error(), DecodeError::INVALID_FIELDS);
+}
+
+TEST(EasyNmeaCoderTests, decodeTagBlock)
+{
+    const std::string gpgga = "$GPGGA,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,2.2,7854,*4a";
+
+    /* The source and the time of the tag block are attached to the decoded data */
+    DecodeResult result = EasyNmeaCoder::decode("\\s:GPS1,c:1609459200*4D\\" + gpgga);
+    ASSERT_EQ(result.error(), DecodeError::NONE);
+    const GPGGAData* data = result.get<GPGGAData>();
+    ASSERT_NE(data, nullptr);
+    ASSERT_STREQ(data->tag_block.source, "GPS1");
+    ASSERT_EQ(data->tag_block.unix_time_ms, 1609459200000);
+    ASSERT_FLOAT_EQ(data->timestamp, 72705);
+
+    /* The rest of the data is the same as without tag block, which yields an empty one */
+    GPGGAData untagged = *EasyNmeaCoder::decode(gpgga).get<GPGGAData>();
+    ASSERT_TRUE(untagged.tag_block.empty());
+    untagged.tag_block = data->tag_block;
+    ASSERT_EQ(*data, untagged);
+
+    /* Times of more than 10 digits are in milliseconds, and other parameters are skipped */
+    result = EasyNmeaCoder::decode("\\c:1609459200123*6D\\" + gpgga);
+    ASSERT_NE(result.get<GPGGAData>(), nullptr);
+    ASSERT_STREQ(result.get<GPGGAData>()->tag_block.source, "");
+    ASSERT_EQ(result.get<GPGGAData>()->tag_block.unix_time_ms, 1609459200123);
+    result = EasyNmeaCoder::decode("\\g:1-2-73874,n:123,s:r003669945,c:1241544035*7C\\" + gpgga);
+    ASSERT_NE(result.get<GPGGAData>(), nullptr);
+    ASSERT_STREQ(result.get<GPGGAData>()->tag_block.source, "r003669945");
+    ASSERT_EQ(result.get<GPGGAData>()->tag_block.unix_time_ms, 1241544035000);
+    result = EasyNmeaCoder::decode("\\s:Receiver1234567*40\\" + gpgga);
+    ASSERT_NE(result.get<GPGGAData>(), nullptr);
+    ASSERT_STREQ(result.get<GPGGAData>()->tag_block.source, "Receiver1234567");
+
+    /* Tag blocks are also attached to encapsulation sentences */
+    result = EasyNmeaCoder::decode("\\s:GPS1,c:1609459200*4D\\!AIVDM,1,1,,A,15RTgt0PAso;90TKcjM8h6g208CQ,0*4A");
+    ASSERT_NE(result.get<AISFragment>(), nullptr);
+    ASSERT_STREQ(result.get<AISFragment>()->tag_block.source, "GPS1");
+
+    /* Tag blocks with incorrect checksum, too long sources, or bad framing are rejected */
+    ASSERT_EQ(EasyNmeaCoder::decode("\\s:GPS1,c:1609459200*4E\\" + gpgga).error(), DecodeError::INVALID_TAG_BLOCK);
+    ASSERT_EQ(EasyNmeaCoder::decode("\\s:Receiver12345678*78\\" + gpgga).error(), DecodeError::INVALID_TAG_BLOCK);
+    ASSERT_EQ(EasyNmeaCoder::decode("\\s:GPS1,c:1609459200*4D" + gpgga).error(), DecodeError::INVALID_TAG_BLOCK);
+    ASSERT_EQ(EasyNmeaCoder::decode("\\" + gpgga).error(), DecodeError::INVALID_TAG_BLOCK);
+
+    /* The sentence is still checked after a valid tag block */
+    ASSERT_EQ(EasyNmeaCoder::decode("\\s:GPS1*3C\\" + gpgga.substr(0, gpgga.size() - 2) + "4b").error(),
+            DecodeError::INVALID_CHECKSUM);
+    ASSERT_EQ(EasyNmeaCoder::decode("\\s:GPS1*3C\\").error(), DecodeError::INVALID_SENTENCE);
+
+    /* Sentences indexed with StructuralIndex are decoded in the same way */
+    std::string buffer =
+            "\\s:GPS1,c:1609459200*4D\\" + gpgga + "\r\n" +
+            "noise\\c:1609459200123*6D\\" + gpgga + "\r\n" +
+            "\\s:GPS1,c:1609459200*4E\\" + gpgga + "\r\n" +
+            gpgga + "\r\n";
+    IndexedSentence index[4];
+    ASSERT_EQ(StructuralIndex::build(buffer, index, 4), 4u);
+    result = EasyNmeaCoder::decode(buffer, index[0]);
+    ASSERT_NE(result.get<GPGGAData>(), nullptr);
+    ASSERT_STREQ(result.get<GPGGAData>()->tag_block.source, "GPS1");
+    ASSERT_EQ(result.get<GPGGAData>()->tag_block.unix_time_ms, 1609459200000);
+    result = EasyNmeaCoder::decode(buffer, index[1]);
+    ASSERT_NE(result.get<GPGGAData>(), nullptr);
+    ASSERT_EQ(result.get<GPGGAData>()->tag_block.unix_time_ms, 1609459200123);
+    ASSERT_EQ(EasyNmeaCoder::decode(buffer, index[2]).error(), DecodeError::INVALID_TAG_BLOCK);
+    result = EasyNmeaCoder::decode(buffer, index[3]);
+    ASSERT_NE(result.get<GPGGAData>(), nullptr);
+    ASSERT_TRUE(result.get<GPGGAData>()->tag_block.empty());
+}
+
+TEST(EasyNmeaCoderTests, decodeTagBlockMatchesRegex)
+{
+    /* The decoder accepts a sentence behind a mutated tag block if and only if the tag block matches
+       nmea0183::TAG_BLOCK_REGEX. The checksum of a tag block covers all of its characters */
+    const std::string gpgga = "$GPGGA,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,2.2,7854,*4a";
+    const std::vector<std::string> bodies = {
+        "s:GPS1,c:1609459200",
+        "c:1609459200123",
+        "g:1-2-73874,n:123,s:r003669945,c:1241544035",
+        "s:Receiver1234567",
+        "t:Text with spaces,d:DEST"
+    };
+    const std::string alphabet = "0123456789scdtzS: ,.-*!$\\";
+    expect_decoder_matches_regex(bodies, alphabet, nmea0183::TAG_BLOCK_REGEX, NMEA0183DataKind::GPGGA, 0,
+            [&gpgga](const std::string& checked)
+            {
+                std::string tag_block = "\\" + checked + "\\";
+                return std::make_pair(tag_block, tag_block + gpgga);
+            });
+}
+
+TEST(EasyNmeaCoderTests, encodeTagBlock)
+{
+    DecodeResult result = EasyNmeaCoder::decode(
+        "$GPGGA,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,2.2,7854,*4a");
+    GPGGAData gpgga = *result.get<GPGGAData>();
+    std::strcpy(gpgga.tag_block.source, "GPS1");
+    gpgga.tag_block.unix_time_ms = 1609459200000;
+
+    /* The tag block is written before the sentence, and it decodes into the same data */
+    char buffer[128];
+    std::size_t size = EasyNmeaCoder::encode(gpgga, buffer, sizeof(buffer));
+    std::string sentence(buffer, size);
+    ASSERT_EQ(sentence.substr(0, 25), "\\s:GPS1,c:1609459200*4D\\$");
+    result = EasyNmeaCoder::decode(sentence);
+    ASSERT_NE(result.get<GPGGAData>(), nullptr);
+    ASSERT_EQ(result.get<GPGGAData>()->tag_block, gpgga.tag_block);
+    ASSERT_EQ(EasyNmeaCoder::encode(gpgga, buffer, size - 1), 0u);
+
+    /* Times which are not a whole number of seconds are written in milliseconds */
+    gpgga.tag_block.source[0] = '\0';
+    gpgga.tag_block.unix_time_ms = 1609459200123;
+    size = EasyNmeaCoder::encode(gpgga, buffer, sizeof(buffer));
+    ASSERT_EQ(std::string(buffer, 21), "\\c:1609459200123*6D\\$");
+    ASSERT_EQ(EasyNmeaCoder::decode(std::string_view(buffer, size)).get<GPGGAData>()->tag_block, gpgga.tag_block);
+
+    /* Tag blocks which cannot be read back are not written */
+    gpgga.tag_block.unix_time_ms = 123;
+    ASSERT_EQ(EasyNmeaCoder::encode(gpgga, buffer, sizeof(buffer)), 0u);
+    gpgga.tag_block.unix_time_ms = -1;
+    std::strcpy(gpgga.tag_block.source, "GPS*1");
+    ASSERT_EQ(EasyNmeaCoder::encode(gpgga, buffer, sizeof(buffer)), 0u);
+
+    /* Data without tag block is encoded without it */
+    gpgga.tag_block = TagBlock();
+    size = EasyNmeaCoder::encode(gpgga, buffer, sizeof(buffer));
+    ASSERT_EQ(buffer[0], '$');
+}
+
+TEST(EasyNmeaCoderTests, decodeBatchTagBlock)
+{
+    const std::string gpgga = "$GPGGA,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,2.2,7854,*4a";
+    std::string buffer;
+    for (int i = 0; i < 10; i++)
+    {
+        buffer += "\\s:r1*0A\\" + gpgga + "\r\n";
+        buffer += "\\s:r2*0A\\" + gpgga + "\r\n";
+    }
+
+    /* Decode with small columns, so that decoding is resumed from tagged sentences */
+    float latitude[3];
+    GPGGAColumns columns;
+    columns.capacity = 3;
+    columns.latitude = latitude;
+    DecodeError status[16];
+
+    std::size_t offset = 0;
+    std::size_t lines = 0;
+    std::size_t rows = 0;
+    while (offset < buffer.size())
+    {
+        /* Decoding is resumed from the tag block, which is validated with its sentence */
+        ASSERT_EQ(buffer[offset], '\\');
+        BatchResult batch = EasyNmeaCoder::decode_batch(std::string_view(buffer).substr(offset), columns, status, 16);
+        ASSERT_GT(batch.lines, 0u);
+        for (std::size_t i = 0; i < batch.lines; i++)
+        {
+            ASSERT_EQ(status[i], ((lines + i) % 2) ? DecodeError::INVALID_TAG_BLOCK : DecodeError::NONE);
+        }
+        lines += batch.lines;
+        rows += batch.rows;
+        offset += batch.consumed;
+    }
+    ASSERT_EQ(lines, 20u);
+    ASSERT_EQ(rows, 10u);
+    ASSERT_EQ(offset, buffer.size());
+}
+
+//! Decoder registered for a sentence whose fields are always rejected
+DecodeResult decode_invalid(
+        std::string_view)
+{
+    return DecodeResult(DecodeError::INVALID_FIELDS);
+}
+
+TEST(EasyNmeaCoderTests, decodeRegisteredSentences)
+{
+    const std::string gpgga = "$GPGGA,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,2.2,7854,*4a";
+    const std::string pgrme = "$PGRME,15.0,M,45.0,M,25.0,M*1C";
+    const std::string pgrmt = "$PGRMT*5C";
+    const std::string pxyz = "$PXYZ,1,A*7B";
+    const std::string gpgll = "$GPGLL,5703.1740,N,00954.9459,E,072705.000,A*39";
+
+    SentenceRegistry registry;
+    ASSERT_TRUE(registry.add("PGRME", EasyNmeaCoder::passthrough));
+    ASSERT_TRUE(registry.add("PGRMT", EasyNmeaCoder::passthrough));
+    ASSERT_TRUE(registry.add("PXYZ", decode_invalid));
+    ASSERT_TRUE(registry.add("GPGGA", decode_invalid));
+
+    /* The registered sentences are handed to their decoder without logging any warning */
+    testing::internal::CaptureStdout();
+    DecodeResult result = EasyNmeaCoder::decode(pgrme, registry);
+    ASSERT_EQ(testing::internal::GetCapturedStdout(), "");
+    ASSERT_EQ(result.kind(), NMEA0183DataKind::RAW);
+    ASSERT_EQ(result.error(), DecodeError::NONE);
+    const RawSentence* raw = result.get<RawSentence>();
+    ASSERT_NE(raw, nullptr);
+    ASSERT_EQ(raw->sentence, pgrme);
+    ASSERT_EQ(raw->sentence.data(), pgrme.data());
+    ASSERT_EQ(raw->talker, NMEA0183Talker::UNKNOWN);
+    ASSERT_EQ(EasyNmeaCoder::decode(pgrmt, registry).get<RawSentence>()->sentence, pgrmt);
+    ASSERT_EQ(EasyNmeaCoder::decode(pxyz, registry).error(), DecodeError::INVALID_FIELDS);
+
+    /* The tag block is attached to the data returned by the decoder */
+    std::string tagged = "\\s:GPS1*3C\\" + pgrme;
+    result = EasyNmeaCoder::decode(tagged, registry);
+    ASSERT_NE(result.get<RawSentence>(), nullptr);
+    ASSERT_EQ(result.get<RawSentence>()->sentence, pgrme);
+    ASSERT_STREQ(result.get<RawSentence>()->tag_block.source, "GPS1");
+
+    /* The sentences are validated before being handed over, and the supported ones cannot be overridden */
+    ASSERT_EQ(EasyNmeaCoder::decode("$PGRME,15.0,M,45.0,M,25.0,M*1D", registry).error(),
+            DecodeError::INVALID_CHECKSUM);
+    ASSERT_EQ(EasyNmeaCoder::decode("$PGRME,15.0,M,45.0,M,25.0,M", registry).error(), DecodeError::INVALID_SENTENCE);
+    ASSERT_EQ(EasyNmeaCoder::decode(gpgga, registry).kind(), NMEA0183DataKind::GPGGA);
+
+    /* The rest of the unsupported sentences are reported as such, unless there is a catch-all decoder */
+    ASSERT_EQ(EasyNmeaCoder::decode(gpgll, registry).error(), DecodeError::UNSUPPORTED_SENTENCE);
+    ASSERT_EQ(EasyNmeaCoder::decode(pgrme).error(), DecodeError::UNSUPPORTED_SENTENCE);
+    ASSERT_TRUE(registry.add("", EasyNmeaCoder::passthrough));
+    result = EasyNmeaCoder::decode(gpgll, registry);
+    ASSERT_NE(result.get<RawSentence>(), nullptr);
+    ASSERT_EQ(result.get<RawSentence>()->talker, NMEA0183Talker::GP);
+    ASSERT_EQ(EasyNmeaCoder::decode(pxyz, registry).error(), DecodeError::INVALID_FIELDS);
+
+    /* The indexed sentences are handed to the same decoders */
+    const std::vector<std::string> sentences = {gpgga, pgrme, pgrmt, pxyz, gpgll, tagged};
+    std::string buffer;
+    for (const std::string& sentence : sentences)
+    {
+        buffer += sentence + "\r\n";
+    }
+    std::vector<IndexedSentence> index(sentences.size());
+    ASSERT_EQ(StructuralIndex::build(buffer, index.data(), index.size()), sentences.size());
+    for (std::size_t i = 0; i < sentences.size(); i++)
+    {
+        DecodeResult expected = EasyNmeaCoder::decode(sentences[i], registry);
+        result = EasyNmeaCoder::decode(buffer, index[i], registry);
+        ASSERT_EQ(result.kind(), expected.kind()) << sentences[i];
+        ASSERT_EQ(result.error(), expected.error()) << sentences[i];
+        if (expected.kind() == NMEA0183DataKind::RAW)
+        {
+            ASSERT_EQ(result.get<RawSentence>()->sentence, expected.get<RawSentence>()->sentence);
+            ASSERT_EQ(result.get<RawSentence>()->tag_block, expected.get<RawSentence>()->tag_block);
+            ASSERT_EQ(result.get<RawSentence>()->sentence.data(), buffer.data() + index[i].begin);
+        }
+    }
+}
+
+TEST(EasyNmeaCoderTests, passthrough)
+{
+    const std::string txt = "$GPTXT,01,01,02,ANTSTATUS=OPEN*2B";
+    DecodeResult result = EasyNmeaCoder::passthrough(txt);
+    ASSERT_EQ(result.kind(), NMEA0183DataKind::RAW);
+    ASSERT_EQ(result.get<RawSentence>()->sentence.data(), txt.data());
+    ASSERT_EQ(result.get<RawSentence>()->sentence.size(), txt.size());
+    ASSERT_EQ(result.get<RawSentence>()->talker, NMEA0183Talker::GP);
+    ASSERT_TRUE(result.get<RawSentence>()->tag_block.empty());
+
+    /* The talker is only set for the supported ones, according to the kind of sentence */
+    ASSERT_EQ(EasyNmeaCoder::passthrough("!AIABM,1,1,0,,,0*00").get<RawSentence>()->talker, NMEA0183Talker::AI);
+    ASSERT_EQ(EasyNmeaCoder::passthrough("$AIABM,1,1,0,,,0*00").get<RawSentence>()->talker, NMEA0183Talker::UNKNOWN);
+    ASSERT_EQ(EasyNmeaCoder::passthrough("$PGRMT*5C").get<RawSentence>()->talker, NMEA0183Talker::UNKNOWN);
+    ASSERT_EQ(EasyNmeaCoder::passthrough("").get<RawSentence>()->talker, NMEA0183Talker::UNKNOWN);
+}
+
+TEST(EasyNmeaCoderTests, decodeZDA)
+{
+    auto with_checksum = [](std::string body)
+            {
+                char checksum[4];
+                std::snprintf(checksum, sizeof(checksum), "*%02X", Checksum::compute(body.data() + 1, body.size() - 1));
+                return body + checksum;
+            };
+
+    /* Time and full date */
+    DecodeResult result = EasyNmeaCoder::decode(with_checksum("$GPZDA,201530.00,04,07,2002,00,00"));
+    ASSERT_EQ(result.error(), DecodeError::NONE);
+    ASSERT_EQ(result.kind(), NMEA0183DataKind::ZDA);
+    const ZDAData* zda = result.get<ZDAData>();
+    ASSERT_NE(zda, nullptr);
+    ASSERT_EQ(zda->talker, NMEA0183Talker::GP);
+    ASSERT_EQ(zda->time_of_day_ms, 72930000);
+    ASSERT_EQ(zda->day, 4u);
+    ASSERT_EQ(zda->month, 7u);
+    ASSERT_EQ(zda->year, 2002u);
+    ASSERT_EQ(zda->local_zone_hours, 0);
+    ASSERT_EQ(zda->local_zone_minutes, 0u);
+    ASSERT_EQ(zda->utc_time.time_since_epoch().count(), 1025813730000);
+
+    /* Negative local zone, and last millisecond of a year */
+    result = EasyNmeaCoder::decode(with_checksum("$GNZDA,235959.999,31,12,1999,-03,30"));
+    zda = result.get<ZDAData>();
+    ASSERT_NE(zda, nullptr);
+    ASSERT_EQ(zda->talker, NMEA0183Talker::GN);
+    ASSERT_EQ(zda->local_zone_hours, -3);
+    ASSERT_EQ(zda->local_zone_minutes, 30u);
+    ASSERT_EQ(zda->utc_time.time_since_epoch().count(), 946684799999);
+
+    /* Leap day, and a date before 1970 */
+    ASSERT_EQ(EasyNmeaCoder::decode(with_checksum("$GPZDA,000000,29,02,2024,,")).get<ZDAData>()->utc_time,
+            UtcTime(std::chrono::milliseconds(1709164800000)));
+    ASSERT_EQ(EasyNmeaCoder::decode(with_checksum("$GPZDA,000000,01,03,1900,,")).get<ZDAData>()->utc_time,
+            UtcTime(std::chrono::milliseconds(-2203891200000)));
+
+    /* Without the full date, the time point is unknown */
+    result = EasyNmeaCoder::decode(with_checksum("$GPZDA,120000,,,,,"));
+    zda = result.get<ZDAData>();
+    ASSERT_NE(zda, nullptr);
+    ASSERT_EQ(zda->time_of_day_ms, 43200000);
+    ASSERT_EQ(zda->day, 0u);
+    ASSERT_EQ(zda->utc_time, UtcTime::min());
+
+    result = EasyNmeaCoder::decode(with_checksum("$GPZDA,,04,07,2002,,"));
+    zda = result.get<ZDAData>();
+    ASSERT_NE(zda, nullptr);
+    ASSERT_EQ(zda->time_of_day_ms, -1);
+    ASSERT_EQ(zda->utc_time, UtcTime::min());
+
+    /* Time out of range */
+    result = EasyNmeaCoder::decode(with_checksum("$GPZDA,250000,04,07,2002,,"));
+    zda = result.get<ZDAData>();
+    ASSERT_NE(zda, nullptr);
+    ASSERT_EQ(zda->time_of_day_ms, -1);
+    ASSERT_EQ(zda->utc_time, UtcTime::min());
+}
+
+TEST(EasyNmeaCoderTests, decodeZDAMatchesRegex)
+{
+    /* The decoder accepts a mutated ZDA sentence if and only if it matches nmea0183::ZDA_REGEX */
+    const std::vector<std::string> bodies = {
+        "$GPZDA,201530.00,04,07,2002,00,00",
+        "$GNZDA,235959.999,31,12,1999,-13,59",
+        "$GPZDA,,,,,,",
+        "$GLZDA,000000,10,10,2020,10,"
+    };
+    const std::string alphabet = "0123456789,.-GZDA*";
+    expect_decoder_matches_regex(bodies, alphabet, nmea0183::ZDA_REGEX, NMEA0183DataKind::ZDA);
+}
+
+TEST(EasyNmeaCoderTests, decodeTimeOfDay)
+{
+    auto with_checksum = [](std::string body)
+            {
+                char checksum[4];
+                std::snprintf(checksum, sizeof(checksum), "*%02X", Checksum::compute(body.data() + 1, body.size() - 1));
+                return body + checksum;
+            };
+
+    /* The time of day is exact where the float timestamp is not */
+    GPGGAData gpgga;
+    ASSERT_TRUE(EasyNmeaCoder::decode(
+                with_checksum("$GPGGA,235959.999,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,,"), gpgga));
+    ASSERT_EQ(gpgga.time_of_day_ms, 86399999);
+    ASSERT_NE(static_cast<double>(gpgga.timestamp), 235959.999);
+
+    /* GGA sentences do not report the date */
+    ASSERT_EQ(gpgga.utc_time, UtcTime::min());
+
+    /* Times out of range are accepted, as by the regular expression, but they are not translated */
+    ASSERT_TRUE(EasyNmeaCoder::decode(
+                with_checksum("$GPGGA,246000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,,"), gpgga));
+    ASSERT_EQ(gpgga.time_of_day_ms, -1);
+
+    /* RMC sentences report the date, whose two-digit year is in [1980; 2079] */
+    RMCData rmc;
+    ASSERT_TRUE(EasyNmeaCoder::decode("$GNRMC,072705.000,A,5703.1740,N,00954.9459,E,0.00,90.87,041118,,,A*46", rmc));
+    ASSERT_EQ(rmc.time_of_day_ms, 26825000);
+    ASSERT_EQ(rmc.utc_time.time_since_epoch().count(), 1541316425000);
+    ASSERT_TRUE(EasyNmeaCoder::decode(with_checksum("$GPRMC,120000,V,,,,,,,311299,,"), rmc));
+    ASSERT_EQ(rmc.utc_time.time_since_epoch().count(), 946641600000);
+
+    /* RMC sentences without a date do not have a time point */
+    ASSERT_TRUE(EasyNmeaCoder::decode(with_checksum("$GPRMC,120000,V,,,,,,,,,"), rmc));
+    ASSERT_EQ(rmc.time_of_day_ms, 43200000);
+    ASSERT_EQ(rmc.utc_time, UtcTime::min());
+}
+
+TEST(EasyNmeaCoderTests, decodeHeading)
+{
+    auto with_checksum = [](std::string body)
+            {
+                char checksum[4];
+                std::snprintf(checksum, sizeof(checksum), "*%02X", Checksum::compute(body.data() + 1, body.size() - 1));
+                return body + checksum;
+            };
+
+    /* HDT */
+    DecodeResult result = EasyNmeaCoder::decode(with_checksum("$GPHDT,274.07,T"));
+    ASSERT_EQ(result.error(), DecodeError::NONE);
+    ASSERT_EQ(result.kind(), NMEA0183DataKind::HDT);
+    const HDTData* hdt = result.get<HDTData>();
+    ASSERT_NE(hdt, nullptr);
+    ASSERT_EQ(hdt->talker, NMEA0183Talker::GP);
+    ASSERT_FLOAT_EQ(hdt->heading, 274.07f);
+
+    /* HDT without heading, e.g. before the receiver resolves it */
+    result = EasyNmeaCoder::decode(with_checksum("$GNHDT,,T"));
+    hdt = result.get<HDTData>();
+    ASSERT_NE(hdt, nullptr);
+    ASSERT_EQ(hdt->talker, NMEA0183Talker::GN);
+    ASSERT_EQ(hdt->heading, -1.0f);
+
+    /* THS */
+    result = EasyNmeaCoder::decode(with_checksum("$GNTHS,359.99,A"));
+    ASSERT_EQ(result.kind(), NMEA0183DataKind::THS);
+    const THSData* ths = result.get<THSData>();
+    ASSERT_NE(ths, nullptr);
+    ASSERT_EQ(ths->talker, NMEA0183Talker::GN);
+    ASSERT_FLOAT_EQ(ths->heading, 359.99f);
+    ASSERT_EQ(ths->mode, 'A');
+
+    result = EasyNmeaCoder::decode(with_checksum("$GPTHS,,V"));
+    ths = result.get<THSData>();
+    ASSERT_NE(ths, nullptr);
+    ASSERT_EQ(ths->heading, -1.0f);
+    ASSERT_EQ(ths->mode, 'V');
+
+    /* ROT, turning to port and to starboard */
+    result = EasyNmeaCoder::decode(with_checksum("$GPROT,-12.5,A"));
+    ASSERT_EQ(result.kind(), NMEA0183DataKind::ROT);
+    const ROTData* rot = result.get<ROTData>();
+    ASSERT_NE(rot, nullptr);
+    ASSERT_FLOAT_EQ(rot->rate_of_turn, -12.5f);
+    ASSERT_EQ(rot->status, 'A');
+
+    result = EasyNmeaCoder::decode(with_checksum("$GPROT,3.0,V"));
+    rot = result.get<ROTData>();
+    ASSERT_NE(rot, nullptr);
+    ASSERT_FLOAT_EQ(rot->rate_of_turn, 3.0f);
+    ASSERT_EQ(rot->status, 'V');
+
+    /* Invalid fields */
+    ASSERT_EQ(EasyNmeaCoder::decode(with_checksum("$GPHDT,274.07,M")).error(), DecodeError::INVALID_FIELDS);
+    ASSERT_EQ(EasyNmeaCoder::decode(with_checksum("$GPHDT,-274.07,T")).error(), DecodeError::INVALID_FIELDS);
+    ASSERT_EQ(EasyNmeaCoder::decode(with_checksum("$GPTHS,274.07,D")).error(), DecodeError::INVALID_FIELDS);
+    ASSERT_EQ(EasyNmeaCoder::decode(with_checksum("$GPROT,12,A")).error(), DecodeError::INVALID_FIELDS);
+    ASSERT_EQ(EasyNmeaCoder::decode(with_checksum("$GPROT,12.0")).error(), DecodeError::INVALID_FIELDS);
+}
+
+TEST(EasyNmeaCoderTests, decodeHeadingMatchesRegex)
+{
+    /* The decoder accepts a mutated HDT, THS, or ROT sentence as its kind if and only if it matches the
+       regular expression of the kind */
+    const std::string alphabet = "0123456789,.-HDTSROAEMV*";
+    expect_decoder_matches_regex({"$GPHDT,274.07,T", "$GNHDT,,T"}, alphabet, nmea0183::HDT_REGEX,
+            NMEA0183DataKind::HDT);
+    expect_decoder_matches_regex({"$GPTHS,359.99,A", "$GLTHS,,V"}, alphabet, nmea0183::THS_REGEX,
+            NMEA0183DataKind::THS);
+    expect_decoder_matches_regex({"$GPROT,-12.5,A", "$GNROT,0.0,V"}, alphabet, nmea0183::ROT_REGEX,
+            NMEA0183DataKind::ROT);
+}
+
+TEST(EasyNmeaCoderTests, decodeGST)
+{
+    auto with_checksum = [](std::string body)
+            {
+                char checksum[4];
+                std::snprintf(checksum, sizeof(checksum), "*%02X", Checksum::compute(body.data() + 1, body.size() - 1));
+                return body + checksum;
+            };
+
+    /* All the statistics */
+    DecodeResult result = EasyNmeaCoder::decode(with_checksum("$GPGST,172814.0,0.006,0.023,0.020,273.6,0.023,0.020,0.031"));
+    ASSERT_EQ(result.error(), DecodeError::NONE);
+    ASSERT_EQ(result.kind(), NMEA0183DataKind::GST);
+    const GSTData* gst = result.get<GSTData>();
+    ASSERT_NE(gst, nullptr);
+    ASSERT_EQ(gst->talker, NMEA0183Talker::GP);
+    ASSERT_EQ(gst->time_of_day_ms, 62894000);
+    ASSERT_FLOAT_EQ(gst->rms, 0.006f);
+    ASSERT_FLOAT_EQ(gst->semi_major_error, 0.023f);
+    ASSERT_FLOAT_EQ(gst->semi_minor_error, 0.020f);
+    ASSERT_FLOAT_EQ(gst->semi_major_orientation, 273.6f);
+    ASSERT_FLOAT_EQ(gst->latitude_error, 0.023f);
+    ASSERT_FLOAT_EQ(gst->longitude_error, 0.020f);
+    ASSERT_FLOAT_EQ(gst->altitude_error, 0.031f);
+
+    /* GST sentences do not report the date */
+    ASSERT_EQ(gst->utc_time, UtcTime::min());
+
+    /* Receivers which do not compute the error ellipse leave it empty */
+    result = EasyNmeaCoder::decode(with_checksum("$GNGST,082356.00,1.8,,,,1.7,1.3,2.2"));
+    gst = result.get<GSTData>();
+    ASSERT_NE(gst, nullptr);
+    ASSERT_EQ(gst->talker, NMEA0183Talker::GN);
+    ASSERT_FLOAT_EQ(gst->rms, 1.8f);
+    ASSERT_EQ(gst->semi_major_error, -1);
+    ASSERT_EQ(gst->semi_minor_error, -1);
+    ASSERT_EQ(gst->semi_major_orientation, -1);
+    ASSERT_FLOAT_EQ(gst->latitude_error, 1.7f);
+    ASSERT_FLOAT_EQ(gst->longitude_error, 1.3f);
+    ASSERT_FLOAT_EQ(gst->altitude_error, 2.2f);
+
+    /* Before the first fix, every field may be empty */
+    result = EasyNmeaCoder::decode(with_checksum("$GPGST,,,,,,,,"));
+    gst = result.get<GSTData>();
+    ASSERT_NE(gst, nullptr);
+    GSTData empty;
+    ASSERT_EQ(*gst, empty);
+
+    /* Missing fields, and statistics which are not decimals */
+    ASSERT_EQ(EasyNmeaCoder::decode(with_checksum("$GPGST,172814.0,0.006,0.023,0.020,273.6,0.023,0.020")).error(),
+            DecodeError::INVALID_FIELDS);
+    ASSERT_EQ(EasyNmeaCoder::decode(with_checksum("$GPGST,172814.0,1,,,,,,")).error(), DecodeError::INVALID_FIELDS);
+    ASSERT_EQ(EasyNmeaCoder::decode(with_checksum("$GPGST,172814.0,-0.006,,,,,,")).error(),
+            DecodeError::INVALID_FIELDS);
+}
+
+TEST(EasyNmeaCoderTests, decodeGSTMatchesRegex)
+{
+    /* The decoder accepts a mutated GST sentence if and only if it matches nmea0183::GST_REGEX */
+    const std::vector<std::string> bodies = {
+        "$GPGST,172814.0,0.006,0.023,0.020,273.6,0.023,0.020,0.031",
+        "$GNGST,082356.00,1.8,,,,1.7,1.3,2.2",
+        "$GPGST,,,,,,,,",
+        "$GLGST,000000,10.5,2.0,1.0,0.0,1.5,1.5,3.0"
+    };
+    const std::string alphabet = "0123456789,.-GST*";
+    expect_decoder_matches_regex(bodies, alphabet, nmea0183::GST_REGEX, NMEA0183DataKind::GST);
 }
 
 int main(
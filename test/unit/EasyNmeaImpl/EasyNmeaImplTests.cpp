@@ -18,7 +18,10 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 // THE SOFTWARE.
 
+#include <mutex>
+#include <string>
 #include <thread>
+#include <vector>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
@@ -392,6 +395,600 @@ TEST(EasyNmeaImplTests, take_next)
     ASSERT_EQ(impl.take_next(data), ReturnCode::RETURN_CODE_NO_DATA);
 }
 
+TEST(EasyNmeaImplTests, take_nextRMC)
+{
+    std::string sentence_1 = "$GNRMC,072705.000,A,5703.1740,N,00954.9459,E,0.00,90.87,041118,,,A*46";
+    std::string sentence_2 = "$GPGGA,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,,*46";
+    std::string sentence_3 = "$GPTXT,01,01,02,ANTSTATUS=OPEN*2B";
+
+    SerialInterfaceMock* serial = new SerialInterfaceMock();
+
+    EXPECT_CALL(*serial, is_open)
+            .Times(AnyNumber())
+            .WillOnce(Return(false))
+            .WillOnce(Return(true))
+            .WillOnce(Return(true))
+            .WillOnce(Return(true))
+            .WillOnce(Return(true))
+            .WillRepeatedly(Return(false));
+
+    EXPECT_CALL(*serial, open)
+            .WillOnce(Return(true));
+
+    EXPECT_CALL(*serial, close)
+            .Times(AnyNumber());
+
+    EXPECT_CALL(*serial, read_line)
+            .Times(AnyNumber())
+            .WillOnce(DoAll(SetArgReferee<0>(sentence_1), Return(true)))
+            .WillOnce(DoAll(SetArgReferee<0>(sentence_2), Return(true)))
+            .WillRepeatedly(DoAll(SetArgReferee<0>(sentence_3), Return(true)));
+
+    EasyNmeaImplTest impl;
+    impl.set_serial_interface(serial);
+
+    ASSERT_EQ(impl.open("some_port", 12), ReturnCode::RETURN_CODE_OK);
+
+    NMEA0183DataKindMask mask;
+    mask.set(NMEA0183DataKind::RMC);
+    ASSERT_EQ(impl.wait_for_data(mask, 100ms), ReturnCode::RETURN_CODE_OK);
+
+    /* RMC and GPGGA samples are stored in different queues */
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    RMCData rmc;
+    ASSERT_EQ(impl.take_next(rmc), ReturnCode::RETURN_CODE_OK);
+    ASSERT_EQ(rmc.talker, NMEA0183Talker::GN);
+    ASSERT_EQ(rmc.date, 41118u);
+    ASSERT_EQ(impl.take_next(rmc), ReturnCode::RETURN_CODE_NO_DATA);
+    ASSERT_EQ(impl.wait_for_data(mask, 100ms), ReturnCode::RETURN_CODE_TIMEOUT);
+
+    GPGGAData gpgga;
+    mask = NMEA0183DataKindMask::all();
+    ASSERT_EQ(impl.wait_for_data(mask, 100ms), ReturnCode::RETURN_CODE_OK);
+    ASSERT_EQ(impl.take_next(gpgga), ReturnCode::RETURN_CODE_OK);
+    ASSERT_EQ(impl.take_next(gpgga), ReturnCode::RETURN_CODE_NO_DATA);
+}
+
+TEST(EasyNmeaImplTests, take_nextGSV)
+{
+    /* The GLONASS group is received while the GPS one is in progress */
+    std::string sentence_1 = "$GPGSV,2,1,07,04,15,270,42,06,01,010,,13,06,292,00,16,40,045,38*7C";
+    std::string sentence_2 = "$GLGSV,1,1,02,65,32,100,40,66,,,*50";
+    std::string sentence_3 = "$GPGSV,2,2,07,20,10,180,30,25,,,,29,77,300,45*79";
+    std::string sentence_4 = "$GPTXT,01,01,02,ANTSTATUS=OPEN*2B";
+
+    SerialInterfaceMock* serial = new SerialInterfaceMock();
+
+    EXPECT_CALL(*serial, is_open)
+            .Times(AnyNumber())
+            .WillOnce(Return(false))
+            .WillOnce(Return(true))
+            .WillOnce(Return(true))
+            .WillRepeatedly(Return(false));
+
+    EXPECT_CALL(*serial, open)
+            .WillOnce(Return(true));
+
+    EXPECT_CALL(*serial, close)
+            .Times(AnyNumber());
+
+    EXPECT_CALL(*serial, read_line)
+            .Times(AnyNumber())
+            .WillOnce(DoAll(SetArgReferee<0>(sentence_1), Return(true)))
+            .WillOnce(DoAll(SetArgReferee<0>(sentence_2), Return(true)))
+            .WillOnce(DoAll(SetArgReferee<0>(sentence_3), Return(true)))
+            .WillRepeatedly(DoAll(SetArgReferee<0>(sentence_4), Return(true)));
+
+    EasyNmeaImplTest impl;
+    impl.set_serial_interface(serial);
+
+    ASSERT_EQ(impl.open("some_port", 12), ReturnCode::RETURN_CODE_OK);
+
+    NMEA0183DataKindMask mask;
+    mask.set(NMEA0183DataKind::GSV);
+    ASSERT_EQ(impl.wait_for_data(mask, 100ms), ReturnCode::RETURN_CODE_OK);
+
+    /* Each table is published as a whole once its last sentence is received */
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    GSVData gsv;
+    ASSERT_EQ(impl.take_next(gsv), ReturnCode::RETURN_CODE_OK);
+    ASSERT_EQ(gsv.talker, NMEA0183Talker::GL);
+    ASSERT_EQ(gsv.satellite_count, 2u);
+    ASSERT_EQ(gsv.satellites[1].prn, 66u);
+    ASSERT_EQ(impl.take_next(gsv), ReturnCode::RETURN_CODE_OK);
+    ASSERT_EQ(gsv.talker, NMEA0183Talker::GP);
+    ASSERT_EQ(gsv.satellites_in_view, 7u);
+    ASSERT_EQ(gsv.satellite_count, 7u);
+    ASSERT_EQ(gsv.satellites[6].prn, 29u);
+    ASSERT_EQ(impl.take_next(gsv), ReturnCode::RETURN_CODE_NO_DATA);
+}
+
+TEST(EasyNmeaImplTests, take_nextGSA)
+{
+    /* Two epochs of two GSA sentences, each of them followed by other sentences */
+    std::string sentence_1 = "$GNGSA,A,3,10,18,27,08,11,,,,,,,,2.19,1.97,0.95*10";
+    std::string sentence_2 = "$GNGSA,A,3,68,74,,,,,,,,,,,2.19,1.97,0.95*18";
+    std::string sentence_3 = "$GPTXT,01,01,02,ANTSTATUS=OPEN*2B";
+    std::string sentence_4 = "$GNGSA,A,3,10,18,27,08,11,,,,,,,,1.59,1.28,0.94*12";
+    std::string sentence_5 = "$GNGSA,A,3,68,75,74,,,,,,,,,,1.59,1.28,0.94*18";
+
+    SerialInterfaceMock* serial = new SerialInterfaceMock();
+
+    EXPECT_CALL(*serial, is_open)
+            .Times(AnyNumber())
+            .WillOnce(Return(false))
+            .WillOnce(Return(true))
+            .WillOnce(Return(true))
+            .WillRepeatedly(Return(false));
+
+    EXPECT_CALL(*serial, open)
+            .WillOnce(Return(true));
+
+    EXPECT_CALL(*serial, close)
+            .Times(AnyNumber());
+
+    EXPECT_CALL(*serial, read_line)
+            .Times(AnyNumber())
+            .WillOnce(DoAll(SetArgReferee<0>(sentence_1), Return(true)))
+            .WillOnce(DoAll(SetArgReferee<0>(sentence_2), Return(true)))
+            .WillOnce(DoAll(SetArgReferee<0>(sentence_3), Return(true)))
+            .WillOnce(DoAll(SetArgReferee<0>(sentence_4), Return(true)))
+            .WillOnce(DoAll(SetArgReferee<0>(sentence_5), Return(true)))
+            .WillRepeatedly(DoAll(SetArgReferee<0>(sentence_3), Return(true)));
+
+    EasyNmeaImplTest impl;
+    impl.set_serial_interface(serial);
+
+    ASSERT_EQ(impl.open("some_port", 12), ReturnCode::RETURN_CODE_OK);
+
+    NMEA0183DataKindMask mask;
+    mask.set(NMEA0183DataKind::GSA);
+    ASSERT_EQ(impl.wait_for_data(mask, 100ms), ReturnCode::RETURN_CODE_OK);
+
+    /* The sentences of each epoch are merged into a single sample */
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    GSAData gsa;
+    ASSERT_EQ(impl.take_next(gsa), ReturnCode::RETURN_CODE_OK);
+    ASSERT_EQ(gsa.talker, NMEA0183Talker::GN);
+    ASSERT_FLOAT_EQ(gsa.pdop, 2.19f);
+    ASSERT_EQ(gsa.system_count, 2u);
+    ASSERT_EQ(gsa.systems[0].prn_count, 5u);
+    ASSERT_EQ(gsa.systems[1].prn_count, 2u);
+    ASSERT_EQ(impl.take_next(gsa), ReturnCode::RETURN_CODE_OK);
+    ASSERT_FLOAT_EQ(gsa.pdop, 1.59f);
+    ASSERT_EQ(gsa.system_count, 2u);
+    ASSERT_EQ(gsa.systems[1].prn_count, 3u);
+    ASSERT_EQ(impl.take_next(gsa), ReturnCode::RETURN_CODE_NO_DATA);
+}
+
+TEST(EasyNmeaImplTests, take_nextAIS)
+{
+    /* A position report in two fragments, interleaved with a message which is not one */
+    std::string sentence_1 = "!AIVDM,2,1,7,A,15RTgt0PAso;90,0*0C";
+    std::string sentence_2 = "!AIVDM,2,1,3,B,55P5TL01VIaAL@7WKO@mBplU@<PDhh000000001S;AJ::4A80?4i@E53,0*3E";
+    std::string sentence_3 = "!AIVDM,2,2,3,B,1@0000000000000,2*55";
+    std::string sentence_4 = "!AIVDM,2,2,7,A,TKcjM8h6g208CQ,0*63";
+    std::string sentence_5 = "!AIVDO,1,1,,,B5NJ;PP005l4ot5Isbl03wsUkP06,0*35";
+    std::string sentence_6 = "$GPTXT,01,01,02,ANTSTATUS=OPEN*2B";
+
+    SerialInterfaceMock* serial = new SerialInterfaceMock();
+
+    EXPECT_CALL(*serial, is_open)
+            .Times(AnyNumber())
+            .WillOnce(Return(false))
+            .WillOnce(Return(true))
+            .WillOnce(Return(true))
+            .WillRepeatedly(Return(false));
+
+    EXPECT_CALL(*serial, open)
+            .WillOnce(Return(true));
+
+    EXPECT_CALL(*serial, close)
+            .Times(AnyNumber());
+
+    EXPECT_CALL(*serial, read_line)
+            .Times(AnyNumber())
+            .WillOnce(DoAll(SetArgReferee<0>(sentence_1), Return(true)))
+            .WillOnce(DoAll(SetArgReferee<0>(sentence_2), Return(true)))
+            .WillOnce(DoAll(SetArgReferee<0>(sentence_3), Return(true)))
+            .WillOnce(DoAll(SetArgReferee<0>(sentence_4), Return(true)))
+            .WillOnce(DoAll(SetArgReferee<0>(sentence_5), Return(true)))
+            .WillRepeatedly(DoAll(SetArgReferee<0>(sentence_6), Return(true)));
+
+    EasyNmeaImplTest impl;
+    impl.set_serial_interface(serial);
+
+    ASSERT_EQ(impl.open("some_port", 12), ReturnCode::RETURN_CODE_OK);
+
+    NMEA0183DataKindMask mask;
+    mask.set(NMEA0183DataKind::AIS);
+    ASSERT_EQ(impl.wait_for_data(mask, 100ms), ReturnCode::RETURN_CODE_OK);
+
+    /* Only the position reports are published, once their message is complete */
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    AISPositionData ais;
+    ASSERT_EQ(impl.take_next(ais), ReturnCode::RETURN_CODE_OK);
+    ASSERT_EQ(ais.message_type, 1u);
+    ASSERT_EQ(ais.mmsi, 371798000u);
+    ASSERT_EQ(ais.channel, 'A');
+    ASSERT_EQ(impl.take_next(ais), ReturnCode::RETURN_CODE_OK);
+    ASSERT_EQ(ais.message_type, 18u);
+    ASSERT_EQ(ais.mmsi, 367430530u);
+    ASSERT_TRUE(ais.own_ship);
+    ASSERT_EQ(impl.take_next(ais), ReturnCode::RETURN_CODE_NO_DATA);
+}
+
+TEST(EasyNmeaImplTests, take_nextZDA)
+{
+    std::string sentence_1 = "$GPGGA,235959.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,,*40";
+    std::string sentence_2 = "$GPZDA,235959.500,04,07,2002,00,00*51";
+    std::string sentence_3 = "$GPGGA,000000.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,,*41";
+    std::string sentence_4 = "$GPRMC,000001,V,,,,,,,,,*30";
+    std::string sentence_5 = "$GPTXT,01,01,02,ANTSTATUS=OPEN*2B";
+
+    SerialInterfaceMock* serial = new SerialInterfaceMock();
+
+    EXPECT_CALL(*serial, is_open)
+            .Times(AnyNumber())
+            .WillOnce(Return(false))
+            .WillOnce(Return(true))
+            .WillOnce(Return(true))
+            .WillOnce(Return(true))
+            .WillOnce(Return(true))
+            .WillOnce(Return(true))
+            .WillOnce(Return(true))
+            .WillRepeatedly(Return(false));
+
+    EXPECT_CALL(*serial, open)
+            .WillOnce(Return(true));
+
+    EXPECT_CALL(*serial, close)
+            .Times(AnyNumber());
+
+    EXPECT_CALL(*serial, read_line)
+            .Times(AnyNumber())
+            .WillOnce(DoAll(SetArgReferee<0>(sentence_1), Return(true)))
+            .WillOnce(DoAll(SetArgReferee<0>(sentence_2), Return(true)))
+            .WillOnce(DoAll(SetArgReferee<0>(sentence_3), Return(true)))
+            .WillOnce(DoAll(SetArgReferee<0>(sentence_4), Return(true)))
+            .WillRepeatedly(DoAll(SetArgReferee<0>(sentence_5), Return(true)));
+
+    EasyNmeaImplTest impl;
+    impl.set_serial_interface(serial);
+
+    ASSERT_EQ(impl.open("some_port", 12), ReturnCode::RETURN_CODE_OK);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    /* The fix received before any ZDA cannot be dated */
+    GPGGAData gpgga;
+    ASSERT_EQ(impl.take_next(gpgga), ReturnCode::RETURN_CODE_OK);
+    ASSERT_EQ(gpgga.time_of_day_ms, 86399000);
+    ASSERT_EQ(gpgga.utc_time, UtcTime::min());
+
+    ZDAData zda;
+    ASSERT_EQ(impl.take_next(zda), ReturnCode::RETURN_CODE_OK);
+    ASSERT_EQ(zda.year, 2002u);
+    ASSERT_EQ(zda.utc_time.time_since_epoch().count(), 1025827200000 - 500);
+    ASSERT_EQ(impl.take_next(zda), ReturnCode::RETURN_CODE_NO_DATA);
+
+    /* Fixes after midnight are dated with the following day */
+    ASSERT_EQ(impl.take_next(gpgga), ReturnCode::RETURN_CODE_OK);
+    ASSERT_EQ(gpgga.time_of_day_ms, 0);
+    ASSERT_EQ(gpgga.utc_time.time_since_epoch().count(), 1025827200000);
+    ASSERT_EQ(impl.take_next(gpgga), ReturnCode::RETURN_CODE_NO_DATA);
+
+    RMCData rmc;
+    ASSERT_EQ(impl.take_next(rmc), ReturnCode::RETURN_CODE_OK);
+    ASSERT_EQ(rmc.date, 0u);
+    ASSERT_EQ(rmc.utc_time.time_since_epoch().count(), 1025827201000);
+}
+
+TEST(EasyNmeaImplTests, take_nextHeading)
+{
+    std::string sentence_1 = "$GPHDT,274.07,T*03";
+    std::string sentence_2 = "$GPTHS,274.10,A*07";
+    std::string sentence_3 = "$GPROT,-12.5,A*2A";
+    std::string sentence_4 = "$GPTXT,01,01,02,ANTSTATUS=OPEN*2B";
+
+    SerialInterfaceMock* serial = new SerialInterfaceMock();
+
+    EXPECT_CALL(*serial, is_open)
+            .Times(AnyNumber())
+            .WillOnce(Return(false))
+            .WillOnce(Return(true))
+            .WillOnce(Return(true))
+            .WillOnce(Return(true))
+            .WillOnce(Return(true))
+            .WillOnce(Return(true))
+            .WillRepeatedly(Return(false));
+
+    EXPECT_CALL(*serial, open)
+            .WillOnce(Return(true));
+
+    EXPECT_CALL(*serial, close)
+            .Times(AnyNumber());
+
+    EXPECT_CALL(*serial, read_line)
+            .Times(AnyNumber())
+            .WillOnce(DoAll(SetArgReferee<0>(sentence_1), Return(true)))
+            .WillOnce(DoAll(SetArgReferee<0>(sentence_2), Return(true)))
+            .WillOnce(DoAll(SetArgReferee<0>(sentence_3), Return(true)))
+            .WillRepeatedly(DoAll(SetArgReferee<0>(sentence_4), Return(true)));
+
+    EasyNmeaImplTest impl;
+    impl.set_serial_interface(serial);
+
+    /* There is no latest sample before any is received */
+    HDTData hdt;
+    THSData ths;
+    ROTData rot;
+    ASSERT_EQ(impl.read_latest(hdt), ReturnCode::RETURN_CODE_NO_DATA);
+    ASSERT_EQ(impl.read_latest(ths), ReturnCode::RETURN_CODE_NO_DATA);
+    ASSERT_EQ(impl.read_latest(rot), ReturnCode::RETURN_CODE_NO_DATA);
+    ASSERT_EQ(hdt, HDTData());
+
+    ASSERT_EQ(impl.open("some_port", 12), ReturnCode::RETURN_CODE_OK);
+
+    NMEA0183DataKindMask mask = NMEA0183DataKind::HDT | NMEA0183DataKind::THS | NMEA0183DataKind::ROT;
+    ASSERT_EQ(impl.wait_for_data(mask, 100ms), ReturnCode::RETURN_CODE_OK);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    /* The latest samples can be read any number of times, regardless of the queues */
+    for (int i = 0; i < 2; i++)
+    {
+        ASSERT_EQ(impl.read_latest(hdt), ReturnCode::RETURN_CODE_OK);
+        ASSERT_FLOAT_EQ(hdt.heading, 274.07f);
+        ASSERT_EQ(impl.read_latest(ths), ReturnCode::RETURN_CODE_OK);
+        ASSERT_FLOAT_EQ(ths.heading, 274.1f);
+        ASSERT_EQ(ths.mode, 'A');
+        ASSERT_EQ(impl.read_latest(rot), ReturnCode::RETURN_CODE_OK);
+        ASSERT_FLOAT_EQ(rot.rate_of_turn, -12.5f);
+    }
+
+    /* The samples are queued as well */
+    HDTData hdt_taken;
+    ASSERT_EQ(impl.take_next(hdt_taken), ReturnCode::RETURN_CODE_OK);
+    ASSERT_EQ(hdt_taken, hdt);
+    ASSERT_EQ(impl.take_next(hdt_taken), ReturnCode::RETURN_CODE_NO_DATA);
+    THSData ths_taken;
+    ASSERT_EQ(impl.take_next(ths_taken), ReturnCode::RETURN_CODE_OK);
+    ASSERT_EQ(ths_taken, ths);
+    ASSERT_EQ(impl.take_next(ths_taken), ReturnCode::RETURN_CODE_NO_DATA);
+    ROTData rot_taken;
+    ASSERT_EQ(impl.take_next(rot_taken), ReturnCode::RETURN_CODE_OK);
+    ASSERT_EQ(rot_taken, rot);
+    ASSERT_EQ(impl.take_next(rot_taken), ReturnCode::RETURN_CODE_NO_DATA);
+    ASSERT_EQ(impl.wait_for_data(mask, 100ms), ReturnCode::RETURN_CODE_TIMEOUT);
+
+    /* Taking the queued samples does not take the latest ones */
+    ASSERT_EQ(impl.read_latest(hdt), ReturnCode::RETURN_CODE_OK);
+    ASSERT_EQ(hdt, hdt_taken);
+}
+
+TEST(EasyNmeaImplTests, take_nextGST)
+{
+    std::string sentence_1 = "$GNRMC,072705.000,A,5703.1740,N,00954.9459,E,0.00,90.87,041118,,,A*46";
+    std::string sentence_2 = "$GNGGA,072706.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,,*5B";
+    std::string sentence_3 = "$GNGST,072706.000,1.8,2.1,1.2,87.5,1.7,1.3,2.2*4A";
+    std::string sentence_4 = "$GPTXT,01,01,02,ANTSTATUS=OPEN*2B";
+
+    SerialInterfaceMock* serial = new SerialInterfaceMock();
+
+    EXPECT_CALL(*serial, is_open)
+            .Times(AnyNumber())
+            .WillOnce(Return(false))
+            .WillOnce(Return(true))
+            .WillOnce(Return(true))
+            .WillOnce(Return(true))
+            .WillOnce(Return(true))
+            .WillOnce(Return(true))
+            .WillRepeatedly(Return(false));
+
+    EXPECT_CALL(*serial, open)
+            .WillOnce(Return(true));
+
+    EXPECT_CALL(*serial, close)
+            .Times(AnyNumber());
+
+    EXPECT_CALL(*serial, read_line)
+            .Times(AnyNumber())
+            .WillOnce(DoAll(SetArgReferee<0>(sentence_1), Return(true)))
+            .WillOnce(DoAll(SetArgReferee<0>(sentence_2), Return(true)))
+            .WillOnce(DoAll(SetArgReferee<0>(sentence_3), Return(true)))
+            .WillRepeatedly(DoAll(SetArgReferee<0>(sentence_4), Return(true)));
+
+    EasyNmeaImplTest impl;
+    impl.set_serial_interface(serial);
+
+    ASSERT_EQ(impl.open("some_port", 12), ReturnCode::RETURN_CODE_OK);
+
+    NMEA0183DataKindMask mask;
+    mask.set(NMEA0183DataKind::GST);
+    ASSERT_EQ(impl.wait_for_data(mask, 100ms), ReturnCode::RETURN_CODE_OK);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    /* The GST sample is dated as the GGA sample of its epoch */
+    GPGGAData gpgga;
+    ASSERT_EQ(impl.take_next(gpgga), ReturnCode::RETURN_CODE_OK);
+    GSTData gst;
+    ASSERT_EQ(impl.take_next(gst), ReturnCode::RETURN_CODE_OK);
+    ASSERT_EQ(gst.talker, NMEA0183Talker::GN);
+    ASSERT_EQ(gst.time_of_day_ms, gpgga.time_of_day_ms);
+    ASSERT_EQ(gst.utc_time, gpgga.utc_time);
+    ASSERT_EQ(gst.utc_time.time_since_epoch().count(), 1541316426000);
+    ASSERT_FLOAT_EQ(gst.rms, 1.8f);
+    ASSERT_FLOAT_EQ(gst.semi_major_orientation, 87.5f);
+    ASSERT_FLOAT_EQ(gst.altitude_error, 2.2f);
+
+    /* Taking the last sample clears the kind from the received data */
+    ASSERT_EQ(impl.take_next(gst), ReturnCode::RETURN_CODE_NO_DATA);
+    ASSERT_EQ(impl.wait_for_data(mask, 100ms), ReturnCode::RETURN_CODE_TIMEOUT);
+}
+
+TEST(EasyNmeaImplTests, take_nextReceiveTime)
+{
+    /* A GGA sentence is received between the two sentences of a GSV group */
+    std::string sentence_1 = "$GPGSV,2,1,07,04,15,270,42,06,01,010,,13,06,292,00,16,40,045,38*7C";
+    std::string sentence_2 = "$GPGGA,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,,*46";
+    std::string sentence_3 = "$GPGSV,2,2,07,20,10,180,30,25,,,,29,77,300,45*79";
+    std::string sentence_4 = "$GPTXT,01,01,02,ANTSTATUS=OPEN*2B";
+
+    SerialInterfaceMock* serial = new SerialInterfaceMock();
+
+    EXPECT_CALL(*serial, is_open)
+            .Times(AnyNumber())
+            .WillOnce(Return(false))
+            .WillOnce(Return(false))
+            .WillOnce(Return(true))
+            .WillOnce(Return(true))
+            .WillOnce(Return(true))
+            .WillRepeatedly(Return(false));
+
+    EXPECT_CALL(*serial, open)
+            .WillOnce(Return(true));
+
+    EXPECT_CALL(*serial, close)
+            .Times(AnyNumber());
+
+    EXPECT_CALL(*serial, read_line)
+            .Times(AnyNumber())
+            .WillOnce(DoAll(SetArgReferee<0>(sentence_1), Return(true)))
+            .WillOnce(DoAll(SetArgReferee<0>(sentence_2), Return(true)))
+            .WillOnce(DoAll(SetArgReferee<0>(sentence_3), Return(true)))
+            .WillRepeatedly(DoAll(SetArgReferee<0>(sentence_4), Return(true)));
+
+    EasyNmeaImplTest impl;
+    impl.set_serial_interface(serial);
+
+    /* The realtime time point can only be enabled while the connection is closed */
+    ASSERT_EQ(impl.stamp_realtime(true), ReturnCode::RETURN_CODE_OK);
+    std::chrono::steady_clock::time_point before = std::chrono::steady_clock::now();
+    std::chrono::system_clock::time_point realtime_before = std::chrono::system_clock::now();
+    ASSERT_EQ(impl.open("some_port", 12), ReturnCode::RETURN_CODE_OK);
+
+    NMEA0183DataKindMask mask;
+    mask.set(NMEA0183DataKind::GSV);
+    ASSERT_EQ(impl.wait_for_data(mask, 100ms), ReturnCode::RETURN_CODE_OK);
+    ASSERT_EQ(impl.stamp_realtime(false), ReturnCode::RETURN_CODE_ILLEGAL_OPERATION);
+
+    /* The samples carry the time at which they were received, rather than the one they are taken */
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    GPGGAData gpgga;
+    ASSERT_EQ(impl.take_next(gpgga), ReturnCode::RETURN_CODE_OK);
+    GSVData gsv;
+    ASSERT_EQ(impl.take_next(gsv), ReturnCode::RETURN_CODE_OK);
+    ASSERT_GE(gpgga.receive_time.monotonic, before);
+    ASSERT_LT(gpgga.receive_time.monotonic, std::chrono::steady_clock::now() - std::chrono::milliseconds(100));
+    ASSERT_GE(gpgga.receive_time.realtime, realtime_before);
+
+    /* The table carries the time of its first sentence */
+    ASSERT_GE(gsv.receive_time.monotonic, before);
+    ASSERT_LE(gsv.receive_time.monotonic, gpgga.receive_time.monotonic);
+    ASSERT_GE(gsv.receive_time.realtime, realtime_before);
+}
+
+TEST(EasyNmeaImplTests, set_read_profile)
+{
+    SerialInterfaceMock* serial = new SerialInterfaceMock();
+
+    EXPECT_CALL(*serial, is_open)
+            .Times(AnyNumber())
+            .WillOnce(Return(false))
+            .WillOnce(Return(false))
+            .WillOnce(Return(false))
+            .WillOnce(Return(true))
+            .WillRepeatedly(Return(false));
+
+    EXPECT_CALL(*serial, set_read_profile(ReadProfile::lowest_cpu()))
+            .WillOnce(Return(true))
+            .WillOnce(Return(false));
+
+    EXPECT_CALL(*serial, close)
+            .Times(AnyNumber());
+
+    EasyNmeaImplTest impl;
+    impl.set_serial_interface(serial);
+
+    /* The profile is handed to the serial interface, which may not support it */
+    ASSERT_EQ(impl.set_read_profile(ReadProfile::lowest_cpu()), ReturnCode::RETURN_CODE_OK);
+    ASSERT_EQ(impl.set_read_profile(ReadProfile::lowest_cpu()), ReturnCode::RETURN_CODE_UNSUPPORTED);
+
+    /* A VMIN of 0 is rejected, and the profile cannot be changed while the connection is open */
+    ASSERT_EQ(impl.set_read_profile(ReadProfile{0, 1}), ReturnCode::RETURN_CODE_BAD_PARAMETER);
+    ASSERT_EQ(impl.set_read_profile(ReadProfile::lowest_latency()), ReturnCode::RETURN_CODE_ILLEGAL_OPERATION);
+}
+
+TEST(EasyNmeaImplTests, register_decoder)
+{
+    /* A registered sentence, a sentence handled by the catch-all handler, and a supported one */
+    std::string sentence_1 = "$PGRME,15.0,M,45.0,M,25.0,M*1C";
+    std::string sentence_2 = "\\s:GPS1*3C\\$PUBX,00*33";
+    std::string sentence_3 = "$GPGGA,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,,*46";
+
+    SerialInterfaceMock* serial = new SerialInterfaceMock();
+
+    EXPECT_CALL(*serial, is_open)
+            .Times(AnyNumber())
+            .WillOnce(Return(false))
+            .WillOnce(Return(false))
+            .WillOnce(Return(false))
+            .WillOnce(Return(false))
+            .WillOnce(Return(false))
+            .WillOnce(Return(true))
+            .WillOnce(Return(true))
+            .WillOnce(Return(true))
+            .WillRepeatedly(Return(false));
+
+    EXPECT_CALL(*serial, open)
+            .WillOnce(Return(true));
+
+    EXPECT_CALL(*serial, close)
+            .Times(AnyNumber());
+
+    EXPECT_CALL(*serial, read_line)
+            .Times(AnyNumber())
+            .WillOnce(DoAll(SetArgReferee<0>(sentence_1), Return(true)))
+            .WillOnce(DoAll(SetArgReferee<0>(sentence_2), Return(true)))
+            .WillRepeatedly(DoAll(SetArgReferee<0>(sentence_3), Return(true)));
+
+    EasyNmeaImplTest impl;
+    impl.set_serial_interface(serial);
+
+    /* The handlers are called from the reading thread, so they copy the sentences under a mutex */
+    std::mutex mutex;
+    std::vector<std::string> pgrme;
+    std::vector<std::string> others;
+    ASSERT_EQ(impl.register_decoder("PGRME", [&](const RawSentence& raw)
+            {
+                std::unique_lock<std::mutex> lck(mutex);
+                pgrme.emplace_back(raw.sentence);
+            }), ReturnCode::RETURN_CODE_OK);
+    ASSERT_EQ(impl.register_decoder("", [&](const RawSentence& raw)
+            {
+                std::unique_lock<std::mutex> lck(mutex);
+                others.emplace_back(raw.sentence);
+                ASSERT_STREQ(raw.tag_block.source, "GPS1");
+            }), ReturnCode::RETURN_CODE_OK);
+    ASSERT_EQ(impl.register_decoder("PGRME", [](const RawSentence&)
+            {
+            }), ReturnCode::RETURN_CODE_BAD_PARAMETER);
+    ASSERT_EQ(impl.register_decoder("pgrme", [](const RawSentence&)
+            {
+            }), ReturnCode::RETURN_CODE_BAD_PARAMETER);
+
+    ASSERT_EQ(impl.open("some_port", 12), ReturnCode::RETURN_CODE_OK);
+    ASSERT_EQ(impl.register_decoder("PGRMZ", [](const RawSentence&)
+            {
+            }), ReturnCode::RETURN_CODE_ILLEGAL_OPERATION);
+
+    /* The sentences preceding the GPGGA one have been handed over once it is received */
+    NMEA0183DataKindMask mask;
+    mask.set(NMEA0183DataKind::GPGGA);
+    ASSERT_EQ(impl.wait_for_data(mask, 100ms), ReturnCode::RETURN_CODE_OK);
+    std::unique_lock<std::mutex> lck(mutex);
+    ASSERT_EQ(pgrme, std::vector<std::string>{sentence_1});
+    ASSERT_EQ(others, std::vector<std::string>{"$PUBX,00*33"});
+}
 
 TEST(EasyNmeaImplTests, destroyNoClose)
 {
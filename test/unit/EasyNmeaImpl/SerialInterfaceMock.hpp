@@ -49,6 +49,32 @@ public:
         read_line,
         (std::string& result),
         (noexcept, override));
+
+    MOCK_METHOD(bool,
+        set_read_profile,
+        (const ReadProfile& profile),
+        (noexcept, override));
+
+    /**
+     * Hand the lines returned by the mocked \c read_line() to \c on_line, so that the expectations
+     * set on \c read_line() drive \c read_lines() as well. Each line is stamped as if it was read
+     * in a chunk of its own.
+     */
+    bool read_lines(
+            const LineHandler& on_line) noexcept override
+    {
+        std::string line;
+        while (read_line(line))
+        {
+            stamp_chunk_();
+            line_time_ = chunk_time_;
+            if (!on_line(line))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
 };
 
 } // namespace eduponz
@@ -0,0 +1,259 @@
+// Copyright (c) 2021 Eduardo Ponz Segrelles.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <easynmea/data.hpp>
+#include <EasyNmeaCoder.hpp>
+#include <GPGGAView.hpp>
+
+using namespace eduponz::easynmea;
+
+/**
+ * Append the checksum to the body of a sentence.
+ */
+std::string with_checksum(
+        const std::string& body)
+{
+    char checksum[4];
+    std::snprintf(checksum, sizeof(checksum), "*%02X", Checksum::compute(body.data() + 1, body.size() - 1));
+    return body + checksum;
+}
+
+/**
+ * Check that every field of the view has the value of the decoded data.
+ */
+void check_fields(
+        const GPGGAView& view,
+        const GPGGAData& expected)
+{
+    float float_value;
+    int32_t int_value;
+    uint16_t short_value;
+    ASSERT_TRUE(view.timestamp(float_value));
+    ASSERT_EQ(float_value, expected.timestamp);
+    ASSERT_TRUE(view.latitude(float_value));
+    ASSERT_EQ(float_value, expected.latitude);
+    ASSERT_TRUE(view.latitude_e7(int_value));
+    ASSERT_EQ(int_value, expected.latitude_e7);
+    ASSERT_TRUE(view.longitude(float_value));
+    ASSERT_EQ(float_value, expected.longitude);
+    ASSERT_TRUE(view.longitude_e7(int_value));
+    ASSERT_EQ(int_value, expected.longitude_e7);
+    ASSERT_TRUE(view.fix(short_value));
+    ASSERT_EQ(short_value, expected.fix);
+    ASSERT_TRUE(view.satellites_on_view(short_value));
+    ASSERT_EQ(short_value, expected.satellites_on_view);
+    ASSERT_TRUE(view.horizontal_precision(float_value));
+    ASSERT_EQ(float_value, expected.horizontal_precision);
+    ASSERT_TRUE(view.altitude(float_value));
+    ASSERT_EQ(float_value, expected.altitude);
+    ASSERT_TRUE(view.height_of_geoid(float_value));
+    ASSERT_EQ(float_value, expected.height_of_geoid);
+    ASSERT_TRUE(view.dgps_last_update(float_value));
+    ASSERT_EQ(float_value, expected.dgps_last_update);
+    ASSERT_TRUE(view.dgps_reference_station_id(short_value));
+    ASSERT_EQ(short_value, expected.dgps_reference_station_id);
+}
+
+TEST(GPGGAViewTests, parseValid)
+{
+    const std::vector<std::string> sentences = {
+        "$GPGGA,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,2.2,7854,*4a",
+        "$GPGGA,072706.000,5703.1740,N,00954.9459,W,1,8,1.28,-21.2,M,42.5,M,2.2,7854,*50",
+        with_checksum("$GPGGA,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,2.2,"),
+        with_checksum("$GPGGA,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,,65535,"),
+        with_checksum("$GPGGA,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,,"),
+        with_checksum("$GPGGA,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,"),
+        "$GPGGA,072705,8960.5,S,17960.25,E,2,12,0.9,21.2,M,-42.5,M,*5E",
+        "$GPGGA,072705.000,90.0,N,180.00,W,1,7,1.97,-21.2,M,42.5,M,,*6E"
+    };
+
+    for (const std::string& sentence : sentences)
+    {
+        DecodeResult result = EasyNmeaCoder::decode(sentence);
+        ASSERT_NE(result.get<GPGGAData>(), nullptr) << sentence;
+
+        GPGGAView view;
+        ASSERT_TRUE(view.parse(sentence)) << sentence;
+        ASSERT_TRUE(view.valid());
+        check_fields(view, *result.get<GPGGAData>());
+
+        // Fields are cached, and converting all of them gives the decoded data
+        check_fields(view, *result.get<GPGGAData>());
+        GPGGAData data;
+        ASSERT_TRUE(view.to_data(data));
+        ASSERT_EQ(data, *result.get<GPGGAData>());
+    }
+}
+
+TEST(GPGGAViewTests, parseInvalid)
+{
+    const std::vector<std::string> sentences = {
+        "",
+        "*",
+        "$GPGGA,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,2.2,7854,*22",
+        "$GPRMC,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,2.2,7854,*57",
+        "$GPGGA,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,2.2,7854,",
+        "$GPGGA,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,F,42.5,M,2.2,7854,*41",
+        "noise$GPGGA,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,2.2,7854,*4a",
+        "$GPGGA,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,2.2,7854,*4a\r\n"
+    };
+
+    for (const std::string& sentence : sentences)
+    {
+        GPGGAView view;
+        ASSERT_FALSE(view.parse(sentence)) << sentence;
+        ASSERT_FALSE(view.valid());
+        float latitude;
+        ASSERT_FALSE(view.latitude(latitude));
+        GPGGAData data;
+        ASSERT_FALSE(view.to_data(data));
+    }
+
+    /* Sentences with a wrong number of fields */
+    std::vector<std::string> bodies = {
+        "$GPGGA,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M",
+        "$GPGGA,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,2.2,,",
+        "$GPGGA,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,2.2,7854,1,"
+    };
+    for (const std::string& body : bodies)
+    {
+        GPGGAView view;
+        ASSERT_FALSE(view.parse(with_checksum(body))) << body;
+    }
+}
+
+TEST(GPGGAViewTests, parseIndexed)
+{
+    std::string buffer =
+            "$GPGGA,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,2.2,7854,*4a\r\n"
+            "$GPTXT,01,01,02,ANTSTATUS=OPEN*2B\r\n"
+            "$GPGGA,072706.000,5703.1740,N,00954.9459,W,1,8,1.28,-21.2,M,42.5,M,2.2,7854,*50\r\n";
+    IndexedSentence index[3];
+    ASSERT_EQ(StructuralIndex::build(buffer, index, 3), 3u);
+
+    GPGGAView view;
+    float value;
+    ASSERT_TRUE(view.parse(buffer, index[0]));
+    ASSERT_TRUE(view.timestamp(value));
+    ASSERT_FLOAT_EQ(value, 72705);
+    ASSERT_FALSE(view.parse(buffer, index[1]));
+    ASSERT_FALSE(view.timestamp(value));
+
+    // Parsing a new sentence forgets the cached fields of the previous one
+    ASSERT_TRUE(view.parse(buffer, index[2]));
+    ASSERT_TRUE(view.timestamp(value));
+    ASSERT_FLOAT_EQ(value, 72706);
+    ASSERT_TRUE(view.longitude(value));
+    ASSERT_FLOAT_EQ(value, -9.9157648);
+}
+
+TEST(GPGGAViewTests, fieldsAreIndependent)
+{
+    /* Invalid altitude: only that field and the full conversion fail */
+    std::string sentence = with_checksum(
+        "$GPGGA,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2.3,M,42.5,M,2.2,7854,");
+    ASSERT_EQ(EasyNmeaCoder::decode(sentence).kind(), NMEA0183DataKind::INVALID);
+
+    GPGGAView view;
+    ASSERT_TRUE(view.parse(sentence));
+    float value;
+    uint16_t fix;
+    ASSERT_TRUE(view.latitude(value));
+    ASSERT_FLOAT_EQ(value, 57.0529);
+    ASSERT_TRUE(view.fix(fix));
+    ASSERT_EQ(fix, 1);
+    value = 123;
+    ASSERT_FALSE(view.altitude(value));
+    ASSERT_FALSE(view.altitude(value));
+    ASSERT_EQ(value, 123);
+    GPGGAData data;
+    ASSERT_FALSE(view.to_data(data));
+    ASSERT_EQ(data, GPGGAData());
+
+    /* Invalid bearing: both the floating point and the fixed point latitude fail */
+    sentence = with_checksum("$GPGGA,072705.000,5703.1740,E,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,2.2,7854,");
+    ASSERT_TRUE(view.parse(sentence));
+    int32_t latitude_e7;
+    ASSERT_FALSE(view.latitude(value));
+    ASSERT_FALSE(view.latitude_e7(latitude_e7));
+    ASSERT_TRUE(view.longitude(value));
+}
+
+TEST(GPGGAViewTests, matchesDecode)
+{
+    /**
+     * Mutate valid GPGGA sentences one character at a time and check that converting all the
+     * fields of the view succeeds if and only if the sentence can be decoded, with the same result.
+     */
+    const std::vector<std::string> bodies = {
+        "$GPGGA,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,2.2,7854,",
+        "$GPGGA,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,,",
+        "$GPGGA,072705,90.00,S,180.0,W,2,12,0.9,21.2,M,-42.5,M,"
+    };
+    const std::string alphabet = "0123456789.,-NSEWMAG*$";
+    std::mt19937 generator(2021);
+
+    for (const std::string& body : bodies)
+    {
+        for (int i = 0; i < 3000; i++)
+        {
+            std::string mutated = body;
+            std::size_t position = 1 + generator() % (mutated.size() - 1);
+            char character = alphabet[generator() % alphabet.size()];
+            switch (generator() % 3)
+            {
+                case 0:
+                    mutated[position] = character;
+                    break;
+                case 1:
+                    mutated.insert(mutated.begin() + position, character);
+                    break;
+                default:
+                    mutated.erase(position, 1);
+            }
+            mutated = with_checksum(mutated);
+
+            DecodeResult result = EasyNmeaCoder::decode(mutated);
+            GPGGAView view;
+            GPGGAData data;
+            bool converted = view.parse(mutated) && view.to_data(data);
+            ASSERT_EQ(converted, result.kind() == NMEA0183DataKind::GPGGA) << mutated;
+            if (converted)
+            {
+                ASSERT_EQ(data, *result.get<GPGGAData>()) << mutated;
+            }
+        }
+    }
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,190 @@
+// Copyright (c) 2021 Eduardo Ponz Segrelles.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <easynmea/data.hpp>
+#include <easynmea/types.hpp>
+#include <EasyNmeaCoder.hpp>
+#include <GSAMerger.hpp>
+
+using namespace eduponz::easynmea;
+
+/**
+ * Decode a GSA sentence into the part it carries.
+ */
+GSAPart part(
+        const std::string& sentence)
+{
+    DecodeResult result = EasyNmeaCoder::decode(sentence);
+    const GSAPart* gsa = result.get<GSAPart>();
+    EXPECT_NE(gsa, nullptr) << sentence;
+    return gsa != nullptr ? *gsa : GSAPart();
+}
+
+//! The GPS and GLONASS sentences of an epoch
+const std::vector<std::string> epoch = {
+    "$GNGSA,A,3,10,18,27,08,11,,,,,,,,2.19,1.97,0.95*10",
+    "$GNGSA,A,3,68,74,,,,,,,,,,,2.19,1.97,0.95*18"};
+
+//! The GPS and GLONASS sentences of the next epoch
+const std::vector<std::string> next_epoch = {
+    "$GNGSA,A,3,10,18,27,08,11,,,,,,,,1.59,1.28,0.94*12",
+    "$GNGSA,A,3,68,75,74,,,,,,,,,,1.59,1.28,0.94*18"};
+
+TEST(GSAMergerTests, mergeEpoch)
+{
+    GSAMerger merger;
+    GSAData gsa;
+    ASSERT_FALSE(merger.add(part(epoch[0]), gsa));
+    ASSERT_FALSE(merger.add(part(epoch[1]), gsa));
+    ASSERT_EQ(gsa, GSAData());
+
+    ASSERT_TRUE(merger.flush(gsa));
+    ASSERT_EQ(gsa.kind, NMEA0183DataKind::GSA);
+    ASSERT_EQ(gsa.talker, NMEA0183Talker::GN);
+    ASSERT_EQ(gsa.selection_mode, 'A');
+    ASSERT_EQ(gsa.fix_type, 3u);
+    ASSERT_FLOAT_EQ(gsa.pdop, 2.19f);
+    ASSERT_FLOAT_EQ(gsa.hdop, 1.97f);
+    ASSERT_FLOAT_EQ(gsa.vdop, 0.95f);
+    ASSERT_EQ(gsa.system_count, 2u);
+    ASSERT_EQ(gsa.systems[0].system_id, '\0');
+    ASSERT_EQ(gsa.systems[0].prn_count, 5u);
+    ASSERT_EQ(gsa.systems[0].prns[4], 11u);
+    ASSERT_EQ(gsa.systems[1].prn_count, 2u);
+    ASSERT_EQ(gsa.systems[1].prns[0], 68u);
+    ASSERT_EQ(gsa.systems[1].prns[1], 74u);
+}
+
+TEST(GSAMergerTests, mergeSystemIds)
+{
+    GSAMerger merger;
+    GSAData gsa;
+    ASSERT_FALSE(merger.add(part("$GNGSA,A,3,10,18,27,08,11,,,,,,,,2.19,1.97,0.95,1*0D"), gsa));
+    ASSERT_FALSE(merger.add(part("$GNGSA,A,3,68,74,,,,,,,,,,,2.19,1.97,0.95,2*06"), gsa));
+    ASSERT_TRUE(merger.flush(gsa));
+    ASSERT_EQ(gsa.system_count, 2u);
+    ASSERT_EQ(gsa.systems[0].system_id, '1');
+    ASSERT_EQ(gsa.systems[1].system_id, '2');
+}
+
+TEST(GSAMergerTests, splitDifferentEpochs)
+{
+    /* A part of the next epoch completes the sample in progress */
+    GSAMerger merger;
+    GSAData gsa;
+    ASSERT_FALSE(merger.add(part(epoch[0]), gsa));
+    ASSERT_FALSE(merger.add(part(epoch[1]), gsa));
+    ASSERT_TRUE(merger.add(part(next_epoch[0]), gsa));
+    ASSERT_FLOAT_EQ(gsa.pdop, 2.19f);
+    ASSERT_EQ(gsa.system_count, 2u);
+    ASSERT_FALSE(merger.add(part(next_epoch[1]), gsa));
+    ASSERT_TRUE(merger.flush(gsa));
+    ASSERT_FLOAT_EQ(gsa.pdop, 1.59f);
+    ASSERT_EQ(gsa.system_count, 2u);
+    ASSERT_EQ(gsa.systems[1].prn_count, 3u);
+
+    /* So does a part with a different fix type */
+    ASSERT_FALSE(merger.add(part(epoch[0]), gsa));
+    ASSERT_TRUE(merger.add(part("$GNGSA,A,2,10,18,27,08,11,,,,,,,,2.19,1.97,0.95*11"), gsa));
+    ASSERT_EQ(gsa.fix_type, 3u);
+    ASSERT_EQ(gsa.system_count, 1u);
+    ASSERT_TRUE(merger.flush(gsa));
+    ASSERT_EQ(gsa.fix_type, 2u);
+
+    /* And a part of a different talker */
+    ASSERT_FALSE(merger.add(part(epoch[0]), gsa));
+    ASSERT_TRUE(merger.add(part("$GPGSA,A,1,,,,,,,,,,,,,99.99,99.99,99.99*30"), gsa));
+    ASSERT_EQ(gsa.talker, NMEA0183Talker::GN);
+    ASSERT_TRUE(merger.flush(gsa));
+    ASSERT_EQ(gsa.talker, NMEA0183Talker::GP);
+}
+
+TEST(GSAMergerTests, splitRepeatedSystemId)
+{
+    /* A system ID can only appear once per sample */
+    GSAMerger merger;
+    GSAData gsa;
+    ASSERT_FALSE(merger.add(part("$GNGSA,A,3,10,18,27,08,11,,,,,,,,2.19,1.97,0.95,1*0D"), gsa));
+    ASSERT_TRUE(merger.add(part("$GNGSA,A,3,68,74,,,,,,,,,,,2.19,1.97,0.95,1*05"), gsa));
+    ASSERT_EQ(gsa.system_count, 1u);
+    ASSERT_TRUE(merger.flush(gsa));
+    ASSERT_EQ(gsa.system_count, 1u);
+    ASSERT_EQ(gsa.systems[0].prns[0], 68u);
+}
+
+TEST(GSAMergerTests, splitFullSample)
+{
+    /* A part which does not fit in the sample in progress completes it */
+    GSAMerger merger;
+    GSAData gsa;
+    for (std::size_t i = 0; i < GSAData::MAX_SYSTEMS; i++)
+    {
+        ASSERT_FALSE(merger.add(part(epoch[0]), gsa));
+    }
+    ASSERT_TRUE(merger.add(part(epoch[0]), gsa));
+    ASSERT_EQ(gsa.system_count, GSAData::MAX_SYSTEMS);
+    ASSERT_TRUE(merger.flush(gsa));
+    ASSERT_EQ(gsa.system_count, 1u);
+}
+
+TEST(GSAMergerTests, flush)
+{
+    /* Nothing is flushed without a sample in progress */
+    GSAMerger merger;
+    GSAData gsa;
+    ASSERT_FALSE(merger.flush(gsa));
+    ASSERT_EQ(gsa, GSAData());
+
+    /* A sample is only flushed once */
+    ASSERT_FALSE(merger.add(part(epoch[0]), gsa));
+    ASSERT_TRUE(merger.flush(gsa));
+    ASSERT_EQ(gsa.system_count, 1u);
+    ASSERT_FALSE(merger.flush(gsa));
+
+    /* A flushed sample is not merged with the parts of the next one */
+    ASSERT_FALSE(merger.add(part(epoch[1]), gsa));
+    ASSERT_TRUE(merger.flush(gsa));
+    ASSERT_EQ(gsa.system_count, 1u);
+    ASSERT_EQ(gsa.systems[0].prns[0], 68u);
+}
+
+TEST(GSAMergerTests, clear)
+{
+    /* Clearing the merger discards the sample in progress */
+    GSAMerger merger;
+    GSAData gsa;
+    ASSERT_FALSE(merger.add(part(epoch[0]), gsa));
+    merger.clear();
+    ASSERT_FALSE(merger.flush(gsa));
+    ASSERT_EQ(gsa, GSAData());
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
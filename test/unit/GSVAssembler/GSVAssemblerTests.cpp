@@ -0,0 +1,248 @@
+// Copyright (c) 2021 Eduardo Ponz Segrelles.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <easynmea/data.hpp>
+#include <easynmea/types.hpp>
+#include <EasyNmeaCoder.hpp>
+#include <GSVAssembler.hpp>
+
+using namespace eduponz::easynmea;
+
+/**
+ * Decode a GSV sentence into the part it carries.
+ */
+GSVPart part(
+        const std::string& sentence)
+{
+    DecodeResult result = EasyNmeaCoder::decode(sentence);
+    const GSVPart* gsv = result.get<GSVPart>();
+    EXPECT_NE(gsv, nullptr) << sentence;
+    return gsv != nullptr ? *gsv : GSVPart();
+}
+
+//! A GPS group of four parts
+const std::vector<std::string> gps_group = {
+    "$GPGSV,4,1,15,08,73,227,31,10,57,079,18,27,53,156,26,18,49,264,32*75",
+    "$GPGSV,4,2,15,11,36,278,15,20,32,060,16,01,22,265,,32,20,127,17*74",
+    "$GPGSV,4,3,15,28,19,326,,14,07,142,,15,06,021,,22,05,216,*7B",
+    "$GPGSV,4,4,15,21,03,089,,30,02,299,,16,01,187,*47"};
+
+//! A GLONASS group of three parts
+const std::vector<std::string> glonass_group = {
+    "$GLGSV,3,1,09,83,66,096,15,68,55,138,21,84,50,304,,67,42,045,*61",
+    "$GLGSV,3,2,09,75,23,333,,74,21,275,16,69,16,180,,82,15,112,*67",
+    "$GLGSV,3,3,09,76,06,014,*5E"};
+
+TEST(GSVAssemblerTests, assembleGroup)
+{
+    GSVAssembler assembler;
+    for (std::size_t i = 0; i < gps_group.size() - 1; i++)
+    {
+        ASSERT_EQ(assembler.add(part(gps_group[i])), nullptr) << gps_group[i];
+    }
+    const GSVData* table = assembler.add(part(gps_group.back()));
+    ASSERT_NE(table, nullptr);
+    ASSERT_EQ(table->kind, NMEA0183DataKind::GSV);
+    ASSERT_EQ(table->talker, NMEA0183Talker::GP);
+    ASSERT_EQ(table->satellites_in_view, 15u);
+    ASSERT_EQ(table->signal_id, '\0');
+    ASSERT_EQ(table->satellite_count, 15u);
+
+    /* The satellites keep the order of the sentences */
+    const uint16_t prns[] = {8, 10, 27, 18, 11, 20, 1, 32, 28, 14, 15, 22, 21, 30, 16};
+    for (std::size_t i = 0; i < table->satellite_count; i++)
+    {
+        ASSERT_EQ(table->satellites[i].prn, prns[i]) << i;
+    }
+    ASSERT_EQ(table->satellites[0].elevation, 73);
+    ASSERT_EQ(table->satellites[0].azimuth, 227);
+    ASSERT_EQ(table->satellites[0].snr, 31);
+    ASSERT_EQ(table->satellites[14].snr, -1);
+
+    /* The next group starts a new table */
+    for (std::size_t i = 0; i < gps_group.size() - 1; i++)
+    {
+        ASSERT_EQ(assembler.add(part(gps_group[i])), nullptr) << gps_group[i];
+    }
+    table = assembler.add(part(gps_group.back()));
+    ASSERT_NE(table, nullptr);
+    ASSERT_EQ(table->satellite_count, 15u);
+}
+
+TEST(GSVAssemblerTests, assembleSinglePart)
+{
+    GSVAssembler assembler;
+    const GSVData* table = assembler.add(part("$GAGSV,1,1,01,05,45,090,35,7*49"));
+    ASSERT_NE(table, nullptr);
+    ASSERT_EQ(table->talker, NMEA0183Talker::GA);
+    ASSERT_EQ(table->signal_id, '7');
+    ASSERT_EQ(table->satellite_count, 1u);
+    ASSERT_EQ(table->satellites[0].prn, 5u);
+
+    /* A group without satellites yields an empty table */
+    table = assembler.add(part("$GPGSV,1,1,00*79"));
+    ASSERT_NE(table, nullptr);
+    ASSERT_EQ(table->talker, NMEA0183Talker::GP);
+    ASSERT_EQ(table->satellite_count, 0u);
+}
+
+TEST(GSVAssemblerTests, assembleInterleavedTalkers)
+{
+    /* Each talker has its own table in progress */
+    GSVAssembler assembler;
+    ASSERT_EQ(assembler.add(part(gps_group[0])), nullptr);
+    ASSERT_EQ(assembler.add(part(glonass_group[0])), nullptr);
+    ASSERT_EQ(assembler.add(part(gps_group[1])), nullptr);
+    ASSERT_EQ(assembler.add(part(glonass_group[1])), nullptr);
+    ASSERT_EQ(assembler.add(part(gps_group[2])), nullptr);
+
+    const GSVData* table = assembler.add(part(glonass_group[2]));
+    ASSERT_NE(table, nullptr);
+    ASSERT_EQ(table->talker, NMEA0183Talker::GL);
+    ASSERT_EQ(table->satellite_count, 9u);
+    ASSERT_EQ(table->satellites[8].prn, 76u);
+
+    table = assembler.add(part(gps_group[3]));
+    ASSERT_NE(table, nullptr);
+    ASSERT_EQ(table->talker, NMEA0183Talker::GP);
+    ASSERT_EQ(table->satellite_count, 15u);
+}
+
+TEST(GSVAssemblerTests, assembleTagBlock)
+{
+    /* The table keeps the tag block of the first part of its group */
+    GSVAssembler assembler;
+    ASSERT_EQ(assembler.add(part("\\s:GPS1,c:1609459200*4D\\" + glonass_group[0])), nullptr);
+    ASSERT_EQ(assembler.add(part("\\c:1609459201*5C\\" + glonass_group[1])), nullptr);
+    const GSVData* table = assembler.add(part(glonass_group[2]));
+    ASSERT_NE(table, nullptr);
+    ASSERT_STREQ(table->tag_block.source, "GPS1");
+    ASSERT_EQ(table->tag_block.unix_time_ms, 1609459200000);
+
+    /* Groups without tag block yield an empty one */
+    for (std::size_t i = 0; i < glonass_group.size() - 1; i++)
+    {
+        ASSERT_EQ(assembler.add(part(glonass_group[i])), nullptr) << glonass_group[i];
+    }
+    table = assembler.add(part(glonass_group.back()));
+    ASSERT_NE(table, nullptr);
+    ASSERT_TRUE(table->tag_block.empty());
+}
+
+TEST(GSVAssemblerTests, discardMissingPart)
+{
+    /* A group with a missing part is discarded */
+    GSVAssembler assembler;
+    ASSERT_EQ(assembler.add(part(gps_group[0])), nullptr);
+    ASSERT_EQ(assembler.add(part(gps_group[2])), nullptr);
+    ASSERT_EQ(assembler.add(part(gps_group[3])), nullptr);
+
+    /* A group without its first part is discarded */
+    ASSERT_EQ(assembler.add(part(gps_group[1])), nullptr);
+    ASSERT_EQ(assembler.add(part(gps_group[2])), nullptr);
+    ASSERT_EQ(assembler.add(part(gps_group[3])), nullptr);
+
+    /* Repeated parts are missing ones too */
+    ASSERT_EQ(assembler.add(part(glonass_group[0])), nullptr);
+    ASSERT_EQ(assembler.add(part(glonass_group[1])), nullptr);
+    ASSERT_EQ(assembler.add(part(glonass_group[1])), nullptr);
+    ASSERT_EQ(assembler.add(part(glonass_group[2])), nullptr);
+}
+
+TEST(GSVAssemblerTests, discardRestartedGroup)
+{
+    /* A new group discards the incomplete one */
+    GSVAssembler assembler;
+    ASSERT_EQ(assembler.add(part(gps_group[0])), nullptr);
+    ASSERT_EQ(assembler.add(part(gps_group[1])), nullptr);
+    for (std::size_t i = 0; i < gps_group.size() - 1; i++)
+    {
+        ASSERT_EQ(assembler.add(part(gps_group[i])), nullptr) << gps_group[i];
+    }
+    const GSVData* table = assembler.add(part(gps_group.back()));
+    ASSERT_NE(table, nullptr);
+    ASSERT_EQ(table->satellite_count, 15u);
+}
+
+TEST(GSVAssemblerTests, discardInconsistentPart)
+{
+    /* The parts of a group must agree on the number of parts */
+    GSVAssembler assembler;
+    ASSERT_EQ(assembler.add(part("$GPGSV,2,1,07,04,15,270,42,06,01,010,,13,06,292,00,16,40,045,38*7C")), nullptr);
+    ASSERT_EQ(assembler.add(part(gps_group[1])), nullptr);
+
+    /* The parts of a group must agree on the signal */
+    ASSERT_EQ(assembler.add(part("$GPGSV,2,1,07,04,15,270,42,06,01,010,,13,06,292,00,16,40,045,38*7C")), nullptr);
+    ASSERT_EQ(assembler.add(part("$GPGSV,2,2,07,20,10,180,30,25,,,,29,77,300,45,1*64")), nullptr);
+
+    ASSERT_EQ(assembler.add(part("$GPGSV,2,1,07,04,15,270,42,06,01,010,,13,06,292,00,16,40,045,38*7C")), nullptr);
+    const GSVData* table = assembler.add(part("$GPGSV,2,2,07,20,10,180,30,25,,,,29,77,300,45*79"));
+    ASSERT_NE(table, nullptr);
+    ASSERT_EQ(table->satellite_count, 7u);
+}
+
+TEST(GSVAssemblerTests, discardInvalidPart)
+{
+    GSVAssembler assembler;
+
+    /* Part number over the number of parts */
+    GSVPart gsv = part("$GAGSV,1,1,01,05,45,090,35,7*49");
+    gsv.part_number = 2;
+    ASSERT_EQ(assembler.add(gsv), nullptr);
+
+    /* More parts than fit in a table */
+    gsv = part("$GAGSV,1,1,01,05,45,090,35,7*49");
+    gsv.total_parts = 10;
+    ASSERT_EQ(assembler.add(gsv), nullptr);
+
+    /* More satellites than fit in a part */
+    gsv = part("$GAGSV,1,1,01,05,45,090,35,7*49");
+    gsv.satellite_count = 5;
+    ASSERT_EQ(assembler.add(gsv), nullptr);
+
+    /* Talker out of the enumeration */
+    gsv = part("$GAGSV,1,1,01,05,45,090,35,7*49");
+    gsv.talker = static_cast<NMEA0183Talker>(200);
+    ASSERT_EQ(assembler.add(gsv), nullptr);
+}
+
+TEST(GSVAssemblerTests, clear)
+{
+    /* Clearing the assembler discards the tables in progress */
+    GSVAssembler assembler;
+    ASSERT_EQ(assembler.add(part(gps_group[0])), nullptr);
+    ASSERT_EQ(assembler.add(part(gps_group[1])), nullptr);
+    assembler.clear();
+    ASSERT_EQ(assembler.add(part(gps_group[2])), nullptr);
+    ASSERT_EQ(assembler.add(part(gps_group[3])), nullptr);
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
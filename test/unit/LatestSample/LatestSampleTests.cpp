@@ -0,0 +1,210 @@
+// Copyright (c) 2021 Eduardo Ponz Segrelles.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <easynmea/data.hpp>
+#include <LatestSample.hpp>
+
+using namespace eduponz::easynmea;
+
+/**
+ * Sample spanning several words, all of them holding the same value, so that a torn copy can be
+ * told from a consistent one.
+ */
+struct WideSample
+{
+    uint64_t words[5] = {};
+
+    bool consistent() const
+    {
+        for (uint64_t word : words)
+        {
+            if (word != words[0])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+};
+
+/**
+ * A LatestSample whose sequence number can be set, to start it close to where a narrower one would
+ * wrap around
+ */
+template<class T>
+class LatestSampleTest : public LatestSample<T>
+{
+public:
+
+    void set_sequence(
+            uint64_t sequence)
+    {
+        this->sequence_.store(sequence);
+    }
+
+};
+
+TEST(LatestSampleTests, loadWithoutSample)
+{
+    LatestSample<HDTData> latest;
+    HDTData hdt;
+    hdt.heading = 10.0f;
+    ASSERT_FALSE(latest.load(hdt));
+    ASSERT_EQ(hdt.heading, 10.0f);
+}
+
+TEST(LatestSampleTests, storeAndLoad)
+{
+    LatestSample<HDTData> latest;
+    HDTData hdt;
+    hdt.heading = 274.07f;
+    hdt.talker = NMEA0183Talker::GN;
+    latest.store(hdt);
+
+    /* The sample is not taken, so it can be loaded any number of times */
+    for (int i = 0; i < 3; i++)
+    {
+        HDTData loaded;
+        ASSERT_TRUE(latest.load(loaded));
+        ASSERT_EQ(loaded, hdt);
+    }
+
+    /* Only the latest sample is kept */
+    hdt.heading = 275.0f;
+    latest.store(hdt);
+    HDTData loaded;
+    ASSERT_TRUE(latest.load(loaded));
+    ASSERT_EQ(loaded, hdt);
+}
+
+TEST(LatestSampleTests, storeLargeSample)
+{
+    /* Samples whose size is not a multiple of the word size are copied exactly */
+    LatestSample<THSData> latest;
+    THSData ths;
+    ths.heading = 12.5f;
+    ths.mode = 'E';
+    std::strcpy(ths.tag_block.source, "GPS1");
+    latest.store(ths);
+    THSData loaded;
+    ASSERT_TRUE(latest.load(loaded));
+    ASSERT_EQ(loaded, ths);
+}
+
+TEST(LatestSampleTests, clear)
+{
+    LatestSample<ROTData> latest;
+    ROTData rot;
+    rot.rate_of_turn = -3.5f;
+    latest.store(rot);
+    latest.clear();
+    ROTData loaded;
+    ASSERT_FALSE(latest.load(loaded));
+    ASSERT_EQ(loaded, ROTData());
+
+    /* A sample stored after clearing is loaded again */
+    latest.store(rot);
+    ASSERT_TRUE(latest.load(loaded));
+    ASSERT_EQ(loaded, rot);
+}
+
+TEST(LatestSampleTests, storeSequenceWrap)
+{
+    /* The samples stored after 2^31 others, where a 32 bit sequence number would wrap around to 0, are
+       loaded as any other */
+    LatestSampleTest<HDTData> latest;
+    latest.set_sequence(UINT32_MAX - 3);
+    HDTData hdt;
+    for (int i = 0; i < 4; i++)
+    {
+        hdt.heading = static_cast<float>(i);
+        latest.store(hdt);
+        HDTData loaded;
+        ASSERT_TRUE(latest.load(loaded)) << i;
+        ASSERT_EQ(loaded, hdt);
+    }
+}
+
+TEST(LatestSampleTests, concurrentReaders)
+{
+    /* The readers never get a torn sample, nor a sample older than the last one they got */
+    LatestSample<WideSample> latest;
+    std::atomic<bool> done(false);
+    std::atomic<bool> failed(false);
+
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 3; i++)
+    {
+        readers.emplace_back([&]()
+                {
+                    uint64_t last = 0;
+                    while (!done.load())
+                    {
+                        WideSample sample;
+                        if (latest.load(sample))
+                        {
+                            if (!sample.consistent() || sample.words[0] < last)
+                            {
+                                failed.store(true);
+                            }
+                            last = sample.words[0];
+                        }
+                    }
+                });
+    }
+
+    WideSample sample;
+    for (uint64_t value = 1; value <= 200000; value++)
+    {
+        for (uint64_t& word : sample.words)
+        {
+            word = value;
+        }
+        latest.store(sample);
+    }
+    done.store(true);
+    for (std::thread& reader : readers)
+    {
+        reader.join();
+    }
+
+    ASSERT_FALSE(failed.load());
+    WideSample loaded;
+    ASSERT_TRUE(latest.load(loaded));
+    ASSERT_TRUE(loaded.consistent());
+    ASSERT_EQ(loaded.words[0], 200000u);
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,92 @@
+// Copyright (c) 2021 Eduardo Ponz Segrelles.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <array>
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+#include <PerfectHashTable.hpp>
+
+using namespace eduponz::easynmea;
+
+/**
+ * Pack three characters as the sentence formatters are packed.
+ */
+constexpr uint32_t code(
+        const char* formatter)
+{
+    return static_cast<uint32_t>(formatter[0]) | (static_cast<uint32_t>(formatter[1]) << 8) |
+           (static_cast<uint32_t>(formatter[2]) << 16);
+}
+
+//! Table with the formatters of the most common NMEA 0183 sentences, mapped to their position
+using Table = PerfectHashTable<int, 16>;
+constexpr Table table(std::array<Table::Item, 16>{{
+    {code("GGA"), 0}, {code("RMC"), 1}, {code("GSV"), 2}, {code("GSA"), 3},
+    {code("GLL"), 4}, {code("VTG"), 5}, {code("ZDA"), 6}, {code("GST"), 7},
+    {code("HDT"), 8}, {code("THS"), 9}, {code("ROT"), 10}, {code("GNS"), 11},
+    {code("VDM"), 12}, {code("VDO"), 13}, {code("TXT"), 14}, {code("DTM"), 15}
+}});
+
+TEST(PerfectHashTableTests, findKeys)
+{
+    const char* formatters[] = {
+        "GGA", "RMC", "GSV", "GSA", "GLL", "VTG", "ZDA", "GST", "HDT", "THS", "ROT", "GNS", "VDM", "VDO", "TXT", "DTM"};
+    for (int i = 0; i < 16; i++)
+    {
+        const int* value = table.find(code(formatters[i]));
+        ASSERT_NE(value, nullptr) << formatters[i];
+        ASSERT_EQ(*value, i) << formatters[i];
+    }
+}
+
+TEST(PerfectHashTableTests, findMissingKeys)
+{
+    const char* formatters[] = {"GGB", "AGG", "gga", "RMB", "XTE", "\0\0\0"};
+    for (const char* formatter : formatters)
+    {
+        ASSERT_EQ(table.find(code(formatter)), nullptr) << formatter;
+    }
+
+    /* Every key of a sparse table */
+    using SparseTable = PerfectHashTable<int, 1, 3>;
+    constexpr SparseTable sparse(std::array<SparseTable::Item, 1>{{{0, 42}}});
+    ASSERT_NE(sparse.find(0), nullptr);
+    ASSERT_EQ(*sparse.find(0), 42);
+    for (uint32_t key = 1; key < 100000; key++)
+    {
+        ASSERT_EQ(sparse.find(key), nullptr) << key;
+    }
+}
+
+TEST(PerfectHashTableTests, compileTimeLookup)
+{
+    static_assert(*table.find(code("GST")) == 7, "Lookups can be resolved at compile time");
+    static_assert(table.find(code("XXX")) == nullptr, "Missing keys can be resolved at compile time");
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
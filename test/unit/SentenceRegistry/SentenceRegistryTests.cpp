@@ -0,0 +1,128 @@
+// Copyright (c) 2021 Eduardo Ponz Segrelles.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <string>
+#include <string_view>
+
+#include <gtest/gtest.h>
+
+#include <SentenceRegistry.hpp>
+
+using namespace eduponz::easynmea;
+
+//! Decoders which tell which of them was called through the talker of the returned sentence
+DecodeResult decode_first(
+        std::string_view sentence)
+{
+    RawSentence raw;
+    raw.sentence = sentence;
+    raw.talker = NMEA0183Talker::GP;
+    return DecodeResult(raw);
+}
+
+DecodeResult decode_second(
+        std::string_view sentence)
+{
+    RawSentence raw;
+    raw.sentence = sentence;
+    raw.talker = NMEA0183Talker::GL;
+    return DecodeResult(raw);
+}
+
+TEST(SentenceRegistryTests, add)
+{
+    SentenceRegistry registry;
+    ASSERT_EQ(registry.size(), 0u);
+    ASSERT_TRUE(registry.add("PGRME", decode_first));
+    ASSERT_TRUE(registry.add("PUBX", decode_second));
+    ASSERT_TRUE(registry.add("PSRF1500", decode_first));
+    ASSERT_TRUE(registry.add("", decode_second));
+    ASSERT_EQ(registry.size(), 4u);
+
+    /* Repeated and invalid addresses */
+    ASSERT_FALSE(registry.add("PGRME", decode_second));
+    ASSERT_FALSE(registry.add("", decode_first));
+    ASSERT_FALSE(registry.add("PSRF15000", decode_first));
+    ASSERT_FALSE(registry.add("pgrme", decode_first));
+    ASSERT_FALSE(registry.add("$PGRMZ", decode_first));
+    ASSERT_FALSE(registry.add("PGRMZ", nullptr));
+    ASSERT_EQ(registry.size(), 4u);
+
+    /* Full registry */
+    for (std::size_t i = registry.size(); i < SentenceRegistry::CAPACITY; i++)
+    {
+        ASSERT_TRUE(registry.add("PX" + std::to_string(i), decode_first));
+    }
+    ASSERT_FALSE(registry.add("PGRMZ", decode_first));
+    ASSERT_EQ(registry.size(), SentenceRegistry::CAPACITY);
+}
+
+TEST(SentenceRegistryTests, find)
+{
+    SentenceRegistry registry;
+    ASSERT_EQ(registry.find("$PGRME"), SentenceRegistry::NOT_FOUND);
+    ASSERT_TRUE(registry.add("PGRME", decode_first));
+    ASSERT_TRUE(registry.add("PUBX", decode_second));
+
+    /* The start mark is ignored, so both parametric and encapsulation sentences match */
+    ASSERT_EQ(registry.find("$PGRME"), 0u);
+    ASSERT_EQ(registry.find("!PGRME"), 0u);
+    ASSERT_EQ(registry.find("$PUBX"), 1u);
+    ASSERT_EQ(registry.decoder(registry.find("$PUBX"))("$PUBX,00*33").get<RawSentence>()->talker,
+            NMEA0183Talker::GL);
+
+    /* Addresses which are prefixes of the registered ones, or the other way round, do not match */
+    const char* missing[] = {"$PGRM", "$PGRMEX", "$PUB", "$", "", "$PSRF150000", "$GPGGA"};
+    for (const char* address : missing)
+    {
+        ASSERT_EQ(registry.find(address), SentenceRegistry::NOT_FOUND) << address;
+    }
+
+    /* The catch-all decoder matches every other address, regardless of its position */
+    ASSERT_TRUE(registry.add("", decode_second));
+    ASSERT_TRUE(registry.add("PSRF", decode_first));
+    for (const char* address : missing)
+    {
+        ASSERT_EQ(registry.find(address), 2u) << address;
+    }
+    ASSERT_EQ(registry.find("$PGRME"), 0u);
+    ASSERT_EQ(registry.find("$PSRF"), 3u);
+}
+
+TEST(SentenceRegistryTests, clear)
+{
+    SentenceRegistry registry;
+    ASSERT_TRUE(registry.add("PGRME", decode_first));
+    ASSERT_TRUE(registry.add("", decode_second));
+    registry.clear();
+    ASSERT_EQ(registry.size(), 0u);
+    ASSERT_EQ(registry.find("$PGRME"), SentenceRegistry::NOT_FOUND);
+    ASSERT_EQ(registry.find("$PUBX"), SentenceRegistry::NOT_FOUND);
+    ASSERT_TRUE(registry.add("PGRME", decode_second));
+    ASSERT_EQ(registry.find("$PGRME"), 0u);
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,512 @@
+// Copyright (c) 2021 Eduardo Ponz Segrelles.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <easynmea/data.hpp>
+#include <easynmea/types.hpp>
+#include <EasyNmeaCoder.hpp>
+#include <SentenceSchema.hpp>
+
+using namespace eduponz::easynmea;
+
+//! Data of a made up sentence, with a field of each kind
+struct ExampleData
+{
+    NMEA0183Talker talker = NMEA0183Talker::UNKNOWN;
+    float time = 0;
+    int32_t time_ms = 0;
+    float latitude = 0;
+    int32_t latitude_e7 = 0;
+    uint16_t mode = 0;
+    float speed = -1;
+    uint16_t count = 0;
+};
+
+//! Schema of the made up sentence '$--XYZ,hhmmss.ss,DDMM.m,N,mode,speed,KN,count,*hh'
+using ExampleSchema = schema::Sentence<ExampleData, 'X', 'Y', 'Z',
+                schema::Time<&ExampleData::time, &ExampleData::time_ms, 2>,
+                schema::Latitude<&ExampleData::latitude, &ExampleData::latitude_e7>,
+                schema::Digit<&ExampleData::mode, '1', '3'>,
+                schema::Optional<schema::Decimal<&ExampleData::speed, true, 1>>,
+                schema::Literal<'K', 'N'>,
+                schema::Omittable<schema::Unsigned<&ExampleData::count>>>;
+
+//! Element of the repeated group of a made up list sentence
+struct ExampleItem
+{
+    uint16_t id = 0;
+    int16_t value = -1;
+};
+
+//! Data of a made up list sentence, with a repeated group of fields
+struct ExampleListData
+{
+    NMEA0183Talker talker = NMEA0183Talker::UNKNOWN;
+    uint16_t total = 0;
+    uint8_t item_count = 0;
+    ExampleItem items[2];
+    char flag = '\0';
+};
+
+//! Schema of the made up sentence '$--LST,total(,id,value)*(,flag)?*hh', with at most two items
+using ExampleListSchema = schema::Sentence<ExampleListData, 'L', 'S', 'T',
+                schema::List<
+                    schema::Unsigned<&ExampleListData::total>,
+                    schema::Repeated<&ExampleListData::items, &ExampleListData::item_count,
+                        schema::Unsigned<&ExampleItem::id>,
+                        schema::Optional<schema::Unsigned<&ExampleItem::value>>>,
+                    schema::Omittable<schema::Char<&ExampleListData::flag, 'A', 'B'>>>>;
+
+//! Data of a made up sentence with slots for up to three identifiers
+struct ExampleSlotsData
+{
+    NMEA0183Talker talker = NMEA0183Talker::UNKNOWN;
+    uint8_t id_count = 0;
+    uint16_t ids[3] = {};
+    uint16_t count = 0;
+};
+
+//! Schema of the made up sentence '$--SLT,id,id,id,count,*hh'
+using ExampleSlotsSchema = schema::Sentence<ExampleSlotsData, 'S', 'L', 'T',
+                schema::Slots<&ExampleSlotsData::ids, &ExampleSlotsData::id_count>,
+                schema::Unsigned<&ExampleSlotsData::count>>;
+
+/**
+ * Append the checksum to a sentence.
+ */
+std::string with_checksum(
+        const std::string& body)
+{
+    char checksum[4];
+    std::snprintf(checksum, sizeof(checksum), "*%02X", Checksum::compute(body.data() + 1, body.size() - 1));
+    return body + checksum;
+}
+
+/**
+ * Encode a made up sentence into a string.
+ */
+std::string encode(
+        const ExampleData& data)
+{
+    char buffer[128];
+    return std::string(buffer, ExampleSchema::encode(data, buffer, sizeof(buffer)));
+}
+
+TEST(SentenceSchemaTests, decodeFields)
+{
+    ExampleData data;
+    ASSERT_TRUE(ExampleSchema::decode(with_checksum("$GPXYZ,123456.50,4530.000,S,2,-1.5,KN,7,"), data));
+    ASSERT_EQ(data.talker, NMEA0183Talker::GP);
+    ASSERT_FLOAT_EQ(data.time, 123456.5f);
+    ASSERT_EQ(data.time_ms, 45296500);
+    ASSERT_FLOAT_EQ(data.latitude, -45.5f);
+    ASSERT_EQ(data.latitude_e7, -455000000);
+    ASSERT_EQ(data.mode, 2u);
+    ASSERT_FLOAT_EQ(data.speed, -1.5f);
+    ASSERT_EQ(data.count, 7u);
+
+    /* The formatter is exposed as a string */
+    ASSERT_STREQ(ExampleSchema::formatter, "XYZ");
+}
+
+TEST(SentenceSchemaTests, decodeOptionalFields)
+{
+    /* Empty optional field and missing omittable field keep their default values */
+    ExampleData data;
+    ASSERT_TRUE(ExampleSchema::decode(with_checksum("$GNXYZ,123456,4530.0,N,1,,KN,"), data));
+    ASSERT_EQ(data.talker, NMEA0183Talker::GN);
+    ASSERT_FLOAT_EQ(data.time, 123456.0f);
+    ASSERT_EQ(data.time_ms, 45296000);
+    ASSERT_EQ(data.latitude_e7, 455000000);
+    ASSERT_EQ(data.mode, 1u);
+    ASSERT_FLOAT_EQ(data.speed, -1.0f);
+    ASSERT_EQ(data.count, 0u);
+
+    /* Omittable field present with an empty optional field */
+    data = ExampleData();
+    ASSERT_TRUE(ExampleSchema::validate(with_checksum("$GNXYZ,123456,4530.0,N,1,,KN,12,")));
+    ASSERT_TRUE(ExampleSchema::decode(with_checksum("$GNXYZ,123456,4530.0,N,1,,KN,12,"), data));
+    ASSERT_EQ(data.count, 12u);
+}
+
+TEST(SentenceSchemaTests, decodeInvalidFields)
+{
+    const std::vector<std::string> sentences = {
+        with_checksum("$GPXYZ,12345,4530.0,N,1,1.0,KN,"),        // Short time
+        with_checksum("$GPXYZ,123456.,4530.0,N,1,1.0,KN,"),      // Time without decimals
+        with_checksum("$GPXYZ,123456,9130.0,N,1,1.0,KN,"),       // Latitude out of range
+        with_checksum("$GPXYZ,123456,4530.0,E,1,1.0,KN,"),       // Wrong bearing
+        with_checksum("$GPXYZ,123456,4530.0,N,0,1.0,KN,"),       // Digit under range
+        with_checksum("$GPXYZ,123456,4530.0,N,4,1.0,KN,"),       // Digit over range
+        with_checksum("$GPXYZ,123456,4530.0,N,1,1,KN,"),         // Decimal without decimals
+        with_checksum("$GPXYZ,123456,4530.0,N,1,1.0,K,"),        // Incomplete literal
+        with_checksum("$GPXYZ,123456,4530.0,N,1,1.0,KN,7"),      // Omittable field without separator
+        with_checksum("$GPXYZ,123456,4530.0,N,1,1.0,KN,7,8,"),   // Extra field
+        with_checksum("$GPXYZ,123456,4530.0,N,1,1.0"),           // Missing fields
+        with_checksum("$XXXYZ,123456,4530.0,N,1,1.0,KN,"),       // Unknown talker
+        with_checksum("$GPXYW,123456,4530.0,N,1,1.0,KN,"),       // Wrong formatter
+        "$GPXYZ,123456,4530.0,N,1,1.0,KN,*00",                   // Wrong checksum
+        "$GPXYZ,123456,4530.0,N,1,1.0,KN,",                      // Missing checksum
+        ""};
+    for (const std::string& sentence : sentences)
+    {
+        ASSERT_FALSE(ExampleSchema::validate(sentence)) << sentence;
+    }
+
+    /* The scanner only checks the syntax of the checksum */
+    const std::string sentence = "$GPXYZ,123456,4530.0,N,1,1.0,KN,*00";
+    ExampleData data;
+    ASSERT_TRUE(ExampleSchema::scan(sentence.data(), sentence.data() + sentence.size(), data));
+}
+
+TEST(SentenceSchemaTests, encodeFields)
+{
+    ExampleData data;
+    data.talker = NMEA0183Talker::GP;
+    data.time_ms = 45296500;
+    data.latitude = -45.5f;
+    data.latitude_e7 = -455000000;
+    data.mode = 2;
+    data.speed = -1.5f;
+    data.count = 7;
+    ASSERT_EQ(encode(data), with_checksum("$GPXYZ,123456.50,4530.000000,S,2,-1.5,KN,7,"));
+
+    /* Values are rounded to the number of decimals of the field, and times are truncated */
+    data.time_ms = 5125;
+    data.speed = 0.04f;
+    ASSERT_EQ(encode(data), with_checksum("$GPXYZ,000005.12,4530.000000,S,2,0.0,KN,7,"));
+}
+
+TEST(SentenceSchemaTests, encodeOptionalFields)
+{
+    ExampleData data;
+    data.talker = NMEA0183Talker::GN;
+    data.time_ms = 45296000;
+    data.mode = 3;
+    ASSERT_EQ(encode(data), with_checksum("$GNXYZ,123456.00,0000.000000,N,3,,KN,"));
+
+    ExampleData decoded;
+    ASSERT_TRUE(ExampleSchema::decode(encode(data), decoded));
+    ASSERT_FLOAT_EQ(decoded.speed, -1.0f);
+    ASSERT_EQ(decoded.count, 0u);
+}
+
+TEST(SentenceSchemaTests, encodeInvalidData)
+{
+    ExampleData valid;
+    valid.talker = NMEA0183Talker::GP;
+    valid.mode = 1;
+    const std::string sentence = encode(valid);
+    ASSERT_FALSE(sentence.empty());
+
+    /* Buffers that are too small */
+    char buffer[128];
+    for (std::size_t size = 0; size < sentence.size(); size++)
+    {
+        ASSERT_EQ(ExampleSchema::encode(valid, buffer, size), 0u) << size;
+    }
+    ASSERT_EQ(ExampleSchema::encode(valid, buffer, sentence.size()), sentence.size());
+
+    /* Values that the sentence cannot represent */
+    ExampleData data = valid;
+    data.talker = NMEA0183Talker::UNKNOWN;
+    ASSERT_EQ(encode(data), "");
+
+    data = valid;
+    data.mode = 4;
+    ASSERT_EQ(encode(data), "");
+
+    data = valid;
+    data.time_ms = -1;
+    ASSERT_EQ(encode(data), "");
+
+    data = valid;
+    data.time_ms = 86401000;
+    ASSERT_EQ(encode(data), "");
+
+    data = valid;
+    data.speed = std::numeric_limits<float>::quiet_NaN();
+    ASSERT_EQ(encode(data), "");
+
+    data = valid;
+    data.speed = 1e10f;
+    ASSERT_EQ(encode(data), "");
+
+    data = valid;
+    data.latitude_e7 = 910000000;
+    ASSERT_EQ(encode(data), "");
+}
+
+TEST(SentenceSchemaTests, decodeTimeOfDay)
+{
+    const std::vector<std::pair<std::string, int32_t>> times = {
+        {"000000", 0},
+        {"000000.001", 1},
+        {"072705.5", 26825500},
+        {"235959.999", 86399999},
+        {"235959.9999", 86399999},   // Truncated, not rounded to the next day
+        {"235960.5", 86400500},      // Leap second
+        {"240000", -1},              // Hours out of range
+        {"126000", -1},              // Minutes out of range
+        {"123461", -1}};             // Seconds out of range
+
+    for (const auto& time : times)
+    {
+        ExampleData data;
+        ASSERT_TRUE(ExampleSchema::decode(with_checksum("$GPXYZ," + time.first + ",4530.0,N,1,,KN,"), data))
+            << time.first;
+        ASSERT_EQ(data.time_ms, time.second) << time.first;
+    }
+}
+
+TEST(SentenceSchemaTests, encodeTimeOfDay)
+{
+    const std::vector<std::pair<int32_t, std::string>> times = {
+        {0, "000000.00"},
+        {26825509, "072705.50"},
+        {86399999, "235959.99"},
+        {86400500, "235960.50"}};  // Leap second
+
+    for (const auto& time : times)
+    {
+        ExampleData data;
+        data.talker = NMEA0183Talker::GP;
+        data.mode = 1;
+        data.time_ms = time.first;
+        std::string sentence = encode(data);
+        ASSERT_EQ(sentence, with_checksum("$GPXYZ," + time.second + ",0000.000000,N,1,,KN,"));
+
+        /* Decoding yields the time truncated to the decimals of the field */
+        ExampleData decoded;
+        ASSERT_TRUE(ExampleSchema::decode(sentence, decoded)) << sentence;
+        ASSERT_EQ(decoded.time_ms, time.first / 10 * 10) << sentence;
+    }
+}
+
+TEST(SentenceSchemaTests, encodeAngles)
+{
+    const std::vector<std::pair<int32_t, std::string>> angles = {
+        {0, "0000.000000,N"},
+        {-1, "0000.000006,S"},
+        {570529000, "5703.174000,N"},
+        {-899999999, "8959.999994,S"},
+        {900000000, "90.0,N"},
+        {900050000, "8960.300000,N"},
+        {-900166666, "8960.999996,S"}};
+
+    for (const auto& angle : angles)
+    {
+        ExampleData data;
+        data.talker = NMEA0183Talker::GP;
+        data.mode = 1;
+        data.latitude_e7 = angle.first;
+        std::string sentence = encode(data);
+        ASSERT_EQ(sentence, with_checksum("$GPXYZ,000000.00," + angle.second + ",1,,KN,"));
+
+        ExampleData decoded;
+        ASSERT_TRUE(ExampleSchema::decode(sentence, decoded)) << sentence;
+        ASSERT_EQ(decoded.latitude_e7, angle.first) << sentence;
+    }
+
+    /* Every angle within range is written exactly */
+    std::mt19937 generator(11);
+    std::uniform_int_distribution<int32_t> distribution(-900000000, 900000000);
+    for (int i = 0; i < 10000; i++)
+    {
+        ExampleData data;
+        data.talker = NMEA0183Talker::GP;
+        data.mode = 1;
+        data.latitude_e7 = distribution(generator);
+        ExampleData decoded;
+        ASSERT_TRUE(ExampleSchema::decode(encode(data), decoded)) << encode(data);
+        ASSERT_EQ(decoded.latitude_e7, data.latitude_e7) << encode(data);
+    }
+}
+
+TEST(SentenceSchemaTests, encodeRoundTrip)
+{
+    /*
+     * Decoding an encoded GGA sentence yields the data of the original sentence. The angles are
+     * written from their value in units of 1e-7 degrees, so the angles in degrees are within 1e-7
+     * degrees of the original ones.
+     */
+    const std::vector<std::string> sentences = {
+        with_checksum("$GPGGA,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,,"),
+        with_checksum("$GNGGA,235959.99,3345.123456,S,17959.99999,W,2,12,0.8,1234.5,M,-33.25,M,2.2,"),
+        with_checksum("$GLGGA,000000,90.00,S,180.0,E,0,0,99.99,0.0,M,0.0,M,,65535,"),
+        with_checksum("$GAGGA,120000.5,0000.0001,N,00000.0001,W,1,3,1.0,-0.5,M,0.1,M,"),
+        with_checksum("$BDGGA,120000,8960.5,N,17960.25,E,1,3,1.0,1.0,M,1.0,M,")};
+
+    for (const std::string& sentence : sentences)
+    {
+        GPGGAData data;
+        ASSERT_TRUE(nmea0183::GGA_SCHEMA::decode(sentence, data)) << sentence;
+
+        char buffer[128];
+        std::size_t size = nmea0183::GGA_SCHEMA::encode(data, buffer, sizeof(buffer));
+        ASSERT_GT(size, 0u) << sentence;
+        std::string encoded(buffer, size);
+
+        GPGGAData decoded;
+        ASSERT_TRUE(nmea0183::GGA_SCHEMA::decode(encoded, decoded)) << encoded;
+        ASSERT_NEAR(decoded.latitude, data.latitude, 1e-7) << encoded;
+        ASSERT_NEAR(decoded.longitude, data.longitude, 1e-7) << encoded;
+        decoded.latitude = data.latitude;
+        decoded.longitude = data.longitude;
+        ASSERT_EQ(decoded, data) << sentence << " -> " << encoded;
+
+        /* Encoding the decoded data yields the same sentence */
+        ASSERT_EQ(nmea0183::GGA_SCHEMA::encode(decoded, buffer, sizeof(buffer)), size);
+        ASSERT_EQ(std::string(buffer, size), encoded);
+    }
+}
+
+TEST(SentenceSchemaTests, decodeRepeatedFields)
+{
+    /* No repetitions */
+    ExampleListData data;
+    ASSERT_TRUE(ExampleListSchema::decode(with_checksum("$GPLST,2"), data));
+    ASSERT_EQ(data.total, 2u);
+    ASSERT_EQ(data.item_count, 0u);
+    ASSERT_EQ(data.flag, '\0');
+
+    /* Repetitions with an empty optional field */
+    data = ExampleListData();
+    ASSERT_TRUE(ExampleListSchema::decode(with_checksum("$GPLST,2,1,5,2,"), data));
+    ASSERT_EQ(data.item_count, 2u);
+    ASSERT_EQ(data.items[0].id, 1u);
+    ASSERT_EQ(data.items[0].value, 5);
+    ASSERT_EQ(data.items[1].id, 2u);
+    ASSERT_EQ(data.items[1].value, -1);
+    ASSERT_EQ(data.flag, '\0');
+
+    /* A field following the repetitions is not taken for an incomplete repetition */
+    data = ExampleListData();
+    ASSERT_TRUE(ExampleListSchema::decode(with_checksum("$GPLST,1,7,3,B"), data));
+    ASSERT_EQ(data.item_count, 1u);
+    ASSERT_EQ(data.items[0].id, 7u);
+    ASSERT_EQ(data.flag, 'B');
+
+    const std::vector<std::string> sentences = {
+        with_checksum("$GPLST,3,1,5,2,,3,1"),   // More repetitions than elements in the array
+        with_checksum("$GPLST,1,1"),            // Incomplete repetition
+        with_checksum("$GPLST,1,1,5,"),         // Trailing separator
+        with_checksum("$GPLST,1,,5"),           // Empty mandatory field in a repetition
+        with_checksum("$GPLST,1,A,1,5")};       // Repetition after the last field
+    for (const std::string& sentence : sentences)
+    {
+        ASSERT_FALSE(ExampleListSchema::validate(sentence)) << sentence;
+    }
+}
+
+TEST(SentenceSchemaTests, encodeRepeatedFields)
+{
+    ExampleListData data;
+    data.talker = NMEA0183Talker::GA;
+    data.total = 2;
+    char buffer[64];
+    ASSERT_EQ(std::string(buffer, ExampleListSchema::encode(data, buffer, sizeof(buffer))),
+            with_checksum("$GALST,2"));
+
+    data.item_count = 2;
+    data.items[0].id = 1;
+    data.items[0].value = 5;
+    data.items[1].id = 2;
+    data.flag = 'A';
+    std::string encoded(buffer, ExampleListSchema::encode(data, buffer, sizeof(buffer)));
+    ASSERT_EQ(encoded, with_checksum("$GALST,2,1,5,2,,A"));
+
+    ExampleListData decoded;
+    ASSERT_TRUE(ExampleListSchema::decode(encoded, decoded));
+    ASSERT_EQ(decoded.item_count, 2u);
+    ASSERT_EQ(decoded.items[1].value, -1);
+    ASSERT_EQ(decoded.flag, 'A');
+
+    /* The count cannot exceed the number of elements in the array */
+    data.item_count = 3;
+    ASSERT_EQ(ExampleListSchema::encode(data, buffer, sizeof(buffer)), 0u);
+}
+
+TEST(SentenceSchemaTests, decodeSlotFields)
+{
+    /* The values of the non-empty slots are packed in order */
+    ExampleSlotsData data;
+    ASSERT_TRUE(ExampleSlotsSchema::decode(with_checksum("$GPSLT,,12,3,9,"), data));
+    ASSERT_EQ(data.id_count, 2u);
+    ASSERT_EQ(data.ids[0], 12u);
+    ASSERT_EQ(data.ids[1], 3u);
+    ASSERT_EQ(data.count, 9u);
+
+    data = ExampleSlotsData();
+    ASSERT_TRUE(ExampleSlotsSchema::decode(with_checksum("$GPSLT,,,,9,"), data));
+    ASSERT_EQ(data.id_count, 0u);
+
+    data = ExampleSlotsData();
+    ASSERT_TRUE(ExampleSlotsSchema::decode(with_checksum("$GPSLT,1,2,3,9,"), data));
+    ASSERT_EQ(data.id_count, 3u);
+    ASSERT_EQ(data.ids[2], 3u);
+
+    const std::vector<std::string> sentences = {
+        with_checksum("$GPSLT,1,2,9,"),       // Missing slot
+        with_checksum("$GPSLT,1,2,3,4,9,"),   // Extra slot
+        with_checksum("$GPSLT,1,A,3,9,")};    // Slot which is not a number
+    for (const std::string& sentence : sentences)
+    {
+        ASSERT_FALSE(ExampleSlotsSchema::validate(sentence)) << sentence;
+    }
+}
+
+TEST(SentenceSchemaTests, encodeSlotFields)
+{
+    ExampleSlotsData data;
+    data.talker = NMEA0183Talker::GP;
+    data.count = 9;
+    char buffer[64];
+    ASSERT_EQ(std::string(buffer, ExampleSlotsSchema::encode(data, buffer, sizeof(buffer))),
+            with_checksum("$GPSLT,,,,9,"));
+
+    /* The stored values are written first, and the rest of the slots are left empty */
+    data.id_count = 2;
+    data.ids[0] = 12;
+    data.ids[1] = 3;
+    ASSERT_EQ(std::string(buffer, ExampleSlotsSchema::encode(data, buffer, sizeof(buffer))),
+            with_checksum("$GPSLT,12,3,,9,"));
+
+    /* The count cannot exceed the number of slots */
+    data.id_count = 4;
+    ASSERT_EQ(ExampleSlotsSchema::encode(data, buffer, sizeof(buffer)), 0u);
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
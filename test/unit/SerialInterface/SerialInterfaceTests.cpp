@@ -18,6 +18,12 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 // THE SOFTWARE.
 
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
@@ -29,6 +35,7 @@ using namespace eduponz::easynmea;
 
 using ::testing::AtLeast;
 using ::testing::DoAll;
+using ::testing::Invoke;
 using ::testing::Return;
 using ::testing::SetArgReferee;
 
@@ -66,67 +73,91 @@ public:
     }
 
     /**
-     * Read a character from the serial port
+     * Read a chunk of bytes from the serial port
      *
-     * This function either reads a char using the implementation of
-     * SerialInterface<SerialPortMock>, or it returns the next character in msg_, moving the "next"
-     * index (char_count_) one position to the right.
-     * This is controlled with the \c use_parent_read_char_ flag.
+     * This function either reads a chunk using the implementation of
+     * SerialInterface<SerialPortMock>, or it returns the next chunk of msg_, moving the "next"
+     * index (char_count_) to the end of the chunk. The chunks are at most chunk_size_ long.
+     * This is controlled with the \c use_parent_read_chunk_ flag.
      *
-     * @param[out] c Reference to the char that will be populated with the read character
+     * @param[out] data Buffer that will be populated with the read bytes
+     * @param size Size of \c data
      * @param[out] ec Reference to the error_code returned that will be populated from the parent's
      *                implementation.
-     * @return The number of read characters.
+     * @return The number of read bytes.
      */
-    std::size_t read_char(
-            char& c,
+    std::size_t read_chunk(
+            char* data,
+            std::size_t size,
             asio::error_code& ec) noexcept override
     {
-        if (use_parent_read_char_)
+        read_chunk_calls_++;
+        if (use_parent_read_chunk_)
         {
-            return SerialInterface<SerialPortMock>::read_char(c, ec);
+            return SerialInterface<SerialPortMock>::read_chunk(data, size, ec);
         }
-        c = msg_[char_count_++];
-        return 1;
+        std::size_t length = std::min({size, chunk_size_, msg_.size() - char_count_});
+        msg_.copy(data, length, char_count_);
+        char_count_ += length;
+        return length;
     }
 
     /**
-     * Set the message that will be read character by character with \c read_char if the
-     * \c use_parent_read_char_ is set to \c false.
+     * Set the message that will be read in chunks with \c read_chunk if the
+     * \c use_parent_read_chunk_ is set to \c false.
      *
      * Setting a message sets \c char_count_ the "next character" index to 0.
      *
      * @param msg The string to set a read message
+     * @param chunk_size The maximum number of bytes returned by each call to \c read_chunk
      */
     void set_msg(
-            std::string msg)
+            std::string msg,
+            std::size_t chunk_size = BUFFER_SIZE)
     {
         char_count_ = 0;
         msg_ = msg;
+        chunk_size_ = chunk_size;
     }
 
     /**
-     * Set whether \c read_char should use the parent's implementation or not.
+     * Set whether \c read_chunk should use the parent's implementation or not.
      */
-    void use_parent_read_char(
+    void use_parent_read_chunk(
             bool should_use = true)
     {
-        use_parent_read_char_ = should_use;
+        use_parent_read_chunk_ = should_use;
+    }
+
+    /**
+     * Get the number of times that \c read_chunk has been called.
+     *
+     * @return The number of calls to \c read_chunk
+     */
+    std::size_t read_chunk_calls() const
+    {
+        return read_chunk_calls_;
     }
 
 private:
 
-    //! Message to be read character by character if \c use_parent_read_char_ is set to \c false
+    //! Message to be read in chunks if \c use_parent_read_chunk_ is set to \c false
     std::string msg_;
 
     //! The index to the next character of \c msg_ to be read.
-    uint8_t char_count_ = 0;
+    std::size_t char_count_ = 0;
+
+    //! The maximum number of characters of \c msg_ returned by each call to \c read_chunk
+    std::size_t chunk_size_ = BUFFER_SIZE;
+
+    //! The number of times that \c read_chunk has been called
+    std::size_t read_chunk_calls_ = 0;
 
     /**
-     * Flag to indicate whether \c read_char should call the parent's \c read_char, or should read
-     * a character from \c msg instead.
+     * Flag to indicate whether \c read_chunk should call the parent's \c read_chunk, or should
+     * read a chunk from \c msg instead.
      */
-    bool use_parent_read_char_ = true;
+    bool use_parent_read_chunk_ = true;
 };
 
 } // namespace easynmea
@@ -362,7 +393,7 @@ TEST(SerialInterfaceTests, read_lineSuccess)
 
     /* Set mock object */
     serial.set_msg(msg);
-    serial.use_parent_read_char(false);
+    serial.use_parent_read_chunk(false);
     serial.set_serial_port(serial_port_mock);
 
     /* Call with an empty string */
@@ -411,6 +442,362 @@ TEST(SerialInterfaceTests, read_lineClosed)
     ASSERT_EQ(result, "Some content");
 }
 
+TEST(SerialInterfaceTests, read_lineReadError)
+{
+    /* Create mock */
+    SerialInterfaceTest serial;
+    SerialPortMock* serial_port_mock = new SerialPortMock(serial.io_service());
+
+    /* The port is open until the read error closes it */
+    EXPECT_CALL(*serial_port_mock, is_open)
+            .WillOnce(Return(true))
+            .WillOnce(Return(true))
+            .WillRepeatedly(Return(false));
+    EXPECT_CALL(*serial_port_mock, async_read_some)
+            .WillOnce(Invoke([](
+                const asio::mutable_buffers_1& buffers,
+                std::function<void (const asio::error_code&, std::size_t)> handler)
+            {
+                static_cast<void>(buffers);
+                handler(asio::error_code(25, asio::error::get_system_category()), 0);
+            }));
+    EXPECT_CALL(*serial_port_mock, close)
+            .WillOnce(SetArgReferee<0>(asio::error_code()));
+
+    /* Set mock object */
+    serial.set_serial_port(serial_port_mock);
+
+    std::string result = "Some content";
+    ASSERT_FALSE(serial.read_line(result));
+    ASSERT_TRUE(result.empty());
+    ASSERT_FALSE(serial.read_line(result));
+}
+
+TEST(SerialInterfaceTests, read_lineBulkRead)
+{
+    /* Create mock */
+    SerialInterfaceTest serial;
+    SerialPortMock* serial_port_mock = new SerialPortMock(serial.io_service());
+
+    EXPECT_CALL(*serial_port_mock, is_open)
+            .WillRepeatedly(Return(true));
+
+    /* The port is given the whole buffer, and it fills it with all the bytes it has available */
+    std::string msg = "$GPHDT,274.07,T*03\r\n$GPROT,-12.5,A*2A\r\n$GPTHS";
+    EXPECT_CALL(*serial_port_mock, async_read_some)
+            .WillOnce(Invoke([&msg](
+                const asio::mutable_buffers_1& buffers,
+                std::function<void (const asio::error_code&, std::size_t)> handler)
+            {
+                ASSERT_EQ(asio::buffer_size(buffers), SerialInterfaceTest::BUFFER_SIZE);
+                asio::buffer_copy(buffers, asio::buffer(msg));
+                handler(asio::error_code(), msg.size());
+            }));
+
+    /* Set mock object */
+    serial.set_serial_port(serial_port_mock);
+
+    /* Both lines are framed from a single read */
+    std::string result;
+    ASSERT_TRUE(serial.read_line(result));
+    ASSERT_EQ(result, "$GPHDT,274.07,T*03");
+    ASSERT_TRUE(serial.read_line(result));
+    ASSERT_EQ(result, "$GPROT,-12.5,A*2A");
+    ASSERT_EQ(serial.read_chunk_calls(), 1u);
+}
+
+TEST(SerialInterfaceTests, read_lineSeveralLinesPerRead)
+{
+    /* Create mock */
+    SerialInterfaceTest serial;
+    SerialPortMock* serial_port_mock = new SerialPortMock(serial.io_service());
+
+    EXPECT_CALL(*serial_port_mock, is_open)
+            .WillRepeatedly(Return(true));
+
+    /* Set mock object */
+    serial.use_parent_read_chunk(false);
+    serial.set_serial_port(serial_port_mock);
+
+    /* Three lines in a single read */
+    serial.set_msg("first\r\nsecond\nthird\r\n");
+    std::string result;
+    ASSERT_TRUE(serial.read_line(result));
+    ASSERT_EQ(result, "first");
+    ASSERT_TRUE(serial.read_line(result));
+    ASSERT_EQ(result, "second");
+    ASSERT_TRUE(serial.read_line(result));
+    ASSERT_EQ(result, "third");
+    ASSERT_EQ(serial.read_chunk_calls(), 1u);
+
+    /* Empty lines are lines as well */
+    serial.set_msg("\r\n");
+    ASSERT_TRUE(serial.read_line(result));
+    ASSERT_TRUE(result.empty());
+}
+
+TEST(SerialInterfaceTests, read_lineSplitAcrossReads)
+{
+    /* Create mock */
+    SerialInterfaceTest serial;
+    SerialPortMock* serial_port_mock = new SerialPortMock(serial.io_service());
+
+    EXPECT_CALL(*serial_port_mock, is_open)
+            .WillRepeatedly(Return(true));
+
+    /* Set mock object */
+    serial.use_parent_read_chunk(false);
+    serial.set_serial_port(serial_port_mock);
+
+    /* A line terminator split across two reads */
+    serial.set_msg("$GPHDT,274.07,T*03\r\n$GP\r\n", 19);
+    std::string result;
+    ASSERT_TRUE(serial.read_line(result));
+    ASSERT_EQ(result, "$GPHDT,274.07,T*03");
+    ASSERT_EQ(serial.read_chunk_calls(), 2u);
+    ASSERT_TRUE(serial.read_line(result));
+    ASSERT_EQ(result, "$GP");
+    ASSERT_EQ(serial.read_chunk_calls(), 2u);
+
+    /* A line spanning several reads of four bytes */
+    serial.set_msg("$GPHDT,274.07,T*03\r\n", 4);
+    ASSERT_TRUE(serial.read_line(result));
+    ASSERT_EQ(result, "$GPHDT,274.07,T*03");
+    ASSERT_EQ(serial.read_chunk_calls(), 7u);
+}
+
+TEST(SerialInterfaceTests, read_linesChain)
+{
+    /* Create mock */
+    SerialInterfaceTest serial;
+    SerialPortMock* serial_port_mock = new SerialPortMock(serial.io_service());
+
+    EXPECT_CALL(*serial_port_mock, is_open)
+            .WillRepeatedly(Return(true));
+    EXPECT_CALL(*serial_port_mock, close).Times(0);
+
+    /**
+     * Each completed read re-arms the next one on the whole buffer, until closing the port aborts
+     * the outstanding one. The second line spans both reads.
+     */
+    std::vector<std::string> chunks = {"$GPHDT,274.07,T*03\r\n$GP", "ROT,-12.5,A*2A\r\n"};
+    std::size_t reads = 0;
+    EXPECT_CALL(*serial_port_mock, async_read_some)
+            .Times(3)
+            .WillRepeatedly(Invoke([&](
+                const asio::mutable_buffers_1& buffers,
+                std::function<void (const asio::error_code&, std::size_t)> handler)
+            {
+                ASSERT_EQ(asio::buffer_size(buffers), SerialInterfaceTest::BUFFER_SIZE);
+                if (reads < chunks.size())
+                {
+                    std::size_t size = asio::buffer_copy(buffers, asio::buffer(chunks[reads++]));
+                    handler(asio::error_code(), size);
+                    return;
+                }
+                handler(asio::error::operation_aborted, 0);
+            }));
+
+    /* Set mock object */
+    serial.set_serial_port(serial_port_mock);
+
+    std::vector<std::string> lines;
+    ASSERT_FALSE(serial.read_lines([&lines](const std::string& line)
+            {
+                lines.push_back(line);
+                return true;
+            }));
+    ASSERT_EQ(lines, std::vector<std::string>({"$GPHDT,274.07,T*03", "$GPROT,-12.5,A*2A"}));
+}
+
+TEST(SerialInterfaceTests, read_linesStop)
+{
+    /* Create mock */
+    SerialInterfaceTest serial;
+    SerialPortMock* serial_port_mock = new SerialPortMock(serial.io_service());
+
+    EXPECT_CALL(*serial_port_mock, is_open)
+            .WillRepeatedly(Return(true));
+
+    /* No read is re-armed once the handler asks to stop */
+    std::string msg = "first\r\nsecond\r\n";
+    EXPECT_CALL(*serial_port_mock, async_read_some)
+            .WillOnce(Invoke([&msg](
+                const asio::mutable_buffers_1& buffers,
+                std::function<void (const asio::error_code&, std::size_t)> handler)
+            {
+                handler(asio::error_code(), asio::buffer_copy(buffers, asio::buffer(msg)));
+            }));
+
+    /* Set mock object */
+    serial.use_parent_read_chunk(false);
+    serial.set_serial_port(serial_port_mock);
+
+    std::vector<std::string> lines;
+    ASSERT_TRUE(serial.read_lines([&lines](const std::string& line)
+            {
+                lines.push_back(line);
+                return false;
+            }));
+    ASSERT_EQ(lines, std::vector<std::string>({"first"}));
+
+    /* The lines received after the stop are kept for the next read */
+    std::string result;
+    ASSERT_TRUE(serial.read_line(result));
+    ASSERT_EQ(result, "second");
+    ASSERT_EQ(serial.read_chunk_calls(), 0u);
+
+    /* And the lines buffered by read_line() are handed over before reading again */
+    serial.set_msg("third\r\nfourth\r\n");
+    ASSERT_TRUE(serial.read_line(result));
+    ASSERT_TRUE(serial.read_lines([&lines](const std::string& line)
+            {
+                lines.push_back(line);
+                return false;
+            }));
+    ASSERT_EQ(lines, std::vector<std::string>({"first", "fourth"}));
+}
+
+TEST(SerialInterfaceTests, read_linesClosed)
+{
+    /* Create mock */
+    SerialInterfaceTest serial;
+    SerialPortMock* serial_port_mock = new SerialPortMock(serial.io_service());
+
+    EXPECT_CALL(*serial_port_mock, is_open)
+            .WillOnce(Return(false));
+    EXPECT_CALL(*serial_port_mock, async_read_some).Times(0);
+
+    /* Set mock object */
+    serial.set_serial_port(serial_port_mock);
+
+    bool called = false;
+    ASSERT_FALSE(serial.read_lines([&called](const std::string&)
+            {
+                called = true;
+                return true;
+            }));
+    ASSERT_FALSE(called);
+}
+
+TEST(SerialInterfaceTests, read_linesReadError)
+{
+    /* Create mock */
+    SerialInterfaceTest serial;
+    SerialPortMock* serial_port_mock = new SerialPortMock(serial.io_service());
+
+    /* The port is open until the read error closes it */
+    EXPECT_CALL(*serial_port_mock, is_open)
+            .WillOnce(Return(true))
+            .WillOnce(Return(true))
+            .WillRepeatedly(Return(false));
+    EXPECT_CALL(*serial_port_mock, async_read_some)
+            .WillOnce(Invoke([](
+                const asio::mutable_buffers_1& buffers,
+                std::function<void (const asio::error_code&, std::size_t)> handler)
+            {
+                static_cast<void>(buffers);
+                handler(asio::error_code(25, asio::error::get_system_category()), 0);
+            }));
+    EXPECT_CALL(*serial_port_mock, close)
+            .WillOnce(SetArgReferee<0>(asio::error_code()));
+
+    /* Set mock object */
+    serial.set_serial_port(serial_port_mock);
+
+    ASSERT_FALSE(serial.read_lines([](const std::string&)
+            {
+                return true;
+            }));
+}
+
+TEST(SerialInterfaceTests, line_timeFirstChunk)
+{
+    /* Create mock */
+    SerialInterfaceTest serial;
+    SerialPortMock* serial_port_mock = new SerialPortMock(serial.io_service());
+
+    EXPECT_CALL(*serial_port_mock, is_open)
+            .WillRepeatedly(Return(true));
+
+    /**
+     * The second line spans both reads, so its time is that of the first read, the one which
+     * holds its '$'
+     */
+    std::vector<std::string> chunks = {"$GPHDT,274.07,T*03\r\n$GP", "ROT,-12.5,A*2A\r\n"};
+    std::vector<std::chrono::steady_clock::time_point> read_times;
+    EXPECT_CALL(*serial_port_mock, async_read_some)
+            .Times(3)
+            .WillRepeatedly(Invoke([&](
+                const asio::mutable_buffers_1& buffers,
+                std::function<void (const asio::error_code&, std::size_t)> handler)
+            {
+                if (read_times.size() < chunks.size())
+                {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                    read_times.push_back(std::chrono::steady_clock::now());
+                    std::size_t size = asio::buffer_copy(buffers, asio::buffer(chunks[read_times.size() - 1]));
+                    handler(asio::error_code(), size);
+                    return;
+                }
+                handler(asio::error::operation_aborted, 0);
+            }));
+
+    /* Set mock object */
+    serial.set_serial_port(serial_port_mock);
+
+    std::vector<ReceiveTime> times;
+    ASSERT_FALSE(serial.read_lines([&](const std::string&)
+            {
+                times.push_back(serial.line_time());
+                return true;
+            }));
+    ASSERT_EQ(times.size(), 2u);
+    ASSERT_EQ(read_times.size(), 2u);
+    for (const ReceiveTime& time : times)
+    {
+        ASSERT_GE(time.monotonic, read_times[0]);
+        ASSERT_LT(time.monotonic, read_times[1]);
+        ASSERT_EQ(time.realtime, std::chrono::system_clock::time_point());
+    }
+}
+
+TEST(SerialInterfaceTests, line_timeRealtime)
+{
+    /* Create mock */
+    SerialInterfaceTest serial;
+    SerialPortMock* serial_port_mock = new SerialPortMock(serial.io_service());
+
+    EXPECT_CALL(*serial_port_mock, is_open)
+            .WillRepeatedly(Return(true));
+
+    /* Set mock object */
+    serial.use_parent_read_chunk(false);
+    serial.set_serial_port(serial_port_mock);
+
+    /* The realtime time point is only taken once enabled */
+    serial.set_msg("$GPHDT,274.07,T*03\r\n$GPHDT,274.07,T*03\r\n", 20);
+    std::string result;
+    std::chrono::steady_clock::time_point before = std::chrono::steady_clock::now();
+    ASSERT_TRUE(serial.read_line(result));
+    ASSERT_GE(serial.line_time().monotonic, before);
+    ASSERT_LE(serial.line_time().monotonic, std::chrono::steady_clock::now());
+    ASSERT_EQ(serial.line_time().realtime, std::chrono::system_clock::time_point());
+
+    serial.stamp_realtime(true);
+    std::chrono::system_clock::time_point realtime_before = std::chrono::system_clock::now();
+    ASSERT_TRUE(serial.read_line(result));
+    ASSERT_GE(serial.line_time().realtime, realtime_before);
+    ASSERT_LE(serial.line_time().realtime, std::chrono::system_clock::now());
+}
+
+TEST(SerialInterfaceTests, set_read_profileUnsupported)
+{
+    /* Ports without read profiles, such as asio::serial_port, do not take any */
+    SerialInterfaceTest serial;
+    ASSERT_FALSE(serial.set_read_profile(ReadProfile::lowest_cpu()));
+}
+
 int main(
         int argc,
         char** argv)
@@ -0,0 +1,327 @@
+// Copyright (c) 2021 Eduardo Ponz Segrelles.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <Simd.hpp>
+#include <StructuralIndex.hpp>
+
+using namespace eduponz::easynmea;
+
+class StructuralIndexTest : public StructuralIndex
+{
+public:
+
+    using StructuralIndex::BitmapKernel;
+    using StructuralIndex::BLOCK_SIZE;
+    using StructuralIndex::classify_;
+
+    /**
+     * Get all the classification kernels available on this platform, including the scalar one.
+     *
+     * @return A vector with the available kernels.
+     */
+    static std::vector<BitmapKernel> kernels()
+    {
+        std::vector<BitmapKernel> available = {classify_scalar_};
+        if (classify_sse2_)
+        {
+            available.push_back(classify_sse2_);
+        }
+        if (classify_avx2_ && simd::cpu_supports_avx2())
+        {
+            available.push_back(classify_avx2_);
+        }
+        if (classify_neon_)
+        {
+            available.push_back(classify_neon_);
+        }
+        return available;
+    }
+
+};
+
+/**
+ * Bitmap of the structural characters of a block, calculated one byte at a time.
+ */
+uint64_t reference_bitmap(
+        const char* block,
+        std::size_t size)
+{
+    uint64_t bits = 0;
+    for (std::size_t i = 0; i < size; i++)
+    {
+        if (std::strchr("$!,*\r\n", block[i]) && block[i] != '\0')
+        {
+            bits |= uint64_t(1) << i;
+        }
+    }
+    return bits;
+}
+
+/**
+ * Split a string on a separator, as the fields of a sentence are expected to be split.
+ */
+std::vector<std::string> split(
+        const std::string& sentence,
+        char separator)
+{
+    std::vector<std::string> fields;
+    std::size_t begin = 0;
+    std::size_t end;
+    while ((end = sentence.find(separator, begin)) != std::string::npos)
+    {
+        fields.push_back(sentence.substr(begin, end - begin));
+        begin = end + 1;
+    }
+    fields.push_back(sentence.substr(begin));
+    return fields;
+}
+
+TEST(StructuralIndexTests, classifyAllKernels)
+{
+    std::mt19937 generator(2021);
+    const char* alphabet = "$!,*\r\nGPGA0123456789.-\x80\xff";
+    std::vector<char> buffer(8 * 64 + 3);
+    for (char& c : buffer)
+    {
+        // Mostly structural-looking text, with some random bytes
+        c = (generator() % 4) ? alphabet[generator() % std::strlen(alphabet)] : static_cast<char>(generator());
+    }
+
+    for (StructuralIndexTest::BitmapKernel kernel : StructuralIndexTest::kernels())
+    {
+        // Unaligned starts
+        for (std::size_t offset = 0; offset < 4; offset++)
+        {
+            uint64_t bitmaps[8];
+            kernel(buffer.data() + offset, 8, bitmaps);
+            for (std::size_t block = 0; block < 8; block++)
+            {
+                ASSERT_EQ(bitmaps[block], reference_bitmap(buffer.data() + offset + block * 64, 64))
+                    << "block " << block << " offset " << offset;
+            }
+        }
+    }
+
+    /* Buffers of any size, where the bits past the end must be cleared */
+    for (std::size_t size = 0; size <= 8 * 64; size++)
+    {
+        uint64_t bitmaps[8];
+        StructuralIndexTest::classify_(buffer.data(), size, bitmaps);
+        for (std::size_t block = 0; block * 64 < size; block++)
+        {
+            std::size_t block_size = std::min<std::size_t>(64, size - block * 64);
+            ASSERT_EQ(bitmaps[block], reference_bitmap(buffer.data() + block * 64, block_size)) << "size " << size;
+        }
+    }
+}
+
+TEST(StructuralIndexTests, buildLines)
+{
+    std::string buffer =
+            "$GPGGA,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,2.2,7854,*4a\r\n"
+            "\r\n"
+            "$GPTXT,01,01,02,ANTSTATUS=OPEN*2B\n"
+            "\n"
+            "GNRMC,072705.000,A*46\n"
+            "$GPTXT,01,01*02,ANTSTATUS=OPEN*2B\n"
+            "!AIVDM,1,1,,B,177KQJ5000G?tO`K>RA1wUbN0TKH,0*5C";
+    std::vector<std::string> lines = {
+        "$GPGGA,072705.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,2.2,7854,*4a",
+        "$GPTXT,01,01,02,ANTSTATUS=OPEN*2B",
+        "GNRMC,072705.000,A*46",
+        "$GPTXT,01,01*02,ANTSTATUS=OPEN*2B",
+        "!AIVDM,1,1,,B,177KQJ5000G?tO`K>RA1wUbN0TKH,0*5C"};
+    std::vector<bool> framed = {true, true, false, false, true};
+
+    IndexedSentence sentences[8];
+    std::size_t consumed = 0;
+    ASSERT_EQ(StructuralIndex::build(buffer, sentences, 8, &consumed), lines.size());
+    ASSERT_EQ(consumed, buffer.size());
+    for (std::size_t i = 0; i < lines.size(); i++)
+    {
+        ASSERT_EQ(sentences[i].sentence(buffer), lines[i]);
+        ASSERT_EQ(sentences[i].framed(), framed[i]) << lines[i];
+        ASSERT_EQ(sentences[i].checksum_mark, lines[i].find('*'));
+    }
+    ASSERT_EQ(sentences[3].checksum_marks, 2u);
+
+    /* Sentences without checksum mark end at the end of the line */
+    ASSERT_EQ(StructuralIndex::build("$GPTXT,01\n", sentences, 8), 1u);
+    ASSERT_EQ(sentences[0].checksum_mark, sentences[0].size);
+    ASSERT_EQ(sentences[0].field(std::string_view("$GPTXT,01\n"), 1), "01");
+
+    /* Buffers without sentences */
+    ASSERT_EQ(StructuralIndex::build("", sentences, 8, &consumed), 0u);
+    ASSERT_EQ(consumed, 0u);
+    ASSERT_EQ(StructuralIndex::build("\r\n\n\r\n", sentences, 8, &consumed), 0u);
+    ASSERT_EQ(consumed, 5u);
+}
+
+TEST(StructuralIndexTests, buildFields)
+{
+    std::mt19937 generator(2021);
+    const char* alphabet = "GPAZ019.-,,,,";
+    std::vector<std::string> lines;
+    std::string buffer;
+    for (int i = 0; i < 500; i++)
+    {
+        // Sentences which span several blocks and chunks
+        std::string line = "$";
+        std::size_t size = generator() % 100;
+        for (std::size_t j = 0; j < size; j++)
+        {
+            line += alphabet[generator() % std::strlen(alphabet)];
+        }
+        line += "*00";
+        lines.push_back(line);
+        buffer += line + ((i % 2) ? "\r\n" : "\n");
+    }
+
+    std::vector<IndexedSentence> sentences(lines.size());
+    ASSERT_EQ(StructuralIndex::build(buffer, sentences.data(), sentences.size()), lines.size());
+    for (std::size_t i = 0; i < lines.size(); i++)
+    {
+        std::vector<std::string> fields = split(lines[i].substr(0, lines[i].size() - 3), ',');
+        ASSERT_EQ(sentences[i].sentence(buffer), lines[i]);
+        ASSERT_TRUE(sentences[i].framed());
+        ASSERT_FALSE(sentences[i].truncated);
+        ASSERT_EQ(sentences[i].field_count(), fields.size()) << lines[i];
+        for (std::size_t field = 0; field < fields.size(); field++)
+        {
+            ASSERT_EQ(sentences[i].field(buffer, field), fields[field]) << lines[i];
+        }
+        ASSERT_TRUE(sentences[i].field(buffer, fields.size()).empty());
+    }
+}
+
+TEST(StructuralIndexTests, buildResynchronize)
+{
+    std::string buffer =
+            "5,M,2.2,7854,*4a$GPTXT,01,01,02,ANTSTATUS=OPEN*2B\r\n"
+            "$GPGGA,0727$GPTXT,01,01,02,ANTSTATUS=OPEN*2B\n"
+            "noise\n";
+
+    IndexedSentence sentences[4];
+    ASSERT_EQ(StructuralIndex::build(buffer, sentences, 4), 3u);
+    ASSERT_EQ(sentences[0].sentence(buffer), "$GPTXT,01,01,02,ANTSTATUS=OPEN*2B");
+    ASSERT_EQ(sentences[0].field_count(), 5u);
+    ASSERT_TRUE(sentences[0].framed());
+    ASSERT_EQ(sentences[1].sentence(buffer), "$GPTXT,01,01,02,ANTSTATUS=OPEN*2B");
+    ASSERT_EQ(sentences[1].field(buffer, 4), "ANTSTATUS=OPEN");
+    ASSERT_TRUE(sentences[1].framed());
+    ASSERT_EQ(sentences[2].sentence(buffer), "noise");
+    ASSERT_FALSE(sentences[2].framed());
+}
+
+TEST(StructuralIndexTests, buildTagBlock)
+{
+    std::string buffer =
+            "\\s:GPS1,c:1609459200*4D\\$GPTXT,01,01,02,ANTSTATUS=OPEN*2B\r\n"
+            "noise\\c:1609459200123*6D\\!AIVDM,1,1,,A,15RTgt0PAso;90TKcjM8h6g208CQ,0*4A\n"
+            "\\s:GPS1*3C\\noise$GPTXT,01,01,02,ANTSTATUS=OPEN*2B\n"
+            "\\$GPTXT,01,01,02,ANTSTATUS=OPEN*2B\n";
+
+    /* The tag block is recorded before the sentence, whose fields are not affected by it */
+    IndexedSentence sentences[4];
+    ASSERT_EQ(StructuralIndex::build(buffer, sentences, 4), 4u);
+    ASSERT_EQ(sentences[0].tag_block(buffer), "\\s:GPS1,c:1609459200*4D\\");
+    ASSERT_EQ(sentences[0].sentence(buffer), "$GPTXT,01,01,02,ANTSTATUS=OPEN*2B");
+    ASSERT_EQ(sentences[0].field_count(), 5u);
+    ASSERT_TRUE(sentences[0].framed());
+    ASSERT_EQ(sentences[1].tag_block(buffer), "\\c:1609459200123*6D\\");
+    ASSERT_EQ(sentences[1].field(buffer, 0), "!AIVDM");
+    ASSERT_TRUE(sentences[1].framed());
+
+    /* Only the characters enclosed in '\\' right before the start mark are a tag block */
+    ASSERT_EQ(sentences[2].tag_block_size, 0u);
+    ASSERT_TRUE(sentences[2].tag_block(buffer).empty());
+    ASSERT_EQ(sentences[2].sentence(buffer), "$GPTXT,01,01,02,ANTSTATUS=OPEN*2B");
+    ASSERT_EQ(sentences[3].tag_block_size, 0u);
+}
+
+TEST(StructuralIndexTests, buildCapacity)
+{
+    std::string buffer;
+    for (int i = 0; i < 10; i++)
+    {
+        buffer += "$GPTXT,01,01,0" + std::to_string(i) + ",ANTSTATUS=OPEN*2B\r\n\r\n";
+    }
+
+    /* Index the buffer three sentences at a time, resuming from the consumed bytes */
+    IndexedSentence sentences[3];
+    std::size_t offset = 0;
+    std::size_t total = 0;
+    std::size_t count;
+    while ((count = StructuralIndex::build(std::string_view(buffer).substr(offset), sentences, 3)) > 0)
+    {
+        std::size_t consumed = 0;
+        ASSERT_EQ(StructuralIndex::build(std::string_view(buffer).substr(offset), sentences, 3, &consumed), count);
+        for (std::size_t i = 0; i < count; i++)
+        {
+            ASSERT_EQ(sentences[i].field(std::string_view(buffer).substr(offset), 3), "0" + std::to_string(total + i));
+        }
+        total += count;
+        offset += consumed;
+    }
+    ASSERT_EQ(total, 10u);
+    ASSERT_EQ(offset, buffer.size());
+    ASSERT_EQ(StructuralIndex::build(buffer, sentences, 0), 0u);
+}
+
+TEST(StructuralIndexTests, buildTruncated)
+{
+    std::string sentence = "$PXXX";
+    for (std::size_t i = 0; i < IndexedSentence::MAX_SEPARATORS + 10; i++)
+    {
+        sentence += "," + std::to_string(i);
+    }
+    sentence += "*00";
+
+    IndexedSentence index;
+    ASSERT_EQ(StructuralIndex::build(sentence, &index, 1), 1u);
+    ASSERT_TRUE(index.truncated);
+    ASSERT_TRUE(index.framed());
+    ASSERT_EQ(index.separator_count, IndexedSentence::MAX_SEPARATORS);
+    ASSERT_EQ(index.field(sentence, IndexedSentence::MAX_SEPARATORS - 1),
+            std::to_string(IndexedSentence::MAX_SEPARATORS - 2));
+    ASSERT_TRUE(index.field(sentence, IndexedSentence::MAX_SEPARATORS).empty());
+    ASSERT_EQ(index.sentence(sentence), sentence);
+}
+
+TEST(StructuralIndexTests, implementationName)
+{
+    std::string name = StructuralIndex::implementation();
+    ASSERT_TRUE(name == "avx2" || name == "sse2" || name == "neon" || name == "scalar") << name;
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
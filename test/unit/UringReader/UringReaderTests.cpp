@@ -0,0 +1,478 @@
+// Copyright (c) 2021 Eduardo Ponz Segrelles.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <pty.h>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include <UringReader.hpp>
+
+using namespace eduponz::easynmea;
+
+namespace eduponz {
+namespace easynmea {
+
+/**
+ * A pty pair, which stands for a serial connection: the \c UringReader opens the slave, and the
+ * tests write the bytes that the device would send to the master.
+ */
+class PtyPair
+{
+public:
+
+    PtyPair()
+    {
+        char name[128];
+        if (openpty(&master_, &slave_, name, nullptr, nullptr) == 0)
+        {
+            name_ = name;
+        }
+    }
+
+    ~PtyPair()
+    {
+        close_master();
+        ::close(slave_);
+    }
+
+    //! Path of the slave end
+    const std::string& name() const
+    {
+        return name_;
+    }
+
+    //! Write to the master end, so that the bytes can be read from the slave one
+    bool write(
+            const std::string& bytes)
+    {
+        return ::write(master_, bytes.data(), bytes.size()) == static_cast<ssize_t>(bytes.size());
+    }
+
+    //! Close the master end, so that the slave one hangs up
+    void close_master()
+    {
+        if (master_ != -1)
+        {
+            ::close(master_);
+            master_ = -1;
+        }
+    }
+
+private:
+
+    int master_ = -1;
+    int slave_ = -1;
+    std::string name_;
+};
+
+/**
+ * A temporary file, removed on destruction
+ */
+class TemporaryFile
+{
+public:
+
+    TemporaryFile(
+            const std::string& contents)
+        : path_("uring_reader_tests_" + std::to_string(::getpid()) + "_" + std::to_string(count_++) + ".log")
+    {
+        std::ofstream file(path_, std::ios::binary);
+        file << contents;
+    }
+
+    ~TemporaryFile()
+    {
+        std::remove(path_.c_str());
+    }
+
+    //! Path of the file
+    const std::string& path() const
+    {
+        return path_;
+    }
+
+private:
+
+    static int count_;
+    std::string path_;
+};
+
+int TemporaryFile::count_ = 0;
+
+//! The backends with which each test is run
+const std::vector<UringReader::Backend> backends = {UringReader::Backend::IO_URING, UringReader::Backend::POLL};
+
+} // namespace eduponz
+} // namespace easynmea
+
+TEST(UringReaderTests, constructorPoll)
+{
+    UringReader reader(4, UringReader::Backend::POLL);
+    ASSERT_EQ(reader.backend(), UringReader::Backend::POLL);
+}
+
+TEST(UringReaderTests, openSuccess)
+{
+    PtyPair pty;
+    ASSERT_FALSE(pty.name().empty());
+
+    for (UringReader::Backend backend : backends)
+    {
+        UringReader reader(4, backend);
+        ASSERT_FALSE(reader.is_open());
+        std::size_t source = 4;
+        ASSERT_TRUE(reader.open(pty.name(), 9600, source));
+        ASSERT_TRUE(reader.is_open());
+        ASSERT_EQ(source, 0u);
+    }
+}
+
+TEST(UringReaderTests, openWrongPort)
+{
+    UringReader reader;
+    std::size_t source;
+    ASSERT_FALSE(reader.open("/dev/this_port_does_not_exist", 9600, source));
+    ASSERT_FALSE(reader.is_open());
+}
+
+TEST(UringReaderTests, openMaxSources)
+{
+    PtyPair pty_1;
+    PtyPair pty_2;
+    PtyPair pty_3;
+
+    UringReader reader(2);
+    std::size_t source;
+    ASSERT_TRUE(reader.open(pty_1.name(), 9600, source));
+    ASSERT_EQ(source, 0u);
+    ASSERT_TRUE(reader.open(pty_2.name(), 9600, source));
+    ASSERT_EQ(source, 1u);
+    ASSERT_FALSE(reader.open(pty_3.name(), 9600, source));
+}
+
+TEST(UringReaderTests, open_fileSuccess)
+{
+    TemporaryFile file("$GPGGA\r\n");
+
+    UringReader reader;
+    std::size_t source = 1;
+    ASSERT_TRUE(reader.open_file(file.path(), source));
+    ASSERT_TRUE(reader.is_open());
+    ASSERT_EQ(source, 0u);
+}
+
+TEST(UringReaderTests, open_fileWrongPath)
+{
+    UringReader reader;
+    std::size_t source;
+    ASSERT_FALSE(reader.open_file("this_file_does_not_exist.log", source));
+    ASSERT_FALSE(reader.is_open());
+}
+
+TEST(UringReaderTests, closeSuccess)
+{
+    PtyPair pty;
+    TemporaryFile file("$GPGGA\r\n");
+
+    UringReader reader;
+    std::size_t source;
+    ASSERT_TRUE(reader.open(pty.name(), 9600, source));
+    ASSERT_TRUE(reader.open_file(file.path(), source));
+    ASSERT_TRUE(reader.close());
+    ASSERT_FALSE(reader.is_open());
+
+    // The sources can be opened again
+    ASSERT_TRUE(reader.open_file(file.path(), source));
+    ASSERT_EQ(source, 0u);
+}
+
+TEST(UringReaderTests, closeClosed)
+{
+    UringReader reader;
+    ASSERT_TRUE(reader.close());
+    ASSERT_FALSE(reader.is_open());
+}
+
+TEST(UringReaderTests, read_linesPty)
+{
+    for (UringReader::Backend backend : backends)
+    {
+        PtyPair pty;
+        UringReader reader(4, backend);
+        std::size_t source;
+        ASSERT_TRUE(reader.open(pty.name(), 9600, source));
+
+        ASSERT_TRUE(pty.write("$GPGGA,1\r\n$GPGGA,2\n$GPGGA,"));
+        std::thread device([&pty]()
+                {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+                    pty.write("3\r\n");
+                });
+
+        std::vector<std::string> lines;
+        ASSERT_TRUE(reader.read_lines([&](
+                    std::size_t line_source,
+                    const std::string& line)
+                {
+                    EXPECT_EQ(line_source, source);
+                    lines.push_back(line);
+                    return lines.size() < 3;
+                }));
+        device.join();
+        ASSERT_EQ(lines, std::vector<std::string>({"$GPGGA,1", "$GPGGA,2", "$GPGGA,3"}));
+        ASSERT_TRUE(reader.is_open());
+    }
+}
+
+TEST(UringReaderTests, read_linesSources)
+{
+    for (UringReader::Backend backend : backends)
+    {
+        std::vector<PtyPair> ptys(3);
+        UringReader reader(4, backend);
+        std::map<std::size_t, std::size_t> pty_of_source;
+        for (std::size_t i = 0; i < ptys.size(); i++)
+        {
+            std::size_t source;
+            ASSERT_TRUE(reader.open(ptys[i].name(), 9600, source));
+            pty_of_source[source] = i;
+        }
+
+        std::thread device([&ptys]()
+                {
+                    for (int sentence = 0; sentence < 10; sentence++)
+                    {
+                        for (std::size_t i = 0; i < ptys.size(); i++)
+                        {
+                            ptys[i].write("$PTY," + std::to_string(i) + "," + std::to_string(sentence) + "\r\n");
+                        }
+                        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                    }
+                });
+
+        std::vector<std::vector<std::string>> lines(ptys.size());
+        std::size_t count = 0;
+        ASSERT_TRUE(reader.read_lines([&](
+                    std::size_t source,
+                    const std::string& line)
+                {
+                    lines[pty_of_source.at(source)].push_back(line);
+                    return ++count < 10 * ptys.size();
+                }));
+        device.join();
+
+        for (std::size_t i = 0; i < ptys.size(); i++)
+        {
+            ASSERT_EQ(lines[i].size(), 10u);
+            for (int sentence = 0; sentence < 10; sentence++)
+            {
+                ASSERT_EQ(lines[i][sentence], "$PTY," + std::to_string(i) + "," + std::to_string(sentence));
+            }
+        }
+    }
+}
+
+TEST(UringReaderTests, read_linesFile)
+{
+    TemporaryFile file("$GPGGA,1\r\n\r\n$GPGGA,2\n$GPGGA,3");
+
+    for (UringReader::Backend backend : backends)
+    {
+        UringReader reader(4, backend);
+        std::size_t source;
+        ASSERT_TRUE(reader.open_file(file.path(), source));
+
+        std::vector<std::string> lines;
+        ASSERT_FALSE(reader.read_lines([&](
+                    std::size_t,
+                    const std::string& line)
+                {
+                    lines.push_back(line);
+                    return true;
+                }));
+
+        // The last line is handed over when the file ends, and the file is closed
+        ASSERT_EQ(lines, std::vector<std::string>({"$GPGGA,1", "", "$GPGGA,2", "$GPGGA,3"}));
+        ASSERT_FALSE(reader.is_open());
+    }
+}
+
+TEST(UringReaderTests, read_linesLargeFile)
+{
+    std::string contents;
+    for (int i = 0; i < 2000; i++)
+    {
+        contents += "$GPGGA," + std::to_string(i) + ",4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*47\r\n";
+    }
+    TemporaryFile file_1(contents);
+    TemporaryFile file_2(contents);
+    ASSERT_GT(contents.size(), 4 * UringReader::BUFFER_SIZE);
+
+    for (UringReader::Backend backend : backends)
+    {
+        UringReader reader(4, backend);
+        std::size_t source;
+        ASSERT_TRUE(reader.open_file(file_1.path(), source));
+        ASSERT_TRUE(reader.open_file(file_2.path(), source));
+
+        std::vector<std::string> lines[2];
+        ASSERT_FALSE(reader.read_lines([&](
+                    std::size_t line_source,
+                    const std::string& line)
+                {
+                    lines[line_source].push_back(line);
+                    return true;
+                }));
+
+        for (const std::vector<std::string>& file_lines : lines)
+        {
+            ASSERT_EQ(file_lines.size(), 2000u);
+            for (int i = 0; i < 2000; i++)
+            {
+                ASSERT_EQ(file_lines[i].substr(0, 8 + std::to_string(i).size()), "$GPGGA," + std::to_string(i) + ",");
+            }
+        }
+    }
+}
+
+TEST(UringReaderTests, read_linesPipe)
+{
+    for (UringReader::Backend backend : backends)
+    {
+        int fds[2];
+        ASSERT_EQ(::pipe(fds), 0);
+
+        UringReader reader(4, backend);
+        std::size_t source;
+        ASSERT_TRUE(reader.open_file("/dev/fd/" + std::to_string(fds[0]), source));
+        ::close(fds[0]);
+
+        std::thread writer([&fds]()
+                {
+                    for (int i = 0; i < 5; i++)
+                    {
+                        std::string line = "$GPGGA," + std::to_string(i) + "\r\n";
+                        static_cast<void>(::write(fds[1], line.data(), line.size()));
+                        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+                    }
+                    ::close(fds[1]);
+                });
+
+        std::vector<std::string> lines;
+        ASSERT_FALSE(reader.read_lines([&](
+                    std::size_t,
+                    const std::string& line)
+                {
+                    lines.push_back(line);
+                    return true;
+                }));
+        writer.join();
+
+        ASSERT_EQ(lines, std::vector<std::string>({"$GPGGA,0", "$GPGGA,1", "$GPGGA,2", "$GPGGA,3", "$GPGGA,4"}));
+        ASSERT_FALSE(reader.is_open());
+    }
+}
+
+TEST(UringReaderTests, read_linesStop)
+{
+    TemporaryFile file("$GPGGA,1\r\n$GPGGA,2\r\n$GPGGA,3\r\n");
+
+    for (UringReader::Backend backend : backends)
+    {
+        UringReader reader(4, backend);
+        std::size_t source;
+        ASSERT_TRUE(reader.open_file(file.path(), source));
+
+        // The lines after the one on which the handler stops are kept for the next call
+        std::vector<std::string> lines;
+        auto on_line = [&](
+            std::size_t,
+            const std::string& line)
+                {
+                    lines.push_back(line);
+                    return lines.size() != 1;
+                };
+        ASSERT_TRUE(reader.read_lines(on_line));
+        ASSERT_EQ(lines, std::vector<std::string>({"$GPGGA,1"}));
+        ASSERT_FALSE(reader.read_lines(on_line));
+        ASSERT_EQ(lines, std::vector<std::string>({"$GPGGA,1", "$GPGGA,2", "$GPGGA,3"}));
+    }
+}
+
+TEST(UringReaderTests, read_linesClose)
+{
+    for (UringReader::Backend backend : backends)
+    {
+        PtyPair pty;
+        UringReader reader(4, backend);
+        std::size_t source;
+        ASSERT_TRUE(reader.open(pty.name(), 9600, source));
+
+        std::thread closer([&reader]()
+                {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+                    reader.close();
+                });
+
+        ASSERT_FALSE(reader.read_lines([](
+                    std::size_t,
+                    const std::string&)
+                {
+                    return true;
+                }));
+        closer.join();
+        ASSERT_FALSE(reader.is_open());
+    }
+}
+
+TEST(UringReaderTests, read_linesHangUp)
+{
+    for (UringReader::Backend backend : backends)
+    {
+        PtyPair pty;
+        UringReader reader(4, backend);
+        std::size_t source;
+        ASSERT_TRUE(reader.open(pty.name(), 9600, source));
+
+        std::thread device([&pty]()
+                {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+                    pty.close_master();
+                });
+
+        ASSERT_FALSE(reader.read_lines([](
+                    std::size_t,
+                    const std::string&)
+                {
+                    return true;
+                }));
+        device.join();
+        ASSERT_FALSE(reader.is_open());
+    }
+}
@@ -0,0 +1,385 @@
+// Copyright (c) 2021 Eduardo Ponz Segrelles.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <pty.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include <asio/buffer.hpp>
+#include <asio/error.hpp>
+#include <asio/error_code.hpp>
+#include <asio/io_service.hpp>
+
+#include <SerialInterface.hpp>
+#include <UringSerialPort.hpp>
+
+using namespace eduponz::easynmea;
+
+namespace eduponz {
+namespace easynmea {
+
+/**
+ * A pty pair, which stands for a serial connection: the \c UringSerialPort opens the slave, and
+ * the tests write the bytes that the device would send to the master.
+ */
+class PtyPair
+{
+public:
+
+    PtyPair()
+    {
+        char name[128];
+        if (openpty(&master_, &slave_, name, nullptr, nullptr) == 0)
+        {
+            name_ = name;
+        }
+    }
+
+    ~PtyPair()
+    {
+        close_master();
+        ::close(slave_);
+    }
+
+    //! Path of the slave end
+    const std::string& name() const
+    {
+        return name_;
+    }
+
+    //! File descriptor of the slave end, which the tests use to check its termios attributes
+    int slave() const
+    {
+        return slave_;
+    }
+
+    //! Write to the master end, so that the bytes can be read from the slave one
+    bool write(
+            const std::string& bytes)
+    {
+        return ::write(master_, bytes.data(), bytes.size()) == static_cast<ssize_t>(bytes.size());
+    }
+
+    //! Close the master end, so that the slave one hangs up
+    void close_master()
+    {
+        if (master_ != -1)
+        {
+            ::close(master_);
+            master_ = -1;
+        }
+    }
+
+private:
+
+    int master_ = -1;
+    int slave_ = -1;
+    std::string name_;
+};
+
+/**
+ * A UringSerialPort which exposes the file descriptor of its tty
+ */
+class UringSerialPortTest : public UringSerialPort
+{
+public:
+
+    using UringSerialPort::UringSerialPort;
+
+    int fd()
+    {
+        return fd_;
+    }
+
+};
+
+/**
+ * Read once from a UringSerialPort, running the I/O service until the read completes.
+ *
+ * @param[out] ec The error code of the read
+ * @return The read bytes
+ */
+std::string read_once(
+        asio::io_service& io_service,
+        UringSerialPort& port,
+        asio::error_code& ec)
+{
+    char buffer[1024];
+    std::size_t bytes = 0;
+    port.async_read_some(asio::buffer(buffer, sizeof(buffer)), [&](
+                const asio::error_code& error_code,
+                std::size_t bytes_transferred)
+            {
+                ec = error_code;
+                bytes = bytes_transferred;
+            });
+    io_service.reset();
+    io_service.run();
+    return std::string(buffer, bytes);
+}
+
+} // namespace eduponz
+} // namespace easynmea
+
+TEST(UringSerialPortTests, openSuccess)
+{
+    PtyPair pty;
+    ASSERT_FALSE(pty.name().empty());
+
+    asio::io_service io_service;
+    UringSerialPortTest port(io_service);
+    ASSERT_FALSE(port.is_open());
+
+    asio::error_code ec;
+    port.open(pty.name(), ec);
+    ASSERT_FALSE(ec);
+    ASSERT_TRUE(port.is_open());
+
+    /* The tty is set raw, with the VMIN of the default profile, and it is only left non-blocking
+       when it is not read on io_uring */
+    termios options;
+    ASSERT_EQ(tcgetattr(pty.slave(), &options), 0);
+    ASSERT_EQ(options.c_lflag & (ICANON | ECHO | ISIG), 0u);
+    ASSERT_EQ(options.c_cc[VMIN], ReadProfile::lowest_latency().vmin);
+    ASSERT_EQ(options.c_cc[VTIME], 0);
+    ASSERT_EQ((fcntl(port.fd(), F_GETFL) & O_NONBLOCK) == 0, port.uses_io_uring());
+}
+
+TEST(UringSerialPortTests, openWrongPort)
+{
+    asio::io_service io_service;
+    UringSerialPort port(io_service);
+
+    asio::error_code ec;
+    port.open("/dev/easynmea_non_existent_tty", ec);
+    ASSERT_EQ(ec.value(), ENOENT);
+    ASSERT_FALSE(port.is_open());
+}
+
+TEST(UringSerialPortTests, closeReopen)
+{
+    PtyPair pty;
+    asio::io_service io_service;
+    UringSerialPort port(io_service);
+
+    asio::error_code ec;
+    port.open(pty.name(), ec);
+    ASSERT_FALSE(ec);
+    port.close(ec);
+    ASSERT_FALSE(ec);
+    ASSERT_FALSE(port.is_open());
+
+    /* The wake-up left by close() does not abort the reads of the port opened again */
+    port.open(pty.name(), ec);
+    ASSERT_FALSE(ec);
+    ASSERT_TRUE(pty.write("$GPGGA"));
+    ASSERT_EQ(read_once(io_service, port, ec), "$GPGGA");
+    ASSERT_FALSE(ec);
+}
+
+TEST(UringSerialPortTests, async_read_someLowestLatency)
+{
+    PtyPair pty;
+    asio::io_service io_service;
+    UringSerialPort port(io_service);
+    asio::error_code ec;
+    port.open(pty.name(), ec);
+    ASSERT_FALSE(ec);
+
+    /* Every byte makes the tty readable, and all the buffered bytes are read at once */
+    ASSERT_TRUE(pty.write("$"));
+    ASSERT_EQ(read_once(io_service, port, ec), "$");
+    ASSERT_FALSE(ec);
+
+    std::string line = "GPGGA,072704.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,,*46\r\n";
+    ASSERT_TRUE(pty.write(line));
+    std::string read;
+    while (!ec && read.size() < line.size())
+    {
+        read += read_once(io_service, port, ec);
+    }
+    ASSERT_FALSE(ec);
+    ASSERT_EQ(read, line);
+}
+
+TEST(UringSerialPortTests, async_read_someLowestCpu)
+{
+    PtyPair pty;
+    asio::io_service io_service;
+    UringSerialPort port(io_service);
+    asio::error_code ec;
+    port.set_option(ReadProfile::lowest_cpu(), ec);
+    port.open(pty.name(), ec);
+    ASSERT_FALSE(ec);
+
+    /* The bytes which arrive within the VTIME after the first one are read together with it */
+    std::thread device([&pty]()
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                pty.write("$GPGGA,");
+                std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                pty.write("072704.000*46\r\n");
+            });
+    auto start = std::chrono::steady_clock::now();
+    std::string read = read_once(io_service, port, ec);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    device.join();
+    ASSERT_FALSE(ec);
+    ASSERT_EQ(read, "$GPGGA,072704.000*46\r\n");
+    ASSERT_GE(elapsed, std::chrono::milliseconds(100));
+
+    /* Bursts longer than the 64 bytes the tty hands over per read are read whole */
+    std::string burst(300, 'a');
+    ASSERT_TRUE(pty.write(burst));
+    ASSERT_EQ(read_once(io_service, port, ec), burst);
+    ASSERT_FALSE(ec);
+}
+
+TEST(UringSerialPortTests, async_read_someVmin)
+{
+    PtyPair pty;
+    asio::io_service io_service;
+    UringSerialPort port(io_service);
+    asio::error_code ec;
+    port.set_option(ReadProfile{8, 0}, ec);
+    port.open(pty.name(), ec);
+    ASSERT_FALSE(ec);
+
+    /* The tty is not readable until it has buffered VMIN bytes */
+    std::chrono::steady_clock::time_point completing_write;
+    std::thread device([&pty, &completing_write]()
+            {
+                pty.write("$GPG");
+                std::this_thread::sleep_for(std::chrono::milliseconds(50));
+                completing_write = std::chrono::steady_clock::now();
+                pty.write("GA,*46\r\n");
+            });
+    std::string read = read_once(io_service, port, ec);
+    auto read_end = std::chrono::steady_clock::now();
+    device.join();
+    ASSERT_FALSE(ec);
+    ASSERT_EQ(read, "$GPGGA,*46\r\n");
+    ASSERT_GE(read_end, completing_write);
+}
+
+TEST(UringSerialPortTests, async_read_someClose)
+{
+    for (ReadProfile profile : {ReadProfile::lowest_latency(), ReadProfile::lowest_cpu()})
+    {
+        PtyPair pty;
+        asio::io_service io_service;
+        UringSerialPort port(io_service);
+        asio::error_code ec;
+        port.set_option(profile, ec);
+        port.open(pty.name(), ec);
+        ASSERT_FALSE(ec);
+
+        /* Closing the port from another thread cancels the read in flight */
+        std::thread closer([&port]()
+                {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                    asio::error_code close_ec;
+                    port.close(close_ec);
+                });
+        ASSERT_EQ(read_once(io_service, port, ec), "");
+        closer.join();
+        ASSERT_EQ(ec, asio::error::operation_aborted);
+
+        /* Reading from a closed port is aborted as well */
+        ASSERT_EQ(read_once(io_service, port, ec), "");
+        ASSERT_EQ(ec, asio::error::operation_aborted);
+    }
+}
+
+TEST(UringSerialPortTests, async_read_someHangUp)
+{
+    PtyPair pty;
+    asio::io_service io_service;
+    UringSerialPort port(io_service);
+    asio::error_code ec;
+    port.open(pty.name(), ec);
+    ASSERT_FALSE(ec);
+
+    /* Hanging the device up ends the reads, rather than aborting them */
+    std::thread device([&pty]()
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                pty.close_master();
+            });
+    ASSERT_EQ(read_once(io_service, port, ec), "");
+    device.join();
+    ASSERT_EQ(ec, asio::error::eof);
+    ASSERT_TRUE(port.is_open());
+}
+
+TEST(UringSerialPortTests, read_lines)
+{
+    PtyPair pty;
+    SerialInterface<UringSerialPort> serial;
+    ASSERT_TRUE(serial.set_read_profile(ReadProfile::lowest_cpu()));
+    ASSERT_TRUE(serial.open(pty.name(), 9600));
+
+    /* SerialInterface frames and stamps the lines read through UringSerialPort until the port is
+       closed */
+    std::vector<std::string> lines = {
+        "$GPGGA,072704.000,5703.1740,N,00954.9459,E,1,7,1.97,-21.2,M,42.5,M,,*46",
+        "$GNRMC,072705.000,A,5703.1740,N,00954.9459,E,0.00,90.87,041118,,,A*46",
+        "$GPVTG,90.87,T,,M,0.00,N,0.00,K,A*0B"};
+    auto start = std::chrono::steady_clock::now();
+    std::thread device([&]()
+            {
+                for (const std::string& line : lines)
+                {
+                    pty.write(line + "\r\n");
+                    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(150));
+                serial.close();
+            });
+    std::vector<std::string> read;
+    std::vector<std::chrono::steady_clock::time_point> times;
+    ASSERT_FALSE(serial.read_lines([&](const std::string& line)
+            {
+                read.push_back(line);
+                times.push_back(serial.line_time().monotonic);
+                return true;
+            }));
+    device.join();
+    ASSERT_EQ(read, lines);
+    for (const auto& time : times)
+    {
+        ASSERT_GE(time, start);
+    }
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
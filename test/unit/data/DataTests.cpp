@@ -18,6 +18,9 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 // THE SOFTWARE.
 
+#include <cstring>
+#include <string>
+
 #include <gtest/gtest.h>
 
 #include <easynmea/data.hpp>
@@ -34,6 +37,42 @@ TEST(DataTests, NMEA0183DataComparisonOperators)
 
     data_1.kind = NMEA0183DataKind::GPGGA;
     ASSERT_NE(data_1, data_2);
+
+    data_2.kind = NMEA0183DataKind::GPGGA;
+    ASSERT_EQ(data_1, data_2);
+
+    data_1.talker = NMEA0183Talker::GN;
+    ASSERT_NE(data_1, data_2);
+
+    data_2.talker = NMEA0183Talker::GN;
+    data_1.tag_block.unix_time_ms = 1609459200000;
+    ASSERT_NE(data_1, data_2);
+}
+
+TEST(DataTests, TagBlockComparisonOperators)
+{
+    TagBlock tag_1;
+    TagBlock tag_2;
+
+    ASSERT_TRUE(tag_1.empty());
+    ASSERT_EQ(tag_1, tag_2);
+
+    std::strcpy(tag_1.source, "GPS1");
+    ASSERT_FALSE(tag_1.empty());
+    ASSERT_NE(tag_1, tag_2);
+
+    std::strcpy(tag_2.source, "GPS1");
+    ASSERT_EQ(tag_1, tag_2);
+
+    tag_1.unix_time_ms = 1609459200000;
+    ASSERT_NE(tag_1, tag_2);
+
+    tag_2.unix_time_ms = 1609459200000;
+    ASSERT_EQ(tag_1, tag_2);
+
+    /* Only the characters up to the null terminator are compared */
+    tag_1.source[5] = 'X';
+    ASSERT_EQ(tag_1, tag_2);
 }
 
 TEST(DataTests, GPGGADataComparisonOperators)
@@ -64,15 +103,425 @@ TEST(DataTests, GPGGADataComparisonOperators)
     data_1.fix = 2;
     ASSERT_NE(data_1, data_2);
 
+    data_1.longitude_e7 = 1230000000;
+    ASSERT_NE(data_1, data_2);
+
+    data_1.latitude_e7 = 1230000000;
+    ASSERT_NE(data_1, data_2);
+
     data_1.longitude = 123.0;
     ASSERT_NE(data_1, data_2);
 
     data_1.latitude = 123.0;
     ASSERT_NE(data_1, data_2);
 
+    data_1.utc_time = UtcTime(std::chrono::milliseconds(1541316425000));
+    ASSERT_NE(data_1, data_2);
+
+    data_1.time_of_day_ms = 26825000;
+    ASSERT_NE(data_1, data_2);
+
     data_1.timestamp = 123.0;
     ASSERT_NE(data_1, data_2);
 
+    data_1.talker = NMEA0183Talker::GN;
+    ASSERT_NE(data_1, data_2);
+
+    data_1.kind = NMEA0183DataKind::INVALID;
+    ASSERT_NE(data_1, data_2);
+}
+
+TEST(DataTests, RMCDataComparisonOperators)
+{
+    RMCData data_1;
+    RMCData data_2;
+
+    ASSERT_EQ(data_1, data_2);
+
+    data_1.navigational_status = 'S';
+    ASSERT_NE(data_1, data_2);
+
+    data_1.mode = 'A';
+    ASSERT_NE(data_1, data_2);
+
+    data_1.magnetic_variation = -3.1f;
+    ASSERT_NE(data_1, data_2);
+
+    data_1.date = 41118;
+    ASSERT_NE(data_1, data_2);
+
+    data_1.course = 90.87f;
+    ASSERT_NE(data_1, data_2);
+
+    data_1.speed = 0.5f;
+    ASSERT_NE(data_1, data_2);
+
+    data_1.longitude_e7 = 1230000000;
+    ASSERT_NE(data_1, data_2);
+
+    data_1.latitude_e7 = 1230000000;
+    ASSERT_NE(data_1, data_2);
+
+    data_1.longitude = 123.0;
+    ASSERT_NE(data_1, data_2);
+
+    data_1.latitude = 123.0;
+    ASSERT_NE(data_1, data_2);
+
+    data_1.status = 'A';
+    ASSERT_NE(data_1, data_2);
+
+    data_1.utc_time = UtcTime(std::chrono::milliseconds(1541316425000));
+    ASSERT_NE(data_1, data_2);
+
+    data_1.time_of_day_ms = 26825000;
+    ASSERT_NE(data_1, data_2);
+
+    data_1.timestamp = 123.0;
+    ASSERT_NE(data_1, data_2);
+
+    data_1.talker = NMEA0183Talker::GN;
+    ASSERT_NE(data_1, data_2);
+
+    data_1.kind = NMEA0183DataKind::INVALID;
+    ASSERT_NE(data_1, data_2);
+}
+
+TEST(DataTests, ZDADataComparisonOperators)
+{
+    ZDAData data_1;
+    ZDAData data_2;
+
+    ASSERT_EQ(data_1, data_2);
+
+    data_1.utc_time = UtcTime(std::chrono::milliseconds(1541316425000));
+    ASSERT_NE(data_1, data_2);
+
+    data_1.local_zone_minutes = 30;
+    ASSERT_NE(data_1, data_2);
+
+    data_1.local_zone_hours = -3;
+    ASSERT_NE(data_1, data_2);
+
+    data_1.year = 2018;
+    ASSERT_NE(data_1, data_2);
+
+    data_1.month = 11;
+    ASSERT_NE(data_1, data_2);
+
+    data_1.day = 4;
+    ASSERT_NE(data_1, data_2);
+
+    data_1.time_of_day_ms = 26825000;
+    ASSERT_NE(data_1, data_2);
+
+    data_1.talker = NMEA0183Talker::GN;
+    ASSERT_NE(data_1, data_2);
+
+    data_1.kind = NMEA0183DataKind::INVALID;
+    ASSERT_NE(data_1, data_2);
+}
+
+TEST(DataTests, HDTDataComparisonOperators)
+{
+    HDTData data_1;
+    HDTData data_2;
+
+    ASSERT_EQ(data_1, data_2);
+
+    data_1.heading = 274.07f;
+    ASSERT_NE(data_1, data_2);
+
+    data_1.talker = NMEA0183Talker::GN;
+    ASSERT_NE(data_1, data_2);
+
+    data_1.kind = NMEA0183DataKind::INVALID;
+    ASSERT_NE(data_1, data_2);
+}
+
+TEST(DataTests, THSDataComparisonOperators)
+{
+    THSData data_1;
+    THSData data_2;
+
+    ASSERT_EQ(data_1, data_2);
+
+    data_1.mode = 'A';
+    ASSERT_NE(data_1, data_2);
+
+    data_1.heading = 274.07f;
+    ASSERT_NE(data_1, data_2);
+
+    data_1.talker = NMEA0183Talker::GN;
+    ASSERT_NE(data_1, data_2);
+
+    data_1.kind = NMEA0183DataKind::INVALID;
+    ASSERT_NE(data_1, data_2);
+}
+
+TEST(DataTests, ROTDataComparisonOperators)
+{
+    ROTData data_1;
+    ROTData data_2;
+
+    ASSERT_EQ(data_1, data_2);
+
+    data_1.status = 'A';
+    ASSERT_NE(data_1, data_2);
+
+    data_1.rate_of_turn = -12.5f;
+    ASSERT_NE(data_1, data_2);
+
+    data_1.talker = NMEA0183Talker::GN;
+    ASSERT_NE(data_1, data_2);
+
+    data_1.kind = NMEA0183DataKind::INVALID;
+    ASSERT_NE(data_1, data_2);
+}
+
+TEST(DataTests, GSTDataComparisonOperators)
+{
+    GSTData data_1;
+    GSTData data_2;
+
+    ASSERT_EQ(data_1, data_2);
+
+    data_1.altitude_error = 0.031f;
+    ASSERT_NE(data_1, data_2);
+
+    data_1.longitude_error = 0.020f;
+    ASSERT_NE(data_1, data_2);
+
+    data_1.latitude_error = 0.023f;
+    ASSERT_NE(data_1, data_2);
+
+    data_1.semi_major_orientation = 273.6f;
+    ASSERT_NE(data_1, data_2);
+
+    data_1.semi_minor_error = 0.020f;
+    ASSERT_NE(data_1, data_2);
+
+    data_1.semi_major_error = 0.023f;
+    ASSERT_NE(data_1, data_2);
+
+    data_1.rms = 0.006f;
+    ASSERT_NE(data_1, data_2);
+
+    data_1.utc_time = UtcTime(std::chrono::milliseconds(1541316425000));
+    ASSERT_NE(data_1, data_2);
+
+    data_1.time_of_day_ms = 62894000;
+    ASSERT_NE(data_1, data_2);
+
+    data_1.talker = NMEA0183Talker::GN;
+    ASSERT_NE(data_1, data_2);
+
+    data_1.kind = NMEA0183DataKind::INVALID;
+    ASSERT_NE(data_1, data_2);
+}
+
+TEST(DataTests, GSVSatelliteComparisonOperators)
+{
+    GSVSatellite satellite_1;
+    GSVSatellite satellite_2;
+
+    ASSERT_EQ(satellite_1, satellite_2);
+
+    satellite_1.snr = 42;
+    ASSERT_NE(satellite_1, satellite_2);
+
+    satellite_1.azimuth = 270;
+    ASSERT_NE(satellite_1, satellite_2);
+
+    satellite_1.elevation = 15;
+    ASSERT_NE(satellite_1, satellite_2);
+
+    satellite_1.prn = 4;
+    ASSERT_NE(satellite_1, satellite_2);
+}
+
+TEST(DataTests, GSVDataComparisonOperators)
+{
+    GSVData data_1;
+    GSVData data_2;
+
+    ASSERT_EQ(data_1, data_2);
+
+    /* Entries past the satellite count are not compared */
+    data_1.satellites[0].prn = 4;
+    ASSERT_EQ(data_1, data_2);
+
+    data_1.satellite_count = 1;
+    ASSERT_NE(data_1, data_2);
+
+    data_2.satellite_count = 1;
+    data_2.satellites[0].prn = 4;
+    ASSERT_EQ(data_1, data_2);
+
+    data_1.satellites[0].snr = 42;
+    ASSERT_NE(data_1, data_2);
+
+    data_1.signal_id = '1';
+    ASSERT_NE(data_1, data_2);
+
+    data_1.satellites_in_view = 11;
+    ASSERT_NE(data_1, data_2);
+
+    data_1.talker = NMEA0183Talker::GL;
+    ASSERT_NE(data_1, data_2);
+
+    data_1.kind = NMEA0183DataKind::INVALID;
+    ASSERT_NE(data_1, data_2);
+}
+
+TEST(DataTests, GSASystemComparisonOperators)
+{
+    GSASystem system_1;
+    GSASystem system_2;
+
+    ASSERT_EQ(system_1, system_2);
+
+    /* Entries past the PRN count are not compared */
+    system_1.prns[0] = 10;
+    ASSERT_EQ(system_1, system_2);
+
+    system_1.prn_count = 1;
+    ASSERT_NE(system_1, system_2);
+
+    system_2.prn_count = 1;
+    system_2.prns[0] = 10;
+    ASSERT_EQ(system_1, system_2);
+
+    system_1.system_id = '1';
+    ASSERT_NE(system_1, system_2);
+}
+
+TEST(DataTests, GSADataComparisonOperators)
+{
+    GSAData data_1;
+    GSAData data_2;
+
+    ASSERT_EQ(data_1, data_2);
+
+    /* Entries past the system count are not compared */
+    data_1.systems[0].prn_count = 1;
+    ASSERT_EQ(data_1, data_2);
+
+    data_1.system_count = 1;
+    ASSERT_NE(data_1, data_2);
+
+    data_2.system_count = 1;
+    data_2.systems[0].prn_count = 1;
+    ASSERT_EQ(data_1, data_2);
+
+    data_1.systems[0].prns[0] = 10;
+    ASSERT_NE(data_1, data_2);
+
+    data_1.vdop = 0.95f;
+    ASSERT_NE(data_1, data_2);
+
+    data_1.hdop = 1.97f;
+    ASSERT_NE(data_1, data_2);
+
+    data_1.pdop = 2.19f;
+    ASSERT_NE(data_1, data_2);
+
+    data_1.fix_type = 3;
+    ASSERT_NE(data_1, data_2);
+
+    data_1.selection_mode = 'M';
+    ASSERT_NE(data_1, data_2);
+
+    data_1.talker = NMEA0183Talker::GN;
+    ASSERT_NE(data_1, data_2);
+
+    data_1.kind = NMEA0183DataKind::INVALID;
+    ASSERT_NE(data_1, data_2);
+}
+
+TEST(DataTests, AISPositionDataComparisonOperators)
+{
+    AISPositionData data_1;
+    AISPositionData data_2;
+
+    ASSERT_EQ(data_1, data_2);
+
+    data_1.own_ship = true;
+    ASSERT_NE(data_1, data_2);
+
+    data_1.channel = 'A';
+    ASSERT_NE(data_1, data_2);
+
+    data_1.raim = true;
+    ASSERT_NE(data_1, data_2);
+
+    data_1.utc_second = 33;
+    ASSERT_NE(data_1, data_2);
+
+    data_1.true_heading = 215;
+    ASSERT_NE(data_1, data_2);
+
+    data_1.course_over_ground = 224.0f;
+    ASSERT_NE(data_1, data_2);
+
+    data_1.longitude_e7 = -1233953833;
+    ASSERT_NE(data_1, data_2);
+
+    data_1.latitude_e7 = 483816333;
+    ASSERT_NE(data_1, data_2);
+
+    data_1.longitude = -123.395383f;
+    ASSERT_NE(data_1, data_2);
+
+    data_1.latitude = 48.381633f;
+    ASSERT_NE(data_1, data_2);
+
+    data_1.position_accuracy = true;
+    ASSERT_NE(data_1, data_2);
+
+    data_1.speed_over_ground = 12.3f;
+    ASSERT_NE(data_1, data_2);
+
+    data_1.rate_of_turn = -127;
+    ASSERT_NE(data_1, data_2);
+
+    data_1.navigation_status = 0;
+    ASSERT_NE(data_1, data_2);
+
+    data_1.mmsi = 371798000;
+    ASSERT_NE(data_1, data_2);
+
+    data_1.repeat_indicator = 1;
+    ASSERT_NE(data_1, data_2);
+
+    data_1.message_type = 1;
+    ASSERT_NE(data_1, data_2);
+
+    data_1.talker = NMEA0183Talker::BS;
+    ASSERT_NE(data_1, data_2);
+
+    data_1.kind = NMEA0183DataKind::INVALID;
+    ASSERT_NE(data_1, data_2);
+}
+
+TEST(DataTests, RawSentenceComparisonOperators)
+{
+    RawSentence data_1;
+    RawSentence data_2;
+
+    ASSERT_EQ(data_1, data_2);
+
+    /* The sentences are compared by value, regardless of where they are stored */
+    std::string sentence_1 = "$PGRMT*5C";
+    std::string sentence_2 = sentence_1;
+    data_1.sentence = sentence_1;
+    ASSERT_NE(data_1, data_2);
+    data_2.sentence = sentence_2;
+    ASSERT_EQ(data_1, data_2);
+
+    data_1.talker = NMEA0183Talker::GP;
+    ASSERT_NE(data_1, data_2);
+
     data_1.kind = NMEA0183DataKind::INVALID;
     ASSERT_NE(data_1, data_2);
 }